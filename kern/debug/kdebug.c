@@ -292,6 +292,24 @@ print_debuginfo(uintptr_t eip) {
     }
 }
 
+/* *
+ * debuginfo_symbol - copy the name of the function holding @eip (at most @len
+ * bytes with the '\0') into @name, return the offset of @eip in it, or -1.
+ * */
+int
+debuginfo_symbol(uintptr_t eip, char *name, int len) {
+    struct eipdebuginfo info;
+    if (len <= 0 || debuginfo_eip(eip, &info) != 0) {
+        return -1;
+    }
+    int j;
+    for (j = 0; j < info.eip_fn_namelen && j < len - 1; j ++) {
+        name[j] = info.eip_fn_name[j];
+    }
+    name[j] = '\0';
+    return eip - info.eip_fn_addr;
+}
+
 static __noinline uint32_t
 read_eip(void) {
     uint32_t eip;
@@ -7,6 +7,11 @@
 void print_kerninfo(void);
 void print_stackframe(void);
 void print_debuginfo(uintptr_t eip);
+int debuginfo_symbol(uintptr_t eip, char *name, int len);
+
+/* sampling profiler, kern/debug/kprof.c */
+void kprof_sample(struct trapframe *tf);
+int do_kprof(int op, uint32_t arg, void *buf, int n);
 
 #endif /* !__KERN_DEBUG_KDEBUG_H__ */
 
@@ -0,0 +1,230 @@
+#include <defs.h>
+#include <x86.h>
+#include <string.h>
+#include <sync.h>
+#include <memlayout.h>
+#include <mmu.h>
+#include <pmm.h>
+#include <vmm.h>
+#include <proc.h>
+#include <trap.h>
+#include <clock.h>
+#include <time.h>
+#include <unistd.h>
+#include <kdebug.h>
+#include <kprof.h>
+#include <error.h>
+
+/* *
+ * Sampling profiler, see libs/kprof.h. The clock interrupt is the only
+ * producer and advances kprof_tail; KPROF_READ is the only consumer and
+ * advances kprof_head. A full ring drops the new sample, so the reader can
+ * copy slots to user space (and fault on its buffer) without locking.
+ * */
+
+#define KPROF_PAGES     ((KPROF_SAMPLES * sizeof(struct kprof_sample) + PGSIZE - 1) / PGSIZE)
+
+static struct Page *kprof_pages;        // the ring, allocated by the first KPROF_START
+static struct kprof_sample *kprof_ring;
+static volatile uint32_t kprof_head, kprof_tail;   // free-running, slot is counter % KPROF_SAMPLES
+static uint32_t kprof_lost;             // samples dropped on a full ring
+static bool kprof_on;
+
+// kprof_kernel_walk - follow the kernel frame chain from ebp within current's kernel stack
+static int
+kprof_kernel_walk(struct kprof_sample *s, int depth, uintptr_t ebp) {
+    uintptr_t base = current->kstack, top = current->kstack + KSTACKSIZE;
+    while (depth < KPROF_DEPTH && ebp >= base && ebp + 8 <= top) {
+        uintptr_t *frame = (uintptr_t *)ebp;
+        if (frame[1] == 0) {
+            break;
+        }
+        s->pc[depth ++] = frame[1];
+        // frames only go up the stack; anything else is not a frame pointer
+        if (frame[0] <= ebp) {
+            break;
+        }
+        ebp = frame[0];
+    }
+    return depth;
+}
+
+/* *
+ * kprof_user_word - read a word of current's user memory through the page
+ * table: the sample may be taken anywhere, so never fault, and do not rely
+ * on cr3 still being the proc's. User frames may be HighMem, map them with
+ * kmap_irq.
+ * */
+static bool
+kprof_user_word(uintptr_t addr, uintptr_t *val) {
+    struct mm_struct *mm = current->mm;
+    pte_t *ptep;
+    if (mm == NULL || addr < USERBASE || addr + sizeof(uintptr_t) > USERTOP || addr % sizeof(uintptr_t) != 0) {
+        return 0;
+    }
+    if ((ptep = get_pte(mm->pgdir, addr, 0)) == NULL || (*ptep & (PTE_P | PTE_U)) != (PTE_P | PTE_U)) {
+        return 0;
+    }
+    void *kva = kmap_irq(pte2page(*ptep));
+    *val = *(uintptr_t *)((uintptr_t)kva + PGOFF(addr));
+    kunmap(kva);
+    return 1;
+}
+
+// kprof_user_walk - record the user pc of tf and the frame chain above it
+static int
+kprof_user_walk(struct kprof_sample *s, int depth, struct trapframe *tf) {
+    uintptr_t ebp = tf->tf_regs.reg_ebp, pc;
+    s->pc[depth ++] = tf->tf_eip;
+    // __sysenter_call passes its esp in %ebp, its caller's frame sits above the saved registers
+    if (tf->tf_err == SYSENTER_FRAME && tf->tf_trapno == T_SYSCALL && depth < KPROF_DEPTH) {
+        if (!kprof_user_word(ebp + 0x14, &pc) || !kprof_user_word(ebp + 0x10, &ebp)) {
+            return depth;
+        }
+        s->pc[depth ++] = pc;
+    }
+    while (depth < KPROF_DEPTH && kprof_user_word(ebp + 4, &pc) && pc != 0) {
+        s->pc[depth ++] = pc;
+        uintptr_t next;
+        if (!kprof_user_word(ebp, &next) || next <= ebp) {
+            break;
+        }
+        ebp = next;
+    }
+    return depth;
+}
+
+/* *
+ * kprof_sample - called from the clock interrupt with its trapframe, record
+ * one sample if the profiler runs.
+ * */
+void
+kprof_sample(struct trapframe *tf) {
+    if (!kprof_on || current == NULL) {
+        return;
+    }
+    if (kprof_tail - kprof_head >= KPROF_SAMPLES) {
+        kprof_lost ++;
+        return;
+    }
+    struct kprof_sample *s = &(kprof_ring[kprof_tail % KPROF_SAMPLES]);
+    s->pid = current->pid;
+    strncpy(s->name, current->name, KPROF_NAME_LEN);
+    s->name[KPROF_NAME_LEN] = '\0';
+
+    int depth = 0;
+    if (trap_in_kernel(tf)) {
+        s->pc[depth ++] = tf->tf_eip;
+        depth = kprof_kernel_walk(s, depth, tf->tf_regs.reg_ebp);
+        s->kdepth = depth;
+        // a user proc in the kernel entered through the trapframe at the top of its kernel stack
+        struct trapframe *utf = (struct trapframe *)(current->kstack + KSTACKSIZE) - 1;
+        if (current->mm != NULL && depth < KPROF_DEPTH && !trap_in_kernel(utf)) {
+            depth = kprof_user_walk(s, depth, utf);
+        }
+    }
+    else {
+        s->kdepth = 0;
+        depth = kprof_user_walk(s, depth, tf);
+    }
+    s->depth = depth;
+    kprof_tail ++;
+}
+
+// kprof_symbol - copy the name of the kernel function holding pc to buf, return the offset
+static int
+kprof_symbol(uintptr_t pc, char *buf, int n) {
+    char name[64];
+    int off;
+    if (pc < KERNBASE || n <= 0 || (off = debuginfo_symbol(pc, name, n < sizeof(name) ? n : sizeof(name))) < 0) {
+        return -E_INVAL;
+    }
+
+    struct mm_struct *mm = current->mm;
+    lock_mm(mm);
+    bool ok = copy_to_user(mm, buf, name, strlen(name) + 1);
+    unlock_mm(mm);
+    return ok ? off : -E_INVAL;
+}
+
+/* *
+ * do_kprof - SYS_kprof
+ *   KPROF_START:  empty the ring and start sampling, at least every arg usecs
+ *   KPROF_STOP:   stop sampling, return the samples dropped since the start
+ *   KPROF_READ:   move up to n samples from the ring to buf, return how many;
+ *                 once stopped and drained, the ring itself is freed
+ *   KPROF_SYMBOL: resolve the kernel pc arg, see kprof_symbol
+ * */
+int
+do_kprof(int op, uint32_t arg, void *buf, int n) {
+    bool intr_flag;
+    switch (op) {
+    case KPROF_START:
+        if (kprof_on) {
+            return -E_BUSY;
+        }
+        if (arg != 0 && arg < KPROF_MIN_PERIOD) {
+            arg = KPROF_MIN_PERIOD;
+        }
+        if (kprof_pages == NULL) {
+            if ((kprof_pages = alloc_pages(KPROF_PAGES)) == NULL) {
+                return -E_NO_MEM;
+            }
+            kprof_ring = page2kva(kprof_pages);
+        }
+        local_intr_save(intr_flag);
+        {
+            kprof_head = kprof_tail = kprof_lost = 0;
+            kprof_on = 1;
+            clock_set_sample_period((uint64_t)arg * NSEC_PER_USEC);
+        }
+        local_intr_restore(intr_flag);
+        return 0;
+    case KPROF_STOP:
+        local_intr_save(intr_flag);
+        {
+            kprof_on = 0;
+            clock_set_sample_period(0);
+        }
+        local_intr_restore(intr_flag);
+        return kprof_lost;
+    case KPROF_SYMBOL:
+        return kprof_symbol(arg, buf, n);
+    case KPROF_READ:
+        break;
+    default:
+        return -E_INVAL;
+    }
+
+    if (kprof_pages == NULL || n <= 0) {
+        return 0;
+    }
+    uint32_t head = kprof_head, avail = kprof_tail - head;
+    if (avail == 0 && !kprof_on) {
+        free_pages(kprof_pages, KPROF_PAGES);
+        kprof_pages = NULL, kprof_ring = NULL;
+        return 0;
+    }
+    if (n > avail) {
+        n = avail;
+    }
+
+    // the slots from head on are ours until kprof_head moves, copy them in at most two runs
+    struct mm_struct *mm = current->mm;
+    int copied = 0;
+    lock_mm(mm);
+    while (copied < n) {
+        uint32_t slot = (head + copied) % KPROF_SAMPLES, run = KPROF_SAMPLES - slot;
+        if (run > n - copied) {
+            run = n - copied;
+        }
+        if (!copy_to_user(mm, (struct kprof_sample *)buf + copied, &(kprof_ring[slot]),
+                          run * sizeof(struct kprof_sample))) {
+            break;
+        }
+        copied += run;
+    }
+    unlock_mm(mm);
+    kprof_head = head + copied;
+    return copied != 0 ? copied : -E_INVAL;
+}
@@ -2,6 +2,12 @@
 #include <trap.h>
 #include <stdio.h>
 #include <picirq.h>
+#include <pmm.h>
+#include <vdso.h>
+#include <time.h>
+#include <sched.h>
+#include <sync.h>
+#include <proc.h>
 
 /* *
  * Support for time-related hardware gadgets - the 8253 timer,
@@ -20,9 +26,24 @@
 
 #define TIMER_MODE      (IO_TIMER1 + 3)         // timer mode port
 #define TIMER_SEL0      0x00                    // select counter 0
+#define TIMER_SEL2      0x80                    // select counter 2
+#define TIMER_ONESHOT   0x00                    // mode 0, interrupt on terminal count
 #define TIMER_RATEGEN   0x04                    // mode 2, rate generator
 #define TIMER_16BIT     0x30                    // r/w counter 16 bits, LSB first
 
+#define IO_TIMER2       (IO_TIMER1 + 2)         // counter 2, gated by port 0x61
+#define IO_PPI          0x61                    // speaker/counter 2 control
+#define PPI_GATE2       0x01                    // counter 2 gate
+#define PPI_SPKR        0x02                    // speaker data enable
+#define PPI_OUT2        0x20                    // counter 2 output (read only)
+
+#define TICK_HZ         100                     // timer ticks per second
+#define TICK_NS         (NSEC_PER_SEC / TICK_HZ)
+#define CALIB_MS        50                      // length of the TSC calibration
+#define PIT_MIN_COUNT   2                       // shortest one-shot the PIT is asked for
+#define PIT_MAX_COUNT   0xFFFF
+#define PIT_MAX_NS      (54 * NSEC_PER_MSEC)    // longest one-shot, 65535 counts are 54.9ms
+
 volatile size_t ticks;
 
 long SYSTEM_READ_TIMER( void ){
@@ -30,20 +51,227 @@ long SYSTEM_READ_TIMER( void ){
 }
 
 /* *
- * clock_init - initialize 8253 clock to interrupt 100 times per second,
- * and then enable IRQ_TIMER.
+ * With a TSC the clock runs in one-shot mode: the TSC, calibrated against
+ * the PIT at boot, is the time source, and every clock interrupt programs
+ * counter 0 for the nearer of the next tick and the earliest hrtimer. Ticks
+ * are counted from the TSC, so they do not drift however the interrupts
+ * are spaced. Without a TSC the PIT stays periodic and ticks are the clock.
+ *
+ * Time since boot is base_ns + (rdtsc() - base_tsc) * ns_mult >> NS_SHIFT;
+ * base_ns/base_tsc move forward on every clock interrupt, which keeps the
+ * product small. The same values are published in the vdso page.
+ *
+ * While the idle thread halts the tick is stopped (tick_stopped): the next
+ * interrupt is due at the first timer_list or hrtimer expiry, and the ticks
+ * skipped meanwhile are counted when the CPU wakes up.
+ * */
+static bool oneshot;
+static bool tick_stopped;
+static uint64_t sample_ns;              // profiler sampling period, 0 when off
+static uint32_t tsc_khz;
+static uint32_t ns_mult;
+static uint64_t base_tsc, base_ns;
+static uint64_t next_tick_ns;
+
+#define NS_SHIFT        VDSO_NS_SHIFT
+
+/* *
+ * tsc_calibrate - count TSC cycles while PIT counter 2 runs down CALIB_MS
+ * milliseconds, return the TSC rate in kHz or 0 if there is no TSC.
+ * */
+static uint32_t
+tsc_calibrate(void) {
+    uint32_t edx;
+    cpuid(1, NULL, NULL, NULL, &edx);
+    if (!(edx & CPUID_FEAT_TSC)) {
+        return 0;
+    }
+    uint32_t count = TIMER_FREQ / (1000 / CALIB_MS);
+    outb(IO_PPI, (inb(IO_PPI) & ~PPI_SPKR) | PPI_GATE2);
+    outb(TIMER_MODE, TIMER_SEL2 | TIMER_ONESHOT | TIMER_16BIT);
+    outb(IO_TIMER2, count % 256);
+    outb(IO_TIMER2, count / 256);
+    uint64_t start = rdtsc();
+    while (!(inb(IO_PPI) & PPI_OUT2)) {
+        /* wait for the terminal count */ ;
+    }
+    uint64_t cycles = rdtsc() - start;
+    outb(IO_PPI, inb(IO_PPI) & ~(PPI_GATE2 | PPI_SPKR));
+    do_div(cycles, CALIB_MS);
+    return (uint32_t)cycles;
+}
+
+// clock_ns - monotonic nanoseconds since clock_init
+uint64_t
+clock_ns(void) {
+    if (!oneshot) {
+        return base_ns;
+    }
+    return base_ns + (((rdtsc() - base_tsc) * ns_mult) >> NS_SHIFT);
+}
+
+// clock_publish - copy the clock state into the vdso page
+static void
+clock_publish(void) {
+    struct vdso_data *vd = vdso_data;
+    vd->seq ++;
+    vd->ticks = ticks;
+    vd->tsc_stamp = base_tsc;
+    vd->ns_stamp = base_ns;
+    vd->seq ++;
+}
+
+// pit_oneshot - interrupt once after delta_ns, at most PIT_MAX_NS from now
+static void
+pit_oneshot(uint64_t delta_ns) {
+    uint32_t us = (delta_ns >= PIT_MAX_NS) ? PIT_MAX_NS / NSEC_PER_USEC : (uint32_t)delta_ns / NSEC_PER_USEC;
+    // TIMER_FREQ / 10^6 == 19549 / 2^14 to five digits, and us * 19549 fits in 32 bits
+    uint32_t count = (us * 19549) >> 14;
+    if (count < PIT_MIN_COUNT) {
+        count = PIT_MIN_COUNT;
+    }
+    if (count > PIT_MAX_COUNT) {
+        count = PIT_MAX_COUNT;
+    }
+    outb(TIMER_MODE, TIMER_SEL0 | TIMER_ONESHOT | TIMER_16BIT);
+    outb(IO_TIMER1, count % 256);
+    outb(IO_TIMER1, count / 256);
+}
+
+/* *
+ * clock_reprogram - arm the next clock interrupt for the nearer of the next
+ * tick and the earliest hrtimer; with the tick stopped, for the nearer of the
+ * first timer_list expiry and the earliest hrtimer. Called with interrupts
+ * disabled.
  * */
 void
-clock_init(void) {
-    // set 8253 timer-chip
-    outb(TIMER_MODE, TIMER_SEL0 | TIMER_RATEGEN | TIMER_16BIT);
-    outb(IO_TIMER1, TIMER_DIV(100) % 256);
-    outb(IO_TIMER1, TIMER_DIV(100) / 256);
+clock_reprogram(void) {
+    if (oneshot) {
+        uint64_t now = clock_ns(), next = next_tick_ns, hr;
+        unsigned int left;
+        if (tick_stopped) {
+            next = now + PIT_MAX_NS;
+            // the first timer fires on the left-th tick from next_tick_ns on
+            if (timer_next(&left) && next_tick_ns + (uint64_t)(left - 1) * TICK_NS < next) {
+                next = next_tick_ns + (uint64_t)(left - 1) * TICK_NS;
+            }
+        }
+        if (hrtimer_next(&hr) && hr < next) {
+            next = hr;
+        }
+        if (sample_ns != 0 && now + sample_ns < next) {
+            next = now + sample_ns;
+        }
+        pit_oneshot(next > now ? next - now : 0);
+    }
+}
+
+/* *
+ * clock_update - bring the clock up to date: account every tick that has
+ * passed (run_timer_list once per tick, which is the catch-up after the tick
+ * was stopped), publish the new time and expire hrtimers.
+ * */
+static void
+clock_update(void) {
+    if (!oneshot) {
+        ticks ++;
+        base_ns += TICK_NS;
+        clock_publish();
+        run_timer_list();
+        run_hrtimer_list(base_ns);
+        return;
+    }
+    uint64_t tsc = rdtsc();
+    base_ns += ((tsc - base_tsc) * ns_mult) >> NS_SHIFT;
+    base_tsc = tsc;
+    while (next_tick_ns <= base_ns) {
+        ticks ++;
+        next_tick_ns += TICK_NS;
+        run_timer_list();
+    }
+    clock_publish();
+    run_hrtimer_list(base_ns);
+}
+
+// clock_interrupt - IRQ_TIMER handler, update the clock and arm the next interrupt
+void
+clock_interrupt(void) {
+    clock_update();
+    clock_reprogram();
+}
 
+/* *
+ * clock_set_sample_period - have a clock interrupt at least every ns for the
+ * sampling profiler, 0 to turn this off. Only the one-shot clock can do it;
+ * the periodic one samples at TICK_HZ. Called with interrupts disabled.
+ * */
+void
+clock_set_sample_period(uint64_t ns) {
+    sample_ns = ns;
+    clock_reprogram();
+}
+
+/* *
+ * clock_idle - halt until the next interrupt, called by the idle thread when
+ * it has nothing to do. In one-shot mode the tick is stopped while halted;
+ * whatever interrupt ends the halt, the clock catches up and the tick is
+ * restarted before the idle thread looks for work again.
+ * */
+void
+clock_idle(void) {
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    if (!current->need_resched) {
+        if (oneshot) {
+            tick_stopped = 1;
+            clock_reprogram();
+        }
+        // an interrupt pending at sti is only taken after hlt, and wakes it
+        asm volatile ("sti; hlt; cli" ::: "memory");
+        if (oneshot) {
+            tick_stopped = 0;
+            clock_update();
+            clock_reprogram();
+        }
+    }
+    local_intr_restore(intr_flag);
+}
+
+/* *
+ * clock_init - calibrate the TSC, start the 8253 clock (one-shot with a TSC,
+ * TICK_HZ periodic without) and then enable IRQ_TIMER.
+ * */
+void
+clock_init(void) {
     // initialize time counter 'ticks' to zero
     ticks = 0;
+    base_ns = 0;
+
+    struct vdso_data *vd = vdso_data;
+    vd->tick_hz = TICK_HZ;
+    if ((tsc_khz = tsc_calibrate()) != 0) {
+        uint64_t mult = (uint64_t)NSEC_PER_MSEC << NS_SHIFT;
+        do_div(mult, tsc_khz);
+        ns_mult = (uint32_t)mult;
+        oneshot = 1;
+        vd->tsc_khz = tsc_khz;
+        vd->ns_mult = ns_mult;
+        cprintf("++ TSC %u.%03u MHz, one-shot timer\n", tsc_khz / 1000, tsc_khz % 1000);
+    }
+    base_tsc = rdtsc();
+    next_tick_ns = TICK_NS;
+    clock_publish();
+
+    if (oneshot) {
+        pit_oneshot(TICK_NS);
+    }
+    else {
+        // set 8253 timer-chip
+        outb(TIMER_MODE, TIMER_SEL0 | TIMER_RATEGEN | TIMER_16BIT);
+        outb(IO_TIMER1, TIMER_DIV(TICK_HZ) % 256);
+        outb(IO_TIMER1, TIMER_DIV(TICK_HZ) / 256);
+    }
 
     cprintf("++ setup timer interrupts\n");
     pic_enable(IRQ_TIMER);
 }
-
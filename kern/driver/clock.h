@@ -6,6 +6,11 @@
 extern volatile size_t ticks;
 
 void clock_init(void);
+void clock_interrupt(void);
+void clock_reprogram(void);
+void clock_idle(void);
+uint64_t clock_ns(void);
+void clock_set_sample_period(uint64_t ns);
 
 long SYSTEM_READ_TIMER( void );
 
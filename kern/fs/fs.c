@@ -55,17 +55,15 @@ files_create(void) {
     return filesp;
 }
 
-/**
- * 进程退出时调用
- * 
- */ 
+// files_clear - close every file of an unused files_struct and drop its pwd, leaving
+//             - it as files_create returns it (kept for reuse by the proc shell cache)
 void
-files_destroy(struct files_struct *filesp) {
-//    cprintf("[files_destroy]\n");
+files_clear(struct files_struct *filesp) {
     /* 只有当文件打开进程数量为0才能关闭进程，否则报错 */
     assert(filesp != NULL && files_count(filesp) == 0);
     if (filesp->pwd != NULL) {
         vop_ref_dec(filesp->pwd);/* 当前目录inode访问数量-1 */
+        filesp->pwd = NULL;
     }
     int i;
     struct file *file = filesp->fd_array;
@@ -75,6 +73,16 @@ files_destroy(struct files_struct *filesp) {
         }
         assert(file->status == FD_NONE);
     }
+}
+
+/**
+ * 进程退出时调用
+ * 
+ */ 
+void
+files_destroy(struct files_struct *filesp) {
+//    cprintf("[files_destroy]\n");
+    files_clear(filesp);
     kfree(filesp);
 }
 
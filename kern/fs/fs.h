@@ -43,6 +43,7 @@ void unlock_files(struct files_struct *filesp);
 
 struct files_struct *files_create(void);
 void files_destroy(struct files_struct *filesp);
+void files_clear(struct files_struct *filesp);
 void files_closeall(struct files_struct *filesp);
 int dup_files(struct files_struct *to, struct files_struct *from);
 
@@ -17,11 +17,17 @@ swapfs_init(void) {
 
 int
 swapfs_read(swap_entry_t entry, struct Page *page) {
-    return ide_read_secs(SWAP_DEV_NO, swap_offset(entry) * PAGE_NSECT, page2kva(page), PAGE_NSECT);
+    void *kva = kmap(page);
+    int ret = ide_read_secs(SWAP_DEV_NO, swap_offset(entry) * PAGE_NSECT, kva, PAGE_NSECT);
+    kunmap(kva);
+    return ret;
 }
 
 int
 swapfs_write(swap_entry_t entry, struct Page *page) {
-    return ide_write_secs(SWAP_DEV_NO, swap_offset(entry) * PAGE_NSECT, page2kva(page), PAGE_NSECT);
+    void *kva = kmap(page);
+    int ret = ide_write_secs(SWAP_DEV_NO, swap_offset(entry) * PAGE_NSECT, kva, PAGE_NSECT);
+    kunmap(kva);
+    return ret;
 }
 
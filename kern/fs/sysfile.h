@@ -24,5 +24,12 @@ int sysfile_dup(int fd1, int fd2);
 int sysfile_pipe(int *fd_store);                                
 int sysfile_mkfifo(const char *name, uint32_t open_flags);      
 
+/* async submission/completion rings, kern/fs/sysuring.c */
+struct uring;
+struct proc_struct;
+int uring_setup(struct uring **ring_store);
+int uring_enter(int min_complete);
+void uring_release(struct proc_struct *proc);
+
 #endif /* !__KERN_FS_SYSFILE_H__ */
 
@@ -0,0 +1,266 @@
+#include <defs.h>
+#include <string.h>
+#include <sync.h>
+#include <wait.h>
+#include <proc.h>
+#include <sched.h>
+#include <pmm.h>
+#include <vmm.h>
+#include <kmalloc.h>
+#include <sysfile.h>
+#include <unistd.h>
+#include <uring.h>
+#include <error.h>
+#include <assert.h>
+
+/* *
+ * Asynchronous submission/completion rings, see libs/uring.h for the layout.
+ *
+ * Every ring has a kernel worker thread started by kernel_worker: it shares
+ * the mm and the fd table of the process, so it runs each request through
+ * the ordinary sysfile_* calls as if the process had made them. The ring page
+ * is mapped into the process and also held by the kernel (an extra page
+ * reference), so the worker can read it through its kernel address no matter
+ * what the process does with the mapping.
+ *
+ * The ring belongs to the proc that set it up. uring_release, called when
+ * that proc exits or execs, only asks the worker to stop; the worker finishes
+ * the request at hand, frees the context and leaves through do_exit, which
+ * drops its references to the mm and the fd table.
+ * */
+
+struct uring_ctx {
+    struct uring *ring;                 // kernel address of the shared page
+    struct Page *page;
+    bool closing;                       // the owner is gone, the worker should exit
+    bool busy;                          // the worker is running a request
+    wait_queue_t worker_queue;          // the worker waits here for submissions
+    wait_queue_t cq_queue;              // uring_enter waits here for completions
+};
+
+// uring_ready - completions posted but not consumed yet
+static inline uint32_t
+uring_ready(struct uring *ring) {
+    return ring->cq_tail - ring->cq_head;
+}
+
+// uring_do - run one request, return what the synchronous call returns
+static int
+uring_do(struct uring_sqe *sqe) {
+    int ret;
+    switch (sqe->opcode) {
+    case URING_OP_NOP:
+        return 0;
+    case URING_OP_READ:
+    case URING_OP_WRITE:
+        if (sqe->off >= 0 && (ret = sysfile_seek(sqe->fd, sqe->off, LSEEK_SET)) != 0) {
+            return ret;
+        }
+        if (sqe->opcode == URING_OP_READ) {
+            return sysfile_read(sqe->fd, (void *)sqe->addr, sqe->len);
+        }
+        return sysfile_write(sqe->fd, (void *)sqe->addr, sqe->len);
+    case URING_OP_FSYNC:
+        return sysfile_fsync(sqe->fd);
+    case URING_OP_OPEN:
+        return sysfile_open((const char *)sqe->addr, sqe->len);
+    case URING_OP_CLOSE:
+        return sysfile_close(sqe->fd);
+    }
+    return -E_INVAL;
+}
+
+// uring_worker - body of the worker thread, serve the ring until it is released
+static int
+uring_worker(void *arg) {
+    struct uring_ctx *ctx = (struct uring_ctx *)arg;
+    struct uring *ring = ctx->ring;
+    bool intr_flag;
+    wait_t __wait, *wait = &__wait;
+
+    while (!ctx->closing) {
+        uint32_t head = ring->sq_head;
+        if (head == ring->sq_tail || uring_ready(ring) >= URING_CQ_ENTRIES) {
+            local_intr_save(intr_flag);
+            wait_current_set(&(ctx->worker_queue), wait, WT_URING_WORKER);
+            local_intr_restore(intr_flag);
+
+            schedule();
+
+            local_intr_save(intr_flag);
+            wait_current_del(&(ctx->worker_queue), wait);
+            local_intr_restore(intr_flag);
+            continue;
+        }
+
+        // the process may rewrite the slot at any time, work on a copy
+        struct uring_sqe sqe = ring->sq[head % URING_SQ_ENTRIES];
+        ring->sq_head = head + 1;
+        ctx->busy = 1;
+        int res = uring_do(&sqe);
+        ctx->busy = 0;
+
+        uint32_t tail = ring->cq_tail;
+        ring->cq[tail % URING_CQ_ENTRIES].user_data = sqe.user_data;
+        ring->cq[tail % URING_CQ_ENTRIES].res = res;
+        ring->cq_tail = tail + 1;
+        if (!wait_queue_empty(&(ctx->cq_queue))) {
+            wakeup_queue(&(ctx->cq_queue), WT_URING, 1);
+        }
+        // let the process run between requests
+        if (current->need_resched) {
+            schedule();
+        }
+    }
+
+    if (page_ref_dec(ctx->page) == 0) {
+        free_page(ctx->page);
+    }
+    kfree(ctx);
+    return 0;
+}
+
+// uring_kick - wake the worker if it waits for submissions
+static void
+uring_kick(struct uring_ctx *ctx) {
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    if (!wait_queue_empty(&(ctx->worker_queue))) {
+        wakeup_queue(&(ctx->worker_queue), WT_URING_WORKER, 1);
+    }
+    local_intr_restore(intr_flag);
+}
+
+/* *
+ * uring_setup - SYS_uring_setup: map a ring page into the caller, start its
+ * worker and store the ring's user address in *ring_store. One ring per proc.
+ * */
+int
+uring_setup(struct uring **ring_store) {
+    struct mm_struct *mm = current->mm;
+    if (mm == NULL) {
+        return -E_INVAL;
+    }
+    if (current->uring != NULL) {
+        return -E_EXISTS;
+    }
+    // fail before anything is set up, so that a retry does not find a ring
+    bool ok;
+    lock_mm(mm);
+    ok = user_mem_check(mm, (uintptr_t)ring_store, sizeof(uintptr_t), 1);
+    unlock_mm(mm);
+    if (!ok) {
+        return -E_INVAL;
+    }
+
+    int ret = -E_NO_MEM;
+    struct uring_ctx *ctx;
+    if ((ctx = kmalloc(sizeof(struct uring_ctx))) == NULL) {
+        goto out;
+    }
+    if ((ctx->page = alloc_page()) == NULL) {
+        goto bad_cleanup_ctx;
+    }
+    ctx->ring = page2kva(ctx->page);
+    memset(ctx->ring, 0, PGSIZE);
+    ctx->closing = ctx->busy = 0;
+    wait_queue_init(&(ctx->worker_queue));
+    wait_queue_init(&(ctx->cq_queue));
+
+    uintptr_t addr;
+    lock_mm(mm);
+    if ((addr = get_unmapped_area(mm, PGSIZE)) == 0) {
+        unlock_mm(mm);
+        goto bad_cleanup_page;
+    }
+    if ((ret = mm_map(mm, addr, PGSIZE, VM_READ | VM_WRITE, NULL)) != 0) {
+        unlock_mm(mm);
+        goto bad_cleanup_page;
+    }
+    if ((ret = page_insert(mm->pgdir, ctx->page, addr, PTE_USER)) != 0) {
+        mm_unmap(mm, addr, PGSIZE);
+        unlock_mm(mm);
+        goto bad_cleanup_page;
+    }
+    unlock_mm(mm);
+
+    // the kernel's own reference, dropped by the worker
+    page_ref_inc(ctx->page);
+    if ((ret = kernel_worker(uring_worker, ctx)) < 0) {
+        page_ref_dec(ctx->page);
+        goto bad_cleanup_map;
+    }
+    current->uring = ctx;
+
+    lock_mm(mm);
+    if (!copy_to_user(mm, ring_store, &addr, sizeof(uintptr_t))) {
+        // another thread unmapped ring_store meanwhile: undo it all, the worker frees ctx
+        uring_release(current);
+        mm_unmap(mm, addr, PGSIZE);
+        unlock_mm(mm);
+        return -E_INVAL;
+    }
+    unlock_mm(mm);
+    return 0;
+
+bad_cleanup_map:
+    // mm_unmap drops the mapping's reference and frees the page
+    lock_mm(mm);
+    mm_unmap(mm, addr, PGSIZE);
+    unlock_mm(mm);
+    goto bad_cleanup_ctx;
+bad_cleanup_page:
+    free_page(ctx->page);
+bad_cleanup_ctx:
+    kfree(ctx);
+out:
+    return ret;
+}
+
+/* *
+ * uring_enter - SYS_uring_enter: hand new submissions to the worker, then wait
+ * until min_complete completions are ready or nothing is left in flight.
+ * The worker stops on a full CQ, so at most URING_CQ_ENTRIES are waited for.
+ * Returns the number of completions ready.
+ * */
+int
+uring_enter(int min_complete) {
+    struct uring_ctx *ctx = current->uring;
+    if (ctx == NULL || min_complete < 0) {
+        return -E_INVAL;
+    }
+    if (min_complete > URING_CQ_ENTRIES) {
+        min_complete = URING_CQ_ENTRIES;
+    }
+    struct uring *ring = ctx->ring;
+    uring_kick(ctx);
+
+    bool intr_flag;
+    wait_t __wait, *wait = &__wait;
+    while (uring_ready(ring) < min_complete && (ring->sq_head != ring->sq_tail || ctx->busy)) {
+        local_intr_save(intr_flag);
+        wait_current_set(&(ctx->cq_queue), wait, WT_URING);
+        local_intr_restore(intr_flag);
+
+        schedule();
+
+        local_intr_save(intr_flag);
+        wait_current_del(&(ctx->cq_queue), wait);
+        local_intr_restore(intr_flag);
+        if (wait->wakeup_flags != WT_URING) {
+            return -E_KILLED;
+        }
+    }
+    return uring_ready(ring);
+}
+
+// uring_release - proc is exiting or execing, tell its ring worker to finish
+void
+uring_release(struct proc_struct *proc) {
+    struct uring_ctx *ctx = proc->uring;
+    if (ctx != NULL) {
+        proc->uring = NULL;
+        ctx->closing = 1;
+        uring_kick(ctx);
+    }
+}
@@ -13,6 +13,7 @@
 #include <swap.h>
 #include <proc.h>
 #include <fs.h>
+#include <futex.h>
 
 int kern_init(void) __attribute__((noreturn));
 
@@ -39,6 +40,7 @@ kern_init(void) {
 
     vmm_init();                 // init virtual memory management
     sched_init();               // init scheduler
+    futex_init();               // init futex wait queues
     proc_init();                // init process table
     
     ide_init();                 // init ide devices
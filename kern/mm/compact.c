@@ -0,0 +1,201 @@
+#include <defs.h>
+#include <x86.h>
+#include <stdio.h>
+#include <string.h>
+#include <sync.h>
+#include <mmu.h>
+#include <memlayout.h>
+#include <pmm.h>
+#include <vmm.h>
+#include <proc.h>
+#include <clock.h>
+#include <compact.h>
+
+/* *
+ * Physical memory compaction. Order-0 user pages end up scattered over the
+ * whole of memory after enough fork/exit churn, so requests for several
+ * contiguous pages (kernel stacks, large kmalloc blocks) fail even though
+ * plenty of pages are free. Compaction makes room for one run of n pages:
+ *
+ *   1. pick the n-aligned window whose pages are all either free or movable,
+ *      preferring the one with the fewest movable pages; free pages are read
+ *      in place from the blocks of pmm_manager, a free block starting at a
+ *      PageProperty page and spanning property pages;
+ *   2. allocate order-0 pages from pmm_manager until there is one outside the
+ *      window for every movable page, holding on to those that fall inside it;
+ *   3. migrate each movable page of the window into one of them: copy the
+ *      content, repoint the pte, move the pra_page_link;
+ *   4. give the pages held (the migrated window pages included) back to
+ *      pmm_manager, which coalesces the window into a single free block.
+ *
+ * A page is movable when it has exactly one user mapping recorded by
+ * page_set_rmap that still points at it, and that mapping is not in the
+ * address space of the current process, whose kernel code may hold the page.
+ * The whole run happens with interrupts disabled.
+ * */
+
+struct compact_stats compact_stats;
+
+// largest run a high-order allocation could not get, served again by compact_idle
+static size_t compact_wanted = 0;
+static size_t compact_last = 0;
+static int compact_retries = 0;         // background runs that failed for compact_wanted
+
+// page_movable - whether page can be migrated, return its pte through ptep_store
+static bool
+page_movable(struct Page *page, pte_t **ptep_store) {
+	if (PageReserved(page) || page_ref(page) != 1 || page->map_pgdir == NULL) {
+		return 0;
+	}
+	if (current != NULL && current->mm != NULL && current->mm->pgdir == page->map_pgdir) {
+		return 0;
+	}
+	pte_t *ptep = get_pte(page->map_pgdir, page->pra_vaddr, 0);
+	if (ptep == NULL || (*ptep & (PTE_P | PTE_U)) != (PTE_P | PTE_U)
+		|| PTE_ADDR(*ptep) != page2pa(page)) {
+		return 0;
+	}
+	*ptep_store = ptep;
+	return 1;
+}
+
+// migrate_page - move the content and the mapping of src to dst
+static void
+migrate_page(struct Page *src, struct Page *dst, pte_t *ptep) {
+	memcpy(page2kva(dst), page2kva(src), PGSIZE);
+	set_page_ref(dst, 1);
+	page_set_rmap(dst, src->map_pgdir, src->pra_vaddr);
+	if (PageSwap(src)) {
+		// take src's place in the swap manager's list
+		list_add(&(src->pra_page_link), &(dst->pra_page_link));
+		list_del(&(src->pra_page_link));
+		ClearPageSwap(src);
+		SetPageSwap(dst);
+	}
+	*ptep = page2pa(dst) | PTE_FLAGS(*ptep);
+	tlb_invalidate(src->map_pgdir, src->pra_vaddr);
+	set_page_ref(src, 0);
+	src->map_pgdir = NULL;
+	compact_stats.pages_migrated++;
+}
+
+/* *
+ * compact_score - find the n-aligned window below limit with the fewest pages
+ * to migrate, and at most nr_free - (its free pages) of them, so that there
+ * is room for them outside. Return that number and the window's first pfn
+ * through base_store, or -1 if no window can be freed.
+ * */
+static int
+compact_score(size_t n, size_t limit, size_t nr_free, size_t *base_store) {
+	size_t base, i, free_left = 0;
+	int best_cost = -1;
+	for (base = 0; base + n <= limit; base += n) {
+		int cost = 0;
+		for (i = base; i < base + n; i++) {
+			struct Page *page = pages + i;
+			pte_t *ptep;
+			if (PageProperty(page)) {
+				free_left = page->property;
+			}
+			if (free_left != 0) {
+				free_left--;
+			}
+			// keep walking a bad window, free_left must follow every page
+			else if (cost >= 0) {
+				cost = page_movable(page, &ptep) ? cost + 1 : -1;
+			}
+		}
+		if (cost >= 0 && nr_free - (n - cost) >= cost && (best_cost < 0 || cost < best_cost)) {
+			*base_store = base, best_cost = cost;
+			if (cost == 0) {
+				break;
+			}
+		}
+	}
+	return best_cost;
+}
+
+// compact_dest - allocate a free page outside pages[base, base+n), hold the ones inside on isolated
+static struct Page *
+compact_dest(size_t base, size_t n, list_entry_t *isolated) {
+	struct Page *page;
+	while ((page = pmm_manager->alloc_pages(1)) != NULL) {
+		if (page < pages + base || page >= pages + base + n) {
+			break;
+		}
+		SetPageIsolated(page);
+		list_add(isolated, &(page->page_link));
+	}
+	return page;
+}
+
+// compact_pages - migrate user pages until n contiguous pages are free, return 1 on success
+bool
+compact_pages(size_t n) {
+	list_entry_t isolated, *le;
+	size_t best = 0, i;
+	int best_cost;
+	bool intr_flag, cache_enabled, ok = 0;
+
+	local_intr_save(intr_flag);
+	compact_stats.runs++;
+	cache_enabled = page_cache_suspend();
+
+	// struct Pages from page_init_pfn on are not set up yet, and blocks
+	// of pmm_manager never extend into HighMem
+	size_t limit = (page_init_pfn < max_low_pfn) ? page_init_pfn : max_low_pfn;
+	size_t nr_free = pmm_manager->nr_free_pages();
+	best_cost = (nr_free >= n) ? compact_score(n, limit, nr_free, &best) : -1;
+
+	list_init(&isolated);
+	if (best_cost >= 0) {
+		for (i = best; i < best + n; i++) {
+			struct Page *src = pages + i, *dst;
+			pte_t *ptep;
+			if (PageIsolated(src) || !page_movable(src, &ptep)) {
+				// taken as a destination above, or still free
+				continue;
+			}
+			if ((dst = compact_dest(best, n, &isolated)) == NULL) {
+				break;
+			}
+			migrate_page(src, dst, ptep);
+			SetPageIsolated(src);
+			list_add(&isolated, &(src->page_link));
+		}
+		if (i == best + n) {
+			compact_stats.successes++;
+			ok = 1;
+		}
+	}
+
+	while ((le = list_next(&isolated)) != &isolated) {
+		list_del(le);
+		struct Page *page = le2page(le, page_link);
+		ClearPageIsolated(page);
+		pmm_manager->free_pages(page, 1);
+	}
+
+	page_cache_resume(cache_enabled);
+	if (ok) {
+		compact_wanted = 0;
+	}
+	else if (n > compact_wanted) {
+		compact_wanted = n, compact_retries = 0;
+	}
+	local_intr_restore(intr_flag);
+	return ok;
+}
+
+// compact_idle - called from cpu_idle, retry the last compaction that failed
+//              - at most once every COMPACT_IDLE_INTERVAL ticks, and give up
+//              - after COMPACT_IDLE_RETRIES runs until an allocation fails again
+void
+compact_idle(void) {
+	if (compact_wanted != 0 && ticks - compact_last >= COMPACT_IDLE_INTERVAL) {
+		compact_last = ticks;
+		if (!compact_pages(compact_wanted) && ++compact_retries >= COMPACT_IDLE_RETRIES) {
+			compact_wanted = 0;
+		}
+	}
+}
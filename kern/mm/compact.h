@@ -0,0 +1,20 @@
+#ifndef __KERN_MM_COMPACT_H__
+#define __KERN_MM_COMPACT_H__
+
+#include <defs.h>
+
+#define COMPACT_IDLE_INTERVAL   100     // ticks between two background compactions
+#define COMPACT_IDLE_RETRIES    5       // background compactions that may fail in a row
+
+struct compact_stats {
+	unsigned int runs;                  // compactions attempted
+	unsigned int successes;             // runs that left the requested free run behind
+	unsigned int pages_migrated;        // user pages moved to another frame
+};
+
+extern struct compact_stats compact_stats;
+
+bool compact_pages(size_t n);
+void compact_idle(void);
+
+#endif /* !__KERN_MM_COMPACT_H__ */
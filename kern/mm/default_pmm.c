@@ -1,25 +1,110 @@
 #include <pmm.h>
 #include <list.h>
+#include <rbtree.h>
 #include <string.h>
+#include <stdio.h>
 #include <default_pmm.h>
 
+/*
+ * Free blocks are kept three ways at once:
+ *   - free_list, in address order, so the check routines and the report can walk them;
+ *   - addr_tree, an rbtree by address augmented with the largest block of each
+ *     subtree (max_property), used to find the neighbours to coalesce with and
+ *     the lowest-addressed block that fits (first fit);
+ *   - size_tree, an rbtree by (size, address), giving the smallest block that
+ *     fits (best fit) and the largest block (worst fit).
+ * Every operation is O(log n) in the number of free blocks. Ties are broken the
+ * same way the old list walks did: best fit takes the lowest address among equal
+ * sizes and worst fit the highest.
+ */
+
 free_area_t free_area;
 
+#define le2addr(node)       rb_entry((node), struct Page, addr_node)
+#define le2size(node)       rb_entry((node), struct Page, size_node)
+
 static void default_init(void)
 {
     list_init(&free_area.free_list);
     free_area.nr_free = 0;
+    free_area.addr_tree = RB_ROOT;
+    free_area.size_tree = RB_ROOT;
+}
+
+// addr_node_update - recompute max_property of node from its children
+static void addr_node_update(struct rb_node *node, void *data)
+{
+    struct Page *page = le2addr(node);
+    unsigned int max = page->property;
+    if (node->rb_left != NULL && le2addr(node->rb_left)->max_property > max)
+        max = le2addr(node->rb_left)->max_property;
+    if (node->rb_right != NULL && le2addr(node->rb_right)->max_property > max)
+        max = le2addr(node->rb_right)->max_property;
+    page->max_property = max;
+}
+
+static inline bool size_less(struct Page *a, struct Page *b)
+{
+    return a->property < b->property || (a->property == b->property && a < b);
 }
 
-/* 
-    原理大体上如下：
-    我们同时维护一个Page数组和记录内存碎片的链表。
-    page数组里面有若干页面，在memlayout里面有介绍。
-    每一个页面的表项里面都有指向实际内存区域的指针。这个指针应当是被初始化过的，但是这里面并没有出现。
-    随后另一个双向链表负责指向实际内存区域的指针，每次读取一个就通过le2page把它转换成page看它的页的数目。
-    le2page用的是很暴力的数字节偏移量的方法将表项复原为原来的page。
-    注意双向链表是一个环形结构，转到头了代表结束。
-*/
+// free_block_insert - index the free block base, which follows prev in address order
+static void free_block_insert(struct Page *base, list_entry_t *prev)
+{
+    struct rb_node **link, *parent;
+
+    list_add(prev, &(base->page_link));
+
+    link = &free_area.addr_tree.rb_node, parent = NULL;
+    while (*link != NULL)
+    {
+        parent = *link;
+        link = (base < le2addr(parent)) ? &parent->rb_left : &parent->rb_right;
+    }
+    base->max_property = base->property;
+    rb_link_node(&(base->addr_node), parent, link);
+    rb_insert_color(&(base->addr_node), &free_area.addr_tree);
+    rb_augment_insert(&(base->addr_node), addr_node_update, NULL);
+
+    link = &free_area.size_tree.rb_node, parent = NULL;
+    while (*link != NULL)
+    {
+        parent = *link;
+        link = size_less(base, le2size(parent)) ? &parent->rb_left : &parent->rb_right;
+    }
+    rb_link_node(&(base->size_node), parent, link);
+    rb_insert_color(&(base->size_node), &free_area.size_tree);
+}
+
+// free_block_remove - drop the free block page from the list and both trees
+static void free_block_remove(struct Page *page)
+{
+    struct rb_node *deepest = rb_augment_erase_begin(&(page->addr_node));
+    rb_erase(&(page->addr_node), &free_area.addr_tree);
+    rb_augment_erase_end(deepest, addr_node_update, NULL);
+    rb_erase(&(page->size_node), &free_area.size_tree);
+    list_del(&(page->page_link));
+}
+
+// addr_tree_prev - the free block with the highest address below base, or NULL
+static struct Page *addr_tree_prev(struct Page *base)
+{
+    struct rb_node *node = free_area.addr_tree.rb_node;
+    struct Page *prev = NULL;
+    while (node != NULL)
+    {
+        if (le2addr(node) < base)
+        {
+            prev = le2addr(node);
+            node = node->rb_right;
+        }
+        else
+            node = node->rb_left;
+    }
+    return prev;
+}
+
+static void default_merge_block(struct Page *base, size_t num);
 
 static void default_init_memmap(struct Page *base, size_t n)   //Here we have only one slice of memory, and the amount of pages is n.
 {
@@ -32,10 +117,28 @@ static void default_init_memmap(struct Page *base, size_t n)   //Here we have on
         set_page_ref(page_ptr,0);
         page_ptr++;
     }
-    base->property = n;
-    SetPageProperty(base);
-    free_area.nr_free += n;
-    list_add_before(&free_area.free_list, &(base->page_link));
+    // memory may arrive in pieces (see page_init), merge it with what is already free
+    default_merge_block(base, n);
+}
+
+// default_take_block - allocate the first num pages of the free block page,
+//                    - the remainder stays free in its place
+static struct Page *default_take_block(struct Page *page, size_t num)
+{
+    if (page == NULL)
+        return NULL;
+    list_entry_t *prev = list_prev(&(page->page_link));
+    free_block_remove(page);
+    if (page->property > num)
+    {
+        struct Page *p = page + num;
+        p->property = page->property - num;
+        SetPageProperty(p);
+        free_block_insert(p, prev);
+    }
+    free_area.nr_free -= num;
+    ClearPageProperty(page);
+    return page;
 }
 
 static struct Page *default_alloc_pages(size_t num)           //the first-fit version
@@ -43,33 +146,23 @@ static struct Page *default_alloc_pages(size_t num)           //the first-fit ve
     assert(num>0);
     if(num > free_area.nr_free)
         return NULL;
-    
+
+    // lowest address whose block fits: go left whenever the left subtree can serve num
     struct Page *page = NULL;
-    list_entry_t *list_entry = &free_area.free_list;
-    while ((list_entry = list_next(list_entry)) != &free_area.free_list)
+    struct rb_node *node = free_area.addr_tree.rb_node;
+    while (node != NULL)
     {
-        struct Page *ptr = le2page(list_entry, page_link);
-        if(ptr->property >= num)
+        if (node->rb_left != NULL && le2addr(node->rb_left)->max_property >= num)
+            node = node->rb_left;
+        else if (le2addr(node)->property >= num)
         {
-            page = ptr;
+            page = le2addr(node);
             break;
-        }   
-    }
-    if(page != NULL)
-    {
-        list_del(&(page->page_link));
-        if(page->property > num)
-        {
-            struct Page *p = page + num;
-            p->property = page->property-num;
-            SetPageProperty(p);
-            list_add_after(&(page->page_link), &(p->page_link));
         }
-        list_del(&(page->page_link));
-        free_area.nr_free -= num;
-        ClearPageProperty(page);
+        else
+            node = node->rb_right;
     }
-    return page;
+    return default_take_block(page, num);
 }
 
 static struct Page *default_alloc_pages_best_fit(size_t num)           //the best-fit version
@@ -77,34 +170,21 @@ static struct Page *default_alloc_pages_best_fit(size_t num)           //the bes
     assert(num>0);
     if(num > free_area.nr_free)
         return NULL;
-    
+
+    // smallest (size, address) with size >= num
     struct Page *page = NULL;
-    list_entry_t *list_entry = &free_area.free_list;
-    int legal_page_min_size = 0x7ffffffff;
-    while ((list_entry = list_next(list_entry)) != &free_area.free_list)
-    {
-        struct Page *ptr = le2page(list_entry, page_link);
-        if(ptr->property >= num && ptr->property < legal_page_min_size)
-        {
-            page = ptr;
-            legal_page_min_size = ptr->property;
-        }   
-    }
-    if(page != NULL)
+    struct rb_node *node = free_area.size_tree.rb_node;
+    while (node != NULL)
     {
-        list_del(&(page->page_link));
-        if(page->property > num)
+        if (le2size(node)->property >= num)
         {
-            struct Page *p = page + num;
-            p->property = page->property-num;
-            SetPageProperty(p);
-            list_add_after(&(page->page_link), &(p->page_link));
+            page = le2size(node);
+            node = node->rb_left;
         }
-        list_del(&(page->page_link));
-        free_area.nr_free -= num;
-        ClearPageProperty(page);
+        else
+            node = node->rb_right;
     }
-    return page;
+    return default_take_block(page, num);
 }
 
 static struct Page *default_alloc_pages_worst_fit(size_t num)           //the worst-fit version
@@ -112,36 +192,12 @@ static struct Page *default_alloc_pages_worst_fit(size_t num)           //the wo
     assert(num>0);
     if(num > free_area.nr_free)
         return NULL;
-    
-    struct Page *page = NULL;
-    list_entry_t *list_entry = &free_area.free_list;
-    int max_page_size = 0;
-    while ((list_entry = list_next(list_entry)) != &free_area.free_list)
-    {
-        struct Page *ptr = le2page(list_entry, page_link);
-        if(ptr->property >= num && ptr->property >= max_page_size)
-        {
-            page = ptr;
-            max_page_size = ptr->property;
-        }   
-    }
-    if(page != NULL)
-    {
-        list_del(&(page->page_link));
-        if(page->property > num)
-        {
-            struct Page *p = page + num;
-            p->property = page->property-num;
-            SetPageProperty(p);
-            list_add_after(&(page->page_link), &(p->page_link));
-        }
-        list_del(&(page->page_link));
-        free_area.nr_free -= num;
-        ClearPageProperty(page);
-    }
-    return page;
-}
 
+    struct rb_node *node = rb_last(&free_area.size_tree);
+    if (node == NULL || le2size(node)->property < num)
+        return NULL;
+    return default_take_block(le2size(node), num);
+}
 
 static void default_free_pages(struct Page *base, size_t num)
 {
@@ -154,44 +210,78 @@ static void default_free_pages(struct Page *base, size_t num)
         set_page_ref(ptr,0);
         ptr++;
     }
+    default_merge_block(base, num);
+}
+
+// default_merge_block - make [base, base+num) a free block, coalesced with its neighbours
+static void default_merge_block(struct Page *base, size_t num)
+{
     base->property = num;
     SetPageProperty(base);
-    list_entry_t *list_entry = &free_area.free_list;
-    while ((list_entry = list_next(list_entry)) != &free_area.free_list)
+
+    struct Page *prev = addr_tree_prev(base);
+    list_entry_t *le = (prev == NULL) ? &free_area.free_list : &(prev->page_link);
+    list_entry_t *next_le = list_next(le);
+    if (next_le != &free_area.free_list)
     {
-        ptr = le2page(list_entry, page_link);
-        if(base+base->property == ptr)
+        struct Page *next = le2page(next_le, page_link);
+        assert(base + base->property <= next);
+        if (base + base->property == next)
         {
-            base->property += ptr->property;
-            ClearPageProperty(ptr);
-            list_del(&(ptr->page_link));
-        }  
-        else if(ptr+ptr->property == base)
+            free_block_remove(next);
+            base->property += next->property;
+            ClearPageProperty(next);
+        }
+    }
+    if (prev != NULL)
+    {
+        assert(prev + prev->property <= base);
+        if (prev + prev->property == base)
         {
-            ptr->property += base->property;
+            le = list_prev(&(prev->page_link));
+            free_block_remove(prev);
+            prev->property += base->property;
             ClearPageProperty(base);
-            base = ptr;
-            list_del(&(ptr->page_link));
-        } 
-    }  
+            base = prev;
+        }
+    }
     free_area.nr_free += num;
-    list_entry = &free_area.free_list;
-    while ((list_entry = list_next(list_entry)) != &free_area.free_list)
-    {
-        ptr = le2page(list_entry, page_link);
-        if(base + base->property <= ptr)
-        {
-            assert(base + base->property != ptr);
-            break;
-        } 
-    }   
-    list_add_before(list_entry, &(base->page_link));
+    free_block_insert(base, le);
 }
 
 static size_t default_nr_free_pages(void) {
     return free_area.nr_free;
 }
 
+#define FRAG_ORDERS     11
+
+// default_report - print how fragmented the free memory is, to compare policies
+static void default_report(void)
+{
+    size_t blocks = 0, largest = 0, hist[FRAG_ORDERS] = {0};
+    list_entry_t *le = &free_area.free_list;
+    while ((le = list_next(le)) != &free_area.free_list)
+    {
+        size_t n = le2page(le, page_link)->property, order = 0;
+        while (order + 1 < FRAG_ORDERS && (n >> (order + 1)) != 0)
+            order++;
+        hist[order]++, blocks++;
+        if (n > largest)
+            largest = n;
+    }
+    assert(free_area.addr_tree.rb_node == NULL
+           || le2addr(free_area.addr_tree.rb_node)->max_property == largest);
+
+    size_t nr_free = free_area.nr_free;
+    cprintf("default_pmm: %u free pages in %u blocks, largest %u pages\n", nr_free, blocks, largest);
+    cprintf("  external fragmentation: %u%%\n", (nr_free == 0) ? 0 : 100 - largest * 100 / nr_free);
+    int order;
+    for (order = 0; order < FRAG_ORDERS; order++)
+    {
+        if (hist[order] != 0)
+            cprintf("  %4u%s pages: %u blocks\n", 1 << order, (order + 1 == FRAG_ORDERS) ? "+" : " ", hist[order]);
+    }
+}
 
 static void basic_check(void) {
     struct Page *p0, *p1, *p2;
@@ -207,13 +297,10 @@ static void basic_check(void) {
     assert(page2pa(p1) < npage * PGSIZE);
     assert(page2pa(p2) < npage * PGSIZE);
 
-    list_entry_t free_list_store = free_area.free_list;
-    list_init(&free_area.free_list);
+    free_area_t free_area_store = free_area;
+    default_init();
     assert(list_empty(&free_area.free_list));
 
-    unsigned int nr_free_store = free_area.nr_free;
-    free_area.nr_free = 0;
-
     assert(alloc_page() == NULL);
 
     free_page(p0);
@@ -235,8 +322,7 @@ static void basic_check(void) {
     assert(alloc_page() == NULL);
 
     assert(free_area.nr_free == 0);
-    free_area.free_list = free_list_store;
-    free_area.nr_free = nr_free_store;
+    free_area = free_area_store;
 
     free_page(p);
     free_page(p1);
@@ -252,7 +338,7 @@ default_check(void) {
         assert(PageProperty(p));
         count ++, total += p->property;
     }
-    assert(total == nr_free_pages());
+    assert(total == free_area.nr_free);
 
     basic_check();
 
@@ -260,14 +346,11 @@ default_check(void) {
     assert(p0 != NULL);
     assert(!PageProperty(p0));
 
-    list_entry_t free_list_store = free_area.free_list;
-    list_init(&free_area.free_list);
+    free_area_t free_area_store = free_area;
+    default_init();
     assert(list_empty(&free_area.free_list));
     assert(alloc_page() == NULL);
 
-    unsigned int nr_free_store = free_area.nr_free;
-    free_area.nr_free = 0;
-
     free_pages(p0 + 2, 3);
     assert(alloc_pages(4) == NULL);
     assert(PageProperty(p0 + 2) && p0[2].property == 3);
@@ -292,9 +375,7 @@ default_check(void) {
     assert(alloc_page() == NULL);
 
     assert(free_area.nr_free == 0);
-    free_area.nr_free = nr_free_store;
-
-    free_area.free_list = free_list_store;
+    free_area = free_area_store;
     free_pages(p0, 5);
 
     le = &free_area.free_list;
@@ -316,7 +397,7 @@ static void default_worst_fit_checker(void)
         assert(PageProperty(p));
         count ++, total += p->property;
     }
-    assert(total == nr_free_pages());
+    assert(total == free_area.nr_free);
 
     basic_check();
 
@@ -324,15 +405,12 @@ static void default_worst_fit_checker(void)
     assert(p0 != NULL);
     assert(!PageProperty(p0));
 
-    list_entry_t free_list_store = free_area.free_list;
-    list_init(&free_area.free_list);
+    free_area_t free_area_store = free_area;
+    default_init();
     assert(list_empty(&free_area.free_list));
     assert(alloc_page() == NULL);
 
     cprintf("888888\n");
-    unsigned int nr_free_store = free_area.nr_free;
-    free_area.nr_free = 0;
-
     free_pages(p0 + 2, 3);
     assert(alloc_pages(4) == NULL);
     assert(PageProperty(p0 + 2) && p0[2].property == 3);
@@ -358,9 +436,7 @@ static void default_worst_fit_checker(void)
     assert(alloc_page() == NULL);
 
     assert(free_area.nr_free == 0);
-    free_area.nr_free = nr_free_store;
-
-    free_area.free_list = free_list_store;
+    free_area = free_area_store;
     free_pages(p0, 5);
 
     le = &free_area.free_list;
@@ -381,4 +457,6 @@ const struct pmm_manager default_pmm_manager = {
     .free_pages = default_free_pages,
     .nr_free_pages = default_nr_free_pages,
 	.check = default_check,
+    .report = default_report,
+    .deferred_memmap = 1,
 };
@@ -8,6 +8,7 @@
 #define SEG_UTEXT   3
 #define SEG_UDATA   4
 #define SEG_TSS     5
+#define SEG_TLS     6
 
 /* ȫ */
 #define GD_KTEXT    ((SEG_KTEXT) << 3)      // ںı
@@ -15,6 +16,7 @@
 #define GD_UTEXT    ((SEG_UTEXT) << 3)      // ûı
 #define GD_UDATA    ((SEG_UDATA) << 3)      // û
 #define GD_TSS      ((SEG_TSS) << 3)        // ״̬
+#define GD_TLS      ((SEG_TLS) << 3)        // thread-local storage of the running thread
 
 #define DPL_KERNEL  (0)
 #define DPL_USER    (3)
@@ -23,6 +25,7 @@
 #define KERNEL_DS   ((GD_KDATA) | DPL_KERNEL)
 #define USER_CS     ((GD_UTEXT) | DPL_USER)
 #define USER_DS     ((GD_UDATA) | DPL_USER)
+#define USER_TLS    ((GD_TLS) | DPL_USER)
 
 
 
@@ -30,15 +33,26 @@
 #define KMEMSIZE            0x38000000                  // ڴ
 #define KERNTOP             (KERNBASE + KMEMSIZE)
 
+#define KMAPBASE            KERNTOP                     // temporary mappings of HighMem pages, see kmap
+#define KMAPSIZE            PTSIZE
+
+#ifdef CONFIG_PAE
+#define VPT                 0xFA800000                  // 8MB window, one PDE per page directory
+#else
 #define VPT                 0xFAC00000
+#endif
 
 #define KSTACKPAGE          2                           // ںջеҳ
 #define KSTACKSIZE          (KSTACKPAGE * PGSIZE)       // ںջĴС
 
-#define USERTOP             0xB0000000
+#define USERTOP             0xB0000000                  // VDSO_BASE (libs/vdso.h) is the page right above
 #define USTACKTOP           USERTOP
-#define USTACKPAGE          256                         // ûջеҳ
-#define USTACKSIZE          (USTACKPAGE * PGSIZE)       // ûջҳĴС
+#define USTACKPAGE          2048                        // pages reserved for the main user stack, populated on demand
+#define USTACKSIZE          (USTACKPAGE * PGSIZE)       // size of that reservation, default per-process stack limit
+#define USTACKGUARD         PGSIZE                      // no-access gap below every thread stack
+#define THREAD_STACKPAGE    64                          // default pages of a thread stack
+#define THREAD_STACKSIZE    (THREAD_STACKPAGE * PGSIZE)
+#define THREAD_STACKMAX     (4096 * PGSIZE)             // largest stack a thread may ask for
 
 #define USERBASE            0x00200000
 #define UTEXT               0x00800000                  
@@ -55,9 +69,17 @@
 #include <defs.h>
 #include <atomic.h>
 #include <list.h>
+#include <rbtree.h>
 
+#ifdef CONFIG_PAE
+typedef uint64_t pte_t;
+typedef uint64_t pde_t;
+typedef uint64_t paddr_t;       // physical address, may lie above 4GB
+#else
 typedef uintptr_t pte_t;
 typedef uintptr_t pde_t;
+typedef uintptr_t paddr_t;
+#endif
 typedef pte_t swap_entry_t; 
 
 
@@ -79,15 +101,21 @@ struct Page {
 	int ref;                        // page frame's reference counter
 	uint32_t flags;                 // array of flags that describe the status of the page frame
 	unsigned int property;          // used in buddy system, stores the order (the X in 2^X) of the continuous memory block
-	int zone_num;                   // used in buddy system, the No. of zone which the page belongs to
+	int zone_num;                   // zone the page belongs to, ZONE_NORMAL or ZONE_HIGHMEM
 	list_entry_t page_link;         // free list link
 	list_entry_t pra_page_link;     // used for pra (page replace algorithm)
-	uintptr_t pra_vaddr;            // used for pra (page replace algorithm)
+	uintptr_t pra_vaddr;            // used for pra (page replace algorithm), also the address mapped in map_pgdir
+	pde_t *map_pgdir;               // page directory of the page's user mapping, NULL if none (page_set_rmap)
+	struct rb_node addr_node;       // free block in default_pmm's address tree
+	struct rb_node size_node;       // free block in default_pmm's (size, address) tree
+	unsigned int max_property;      // largest free block in this addr_node subtree
 };
 
 /* ҳ״̬ */
 #define PG_reserved                 0       // Ƿ
 #define PG_property                 1       // Ƿ
+#define PG_swap                     2       // on a swap manager's pra list through pra_page_link
+#define PG_isolated                 3       // taken out of the pmm by compaction
 
 #define SetPageReserved(page)       set_bit(PG_reserved, &((page)->flags))
 #define ClearPageReserved(page)     clear_bit(PG_reserved, &((page)->flags))
@@ -95,6 +123,18 @@ struct Page {
 #define SetPageProperty(page)       set_bit(PG_property, &((page)->flags))
 #define ClearPageProperty(page)     clear_bit(PG_property, &((page)->flags))
 #define PageProperty(page)          test_bit(PG_property, &((page)->flags))
+#define SetPageSwap(page)           set_bit(PG_swap, &((page)->flags))
+#define ClearPageSwap(page)         clear_bit(PG_swap, &((page)->flags))
+#define PageSwap(page)              test_bit(PG_swap, &((page)->flags))
+#define SetPageIsolated(page)       set_bit(PG_isolated, &((page)->flags))
+#define ClearPageIsolated(page)     clear_bit(PG_isolated, &((page)->flags))
+#define PageIsolated(page)          test_bit(PG_isolated, &((page)->flags))
+
+/* zones, recorded in Page.zone_num */
+#define ZONE_NORMAL                 0       // below KMEMSIZE, always mapped at KERNBASE
+#define ZONE_HIGHMEM                1       // above KMEMSIZE, reachable only through kmap
+
+#define PageHighMem(page)           ((page)->zone_num == ZONE_HIGHMEM)
 
 // list entryתΪpage
 #define le2page(le, member)                 \
@@ -103,6 +143,8 @@ struct Page {
 typedef struct {
 	list_entry_t free_list;         // бͷ
 	unsigned int nr_free;           // ҳĸ
+	struct rb_root addr_tree;       // free blocks by address, for coalescing and first fit
+	struct rb_root size_tree;       // free blocks by (size, address), for best/worst fit
 } free_area_t;
 
 
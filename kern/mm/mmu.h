@@ -176,11 +176,25 @@ struct taskstate {
 
 #endif /* !__ASSEMBLER__ */
 
+/* *
+ * With CONFIG_PAE the MMU walks three levels: a 4-entry page directory pointer
+ * table (PDPT, loaded by cr3), four page directories of 512 entries and page
+ * tables of 512 entries, all with 64-bit entries. PDX still indexes the four
+ * page directories as one of NPDEENTRY entries, which is how the VPT window
+ * shows them; PDPX picks the page directory and PDX % NPTEENTRY the entry in
+ * it, see pgdir_pde.
+ * */
+
 // page directory index
-#define PDX(la) ((((uintptr_t)(la)) >> PDXSHIFT) & 0x3FF)
+#define PDX(la) ((((uintptr_t)(la)) >> PDXSHIFT) & (NPDEENTRY - 1))
+
+#ifdef CONFIG_PAE
+// page directory pointer table index
+#define PDPX(la) (((uintptr_t)(la)) >> PDPXSHIFT)
+#endif
 
 // page table index
-#define PTX(la) ((((uintptr_t)(la)) >> PTXSHIFT) & 0x3FF)
+#define PTX(la) ((((uintptr_t)(la)) >> PTXSHIFT) & (NPTEENTRY - 1))
 
 // page number field of address
 #define PPN(la) (((uintptr_t)(la)) >> PTXSHIFT)
@@ -192,20 +206,37 @@ struct taskstate {
 #define PGADDR(d, t, o) ((uintptr_t)((d) << PDXSHIFT | (t) << PTXSHIFT | (o)))
 
 // address in page table or page directory entry
+#ifdef CONFIG_PAE
+#define PTE_ADDR(pte)   ((uint64_t)(pte) & 0x000FFFFFFFFFF000ULL)
+#else
 #define PTE_ADDR(pte)   ((uintptr_t)(pte) & ~0xFFF)
+#endif
 #define PDE_ADDR(pde)   PTE_ADDR(pde)
+#define PTE_FLAGS(pte)  ((pte) ^ PTE_ADDR(pte))  // every bit but the address, NX included
 
 /* page directory and page table constants */
+#ifdef CONFIG_PAE
+#define NPDPENTRY       4                       // entries of the page directory pointer table
+#define NPDEENTRY       2048                    // page directory entries, all four directories
+#define NPTEENTRY       512                     // page table entries per page table
+#else
 #define NPDEENTRY       1024                    // page directory entries per page directory
 #define NPTEENTRY       1024                    // page table entries per page table
+#endif
 
 #define PGSIZE          4096                    // bytes mapped by a page
 #define PGSHIFT         12                      // log2(PGSIZE)
 #define PTSIZE          (PGSIZE * NPTEENTRY)    // bytes mapped by a page directory entry
-#define PTSHIFT         22                      // log2(PTSIZE)
 
-#define PTXSHIFT        12                      // offset of PTX in a linear address
+#ifdef CONFIG_PAE
+#define PTSHIFT         21                      // log2(PTSIZE)
+#define PDXSHIFT        21                      // offset of PDX in a linear address
+#define PDPXSHIFT       30                      // offset of PDPX in a linear address
+#else
+#define PTSHIFT         22                      // log2(PTSIZE)
 #define PDXSHIFT        22                      // offset of PDX in a linear address
+#endif
+#define PTXSHIFT        12                      // offset of PTX in a linear address
 
 /* page table/directory entry flags */
 #define PTE_P           0x001                   // Present
@@ -216,11 +247,16 @@ struct taskstate {
 #define PTE_A           0x020                   // Accessed
 #define PTE_D           0x040                   // Dirty
 #define PTE_PS          0x080                   // Page Size
+#define PTE_G           0x100                   // Global: survives cr3 reloads while CR4.PGE is set
 #define PTE_MBZ         0x180                   // Bits must be zero
 #define PTE_AVAIL       0xE00                   // Available for software use
 												// The PTE_AVAIL bits aren't used by the kernel or interpreted by the
 												// hardware, so user processes are allowed to set them arbitrarily.
 
+#ifdef CONFIG_PAE
+#define PTE_NX          0x8000000000000000ULL   // No-execute, needs EFER.NXE
+#endif
+
 #define PTE_USER        (PTE_U | PTE_W | PTE_P)
 
 /* Control Register flags */
@@ -237,6 +273,8 @@ struct taskstate {
 #define CR0_PG          0x80000000              // Paging
 
 #define CR4_PCE         0x00000100              // Performance counter enable
+#define CR4_PGE         0x00000080              // Page Global Enable
+#define CR4_PAE         0x00000020              // Physical Address Extension
 #define CR4_MCE         0x00000040              // Machine Check Enable
 #define CR4_PSE         0x00000010              // Page Size Extensions
 #define CR4_DE          0x00000008              // Debugging Extensions
@@ -244,5 +282,19 @@ struct taskstate {
 #define CR4_PVI         0x00000002              // Protected-Mode Virtual Interrupts
 #define CR4_VME         0x00000001              // V86 Mode Extensions
 
+/* CPUID.01H:EDX feature flags */
+#define CPUID_FEAT_PSE  0x00000008              // Page Size Extensions
+#define CPUID_FEAT_TSC  0x00000010              // Time Stamp Counter
+#define CPUID_FEAT_SEP  0x00000800              // SYSENTER/SYSEXIT
+#define CPUID_FEAT_PGE  0x00002000              // Page Global Enable
+#define CPUID_EXT_NX    0x00100000              // CPUID.80000001H:EDX, No-execute pages
+
+/* model specific registers */
+#define MSR_EFER        0xC0000080              // Extended Feature Enable Register
+#define EFER_NXE        0x00000800              // No-execute Enable
+#define MSR_SYSENTER_CS     0x00000174          // ring 0 %cs for sysenter, %ss is %cs + 8
+#define MSR_SYSENTER_ESP    0x00000175          // ring 0 %esp for sysenter
+#define MSR_SYSENTER_EIP    0x00000176          // ring 0 %eip for sysenter
+
 #endif /* !__KERN_MM_MMU_H__ */
 
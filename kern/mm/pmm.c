@@ -12,26 +12,75 @@
 #include <vmm.h>
 #include <kmalloc.h>
 #include <buddy.h>
+#include <compact.h>
+#include <proc.h>
+#include <vdso.h>
+
+// without PAE only the first 4GB of physical memory can be addressed
+#ifdef CONFIG_PAE
+#define MAXPA                   ((uint64_t)1 << 36)
+#else
+#define MAXPA                   ((uint64_t)1 << 32)
+#endif
 
 static struct taskstate ts = { 0 };
 
 struct Page *pages;
 
 size_t npage = 0;
+size_t max_low_pfn = 0;     // frames below this are mapped at KERNBASE, the rest is HighMem
 size_t tpage = 0; // 总共可用的空闲页
 
 
+#ifdef CONFIG_PAE
+extern pde_t __boot_pdpt;
+pde_t *boot_pgdir = &__boot_pdpt;
+#else
 extern pde_t __boot_pgdir;
 pde_t *boot_pgdir = &__boot_pgdir;
+#endif
 
 uintptr_t boot_cr3;
 
+#ifdef CONFIG_PAE
+pte_t pte_nx = 0;
+#endif
+
 
 const struct pmm_manager *pmm_manager;
 
+// pre-zeroed pages refilled by the idle process, see alloc_zeroed_page
+static list_entry_t zero_pool = { &zero_pool, &zero_pool };
+static size_t zero_pool_nr = 0;
+
+// free HighMem frames, see alloc_user_page
+static list_entry_t highmem_free = { &highmem_free, &highmem_free };
+static size_t nr_highmem_free = 0;
+
+// page table of the kmap window at KMAPBASE, shared by every pgdir
+static pte_t *kmap_pte = NULL;
+static size_t kmap_next = 0;
+
+/* *
+ * Order-0 page cache. Single pages are by far the most common request, so they
+ * are served from a short LIFO list instead of going through pmm_manager: frees
+ * push at the head (the page is still cache-hot), cold frees append at the tail,
+ * allocations pop from the head, and the list is refilled from / trimmed back to
+ * pmm_manager PCP_BATCH pages at a time. There is a single instance for now;
+ * with SMP it becomes per-CPU and only the batch operations touch the zone.
+ * */
+struct per_cpu_pages {
+	bool enabled;               // off until pmm_init is done, and during checks
+	size_t count;               // number of pages on list
+	list_entry_t list;          // hot pages first, cold pages last
+};
+
+static struct per_cpu_pages pcp = { 0, 0, { &pcp.list, &pcp.list } };
+static int pcp_suspended = 0;               // nesting of page_cache_suspend
+
 
 pte_t * const vpt = (pte_t *)VPT;
-pde_t * const vpd = (pde_t *)PGADDR(PDX(VPT), PDX(VPT), 0);
+pde_t * const vpd = (pde_t *)(VPT + (PDX(VPT) << PGSHIFT));
 
 
 static struct segdesc gdt[] = {
@@ -41,6 +90,7 @@ static struct segdesc gdt[] = {
 	[SEG_UTEXT] = SEG(STA_X | STA_R, 0x0, 0xFFFFFFFF, DPL_USER),
 	[SEG_UDATA] = SEG(STA_W, 0x0, 0xFFFFFFFF, DPL_USER),
 	[SEG_TSS] = SEG_NULL,
+	[SEG_TLS] = SEG(STA_W, 0x0, 0xFFFFFFFF, DPL_USER),
 };
 
 static struct pseudodesc gdt_pd = {
@@ -65,9 +115,50 @@ lgdt(struct pseudodesc *pd) {
 }
 
 
+// sysenter lands on SYSENTER_ESP instead of the TSS, so it follows esp0
+static bool sysenter_enabled = 0;
+
 void
 load_esp0(uintptr_t esp0) {
 	ts.ts_esp0 = esp0;
+	if (sysenter_enabled) {
+		wrmsr(MSR_SYSENTER_ESP, esp0);
+	}
+}
+
+/* *
+ * sysenter_init - route sysenter to __sysenter_entry when CPUID reports SEP.
+ * The selectors sysenter/sysexit derive from SYSENTER_CS (KTEXT, KDATA, UTEXT,
+ * UDATA) are exactly the GDT order. Early Pentium Pro parts report SEP without
+ * implementing it, so they are skipped as the SDM describes.
+ * */
+static void
+sysenter_init(void) {
+	extern char __sysenter_entry[];
+	uint32_t eax, edx;
+	cpuid(1, &eax, NULL, NULL, &edx);
+	if (!(edx & CPUID_FEAT_SEP)) {
+		return;
+	}
+	uint32_t family = (eax >> 8) & 0xF, model = (eax >> 4) & 0xF, stepping = eax & 0xF;
+	if (family == 6 && model < 3 && stepping < 3) {
+		return;
+	}
+	wrmsr(MSR_SYSENTER_CS, GD_KTEXT);
+	wrmsr(MSR_SYSENTER_EIP, (uintptr_t)__sysenter_entry);
+	sysenter_enabled = 1;
+	load_esp0(ts.ts_esp0);
+	cprintf("sysenter fast system calls enabled.\n");
+}
+
+/* *
+ * load_tls - point the SEG_TLS descriptor at a thread's TLS block. User %gs is
+ * reloaded from the trapframe on every return to user mode, which picks up
+ * the new base.
+ * */
+void
+load_tls(uintptr_t base) {
+	gdt[SEG_TLS] = SEG(STA_W, base, 0xFFFFFFFF, DPL_USER);
 }
 
 /* gdt_init - initialize the default GDT and TSS */
@@ -85,6 +176,8 @@ gdt_init(void) {
 
 	// load the TSS
 	ltr(GD_TSS);
+
+	sysenter_init();
 }
 
 //init_pmm_manager - initialize a pmm_manager instance
@@ -101,21 +194,208 @@ init_memmap(struct Page *base, size_t n) {
 	pmm_manager->init_memmap(base, n);
 }
 
+/* *
+ * Deferred struct Page initialisation. Setting up every struct Page at boot makes
+ * boot time grow with the amount of RAM, so page_init only records the free
+ * ranges of the e820 map and initialises the first PAGE_INIT_BOOT_PAGES frames.
+ * The rest is set up PAGE_INIT_CHUNK frames at a time, by cpu_idle and by
+ * alloc_pages when pmm_manager runs dry. Frames below page_init_pfn are ready;
+ * free frames above it are counted in deferred_free and in nr_free_pages.
+ * */
+static struct {
+	size_t begin, end;          // [begin, end) page frame numbers
+} free_ranges[E820MAX];
+static int nr_free_ranges = 0;
+static size_t deferred_free = 0;
+size_t page_init_pfn = 0;
+
+//highmem_free_page - put a HighMem frame on the HighMem free list
+//                  - interrupts must be disabled
+static void
+highmem_free_page(struct Page *page) {
+	page->flags = 0;
+	set_page_ref(page, 0);
+	list_add(&highmem_free, &(page->page_link));
+	nr_highmem_free++;
+}
+
+//page_init_range - initialise struct Pages [page_init_pfn, end_pfn), reserved
+//                - unless they fall in a free range, which goes to pmm_manager
+//                - (or to the HighMem free list above max_low_pfn)
+static void
+page_init_range(size_t end_pfn) {
+	size_t pfn;
+	int i;
+	for (pfn = page_init_pfn; pfn < end_pfn; pfn++) {
+		memset(pages + pfn, 0, sizeof(struct Page));
+		SetPageReserved(pages + pfn);
+		if (pfn >= max_low_pfn) {
+			pages[pfn].zone_num = ZONE_HIGHMEM;
+		}
+	}
+	for (i = 0; i < nr_free_ranges; i++) {
+		size_t begin = free_ranges[i].begin, end = free_ranges[i].end;
+		if (begin < page_init_pfn) {
+			begin = page_init_pfn;
+		}
+		if (end > end_pfn) {
+			end = end_pfn;
+		}
+		if (begin < end) {
+			size_t low_end = (end < max_low_pfn) ? end : max_low_pfn;
+			if (begin < low_end) {
+				init_memmap(pages + begin, low_end - begin);
+			}
+			for (pfn = (begin > low_end) ? begin : low_end; pfn < end; pfn++) {
+				highmem_free_page(pages + pfn);
+			}
+			deferred_free -= end - begin;
+		}
+	}
+	page_init_pfn = end_pfn;
+}
+
+//pcp_drain - return up to n of the coldest cached pages to pmm_manager
+//           - interrupts must be disabled
+static size_t
+pcp_drain(size_t n) {
+	size_t i;
+	for (i = 0; i < n && pcp.count != 0; i++) {
+		list_entry_t *le = list_prev(&(pcp.list));
+		list_del(le);
+		pcp.count--;
+		pmm_manager->free_pages(le2page(le, page_link), 1);
+	}
+	return i;
+}
+
+//pcp_alloc - take the hottest cached page, refilling a batch when empty
+//          - interrupts must be disabled
+static struct Page *
+pcp_alloc(void) {
+	if (pcp.count == 0) {
+		size_t i;
+		for (i = 0; i < PCP_BATCH; i++) {
+			struct Page *page = pmm_manager->alloc_pages(1);
+			if (page == NULL) {
+				break;
+			}
+			list_add_before(&(pcp.list), &(page->page_link));
+			pcp.count++;
+		}
+		if (pcp.count == 0) {
+			return NULL;
+		}
+	}
+	list_entry_t *le = list_next(&(pcp.list));
+	list_del(le);
+	pcp.count--;
+	return le2page(le, page_link);
+}
+
+//pcp_free - cache a single page, trimming a batch once above PCP_HIGH
+//         - interrupts must be disabled
+static void
+pcp_free(struct Page *page, bool cold) {
+	assert(!PageReserved(page) && !PageProperty(page));
+	page->flags = 0;
+	set_page_ref(page, 0);
+	if (cold) {
+		list_add_before(&(pcp.list), &(page->page_link));
+	}
+	else {
+		list_add(&(pcp.list), &(page->page_link));
+	}
+	if (++pcp.count > PCP_HIGH) {
+		pcp_drain(PCP_BATCH);
+	}
+}
+
+//__free_pages - free pages with interrupts already disabled
+static void
+__free_pages(struct Page *base, size_t n, bool cold) {
+	if (PageHighMem(base)) {
+		size_t i;
+		for (i = 0; i < n; i++) {
+			highmem_free_page(base + i);
+		}
+	}
+	else if (n == 1 && pcp.enabled) {
+		pcp_free(base, cold);
+	}
+	else {
+		pmm_manager->free_pages(base, n);
+	}
+}
+
+//page_cache_reclaim - flush the order-0 cache and the zero pool back to pmm_manager
+static size_t
+page_cache_reclaim(void) {
+	size_t n;
+	bool intr_flag;
+	local_intr_save(intr_flag);
+	{
+		n = pcp_drain(pcp.count);
+	}
+	local_intr_restore(intr_flag);
+	return n + zero_pool_drain();
+}
+
+//page_cache_suspend - empty every page cache and bypass the order-0 cache until
+//                   - page_cache_resume; for checks that inspect pmm_manager directly
+bool
+page_cache_suspend(void) {
+	bool enabled = pcp.enabled;
+	pcp.enabled = 0;
+	pcp_suspended++;
+	page_cache_reclaim();
+	return enabled;
+}
+
+void
+page_cache_resume(bool enabled) {
+	pcp_suspended--;
+	pcp.enabled = enabled;
+}
+
 //alloc_pages - call pmm->alloc_pages to allocate a continuous n*PAGESIZE memory 
 struct Page *
 	alloc_pages(size_t n) {
 	struct Page *page = NULL;
-	bool intr_flag;
+	bool intr_flag, compacted = 0;
 
 	while (1)
 	{
 		local_intr_save(intr_flag);
 		{
-			page = pmm_manager->alloc_pages(n);
+			if (n == 1 && pcp.enabled) {
+				page = pcp_alloc();
+			}
+			else {
+				page = pmm_manager->alloc_pages(n);
+			}
 		}
 		local_intr_restore(intr_flag);
 
-		if (page != NULL || n > 1 || swap_init_ok == 0) break;
+		if (page != NULL) {
+			size_t i;
+			for (i = 0; i < n; i++) {
+				page[i].map_pgdir = NULL;
+			}
+			break;
+		}
+		// bring up more of memory, unless a check is looking at pmm_manager
+		if (pcp_suspended == 0 && page_init_step()) continue;
+		// hand cached and idle-time zeroed pages back before resorting to swap
+		if (page_cache_reclaim() != 0) continue;
+		// and the kernel stacks / page directories held by cached process shells
+		if (proc_shell_drain() != 0) continue;
+		// enough memory may be free, just not contiguous
+		if (n > 1 && !compacted) {
+			compacted = 1;
+			if (compact_pages(n)) continue;
+		}
+		if (n > 1 || swap_init_ok == 0) break;
 
 		extern struct mm_struct *check_mm_struct;
 		//cprintf("page %x, call swap_out in alloc_pages %d\n",page, n);
@@ -131,7 +411,7 @@ free_pages(struct Page *base, size_t n) {
 	bool intr_flag;
 	local_intr_save(intr_flag);
 	{
-		pmm_manager->free_pages(base, n);
+		__free_pages(base, n, 0);
 	}
 	local_intr_restore(intr_flag);
 }
@@ -144,12 +424,187 @@ nr_free_pages(void) {
 	bool intr_flag;
 	local_intr_save(intr_flag);
 	{
-		ret = pmm_manager->nr_free_pages();
+		ret = pmm_manager->nr_free_pages() + pcp.count + zero_pool_nr + nr_highmem_free + deferred_free;
 	}
 	local_intr_restore(intr_flag);
 	return ret;
 }
 
+/* *
+ * Pre-zeroed page pool. Clearing a page costs a full PGSIZE memset, which used to
+ * happen on the page fault path. The idle process refills this pool whenever it
+ * has nothing to run, and allocations that need zeroed memory take from it first.
+ * Pool pages are allocated from pmm_manager but still count as free memory: they
+ * are drained back before alloc_pages falls back to swapping.
+ * */
+//zero_pool_get - take a page from the zero pool, NULL if it is empty
+static struct Page *
+zero_pool_get(void) {
+	struct Page *page = NULL;
+	bool intr_flag;
+	local_intr_save(intr_flag);
+	{
+		if (!list_empty(&zero_pool)) {
+			list_entry_t *le = list_next(&zero_pool);
+			list_del(le);
+			zero_pool_nr--;
+			page = le2page(le, page_link);
+		}
+	}
+	local_intr_restore(intr_flag);
+	return page;
+}
+
+//alloc_zeroed_page - allocate one page whose content is all zero
+struct Page *
+alloc_zeroed_page(void) {
+	struct Page *page = zero_pool_get();
+	if (page == NULL && (page = alloc_page()) != NULL) {
+		memset(page2kva(page), 0, PGSIZE);
+	}
+	return page;
+}
+
+//alloc_zeroed_user_page - like alloc_zeroed_page, but may return a HighMem page
+struct Page *
+alloc_zeroed_user_page(void) {
+	struct Page *page = zero_pool_get();
+	if (page == NULL && (page = alloc_user_page()) != NULL) {
+		void *kva = kmap(page);
+		memset(kva, 0, PGSIZE);
+		kunmap(kva);
+	}
+	return page;
+}
+
+//zero_pool_refill - zero one more page for the pool, return 0 once it is full
+//                 - or memory is short; called from cpu_idle
+bool
+zero_pool_refill(void) {
+	struct Page *page;
+	bool intr_flag;
+	if (zero_pool_nr >= ZERO_POOL_MAX) {
+		return 0;
+	}
+	local_intr_save(intr_flag);
+	{
+		page = NULL;
+		if (pmm_manager->nr_free_pages() > ZERO_POOL_RESERVE) {
+			page = pmm_manager->alloc_pages(1);
+		}
+	}
+	local_intr_restore(intr_flag);
+	if (page == NULL) {
+		return 0;
+	}
+	memset(page2kva(page), 0, PGSIZE);
+	page->map_pgdir = NULL;
+	local_intr_save(intr_flag);
+	{
+		list_add(&zero_pool, &(page->page_link));
+		zero_pool_nr++;
+	}
+	local_intr_restore(intr_flag);
+	return 1;
+}
+
+//zero_pool_drain - give every pooled page back to pmm_manager, return how many
+size_t
+zero_pool_drain(void) {
+	size_t n;
+	bool intr_flag;
+	local_intr_save(intr_flag);
+	{
+		n = zero_pool_nr;
+		while (!list_empty(&zero_pool)) {
+			list_entry_t *le = list_next(&zero_pool);
+			list_del(le);
+			pmm_manager->free_pages(le2page(le, page_link), 1);
+		}
+		zero_pool_nr = 0;
+	}
+	local_intr_restore(intr_flag);
+	return n;
+}
+
+//alloc_user_page - allocate a page for user memory; HighMem is used first so the
+//                - directly mapped memory stays available to the kernel
+struct Page *
+alloc_user_page(void) {
+	struct Page *page = NULL;
+	bool intr_flag;
+	local_intr_save(intr_flag);
+	{
+		// checks that inspect pmm_manager expect user pages to come from it
+		if (pcp_suspended == 0 && !list_empty(&highmem_free)) {
+			list_entry_t *le = list_next(&highmem_free);
+			list_del(le);
+			nr_highmem_free--;
+			page = le2page(le, page_link);
+		}
+	}
+	local_intr_restore(intr_flag);
+	if (page == NULL) {
+		return alloc_page();
+	}
+	page->map_pgdir = NULL;
+	return page;
+}
+
+//kmap - map page into the kernel address space, return its kernel virtual address
+//     - pages below max_low_pfn are already mapped; HighMem pages take a slot of
+//     - the kmap window until kunmap
+void *
+kmap(struct Page *page) {
+	size_t slot, i;
+	bool intr_flag;
+	if (!PageHighMem(page)) {
+		return page2kva(page);
+	}
+	local_intr_save(intr_flag);
+	{
+		for (i = 0; i < KMAP_IRQ_SLOT; i++, kmap_next = (kmap_next + 1) % KMAP_IRQ_SLOT) {
+			if (kmap_pte[kmap_next] == 0) {
+				break;
+			}
+		}
+		if (i == KMAP_IRQ_SLOT) {
+			panic("kmap: no free slot in the kmap window.\n");
+		}
+		slot = kmap_next;
+		kmap_next = (kmap_next + 1) % KMAP_IRQ_SLOT;
+		kmap_pte[slot] = page2pa(page) | PTE_P | PTE_W | pte_nx;
+	}
+	local_intr_restore(intr_flag);
+	void *kva = (void *)(KMAPBASE + slot * PGSIZE);
+	invlpg(kva);
+	return kva;
+}
+
+//kmap_irq - kmap for interrupt handlers, which must not take a slot kmap may
+//         - run out of; uses the one reserved slot, so the caller keeps interrupts
+//         - disabled and calls kunmap before mapping another page
+void *
+kmap_irq(struct Page *page) {
+	if (!PageHighMem(page)) {
+		return page2kva(page);
+	}
+	kmap_pte[KMAP_IRQ_SLOT] = page2pa(page) | PTE_P | PTE_W | pte_nx;
+	void *kva = (void *)(KMAPBASE + KMAP_IRQ_SLOT * PGSIZE);
+	invlpg(kva);
+	return kva;
+}
+
+//kunmap - release a mapping returned by kmap or kmap_irq
+void
+kunmap(void *kva) {
+	uintptr_t va = (uintptr_t)kva;
+	if (va >= KMAPBASE && va < KMAPBASE + KMAPSIZE) {
+		kmap_pte[(va - KMAPBASE) >> PGSHIFT] = 0;
+		invlpg(kva);
+	}
+}
+
 /* pmm_init - initialize the physical memory management */
 static void
 page_init(void) {
@@ -163,25 +618,32 @@ page_init(void) {
 		cprintf("  memory: %08llx, [%08llx, %08llx], type = %d.\n",
 			memmap->map[i].size, begin, end - 1, memmap->map[i].type);
 		if (memmap->map[i].type == E820_ARM) {
-			if (maxpa < end && begin < KMEMSIZE) {
+			if (maxpa < end && begin < MAXPA) {
 				maxpa = end;
 			}
 		}
 	}
-	if (maxpa > KMEMSIZE) {
-		maxpa = KMEMSIZE;
+	if (maxpa > MAXPA) {
+		maxpa = MAXPA;
 	}
 
 	extern char end[];
 
+	// memory above KMEMSIZE has no kernel mapping and becomes HighMem; the
+	// struct Page array itself must leave most of the direct map to the kernel
 	npage = maxpa / PGSIZE;
-	pages = (struct Page *)ROUNDUP((void *)end, PGSIZE);
-
-	for (i = 0; i < npage; i++) {
-		SetPageReserved(pages + i);
+	if (npage > KMEMSIZE / 2 / sizeof(struct Page)) {
+		npage = KMEMSIZE / 2 / sizeof(struct Page);
+		maxpa = (uint64_t)npage * PGSIZE;
+		cprintf("memory above %08llx is not used.\n", maxpa);
 	}
+	max_low_pfn = (npage < KMEMSIZE / PGSIZE) ? npage : KMEMSIZE / PGSIZE;
+	pages = (struct Page *)ROUNDUP((void *)end, PGSIZE);
 
 	uintptr_t freemem = PADDR((uintptr_t)pages + sizeof(struct Page) * npage);
+	if (PPN(freemem) >= max_low_pfn) {
+		panic("page_init: no room for struct Page array.\n");
+	}
 
 	for (i = 0; i < memmap->nr_map; i++) {
 		uint64_t begin = memmap->map[i].addr, end = begin + memmap->map[i].size;
@@ -189,24 +651,51 @@ page_init(void) {
 			if (begin < freemem) {
 				begin = freemem;
 			}
-			if (end > KMEMSIZE) {
-				end = KMEMSIZE;
+			if (end > maxpa) {
+				end = maxpa;
 			}
 			if (begin < end) {
 				begin = ROUNDUP(begin, PGSIZE);
 				end = ROUNDDOWN(end, PGSIZE);
 				if (begin < end) {
-					init_memmap(pa2page(begin), (end - begin) / PGSIZE);
+					// end may be 4GB, so no PPN on the 32-bit uintptr_t
+					free_ranges[nr_free_ranges].begin = begin / PGSIZE;
+					free_ranges[nr_free_ranges].end = end / PGSIZE;
+					nr_free_ranges++;
+					deferred_free += (end - begin) / PGSIZE;
 				}
 			}
 		}
 	}
-	tpage = pmm_manager->nr_free_pages();
+
+	// only the struct Pages needed to boot are set up now, see page_init_step
+	size_t boot_pfn = npage;
+	if (pmm_manager->deferred_memmap && PPN(freemem) + PAGE_INIT_BOOT_PAGES < npage) {
+		boot_pfn = PPN(freemem) + PAGE_INIT_BOOT_PAGES;
+	}
+	page_init_range(boot_pfn);
+	tpage = nr_free_pages();
+}
+
+//page_init_step - initialise the next PAGE_INIT_CHUNK struct Pages and hand their
+//               - free memory to pmm_manager, return 0 once every page is ready
+bool
+page_init_step(void) {
+	bool intr_flag, more;
+	local_intr_save(intr_flag);
+	{
+		more = (page_init_pfn < npage);
+		if (more) {
+			page_init_range((npage - page_init_pfn > PAGE_INIT_CHUNK) ? page_init_pfn + PAGE_INIT_CHUNK : npage);
+		}
+	}
+	local_intr_restore(intr_flag);
+	return more;
 }
 
 
 static void
-boot_map_segment(pde_t *pgdir, uintptr_t la, size_t size, uintptr_t pa, uint32_t perm) {
+boot_map_segment(pde_t *pgdir, uintptr_t la, size_t size, uintptr_t pa, pte_t perm) {
 	assert(PGOFF(la) == PGOFF(pa));
 	size_t n = ROUNDUP(size + PGOFF(la), PGSIZE) / PGSIZE;
 	la = ROUNDDOWN(la, PGSIZE);
@@ -219,6 +708,144 @@ boot_map_segment(pde_t *pgdir, uintptr_t la, size_t size, uintptr_t pa, uint32_t
 }
 
 
+/* pge_supported - check CPUID for global page support (CR4.PGE / PTE_G) */
+static bool
+pge_supported(void) {
+	uint32_t edx;
+	cpuid(1, NULL, NULL, NULL, &edx);
+	return (edx & CPUID_FEAT_PGE) != 0;
+}
+
+#ifdef CONFIG_PAE
+/* nx_init - turn on no-execute pages when CPUID reports them */
+static void
+nx_init(void) {
+	uint32_t eax, edx;
+	cpuid(0x80000000, &eax, NULL, NULL, NULL);
+	if (eax >= 0x80000001) {
+		cpuid(0x80000001, NULL, NULL, NULL, &edx);
+		if (edx & CPUID_EXT_NX) {
+			wrmsr(MSR_EFER, rdmsr(MSR_EFER) | EFER_NXE);
+			pte_nx = PTE_NX;
+			cprintf("no-execute pages enabled.\n");
+		}
+	}
+}
+
+//split_large_pde - replace a 2MB mapping of the boot page directory (entry.S)
+//                - by a page table that maps the same memory
+static bool
+split_large_pde(pde_t *pdep) {
+	struct Page *page;
+	if ((page = alloc_page()) == NULL) {
+		return 0;
+	}
+	set_page_ref(page, 1);
+	pte_t *pt = page2kva(page), perm = PTE_FLAGS(*pdep) & ~PTE_PS;
+	paddr_t pa = PDE_ADDR(*pdep);
+	int i;
+	for (i = 0; i < NPTEENTRY; i++) {
+		pt[i] = (pa + i * PGSIZE) | perm;
+	}
+	*pdep = page2pa(page) | PTE_U | PTE_W | PTE_P;
+	lcr3(rcr3());
+	return 1;
+}
+#endif
+
+//pgdir_self_map - map pgdir at VPT, with CONFIG_PAE its four page directories one after the other
+static void
+pgdir_self_map(pde_t *pgdir) {
+#ifdef CONFIG_PAE
+	int i;
+	for (i = 0; i < NPDPENTRY; i++) {
+		*pgdir_pde(pgdir, VPT + i * PTSIZE) = PDE_ADDR(pgdir[i]) | PTE_P | PTE_W;
+	}
+#else
+	pgdir[PDX(VPT)] = PADDR(pgdir) | PTE_P | PTE_W;
+#endif
+}
+
+#ifdef CONFIG_PAE
+// room to align a PDPT to 32 bytes in a kmalloc block and keep the block behind it
+#define PDPT_SIZE               (NPDPENTRY * sizeof(pde_t))
+#define PDPT_ALLOC_SIZE         (2 * PDPT_SIZE + sizeof(void *))
+#endif
+
+//pgdir_alloc - allocate a new page directory: the kernel part is shared with
+//            - boot_pgdir, the user part starts empty
+pde_t *
+pgdir_alloc(void) {
+	pde_t *pgdir;
+#ifdef CONFIG_PAE
+	void *block;
+	int i;
+	if ((block = kmalloc(PDPT_ALLOC_SIZE)) == NULL) {
+		return NULL;
+	}
+	pgdir = (pde_t *)ROUNDUP((uintptr_t)block, PDPT_SIZE);
+	*(void **)(pgdir + NPDPENTRY) = block;
+	for (i = 0; i < NPDPENTRY; i++) {
+		struct Page *page;
+		if ((page = alloc_page()) == NULL) {
+			while (--i >= 0) {
+				free_page(pde2page(pgdir[i]));
+			}
+			kfree(block);
+			return NULL;
+		}
+		pgdir[i] = page2pa(page) | PTE_P;
+		memcpy(page2kva(page), KADDR(PDE_ADDR(boot_pgdir[i])), PGSIZE);
+	}
+#else
+	struct Page *page;
+	if ((page = alloc_page()) == NULL) {
+		return NULL;
+	}
+	pgdir = page2kva(page);
+	memcpy(pgdir, boot_pgdir, PGSIZE);
+#endif
+	pgdir_self_map(pgdir);
+	return pgdir;
+}
+
+//pgdir_free - free a page directory of pgdir_alloc, its user part already empty
+void
+pgdir_free(pde_t *pgdir) {
+#ifdef CONFIG_PAE
+	int i;
+	for (i = 0; i < NPDPENTRY; i++) {
+		free_page(pde2page(pgdir[i]));
+	}
+	kfree(*(void **)(pgdir + NPDPENTRY));
+#else
+	free_page(kva2page(pgdir));
+#endif
+}
+
+/* *
+ * vdso_init - set up the shared kernel data page (libs/vdso.h). It is mapped
+ * read-only for user mode into boot_pgdir; pgdir_init copies that pde into
+ * every new page directory, so all address spaces share one page table. The
+ * page lies above USERTOP, out of reach of exit_mmap, put_pgdir and swap.
+ * */
+struct vdso_data *vdso_data;
+
+static void
+vdso_init(void) {
+	static_assert(VDSO_BASE >= USERTOP && VDSO_BASE + PGSIZE <= KERNBASE);
+	static_assert(sizeof(struct vdso_data) <= PGSIZE);
+	struct Page *page = alloc_page();
+	if (page == NULL) {
+		panic("vdso_init: no page for the vdso data.\n");
+	}
+	vdso_data = page2kva(page);
+	memset(vdso_data, 0, PGSIZE);
+	pte_t *ptep = get_pte(boot_pgdir, VDSO_BASE, 1);
+	assert(ptep != NULL);
+	*ptep = page2pa(page) | PTE_U | PTE_P | pte_nx;
+}
+
 static void *
 boot_alloc_page(void) {
 	struct Page *p = alloc_page();
@@ -232,7 +859,11 @@ boot_alloc_page(void) {
 void
 pmm_init(void) {
 
-	boot_cr3 = PADDR(boot_pgdir);
+	boot_cr3 = pgdir_cr3(boot_pgdir);
+#ifdef CONFIG_PAE
+	// before any mapping may carry PTE_NX
+	nx_init();
+#endif
 	init_pmm_manager();
 	page_init();
 	check_alloc_page();
@@ -242,9 +873,34 @@ pmm_init(void) {
 	static_assert(KERNBASE % PTSIZE == 0 && KERNTOP % PTSIZE == 0);
 
 
-	boot_pgdir[PDX(VPT)] = PADDR(boot_pgdir) | PTE_P | PTE_W;
+	pgdir_self_map(boot_pgdir);
+
+	// mark the kernel mappings global when possible, so the cr3 reload in proc_run does not
+	// flush them. The kernel page tables are shared by every pgdir copied in setup_pgdir,
+	// so all address spaces see the same global entries.
+	pte_t kern_perm = PTE_W;
+	if (pge_supported()) {
+		kern_perm |= PTE_G;
+	}
+	// only kernel text stays executable
+	extern char etext[];
+	uintptr_t text_end = ROUNDUP(PADDR(etext), PGSIZE);
+	boot_map_segment(boot_pgdir, KERNBASE, text_end, 0, kern_perm);
+	boot_map_segment(boot_pgdir, KERNBASE + text_end, KMEMSIZE - text_end, text_end, kern_perm | pte_nx);
+	if (kern_perm & PTE_G) {
+		// setting CR4.PGE flushes the whole TLB, stale non-global kernel entries included
+		lcr4(rcr4() | CR4_PGE);
+		cprintf("global kernel pages enabled.\n");
+	}
 
-	boot_map_segment(boot_pgdir, KERNBASE, KMEMSIZE, 0, PTE_W);
+	// the kmap window's page table must exist before setup_pgdir copies boot_pgdir
+	kmap_pte = get_pte(boot_pgdir, KMAPBASE, 1);
+	assert(kmap_pte != NULL);
+	// so must the vdso page's
+	vdso_init();
+	if (npage > max_low_pfn) {
+		cprintf("highmem: %u pages above KMEMSIZE.\n", npage - max_low_pfn);
+	}
 
 	gdt_init();
 
@@ -254,6 +910,9 @@ pmm_init(void) {
 
 	cprintf("kmalloc_init succeeded.\n");
 
+	// single-page requests go through the order-0 cache from now on
+	pcp.enabled = 1;
+
 }
 
 pte_t *
@@ -270,15 +929,21 @@ get_pte(pde_t *pgdir, uintptr_t la, bool create) {
 	}
 	return NULL;          // (8) return page table entry
 #endif
-	pde_t *pdep = &pgdir[PDX(la)];
+	pde_t *pdep = pgdir_pde(pgdir, la);
+#ifdef CONFIG_PAE
+	if ((*pdep & (PTE_P | PTE_PS)) == (PTE_P | PTE_PS)) {
+		if (!create || !split_large_pde(pdep)) {
+			return NULL;
+		}
+	}
+#endif
 	if (!(*pdep & PTE_P)) {
 		struct Page *page;
-		if (!create || (page = alloc_page()) == NULL) {
+		if (!create || (page = alloc_zeroed_page()) == NULL) {
 			return NULL;
 		}
 		set_page_ref(page, 1);
-		uintptr_t pa = page2pa(page);
-		memset(KADDR(pa), 0, PGSIZE);
+		paddr_t pa = page2pa(page);
 		*pdep = pa | PTE_U | PTE_W | PTE_P;
 	}
 	return &((pte_t *)KADDR(PDE_ADDR(*pdep)))[PTX(la)];
@@ -317,40 +982,131 @@ page_remove_pte(pde_t *pgdir, uintptr_t la, pte_t *ptep) {
 	}
 }
 
+//tlb_gather_init - start an empty batch of unmaps against pgdir
 void
-unmap_range(pde_t *pgdir, uintptr_t start, uintptr_t end) {
+tlb_gather_init(struct tlb_gather *tlb, pde_t *pgdir) {
+	tlb->pgdir = pgdir;
+	tlb->cold = 0;
+	tlb->flush_all = 0;
+	tlb->nr_addrs = tlb->nr_pages = 0;
+}
+
+//tlb_gather_flush - invalidate every gathered translation, then free the gathered pages
+void
+tlb_gather_flush(struct tlb_gather *tlb) {
+	if (rcr3() == pgdir_cr3(tlb->pgdir)) {
+		if (tlb->flush_all) {
+			// kernel mappings are global, so this only drops user entries
+			lcr3(rcr3());
+		}
+		else {
+			size_t i;
+			for (i = 0; i < tlb->nr_addrs; i++) {
+				invlpg((void *)tlb->addrs[i]);
+			}
+		}
+	}
+	if (tlb->nr_pages != 0) {
+		bool intr_flag;
+		local_intr_save(intr_flag);
+		{
+			size_t i;
+			for (i = 0; i < tlb->nr_pages; i++) {
+				__free_pages(tlb->pages[i], 1, tlb->cold);
+			}
+		}
+		local_intr_restore(intr_flag);
+	}
+	tlb->flush_all = 0;
+	tlb->nr_addrs = tlb->nr_pages = 0;
+}
+
+static inline void
+tlb_gather_addr(struct tlb_gather *tlb, uintptr_t la) {
+	if (!tlb->flush_all) {
+		if (tlb->nr_addrs < TLB_FLUSH_ALL_THRESHOLD) {
+			tlb->addrs[tlb->nr_addrs++] = la;
+		}
+		else {
+			tlb->flush_all = 1;
+		}
+	}
+}
+
+static inline void
+tlb_gather_free(struct tlb_gather *tlb, struct Page *page) {
+	if (tlb->nr_pages == TLB_GATHER_PAGES) {
+		tlb_gather_flush(tlb);
+	}
+	tlb->pages[tlb->nr_pages++] = page;
+}
+
+//tlb_gather_page - queue the invalidation of la and, if page != NULL, the release of page
+void
+tlb_gather_page(struct tlb_gather *tlb, uintptr_t la, struct Page *page) {
+	tlb_gather_addr(tlb, la);
+	if (page != NULL) {
+		tlb_gather_free(tlb, page);
+	}
+}
+
+//tlb_unmap_range - clear the ptes of [start, end), deferring flush and free to tlb
+void
+tlb_unmap_range(struct tlb_gather *tlb, uintptr_t start, uintptr_t end) {
 	assert(start % PGSIZE == 0 && end % PGSIZE == 0);
 	assert(USER_ACCESS(start, end));
 
 	do {
-		pte_t *ptep = get_pte(pgdir, start, 0);
+		pte_t *ptep = get_pte(tlb->pgdir, start, 0);
 		if (ptep == NULL) {
 			start = ROUNDDOWN(start + PTSIZE, PTSIZE);
 			continue;
 		}
-		if (*ptep != 0) {
-			page_remove_pte(pgdir, start, ptep);
+		if (*ptep & PTE_P) {
+			struct Page *page = pte2page(*ptep);
+			*ptep = 0;
+			tlb_gather_page(tlb, start, (page_ref_dec(page) == 0) ? page : NULL);
 		}
 		start += PGSIZE;
 	} while (start != 0 && start < end);
 }
 
+//tlb_exit_range - release the page tables covering [start, end) through tlb
 void
-exit_range(pde_t *pgdir, uintptr_t start, uintptr_t end) {
+tlb_exit_range(struct tlb_gather *tlb, uintptr_t start, uintptr_t end) {
 	assert(start % PGSIZE == 0 && end % PGSIZE == 0);
 	assert(USER_ACCESS(start, end));
 
 	start = ROUNDDOWN(start, PTSIZE);
 	do {
-		int pde_idx = PDX(start);
-		if (pgdir[pde_idx] & PTE_P) {
-			free_page(pde2page(pgdir[pde_idx]));
-			pgdir[pde_idx] = 0;
+		pde_t *pdep = pgdir_pde(tlb->pgdir, start);
+		if (*pdep & PTE_P) {
+			struct Page *ptpage = pde2page(*pdep);
+			*pdep = 0;
+			// paging-structure caches may still hold the pde, invlpg is not enough
+			tlb->flush_all = 1;
+			tlb_gather_free(tlb, ptpage);
 		}
 		start += PTSIZE;
 	} while (start != 0 && start < end);
 }
 
+void
+unmap_range(pde_t *pgdir, uintptr_t start, uintptr_t end) {
+	struct tlb_gather tlb;
+	tlb_gather_init(&tlb, pgdir);
+	tlb_unmap_range(&tlb, start, end);
+	tlb_gather_flush(&tlb);
+}
+
+void
+exit_range(pde_t *pgdir, uintptr_t start, uintptr_t end) {
+	struct tlb_gather tlb;
+	tlb_gather_init(&tlb, pgdir);
+	tlb_exit_range(&tlb, start, end);
+	tlb_gather_flush(&tlb);
+}
+
 int
 copy_range(pde_t *to, pde_t *from, uintptr_t start, uintptr_t end, bool share) {
 	assert(start % PGSIZE == 0 && end % PGSIZE == 0);
@@ -368,21 +1124,24 @@ copy_range(pde_t *to, pde_t *from, uintptr_t start, uintptr_t end, bool share) {
 			if ((nptep = get_pte(to, start, 1)) == NULL) {
 				return -E_NO_MEM;
 			}
-			uint32_t perm = (*ptep & PTE_USER);
+			pte_t perm = (*ptep & (PTE_USER | pte_nx));
 			//get page from ptep
 			struct Page *page = pte2page(*ptep);
 			// alloc a page for process B
-			struct Page *npage = alloc_page();
+			struct Page *npage = alloc_user_page();
 			assert(page != NULL);
 			assert(npage != NULL);
 			int ret = 0;
-			void * kva_src = page2kva(page);
-			void * kva_dst = page2kva(npage);
+			void * kva_src = kmap(page);
+			void * kva_dst = kmap(npage);
 
 			memcpy(kva_dst, kva_src, PGSIZE);
+			kunmap(kva_dst);
+			kunmap(kva_src);
 
 			ret = page_insert(to, npage, start, perm);
 			assert(ret == 0);
+			page_set_rmap(npage, to, start);
 		}
 		start += PGSIZE;
 	} while (start != 0 && start < end);
@@ -399,7 +1158,7 @@ page_remove(pde_t *pgdir, uintptr_t la) {
 }
 
 int
-page_insert(pde_t *pgdir, struct Page *page, uintptr_t la, uint32_t perm) {
+page_insert(pde_t *pgdir, struct Page *page, uintptr_t la, pte_t perm) {
 	pte_t *ptep = get_pte(pgdir, la, 1);
 	if (ptep == NULL) {
 		return -E_NO_MEM;
@@ -421,19 +1180,19 @@ page_insert(pde_t *pgdir, struct Page *page, uintptr_t la, uint32_t perm) {
 
 void
 tlb_invalidate(pde_t *pgdir, uintptr_t la) {
-	if (rcr3() == PADDR(pgdir)) {
+	if (rcr3() == pgdir_cr3(pgdir)) {
 		invlpg((void *)la);
 	}
 }
 
-struct Page *
-	pgdir_alloc_page(pde_t *pgdir, uintptr_t la, uint32_t perm) {
-	struct Page *page = alloc_page();
+static struct Page *
+pgdir_insert_new_page(pde_t *pgdir, struct Page *page, uintptr_t la, pte_t perm) {
 	if (page != NULL) {
 		if (page_insert(pgdir, page, la, perm) != 0) {
 			free_page(page);
 			return NULL;
 		}
+		page_set_rmap(page, pgdir, la);
 		if (swap_init_ok) {
 			if (check_mm_struct != NULL) {
 				swap_map_swappable(check_mm_struct, la, page, 0);
@@ -454,15 +1213,46 @@ struct Page *
 	return page;
 }
 
+struct Page *
+	pgdir_alloc_page(pde_t *pgdir, uintptr_t la, pte_t perm) {
+	return pgdir_insert_new_page(pgdir, alloc_user_page(), la, perm);
+}
+
+//pgdir_alloc_zeroed_page - like pgdir_alloc_page, but the new page is cleared
+struct Page *
+	pgdir_alloc_zeroed_page(pde_t *pgdir, uintptr_t la, pte_t perm) {
+	return pgdir_insert_new_page(pgdir, alloc_zeroed_user_page(), la, perm);
+}
+
 void
 check_alloc_page(void) {
+	bool cache_enabled = page_cache_suspend();
 	pmm_manager->check();
+	page_cache_resume(cache_enabled);
 	cprintf("check_alloc_page() succeeded!\n");
 }
 
+//pmm_report - print the free memory state of the pmm_manager and the page caches
+void
+pmm_report(void) {
+	bool intr_flag;
+	local_intr_save(intr_flag);
+	{
+		cprintf("memory management: %s, %u free pages\n", pmm_manager->name, nr_free_pages());
+		cprintf("  order-0 cache: %u pages, zero pool: %u pages, highmem: %u pages\n",
+			pcp.count, zero_pool_nr, nr_highmem_free);
+		cprintf("  compaction: %u runs, %u succeeded, %u pages migrated\n",
+			compact_stats.runs, compact_stats.successes, compact_stats.pages_migrated);
+		if (pmm_manager->report != NULL) {
+			pmm_manager->report();
+		}
+	}
+	local_intr_restore(intr_flag);
+}
+
 void
 check_pgdir(void) {
-	assert(npage <= KMEMSIZE / PGSIZE);
+	assert(max_low_pfn <= KMEMSIZE / PGSIZE);
 	assert(boot_pgdir != NULL && (uint32_t)PGOFF(boot_pgdir) == 0);
 	assert(get_page(boot_pgdir, 0x0, NULL) == NULL);
 
@@ -475,7 +1265,7 @@ check_pgdir(void) {
 	assert(pte2page(*ptep) == p1);
 	assert(page_ref(p1) == 1);
 
-	ptep = &((pte_t *)KADDR(PDE_ADDR(boot_pgdir[0])))[1];
+	ptep = &((pte_t *)KADDR(PDE_ADDR(*pgdir_pde(boot_pgdir, 0))))[1];
 	assert(get_pte(boot_pgdir, PGSIZE, 0) == ptep);
 
 	p2 = alloc_page();
@@ -483,7 +1273,7 @@ check_pgdir(void) {
 	assert((ptep = get_pte(boot_pgdir, PGSIZE, 0)) != NULL);
 	assert(*ptep & PTE_U);
 	assert(*ptep & PTE_W);
-	assert(boot_pgdir[0] & PTE_U);
+	assert(*pgdir_pde(boot_pgdir, 0) & PTE_U);
 	assert(page_ref(p2) == 1);
 
 	assert(page_insert(boot_pgdir, p1, PGSIZE, 0) == 0);
@@ -501,9 +1291,9 @@ check_pgdir(void) {
 	assert(page_ref(p1) == 0);
 	assert(page_ref(p2) == 0);
 
-	assert(page_ref(pde2page(boot_pgdir[0])) == 1);
-	free_page(pde2page(boot_pgdir[0]));
-	boot_pgdir[0] = 0;
+	assert(page_ref(pde2page(*pgdir_pde(boot_pgdir, 0))) == 1);
+	free_page(pde2page(*pgdir_pde(boot_pgdir, 0)));
+	*pgdir_pde(boot_pgdir, 0) = 0;
 
 	cprintf("check_pgdir() succeeded!\n");
 }
@@ -517,9 +1307,9 @@ check_boot_pgdir(void) {
 		assert(PTE_ADDR(*ptep) == i);
 	}
 
-	assert(PDE_ADDR(boot_pgdir[PDX(VPT)]) == PADDR(boot_pgdir));
+	assert(PDE_ADDR(*pgdir_pde(boot_pgdir, VPT)) == PADDR(pgdir_pde(boot_pgdir, 0)));
 
-	assert(boot_pgdir[0] == 0);
+	assert(*pgdir_pde(boot_pgdir, 0) == 0);
 
 	struct Page *p;
 	p = alloc_page();
@@ -536,8 +1326,8 @@ check_boot_pgdir(void) {
 	assert(strlen((const char *)0x100) == 0);
 
 	free_page(p);
-	free_page(pde2page(boot_pgdir[0]));
-	boot_pgdir[0] = 0;
+	free_page(pde2page(*pgdir_pde(boot_pgdir, 0)));
+	*pgdir_pde(boot_pgdir, 0) = 0;
 
 	tlb_invalidate(boot_pgdir, 0x100);
 	tlb_invalidate(boot_pgdir, 0x100 + PGSIZE);
@@ -557,7 +1347,7 @@ perm2str(int perm) {
 }
 
 static int
-get_pgtable_items(size_t left, size_t right, size_t start, uintptr_t *table, size_t *left_store, size_t *right_store) {
+get_pgtable_items(size_t left, size_t right, size_t start, pte_t *table, size_t *left_store, size_t *right_store) {
 	if (start >= right) {
 		return 0;
 	}
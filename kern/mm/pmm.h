@@ -17,11 +17,33 @@ struct pmm_manager {
 	void(*free_pages)(struct Page *base, size_t n);  // free >=n pages with "base" addr of Page descriptor structures(memlayout.h)
 	size_t(*nr_free_pages)(void);                    // return the number of free pages 
 	void(*check)(void);                              // check the correctness of XXX_pmm_manager 
+	void(*report)(void);                             // optional, print free memory layout / fragmentation
+	bool deferred_memmap;                            // init_memmap may be called again later to add memory
 };
 
 extern const struct pmm_manager *pmm_manager;
 extern pde_t *boot_pgdir;
 extern uintptr_t boot_cr3;
+extern struct vdso_data *vdso_data;     // kernel view of the page mapped at VDSO_BASE
+
+/* *
+ * A page directory, as in mm->pgdir, points to what cr3 points to (pgdir_cr3).
+ * Without CONFIG_PAE that is the page directory page itself. With CONFIG_PAE
+ * it is the PDPT, a small kmalloc object listing the four page directories,
+ * which are pages of their own: pgdir_alloc takes PGDIR_PAGES single pages,
+ * so a fork never needs a contiguous run. Reach the entry of la through
+ * pgdir_pde.
+ * */
+#ifdef CONFIG_PAE
+#define PGDIR_PAGES             NPDPENTRY
+extern pte_t pte_nx;            // PTE_NX when the CPU supports no-execute pages, else 0
+#else
+#define PGDIR_PAGES             1
+#define pte_nx                  0
+#endif
+
+pde_t *pgdir_alloc(void);
+void pgdir_free(pde_t *pgdir);
 
 void pmm_init(void);
 
@@ -32,18 +54,80 @@ size_t nr_free_pages(void);
 #define alloc_page() alloc_pages(1)
 #define free_page(page) free_pages(page, 1)
 
+#define PCP_HIGH                64      // order-0 cache size that triggers a drain
+#define PCP_BATCH               16      // pages moved per refill/drain of the order-0 cache
+
+bool page_cache_suspend(void);
+void page_cache_resume(bool enabled);
+
+#define PAGE_INIT_BOOT_PAGES    8192    // struct Pages initialised during boot (32MB)
+#define PAGE_INIT_CHUNK         1024    // struct Pages initialised per deferred step
+
+extern size_t page_init_pfn;
+bool page_init_step(void);
+
+#define ZERO_POOL_MAX           64      // pre-zeroed pages kept by the idle process
+#define ZERO_POOL_RESERVE       256     // never grow the pool below this many free pages
+
+struct Page *alloc_zeroed_page(void);
+bool zero_pool_refill(void);
+size_t zero_pool_drain(void);
+
+/* *
+ * HighMem. Frames above KMEMSIZE have no permanent kernel mapping. They are kept
+ * on their own free list, outside pmm_manager, and only handed out for user pages
+ * (alloc_user_page); the kernel reaches their content through kmap/kunmap.
+ * */
+#define KMAP_SLOTS              (KMAPSIZE / PGSIZE)
+#define KMAP_IRQ_SLOT           (KMAP_SLOTS - 1)       // kept for kmap_irq
+
+extern size_t max_low_pfn;
+
+struct Page *alloc_user_page(void);
+struct Page *alloc_zeroed_user_page(void);
+void *kmap(struct Page *page);
+void *kmap_irq(struct Page *page);
+void kunmap(void *kva);
+
 pte_t *get_pte(pde_t *pgdir, uintptr_t la, bool create);
 struct Page *get_page(pde_t *pgdir, uintptr_t la, pte_t **ptep_store);
 void page_remove(pde_t *pgdir, uintptr_t la);
-int page_insert(pde_t *pgdir, struct Page *page, uintptr_t la, uint32_t perm);
+int page_insert(pde_t *pgdir, struct Page *page, uintptr_t la, pte_t perm);
+
+/* *
+ * tlb_gather - collects the translations and pages dropped by a range unmap so
+ * the TLB is flushed once per batch and the pages go back to the pmm together.
+ * A page is only freed after the flush that removes its last translation.
+ * */
+#define TLB_GATHER_PAGES        32      // pages held back before a forced flush
+#define TLB_FLUSH_ALL_THRESHOLD 16      // above this many addresses, reload cr3 instead of invlpg
+
+struct tlb_gather {
+	pde_t *pgdir;                               // page directory the entries were removed from
+	bool cold;                                  // pages are cold, queue them behind the hot ones
+	bool flush_all;                             // too many addresses (or a page table) -> reload cr3
+	size_t nr_addrs;
+	uintptr_t addrs[TLB_FLUSH_ALL_THRESHOLD];   // linear addresses to invlpg
+	size_t nr_pages;
+	struct Page *pages[TLB_GATHER_PAGES];       // pages to free after the flush
+};
+
+void tlb_gather_init(struct tlb_gather *tlb, pde_t *pgdir);
+void tlb_gather_page(struct tlb_gather *tlb, uintptr_t la, struct Page *page);
+void tlb_gather_flush(struct tlb_gather *tlb);
+void tlb_unmap_range(struct tlb_gather *tlb, uintptr_t start, uintptr_t end);
+void tlb_exit_range(struct tlb_gather *tlb, uintptr_t start, uintptr_t end);
 
 void load_esp0(uintptr_t esp0);
+void load_tls(uintptr_t base);
 void tlb_invalidate(pde_t *pgdir, uintptr_t la);
-struct Page *pgdir_alloc_page(pde_t *pgdir, uintptr_t la, uint32_t perm);
+struct Page *pgdir_alloc_page(pde_t *pgdir, uintptr_t la, pte_t perm);
+struct Page *pgdir_alloc_zeroed_page(pde_t *pgdir, uintptr_t la, pte_t perm);
 void unmap_range(pde_t *pgdir, uintptr_t start, uintptr_t end);
 void exit_range(pde_t *pgdir, uintptr_t start, uintptr_t end);
 int copy_range(pde_t *to, pde_t *from, uintptr_t start, uintptr_t end, bool share);
 void check_alloc_page(void);
+void pmm_report(void);
 void check_pgdir(void);
 void print_pgdir(void);
 
@@ -56,12 +140,12 @@ void print_pgdir(void);
         })
 
 #define KADDR(pa) ({                                                    \
-            uintptr_t __m_pa = (pa);                                    \
-            size_t __m_ppn = PPN(__m_pa);                               \
-            if (__m_ppn >= npage) {                                     \
-                panic("KADDR called with invalid pa %08lx", __m_pa);    \
+            paddr_t __m_pa = (pa);                                      \
+            if ((__m_pa >> PGSHIFT) >= max_low_pfn) {                   \
+                panic("KADDR called with invalid pa %08llx",            \
+                      (uint64_t)__m_pa);                                \
             }                                                           \
-            (void *) (__m_pa + KERNBASE);                               \
+            (void *) ((uintptr_t)__m_pa + KERNBASE);                    \
         })
 
 extern struct Page *pages;
@@ -73,17 +157,17 @@ page2ppn(struct Page *page) {
 	return page - pages;
 }
 
-static inline uintptr_t
+static inline paddr_t
 page2pa(struct Page *page) {
-	return page2ppn(page) << PGSHIFT;
+	return (paddr_t)page2ppn(page) << PGSHIFT;
 }
 
 static inline struct Page *
-pa2page(uintptr_t pa) {
-	if (PPN(pa) >= npage) {
+pa2page(paddr_t pa) {
+	if ((pa >> PGSHIFT) >= npage) {
 		panic("pa2page called with invalid pa");
 	}
-	return &pages[PPN(pa)];
+	return &pages[pa >> PGSHIFT];
 }
 
 static inline void *
@@ -96,6 +180,22 @@ kva2page(void *kva) {
 	return pa2page(PADDR(kva));
 }
 
+//pgdir_cr3 - the cr3 value that selects pgdir
+static inline uintptr_t
+pgdir_cr3(pde_t *pgdir) {
+	return PADDR(pgdir);
+}
+
+//pgdir_pde - the page directory entry of pgdir that maps la
+static inline pde_t *
+pgdir_pde(pde_t *pgdir, uintptr_t la) {
+#ifdef CONFIG_PAE
+	return &((pde_t *)KADDR(PDE_ADDR(pgdir[PDPX(la)])))[PDX(la) % NPTEENTRY];
+#else
+	return &pgdir[PDX(la)];
+#endif
+}
+
 static inline struct Page *
 pte2page(pte_t pte) {
 	if (!(pte & PTE_P)) {
@@ -109,6 +209,13 @@ pde2page(pde_t pde) {
 	return pa2page(PDE_ADDR(pde));
 }
 
+//page_set_rmap - record the user mapping of page, so compaction can migrate it
+static inline void
+page_set_rmap(struct Page *page, pde_t *pgdir, uintptr_t la) {
+	page->map_pgdir = pgdir;
+	page->pra_vaddr = la;
+}
+
 static inline int
 page_ref(struct Page *page) {
 	return page->ref;
@@ -65,6 +65,7 @@ swap_tick_event(struct mm_struct *mm)
 int
 swap_map_swappable(struct mm_struct *mm, uintptr_t addr, struct Page *page, int swap_in)
 {
+	SetPageSwap(page);
 	return sm->map_swappable(mm, addr, page, swap_in);
 }
 
@@ -80,6 +81,10 @@ int
 swap_out(struct mm_struct *mm, int n, int in_tick)
 {
 	int i;
+	struct tlb_gather tlb;
+	tlb_gather_init(&tlb, mm->pgdir);
+	// victims are the least recently used pages
+	tlb.cold = 1;
 	for (i = 0; i != n; ++i)
 	{
 		uintptr_t v;
@@ -92,6 +97,7 @@ swap_out(struct mm_struct *mm, int n, int in_tick)
 			break;
 		}
 		//assert(!PageReserved(page));
+		ClearPageSwap(page);
 
 		//cprintf("SWAP: choose victim page 0x%08x\n", page);
 
@@ -99,26 +105,25 @@ swap_out(struct mm_struct *mm, int n, int in_tick)
 		pte_t *ptep = get_pte(mm->pgdir, v, 0);
 		assert((*ptep & PTE_P) != 0);
 
-		if (swapfs_write((page->pra_vaddr / PGSIZE + 1) << 8, page) != 0) {
+		if (swapfs_write(swap_entry(page->pra_vaddr / PGSIZE + 1), page) != 0) {
 			cprintf("SWAP: failed to save\n");
-			sm->map_swappable(mm, v, page, 0);
+			swap_map_swappable(mm, v, page, 0);
 			continue;
 		}
 		else {
 			cprintf("swap_out: i %d, store page in vaddr 0x%x to disk swap entry %d\n", i, v, page->pra_vaddr / PGSIZE + 1);
-			*ptep = (page->pra_vaddr / PGSIZE + 1) << 8;
-			free_page(page);
+			*ptep = swap_entry(page->pra_vaddr / PGSIZE + 1);
+			tlb_gather_page(&tlb, v, page);
 		}
-
-		tlb_invalidate(mm->pgdir, v);
 	}
+	tlb_gather_flush(&tlb);
 	return i;
 }
 
 int
 swap_in(struct mm_struct *mm, uintptr_t addr, struct Page **ptr_result)
 {
-	struct Page *result = alloc_page();
+	struct Page *result = alloc_user_page();
 	assert(result != NULL);
 
 	pte_t *ptep = get_pte(mm->pgdir, addr, 0);
@@ -129,7 +134,7 @@ swap_in(struct mm_struct *mm, uintptr_t addr, struct Page **ptr_result)
 	{
 		assert(r != 0);
 	}
-	cprintf("swap_in: load disk swap entry %d with swap_page in vadr 0x%x\n", (*ptep) >> 8, addr);
+	cprintf("swap_in: load disk swap entry %d with swap_page in vadr 0x%x\n", swap_offset(*ptep), addr);
 	*ptr_result = result;
 	return 0;
 }
@@ -177,6 +182,7 @@ void
 check_swap(void)
 {
 	//backup mem env
+	bool cache_enabled = page_cache_suspend();
 	int ret, count = 0, total = 0, i;
 	list_entry_t *le = &free_list;
 	while ((le = list_next(le)) != &free_list) {
@@ -184,7 +190,7 @@ check_swap(void)
 		assert(PageProperty(p));
 		count++, total += p->property;
 	}
-	assert(total == nr_free_pages());
+	assert(total == pmm_manager->nr_free_pages());
 	cprintf("BEGIN check_swap: count %d, total %d\n", count, total);
 
 	//now we set the phy pages env     
@@ -197,7 +203,7 @@ check_swap(void)
 	check_mm_struct = mm;
 
 	pde_t *pgdir = mm->pgdir = boot_pgdir;
-	assert(pgdir[0] == 0);
+	assert(*pgdir_pde(pgdir, 0) == 0);
 
 	struct vma_struct *vma = vma_create(BEING_CHECK_VALID_VADDR, CHECK_VALID_VADDR, VM_WRITE | VM_READ);
 	assert(vma != NULL);
@@ -216,13 +222,13 @@ check_swap(void)
 		assert(check_rp[i] != NULL);
 		assert(!PageProperty(check_rp[i]));
 	}
-	list_entry_t free_list_store = free_list;
+	free_area_t free_area_store = free_area;
 	list_init(&free_list);
 	assert(list_empty(&free_list));
+	free_area.addr_tree = free_area.size_tree = RB_ROOT;
 
 	//assert(alloc_page() == NULL);
 
-	unsigned int nr_free_store = nr_free;
 	nr_free = 0;
 	for (i = 0; i < CHECK_VALID_PHY_PAGE_NUM; i++) {
 		free_pages(check_rp[i], 1);
@@ -259,14 +265,13 @@ check_swap(void)
 	}
 
 	//free_page(pte2page(*temp_ptep));
-	free_page(pde2page(pgdir[0]));
-	pgdir[0] = 0;
+	free_page(pde2page(*pgdir_pde(pgdir, 0)));
+	*pgdir_pde(pgdir, 0) = 0;
 	mm->pgdir = NULL;
 	mm_destroy(mm);
 	check_mm_struct = NULL;
 
-	nr_free = nr_free_store;
-	free_list = free_list_store;
+	free_area = free_area_store;
 
 
 	le = &free_list;
@@ -276,6 +281,7 @@ check_swap(void)
 	}
 	cprintf("count is %d, total is %d\n", count, total);
 	//assert(count == 0);
+	page_cache_resume(cache_enabled);
 
 	cprintf("check_swap() succeeded!\n");
 }
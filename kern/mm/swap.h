@@ -11,10 +11,17 @@
 
 extern size_t max_swap_offset;
 
+/* *
+ * A swapped out page leaves its swap entry in the (not present) pte: the swap
+ * offset above bit 8, PTE_P clear. With CONFIG_PAE the entry is a 64-bit pte.
+ * */
+#define swap_entry(offset)      ((swap_entry_t)(offset) << 8)
+
 #define swap_offset(entry) ({                                       \
-               size_t __offset = (entry >> 8);                        \
+               size_t __offset = (size_t)((entry) >> 8);             \
                if (!(__offset > 0 && __offset < max_swap_offset)) {    \
-                    panic("invalid swap_entry_t = %08x.\n", entry);    \
+                    panic("invalid swap_entry_t = %08llx.\n",         \
+                          (uint64_t)(entry));                       \
                }                                                    \
                __offset;                                            \
           })
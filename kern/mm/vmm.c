@@ -28,6 +28,7 @@ mm_create(void) {
         
         set_mm_count(mm, 0);
         sem_init(&(mm->mm_sem), 1);
+        mm->stack_limit = USTACKSIZE;
     }    
     return mm;
 }
@@ -163,9 +164,54 @@ out:
     return ret;
 }
 
+// get_unmapped_area - find the highest free range of len bytes below the main
+//                   - user stack, return 0 if the address space is full
+uintptr_t
+get_unmapped_area(struct mm_struct *mm, size_t len) {
+    uintptr_t end = USTACKTOP - USTACKSIZE;
+    len = ROUNDUP(len, PGSIZE);
+    list_entry_t *list = &(mm->mmap_list), *le = list;
+    while ((le = list_prev(le)) != list) {
+        struct vma_struct *vma = le2vma(le, list_link);
+        if (vma->vm_start >= end) {
+            continue;
+        }
+        if (vma->vm_end + len <= end) {
+            break;
+        }
+        end = vma->vm_start;
+    }
+    if (end < USERBASE + len) {
+        return 0;
+    }
+    return end - len;
+}
+
+// mm_map_stack - reserve a VM_STACK area of len bytes with a no-access guard
+//              - area below it; pages are only faulted in when first touched
+int
+mm_map_stack(struct mm_struct *mm, size_t len, uintptr_t *top_store) {
+    uintptr_t base;
+    len = ROUNDUP(len, PGSIZE);
+    if ((base = get_unmapped_area(mm, len + USTACKGUARD)) == 0) {
+        return -E_NO_MEM;
+    }
+    int ret;
+    if ((ret = mm_map(mm, base, USTACKGUARD, 0, NULL)) != 0) {
+        return ret;
+    }
+    if ((ret = mm_map(mm, base + USTACKGUARD, len, VM_READ | VM_WRITE | VM_STACK, NULL)) != 0) {
+        mm_unmap(mm, base, USTACKGUARD);
+        return ret;
+    }
+    *top_store = base + USTACKGUARD + len;
+    return 0;
+}
+
 int
 dup_mmap(struct mm_struct *to, struct mm_struct *from) {
     assert(to != NULL && from != NULL);
+    to->stack_limit = from->stack_limit;
     list_entry_t *list = &(from->mmap_list), *le = list;
     while ((le = list_prev(le)) != list) {
         struct vma_struct *vma, *nvma;
@@ -188,16 +234,18 @@ dup_mmap(struct mm_struct *to, struct mm_struct *from) {
 void
 exit_mmap(struct mm_struct *mm) {
     assert(mm != NULL && mm_count(mm) == 0);
-    pde_t *pgdir = mm->pgdir;
+    struct tlb_gather tlb;
+    tlb_gather_init(&tlb, mm->pgdir);
     list_entry_t *list = &(mm->mmap_list), *le = list;
     while ((le = list_next(le)) != list) {
         struct vma_struct *vma = le2vma(le, list_link);
-        unmap_range(pgdir, vma->vm_start, vma->vm_end);
+        tlb_unmap_range(&tlb, vma->vm_start, vma->vm_end);
     }
     while ((le = list_next(le)) != list) {
         struct vma_struct *vma = le2vma(le, list_link);
-        exit_range(pgdir, vma->vm_start, vma->vm_end);
+        tlb_exit_range(&tlb, vma->vm_start, vma->vm_end);
     }
+    tlb_gather_flush(&tlb);
 }
 
 bool
@@ -314,7 +362,7 @@ check_pgfault(void) {
 
     struct mm_struct *mm = check_mm_struct;
     pde_t *pgdir = mm->pgdir = boot_pgdir;
-    assert(pgdir[0] == 0);
+    assert(*pgdir_pde(pgdir, 0) == 0);
 
     struct vma_struct *vma = vma_create(0, PTSIZE, VM_WRITE);
     assert(vma != NULL);
@@ -335,8 +383,8 @@ check_pgfault(void) {
     assert(sum == 0);
 
     page_remove(pgdir, ROUNDDOWN(addr, PGSIZE));
-    free_page(pde2page(pgdir[0]));
-    pgdir[0] = 0;
+    free_page(pde2page(*pgdir_pde(pgdir, 0)));
+    *pgdir_pde(pgdir, 0) = 0;
 
     mm->pgdir = NULL;
     mm_destroy(mm);
@@ -349,6 +397,44 @@ check_pgfault(void) {
 //page fault number
 volatile unsigned int pgfault_num=0;
 
+// stack_vma - addr is below every vma containing it: return the vma right above
+//           - it if that is a VM_STACK area that may grow down to cover addr, staying
+//           - within mm->stack_limit and a guard gap from the vma below. Nothing changes.
+static struct vma_struct *
+stack_vma(struct mm_struct *mm, uintptr_t addr) {
+    list_entry_t *list = &(mm->mmap_list), *le = list;
+    struct vma_struct *vma = NULL, *prev = NULL;
+    while ((le = list_next(le)) != list) {
+        vma = le2vma(le, list_link);
+        if (vma->vm_start > addr) {
+            break;
+        }
+        prev = vma;
+    }
+    if (le == list || !(vma->vm_flags & VM_STACK)) {
+        return NULL;
+    }
+    uintptr_t start = ROUNDDOWN(addr, PGSIZE);
+    if (start < USERBASE || vma->vm_end - start > mm->stack_limit) {
+        return NULL;
+    }
+    if (prev != NULL && prev->vm_end + USTACKGUARD > start) {
+        return NULL;
+    }
+    return vma;
+}
+
+// stack_grow - extend the stack_vma of addr down to cover addr, only on a page fault.
+//            - The pages themselves are still faulted in one at a time.
+static struct vma_struct *
+stack_grow(struct mm_struct *mm, uintptr_t addr) {
+    struct vma_struct *vma;
+    if ((vma = stack_vma(mm, addr)) != NULL) {
+        vma->vm_start = ROUNDDOWN(addr, PGSIZE);
+    }
+    return vma;
+}
+
 int
 do_pgfault(struct mm_struct *mm, uint32_t error_code, uintptr_t addr) {
     int ret = -E_INVAL;
@@ -357,8 +443,8 @@ do_pgfault(struct mm_struct *mm, uint32_t error_code, uintptr_t addr) {
     struct vma_struct *vma = find_vma(mm, addr);
 
     pgfault_num++;
-    //If the addr is in the range of a mm's vma?
-    if (vma == NULL || vma->vm_start > addr) {
+    //If the addr is in the range of a mm's vma, or just below a stack that may grow?
+    if ((vma == NULL || vma->vm_start > addr) && (vma = stack_grow(mm, addr)) == NULL) {
         // cprintf("not valid addr %x, and can not find it in vma, %x\n", addr, vma);
         goto failed;
     }
@@ -387,10 +473,13 @@ do_pgfault(struct mm_struct *mm, uint32_t error_code, uintptr_t addr) {
      * THEN
      *    continue process
      */
-    uint32_t perm = PTE_U;
+    pte_t perm = PTE_U;
     if (vma->vm_flags & VM_WRITE) {
         perm |= PTE_W;
     }
+    if (!(vma->vm_flags & VM_EXEC)) {
+        perm |= pte_nx;
+    }
     addr = ROUNDDOWN(addr, PGSIZE);
 
     ret = -E_NO_MEM;
@@ -424,8 +513,8 @@ do_pgfault(struct mm_struct *mm, uint32_t error_code, uintptr_t addr) {
     }
     
     if (*ptep == 0) { // if the phy addr isn't exist, then alloc a page & map the phy addr with logical addr
-        if (pgdir_alloc_page(mm->pgdir, addr, perm) == NULL) {
-            cprintf("pgdir_alloc_page in do_pgfault failed\n");
+        if (pgdir_alloc_zeroed_page(mm->pgdir, addr, perm) == NULL) {
+            cprintf("pgdir_alloc_zeroed_page in do_pgfault failed\n");
             goto failed;
         }
     }
@@ -450,7 +539,7 @@ do_pgfault(struct mm_struct *mm, uint32_t error_code, uintptr_t addr) {
        } 
        page_insert(mm->pgdir, page, addr, perm);
        swap_map_swappable(mm, addr, page, 1);
-       page->pra_vaddr = addr;
+       page_set_rmap(page, mm->pgdir, addr);
    }
    ret = 0;
 failed:
@@ -470,7 +559,8 @@ user_mem_check(struct mm_struct *mm, uintptr_t addr, size_t len, bool write) {
         uintptr_t start = addr, end = addr + len;
         while (start < end) {
             //cprintf("Finding %x %x.\n", mm, start);
-            if ((vma = find_vma(mm, start)) == NULL || start < vma->vm_start) {
+            if (((vma = find_vma(mm, start)) == NULL || start < vma->vm_start)
+                && (vma = stack_vma(mm, start)) == NULL) {
                 //cprintf("No space in vma\n");
                 return 0;
             }
@@ -478,12 +568,6 @@ user_mem_check(struct mm_struct *mm, uintptr_t addr, size_t len, bool write) {
                 //cprintf("VM access fault\n");
                 return 0;
             }
-            if (write && (vma->vm_flags & VM_STACK)) {
-                if (start < vma->vm_start + PGSIZE) { //check stack start & size
-                    //cprintf("Not enough space\n");
-                    return 0;
-                }
-            }
             start = vma->vm_end;
         }
         return 1;
@@ -558,6 +642,8 @@ int mm_unmap(struct mm_struct *mm, uintptr_t addr, size_t len)
 		vma = le2vma(le, list_link);
 	}
 
+	struct tlb_gather tlb;
+	tlb_gather_init(&tlb, mm->pgdir);
 	le = list_next(&free_list);
 	while (le != &free_list) {
 		vma = le2vma(le, list_link);
@@ -580,8 +666,9 @@ int mm_unmap(struct mm_struct *mm, uintptr_t addr, size_t len)
 				vma_destroy(vma);
 			}
 		}
-		unmap_range(mm->pgdir, un_start, un_end);
+		tlb_unmap_range(&tlb, un_start, un_end);
 	}
+	tlb_gather_flush(&tlb);
 	return 0;
 }
 
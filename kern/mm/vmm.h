@@ -38,6 +38,7 @@ struct mm_struct {
     int mm_count;                  // the number ofprocess which shared the mm
     semaphore_t mm_sem;            // mutex for using dup_mmap fun to duplicat the mm 
     int locked_by;                 // the lock owner process's pid
+    size_t stack_limit;            // how far the VM_STACK area below USTACKTOP may grow
 	uintptr_t brk_start, brk;
 };
 
@@ -61,6 +62,7 @@ int mm_unmap(struct mm_struct *mm, uintptr_t addr, size_t len);
 int dup_mmap(struct mm_struct *to, struct mm_struct *from);
 void exit_mmap(struct mm_struct *mm);
 uintptr_t get_unmapped_area(struct mm_struct *mm, size_t len);
+int mm_map_stack(struct mm_struct *mm, size_t len, uintptr_t *top_store);
 int mm_brk(struct mm_struct *mm, uintptr_t addr, size_t len);
 
 extern volatile unsigned int pgfault_num;
@@ -15,6 +15,10 @@
 #include <fs.h>
 #include <vfs.h>
 #include <sysfile.h>
+#include <compact.h>
+#include <tls.h>
+#include <clock.h>
+#include <syscall.h>
 
 /* ------------- process/thread mechanism design&implementation -------------
 (an simplified Linux process/thread mechanism )
@@ -65,13 +69,20 @@ SYS_getpid      : get the process's pid
 // the process set's list
 list_entry_t proc_list;
 
-#define HASH_SHIFT          10
-#define HASH_LIST_SIZE      (1 << HASH_SHIFT)
-#define pid_hashfn(x)       (hash32(x, HASH_SHIFT))
-
-
-// has list for process set based on pid
-static list_entry_t hash_list[HASH_LIST_SIZE];
+/* *
+ * pid allocation and lookup
+ * pid_map has one bit per pid (set = in use), pid_map_full has one bit per
+ * pid_map word (set = all 32 pids of that word are in use). get_pid walks the
+ * summary to the first word with a free bit, so allocating a pid costs at most
+ * MAX_PID / 32 / 32 summary words plus one bsf, independent of nr_process.
+ * pid_table maps a pid straight to its proc_struct for find_proc.
+ * */
+#define PID_MAP_WORDS       (MAX_PID / 32)
+#define PID_FULL_WORDS      (PID_MAP_WORDS / 32)
+
+static uint32_t pid_map[PID_MAP_WORDS];
+static uint32_t pid_map_full[PID_FULL_WORDS];
+static struct proc_struct *pid_table[MAX_PID];
 
 // idle proc
 struct proc_struct *idleproc = NULL;
@@ -86,10 +97,46 @@ void kernel_thread_entry(void);
 void forkrets(struct trapframe *tf);
 void switch_to(struct context *from, struct context *to);
 
+/* *
+ * Process shells. Fork-heavy workloads spend much of do_fork and do_wait building
+ * and tearing down the same objects, so a reaped process is kept as a shell: its
+ * proc_struct and kernel stack, plus the page directory and fd table it gave up in
+ * do_exit (spare_pgdir / spare_filesp, already cleaned). alloc_proc, setup_kstack,
+ * setup_pgdir and copy_fs take from the shell before allocating anything. At most
+ * PROC_SHELL_MAX shells are cached; proc_shell_drain frees them when memory runs
+ * short and before init_main checks for leaks.
+ * */
+static list_entry_t proc_shells = { &proc_shells, &proc_shells };  // linked by list_link
+static size_t nr_proc_shells = 0;
+
+// proc_shell_get - take a cached shell, NULL if there is none
+static struct proc_struct *
+proc_shell_get(void) {
+    struct proc_struct *proc = NULL;
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    {
+        if (!list_empty(&proc_shells)) {
+            list_entry_t *le = list_next(&proc_shells);
+            list_del(le);
+            nr_proc_shells --;
+            proc = le2proc(le, list_link);
+        }
+    }
+    local_intr_restore(intr_flag);
+    return proc;
+}
+
 // alloc_proc - alloc a proc_struct and init all fields of proc_struct
 static struct proc_struct *
 alloc_proc(void) {
-    struct proc_struct *proc = kmalloc(sizeof(struct proc_struct));
+    // a recycled shell keeps its kernel stack and spare pgdir / fd table
+    struct proc_struct *proc = proc_shell_get();
+    if (proc == NULL && (proc = kmalloc(sizeof(struct proc_struct))) != NULL) {
+        proc->kstack = 0;
+        proc->spare_pgdir = NULL;
+        proc->spare_filesp = NULL;
+    }
     if (proc != NULL) {
     //LAB4:EXERCISE1 YOUR CODE
     /*
@@ -117,7 +164,6 @@ alloc_proc(void) {
         proc->state = PROC_UNINIT;
         proc->pid = -1;
         proc->runs = 0;
-        proc->kstack = 0;
         proc->need_resched = 0;
         proc->parent = NULL;
         proc->mm = NULL;
@@ -137,10 +183,13 @@ alloc_proc(void) {
         proc->cfs_prior = 19;
         proc->vruntime = 0;
         proc->is_thread = 0;
-        for (int i = 0; i < MAX_THREAD; i++)
-            proc->stack[i] = 0;
-        proc->stack_num = 0;
-        proc->stack[0] = 1; //0号栈是主线程用的，不能被占用,这里不是主线程的pid也没事
+        proc->ustack_base = 0;
+        proc->ustack_size = 0;
+        proc->tls_base = 0;
+        proc->tgroup = NULL;
+        list_init(&(proc->tg_link));
+        proc->uring = NULL;
+        proc->sysprof = NULL;
     }
     return proc;
 }
@@ -188,39 +237,59 @@ remove_links(struct proc_struct *proc) {
     nr_process --;
 }
 
-// get_pid - alloc a unique pid for process
+// pid_map_find - find the first free pid >= start, return -1 if there is none
 static int
-get_pid(void) {
-    static_assert(MAX_PID > MAX_PROCESS);
-    struct proc_struct *proc;
-    list_entry_t *list = &proc_list, *le;
-    static int next_safe = MAX_PID, last_pid = MAX_PID;
-    if (++ last_pid >= MAX_PID) {
-        last_pid = 1;
-        goto inside;
-    }
-    if (last_pid >= next_safe) {
-    inside:
-        next_safe = MAX_PID;
-    repeat:
-        le = list;
-        while ((le = list_next(le)) != list) {
-            proc = le2proc(le, list_link);
-            if (proc->pid == last_pid) {
-                if (++ last_pid >= next_safe) {
-                    if (last_pid >= MAX_PID) {
-                        last_pid = 1;
-                    }
-                    next_safe = MAX_PID;
-                    goto repeat;
-                }
-            }
-            else if (proc->pid > last_pid && next_safe > proc->pid) {
-                next_safe = proc->pid;
-            }
+pid_map_find(int start) {
+    if (start >= MAX_PID) {
+        return -1;
+    }
+    int w = start / 32, s;
+    uint32_t free = ~pid_map[w] & (~0U << (start % 32));
+    if (free != 0) {
+        return w * 32 + __builtin_ctz(free);
+    }
+    for (w ++; w < PID_MAP_WORDS; w = (s + 1) * 32) {
+        s = w / 32;
+        uint32_t notfull = ~pid_map_full[s] & (~0U << (w % 32));
+        if (notfull != 0) {
+            w = s * 32 + __builtin_ctz(notfull);
+            return w * 32 + __builtin_ctz(~pid_map[w]);
         }
     }
-    return last_pid;
+    return -1;
+}
+
+// pid_map_set - mark pid as used
+static void
+pid_map_set(int pid) {
+    int w = pid / 32;
+    pid_map[w] |= (1U << (pid % 32));
+    if (pid_map[w] == ~0U) {
+        pid_map_full[w / 32] |= (1U << (w % 32));
+    }
+}
+
+// pid_map_clear - mark pid as free
+static void
+pid_map_clear(int pid) {
+    int w = pid / 32;
+    pid_map[w] &= ~(1U << (pid % 32));
+    pid_map_full[w / 32] &= ~(1U << (w % 32));
+}
+
+// get_pid - alloc a unique pid for process, next-fit from the last pid handed out
+static int
+get_pid(void) {
+    static_assert(MAX_PID > MAX_PROCESS);
+    static_assert(MAX_PID % (32 * 32) == 0);
+    static int last_pid = 0;
+    int pid;
+    if ((pid = pid_map_find(last_pid + 1)) < 0) {
+        pid = pid_map_find(1);
+    }
+    assert(pid > 0);
+    pid_map_set(pid);
+    return (last_pid = pid);
 }
 
 // proc_run - make process "proc" running on cpu
@@ -234,7 +303,12 @@ proc_run(struct proc_struct *proc) {
         {
             current = proc;
             load_esp0(next->kstack + KSTACKSIZE);
-            lcr3(next->cr3);
+            load_tls(next->tls_base);
+            // CLONE_VM siblings (threads from do_clone, kernel threads) share the page
+            // directory, so skip the cr3 reload and keep their TLB entries alive
+            if (next->cr3 != prev->cr3) {
+                lcr3(next->cr3);
+            }
             switch_to(&(prev->context), &(next->context));
         }
         local_intr_restore(intr_flag);
@@ -246,36 +320,113 @@ proc_run(struct proc_struct *proc) {
 //       after switch_to, the current proc will execute here.
 static void
 forkret(void) {
+    // a forked child carries a copy of its parent's TLS block and a new
+    // thread a fresh one; both get their own pid here, in their own mm
+    if (current->tls_base != 0) {
+        *(int *)(current->tls_base + TLS_PID) = current->pid;
+    }
     forkrets(current->tf);
 }
 
-// hash_proc - add proc into proc hash_list
+// hash_proc - add proc into pid_table, its pid comes from get_pid
 static void
 hash_proc(struct proc_struct *proc) {
-    list_add(hash_list + pid_hashfn(proc->pid), &(proc->hash_link));
+    assert(pid_table[proc->pid] == NULL);
+    pid_table[proc->pid] = proc;
 }
 
-// unhash_proc - delete proc from proc hash_list
+// unhash_proc - delete proc from pid_table and release its pid
 static void
 unhash_proc(struct proc_struct *proc) {
-    list_del(&(proc->hash_link));
+    assert(pid_table[proc->pid] == proc);
+    pid_table[proc->pid] = NULL;
+    pid_map_clear(proc->pid);
 }
 
-// find_proc - find proc frome proc hash_list according to pid
+// find_proc - find proc from pid_table according to pid
 struct proc_struct *
 find_proc(int pid) {
     if (0 < pid && pid < MAX_PID) {
-        list_entry_t *list = hash_list + pid_hashfn(pid), *le = list;
-        while ((le = list_next(le)) != list) {
-            struct proc_struct *proc = le2proc(le, hash_link);
-            if (proc->pid == pid) {
-                return proc;
-            }
-        }
+        return pid_table[pid];
     }
     return NULL;
 }
 
+/* *
+ * thread groups
+ * A process gets a thread_group when it creates its first thread; the group
+ * keeps every member (zombies included) on thread_list, so group kill and
+ * group wait never scan proc_list or parent chains. It is freed when the
+ * last member is reaped by do_wait.
+ * */
+struct thread_group {
+    int tgid;                                   // pid of the main thread
+    struct proc_struct *leader;                 // the main thread
+    list_entry_t thread_list;                   // members, linked by proc->tg_link
+    int nr_members;                             // entries on thread_list
+    int nr_live;                                // members that have not run do_exit yet
+    bool exiting;                               // the group has been killed
+    int exit_code;                              // exit status shared by all members once killed
+    wait_queue_t exit_wait;                     // leader waits here in thread_group_wait
+};
+
+// thread_group_join - add proc to tg, called with interrupts disabled
+static void
+thread_group_join(struct thread_group *tg, struct proc_struct *proc) {
+    list_add_before(&(tg->thread_list), &(proc->tg_link));
+    tg->nr_members ++, tg->nr_live ++;
+    proc->tgroup = tg;
+}
+
+// thread_group_get - the thread group of current, created on first use
+static struct thread_group *
+thread_group_get(void) {
+    struct thread_group *tg;
+    if ((tg = current->tgroup) == NULL) {
+        if ((tg = kmalloc(sizeof(struct thread_group))) != NULL) {
+            tg->tgid = current->pid;
+            tg->leader = current;
+            list_init(&(tg->thread_list));
+            tg->nr_members = tg->nr_live = 0;
+            tg->exiting = 0;
+            tg->exit_code = 0;
+            wait_queue_init(&(tg->exit_wait));
+            bool intr_flag;
+            local_intr_save(intr_flag);
+            thread_group_join(tg, current);
+            local_intr_restore(intr_flag);
+        }
+    }
+    return tg;
+}
+
+// thread_group_exit - current stops running, wake the leader if it is waiting for
+//                   - the group to drain; called with interrupts disabled
+static void
+thread_group_exit(struct thread_group *tg) {
+    tg->nr_live --;
+    if (!wait_queue_empty(&(tg->exit_wait))) {
+        wakeup_queue(&(tg->exit_wait), WT_TGROUP, 1);
+    }
+}
+
+// thread_group_leave - proc has been reaped, drop it from its group
+static void
+thread_group_leave(struct proc_struct *proc) {
+    struct thread_group *tg;
+    if ((tg = proc->tgroup) != NULL) {
+        bool intr_flag;
+        local_intr_save(intr_flag);
+        list_del(&(proc->tg_link));
+        tg->nr_members --;
+        local_intr_restore(intr_flag);
+        proc->tgroup = NULL;
+        if (tg->nr_members == 0) {
+            kfree(tg);
+        }
+    }
+}
+
 // kernel_thread - create a kernel thread using "fn" function
 // NOTE: the contents of temp trapframe tf will be copied to 
 //       proc->tf in do_fork-->copy_thread function
@@ -291,9 +442,37 @@ kernel_thread(int (*fn)(void *), void *arg, uint32_t clone_flags) {
     return do_fork(clone_flags | CLONE_VM, 0, &tf);
 }
 
+/* *
+ * kernel_worker - start a kernel thread that shares the mm and the fd table
+ * of current and works on its behalf (see kern/fs/sysuring.c). It is handed
+ * to initproc at once, so the process never waits for it, and it drops the
+ * mm and the files through do_exit like any thread.
+ * */
+int
+kernel_worker(int (*fn)(void *), void *arg) {
+    int pid = kernel_thread(fn, arg, CLONE_FS);
+    if (pid > 0) {
+        struct proc_struct *proc = find_proc(pid);
+        bool intr_flag;
+        local_intr_save(intr_flag);
+        {
+            remove_links(proc);
+            proc->parent = initproc;
+            set_links(proc);
+        }
+        local_intr_restore(intr_flag);
+        // no TLS block of its own; forkret must not write into the process's
+        proc->tls_base = 0;
+    }
+    return pid;
+}
+
 // setup_kstack - alloc pages with size KSTACKPAGE as process kernel stack
 static int
 setup_kstack(struct proc_struct *proc) {
+    if (proc->kstack != 0) {
+        return 0;   // recycled shell
+    }
     struct Page *page = alloc_pages(KSTACKPAGE);
     if (page != NULL) {
         proc->kstack = (uintptr_t)page2kva(page);
@@ -308,24 +487,42 @@ put_kstack(struct proc_struct *proc) {
     free_pages(kva2page((void *)(proc->kstack)), KSTACKPAGE);
 }
 
-// setup_pgdir - alloc one page as PDT
+// setup_pgdir - alloc a new PDT, unless proc has a spare one
 static int
-setup_pgdir(struct mm_struct *mm) {
-    struct Page *page;
-    if ((page = alloc_page()) == NULL) {
+setup_pgdir(struct proc_struct *proc, struct mm_struct *mm) {
+    pde_t *pgdir;
+    if ((pgdir = proc->spare_pgdir) != NULL) {
+        proc->spare_pgdir = NULL;
+    }
+    else if ((pgdir = pgdir_alloc()) == NULL) {
         return -E_NO_MEM;
     }
-    pde_t *pgdir = page2kva(page);
-    memcpy(pgdir, boot_pgdir, PGSIZE);
-    pgdir[PDX(VPT)] = PADDR(pgdir) | PTE_P | PTE_W;
     mm->pgdir = pgdir;
     return 0;
 }
 
-// put_pgdir - free the memory space of PDT
+// pgdir_user_clean - whether no page table is left in the user part of pgdir
+static bool
+pgdir_user_clean(pde_t *pgdir) {
+    uintptr_t la;
+    for (la = 0; la < USERTOP; la += PTSIZE) {
+        if (*pgdir_pde(pgdir, la) != 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// put_pgdir - free the memory space of PDT, or keep it as proc's spare once the
+//           - user part is empty (after exit_mmap); the kernel part never changes
 static void
-put_pgdir(struct mm_struct *mm) {
-    free_page(kva2page(mm->pgdir));
+put_pgdir(struct proc_struct *proc, struct mm_struct *mm) {
+    if (proc->spare_pgdir == NULL && pgdir_user_clean(mm->pgdir)) {
+        proc->spare_pgdir = mm->pgdir;
+    }
+    else {
+        pgdir_free(mm->pgdir);
+    }
 }
 
 // copy_mm - process "proc" duplicate OR share process "current"'s mm according clone_flags
@@ -347,7 +544,7 @@ copy_mm(uint32_t clone_flags, struct proc_struct *proc) {
     if ((mm = mm_create()) == NULL) {
         goto bad_mm;
     }
-    if (setup_pgdir(mm) != 0) {
+    if (setup_pgdir(proc, mm) != 0) {
         goto bad_pgdir_cleanup_mm;
     }
 
@@ -364,11 +561,11 @@ copy_mm(uint32_t clone_flags, struct proc_struct *proc) {
 good_mm:
     mm_count_inc(mm);
     proc->mm = mm;
-    proc->cr3 = PADDR(mm->pgdir);
+    proc->cr3 = pgdir_cr3(mm->pgdir);
     return 0;
 bad_dup_cleanup_mmap:
     exit_mmap(mm);
-    put_pgdir(mm);
+    put_pgdir(proc, mm);
 bad_pgdir_cleanup_mm:
     mm_destroy(mm);
 bad_mm:
@@ -401,7 +598,10 @@ copy_fs(uint32_t clone_flags, struct proc_struct *proc) {
     }
 
     int ret = -E_NO_MEM;
-    if ((filesp = files_create()) == NULL) {
+    if ((filesp = proc->spare_filesp) != NULL) {
+        proc->spare_filesp = NULL;
+    }
+    else if ((filesp = files_create()) == NULL) {
         goto bad_files_struct;
     }
 
@@ -425,9 +625,63 @@ put_fs(struct proc_struct *proc) {
     struct files_struct *filesp = proc->filesp;
     if (filesp != NULL) {
         if (files_count_dec(filesp) == 0) {
-            files_destroy(filesp);
+            if (proc->spare_filesp == NULL) {
+                files_clear(filesp);
+                proc->spare_filesp = filesp;
+            }
+            else {
+                files_destroy(filesp);
+            }
+        }
+    }
+}
+
+// proc_shell_free - free a shell and everything it holds
+static void
+proc_shell_free(struct proc_struct *proc) {
+    if (proc->kstack != 0) {
+        put_kstack(proc);
+    }
+    if (proc->spare_pgdir != NULL) {
+        pgdir_free(proc->spare_pgdir);
+    }
+    if (proc->spare_filesp != NULL) {
+        files_destroy(proc->spare_filesp);
+    }
+    kfree(proc);
+}
+
+// proc_shell_put - cache a reaped (or never started) proc as a shell, or free it
+//                - when the cache is full
+static void
+proc_shell_put(struct proc_struct *proc) {
+    bool intr_flag, cached = 0;
+    if (proc->kstack != 0) {
+        local_intr_save(intr_flag);
+        {
+            if (nr_proc_shells < PROC_SHELL_MAX) {
+                list_add(&proc_shells, &(proc->list_link));
+                nr_proc_shells ++;
+                cached = 1;
+            }
         }
+        local_intr_restore(intr_flag);
+    }
+    if (!cached) {
+        proc_shell_free(proc);
+    }
+}
+
+// proc_shell_drain - free every cached shell, return the number of pages released
+size_t
+proc_shell_drain(void) {
+    struct proc_struct *proc;
+    size_t n = 0;
+    while ((proc = proc_shell_get()) != NULL) {
+        n += KSTACKPAGE + ((proc->spare_pgdir != NULL) ? PGDIR_PAGES : 0);
+        proc_shell_free(proc);
     }
+    return n;
 }
 
 /* do_fork -     parent process for a new child process
@@ -454,7 +708,7 @@ do_fork(uint32_t clone_flags, uintptr_t stack, struct trapframe *tf) {
      *                 if clone_flags & CLONE_VM, then "share" ; else "duplicate"
      *   copy_thread:  setup the trapframe on the  process's kernel stack top and
      *                 setup the kernel entry point and stack of process
-     *   hash_proc:    add proc into proc hash_list
+     *   hash_proc:    add proc into pid_table
      *   get_pid:      alloc a unique pid for process
      *   wakeup_proc:  set proc->state = PROC_RUNNABLE
      * VARIABLES:
@@ -466,7 +720,7 @@ do_fork(uint32_t clone_flags, uintptr_t stack, struct trapframe *tf) {
     //    2. call setup_kstack to allocate a kernel stack for child process
     //    3. call copy_mm to dup OR share mm according clone_flag
     //    4. call copy_thread to setup tf & context in proc_struct
-    //    5. insert proc_struct into hash_list && proc_list
+    //    5. insert proc_struct into pid_table && proc_list
     //    6. call wakeup_proc to make the new child process RUNNABLE
     //    7. set ret vaule using child proc's pid
 
@@ -475,7 +729,7 @@ do_fork(uint32_t clone_flags, uintptr_t stack, struct trapframe *tf) {
     *    set_links:  set the relation links of process.  ALSO SEE: remove_links:  lean the relation links of process 
     *    -------------------
 	*    update step 1: set child proc's parent to current process, make sure current process's wait_state is 0
-	*    update step 5: insert proc_struct into hash_list && proc_list, set the relation links of process
+	*    update step 5: insert proc_struct into pid_table && proc_list, set the relation links of process
     */
     if ((proc = alloc_proc()) == NULL) {
         goto fork_out;
@@ -488,12 +742,14 @@ do_fork(uint32_t clone_flags, uintptr_t stack, struct trapframe *tf) {
         goto bad_fork_cleanup_proc;
     }
     if (copy_fs(clone_flags, proc) != 0) { //for LAB8
-        goto bad_fork_cleanup_kstack;
+        goto bad_fork_cleanup_proc;
     }
     if (copy_mm(clone_flags, proc) != 0) {
         goto bad_fork_cleanup_fs;
     }
     copy_thread(proc, stack, tf);
+    proc->tls_base = current->tls_base;
+    sysprof_fork(proc);
 
     bool intr_flag;
     local_intr_save(intr_flag);
@@ -513,13 +769,25 @@ fork_out:
 
 bad_fork_cleanup_fs:  //for LAB8
     put_fs(proc);
-bad_fork_cleanup_kstack:
-    put_kstack(proc);
 bad_fork_cleanup_proc:
-    kfree(proc);
+    proc_shell_put(proc);
     goto fork_out;
 }
 
+// put_ustack - a thread leaving its mm (exit or exec) gives its stack area back
+//            - to the threads still sharing that mm
+static void
+put_ustack(struct mm_struct *mm) {
+    if (current->ustack_size != 0) {
+        if (mm_count(mm) > 1) {
+            lock_mm(mm);
+            mm_unmap(mm, current->ustack_base, current->ustack_size);
+            unlock_mm(mm);
+        }
+        current->ustack_base = current->ustack_size = 0;
+    }
+}
+
 // do_exit - called by sys_exit
 //   1. call exit_mmap & put_pgdir & mm_destroy to free the almost all memory space of process
 //   2. set process' state as PROC_ZOMBIE, then call wakeup_proc(parent) to ask parent reclaim itself.
@@ -534,26 +802,26 @@ do_exit(int error_code) {
     }
     
     struct mm_struct *mm = current->mm;
+    uring_release(current);
     if (mm != NULL) {
+        put_ustack(mm);
         lcr3(boot_cr3);
+        current->cr3 = boot_cr3;
+        // detach first: a profiler sample must not walk an mm being torn down
+        current->mm = NULL;
         if (mm_count_dec(mm) == 0) {
             exit_mmap(mm);
-            put_pgdir(mm);
+            put_pgdir(current, mm);
             mm_destroy(mm);
         }
-        current->mm = NULL;
     }
     put_fs(current); //for LAB8
+    sysprof_exit(current);
 
-    // 若是一个线程退出，向主进程归还栈空间
-    if (current->is_thread)
-    {
-        struct proc_struct *father = current->parent;
-        while (father->is_thread)
-            father = father->parent;
-        father->stack[current->stack_num] = 0;
+    // a killed thread group reports one exit status for all of its members
+    if (current->tgroup != NULL && current->tgroup->exiting) {
+        error_code = current->tgroup->exit_code;
     }
-
     current->state = PROC_ZOMBIE;
     current->exit_code = error_code;
 
@@ -563,6 +831,9 @@ do_exit(int error_code) {
     struct proc_struct *proc;
     local_intr_save(intr_flag);
     {
+        if (current->tgroup != NULL) {
+            thread_group_exit(current->tgroup);
+        }
         proc = current->parent;
         if (proc->wait_state == WT_CHILD) {
             wakeup_proc(proc);
@@ -643,7 +914,7 @@ load_icode(int fd, int argc, char **kargv) {
     if ((mm = mm_create()) == NULL) {
         goto bad_mm;
     }
-    if (setup_pgdir(mm) != 0) {
+    if (setup_pgdir(current, mm) != 0) {
         goto bad_pgdir_cleanup_mm;
     }
 
@@ -660,7 +931,8 @@ load_icode(int fd, int argc, char **kargv) {
     }
 
     struct proghdr __ph, *ph = &__ph;
-    uint32_t vm_flags, perm, phnum;
+    uint32_t vm_flags, phnum;
+    pte_t perm;
     for (phnum = 0; phnum < elf->e_phnum; phnum ++) {
         off_t phoff = elf->e_phoff + sizeof(struct proghdr) * phnum;
         if ((ret = load_icode_read(fd, ph, sizeof(struct proghdr), phoff)) != 0) {
@@ -681,6 +953,7 @@ load_icode(int fd, int argc, char **kargv) {
         if (ph->p_flags & ELF_PF_W) vm_flags |= VM_WRITE;
         if (ph->p_flags & ELF_PF_R) vm_flags |= VM_READ;
         if (vm_flags & VM_WRITE) perm |= PTE_W;
+        if (!(vm_flags & VM_EXEC)) perm |= pte_nx;
         if ((ret = mm_map(mm, ph->p_va, ph->p_memsz, vm_flags, NULL)) != 0) {
             goto bad_cleanup_mmap;
         }
@@ -700,7 +973,10 @@ load_icode(int fd, int argc, char **kargv) {
             if (end < la) {
                 size -= la - end;
             }
-            if ((ret = load_icode_read(fd, page2kva(page) + off, size, offset)) != 0) {
+            void *kva = kmap(page);
+            ret = load_icode_read(fd, kva + off, size, offset);
+            kunmap(kva);
+            if (ret != 0) {
                 goto bad_cleanup_mmap;
             }
             start += size, offset += size;
@@ -716,12 +992,15 @@ load_icode(int fd, int argc, char **kargv) {
             if (end < la) {
                 size -= la - end;
             }
-            memset(page2kva(page) + off, 0, size);
+            void *kva = kmap(page);
+            memset(kva + off, 0, size);
+            kunmap(kva);
             start += size;
             assert((end < la && start == end) || (end >= la && start == la));
         }
         while (start < end) {
-            if ((page = pgdir_alloc_page(mm->pgdir, la, perm)) == NULL) {
+            // BSS pages come from the zero pool, nothing left to clear
+            if ((page = pgdir_alloc_zeroed_page(mm->pgdir, la, perm)) == NULL) {
                 ret = -E_NO_MEM;
                 goto bad_cleanup_mmap;
             }
@@ -729,25 +1008,22 @@ load_icode(int fd, int argc, char **kargv) {
             if (end < la) {
                 size -= la - end;
             }
-            memset(page2kva(page) + off, 0, size);
             start += size;
         }
     }
     sysfile_close(fd);
 
     vm_flags = VM_READ | VM_WRITE | VM_STACK;
-    if ((ret = mm_map(mm, USTACKTOP - USTACKSIZE, USTACKSIZE, vm_flags, NULL)) != 0) {
+    // the stack area starts as one unbacked page; do_pgfault grows it downward
+    // (up to mm->stack_limit) and faults pages in as the program touches them
+    if ((ret = mm_map(mm, USTACKTOP - PGSIZE, PGSIZE, vm_flags, NULL)) != 0) {
         goto bad_cleanup_mmap;
     }
-    assert(pgdir_alloc_page(mm->pgdir, USTACKTOP-PGSIZE , PTE_USER) != NULL);
-    assert(pgdir_alloc_page(mm->pgdir, USTACKTOP-2*PGSIZE , PTE_USER) != NULL);
-    assert(pgdir_alloc_page(mm->pgdir, USTACKTOP-3*PGSIZE , PTE_USER) != NULL);
-    assert(pgdir_alloc_page(mm->pgdir, USTACKTOP-4*PGSIZE , PTE_USER) != NULL);
-    
+
     mm_count_inc(mm);
     current->mm = mm;
-    current->cr3 = PADDR(mm->pgdir);
-    lcr3(PADDR(mm->pgdir));
+    current->cr3 = pgdir_cr3(mm->pgdir);
+    lcr3(current->cr3);
 
     //setup argc, argv
     uint32_t argv_size=0, i;
@@ -755,7 +1031,14 @@ load_icode(int fd, int argc, char **kargv) {
         argv_size += strnlen(kargv[i],EXEC_MAX_ARG_LEN + 1)+1;
     }
 
-    uintptr_t stacktop = USTACKTOP - (argv_size/sizeof(long)+1)*sizeof(long);
+    // the main thread's TLS block sits at the very top of the stack
+    uintptr_t tls = USTACKTOP - TLS_SIZE;
+    *(uintptr_t *)(tls + TLS_SELF) = tls;
+    *(int *)(tls + TLS_PID) = current->pid;
+    current->tls_base = tls;
+    load_tls(tls);
+
+    uintptr_t stacktop = tls - (argv_size/sizeof(long)+1)*sizeof(long);
     char** uargv=(char **)(stacktop  - argc * sizeof(char *));
     
     argv_size = 0;
@@ -771,6 +1054,7 @@ load_icode(int fd, int argc, char **kargv) {
     memset(tf, 0, sizeof(struct trapframe));
     tf->tf_cs = USER_CS;
     tf->tf_ds = tf->tf_es = tf->tf_ss = USER_DS;
+    tf->tf_gs = USER_TLS;
     tf->tf_esp = stacktop;
     tf->tf_eip = elf->e_entry;
     tf->tf_eflags = FL_IF;
@@ -780,7 +1064,7 @@ out:
 bad_cleanup_mmap:
     exit_mmap(mm);
 bad_elf_cleanup_pgdir:
-    put_pgdir(mm);
+    put_pgdir(current, mm);
 bad_pgdir_cleanup_mm:
     mm_destroy(mm);
 bad_mm:
@@ -869,14 +1153,19 @@ do_execve(const char *name, int argc, const char **argv) {
     //     file_fstat(1, &_stat);
     //     cprintf("\nmode:%x nlinks:%d\n", _stat.st_mode, _stat.st_nlinks);
     // }
+    // the ring page belongs to the old image
+    uring_release(current);
     if (mm != NULL) {
+        put_ustack(mm);
         lcr3(boot_cr3);
+        current->cr3 = boot_cr3;
+        // detach first: a profiler sample must not walk an mm being torn down
+        current->mm = NULL;
         if (mm_count_dec(mm) == 0) {
             exit_mmap(mm);
-            put_pgdir(mm);
+            put_pgdir(current, mm);
             mm_destroy(mm);
         }
-        current->mm = NULL;
     }
     ret= -E_NO_MEM;;
     if ((ret = load_icode(fd, argc, kargv)) != 0) {
@@ -964,8 +1253,8 @@ found:
         remove_links(proc);
     }
     local_intr_restore(intr_flag);
-    put_kstack(proc);
-    kfree(proc);
+    thread_group_leave(proc);
+    proc_shell_put(proc);
     return 0;
 }
 
@@ -1054,6 +1343,7 @@ init_main(void *arg) {
     }
 
     fs_cleanup();
+    proc_shell_drain();
         
     cprintf("all user-mode processes have quit.\n");
     assert(initproc->cptr == NULL && initproc->yptr == NULL && initproc->optr == NULL);
@@ -1070,12 +1360,8 @@ init_main(void *arg) {
 //           - create the second kernel thread init_main
 void
 proc_init(void) {
-    int i;
-
     list_init(&proc_list);
-    for (i = 0; i < HASH_LIST_SIZE; i ++) {
-        list_init(hash_list + i);
-    }
+    pid_map_set(0);
 
     if ((idleproc = alloc_proc()) == NULL) {
         panic("cannot alloc idleproc.\n");
@@ -1115,6 +1401,17 @@ cpu_idle(void) {
         if (current->need_resched) {
             schedule();
         }
+        else {
+            // nothing to run: finish memory setup, then clear pages ahead
+            // of time, one step per pass; halt once there is nothing left
+            if (!page_init_step()) {
+                bool busy = zero_pool_refill();
+                compact_idle();
+                if (!busy) {
+                    clock_idle();
+                }
+            }
+        }
     }
 }
 
@@ -1139,6 +1436,26 @@ do_sleep(unsigned int time) {
     return 0;
 }
 
+// do_nanosleep - like do_sleep, but wake up once clock_ns() has advanced by ns
+int
+do_nanosleep(uint64_t ns) {
+    if (ns == 0) {
+        return 0;
+    }
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    hrtimer_t __timer, *timer = hrtimer_init(&__timer, current, clock_ns() + ns);
+    current->state = PROC_SLEEPING;
+    current->wait_state = WT_TIMER;
+    add_hrtimer(timer);
+    local_intr_restore(intr_flag);
+
+    schedule();
+
+    del_hrtimer(timer);
+    return 0;
+}
+
 // 从pdb中抓取向用户显示的字段
 int get_pdb(void *base)
 {
@@ -1181,10 +1498,16 @@ void pdb2pdb_user(struct proc_struct *proc, struct proc_struct_user *pdb_user)
     pdb_user->is_thread = proc->is_thread;
 }
 
-int do_clone(void *(*fn)(void *), void *arg, void (*exit)(int))
+int do_clone(void *(*fn)(void *), void *arg, void (*exit)(int), size_t stack_size)
 {
-    int ret = -E_NO_FREE_PROC;
+    int ret = -E_INVAL;
     struct proc_struct *proc;
+    if (stack_size == 0)
+        stack_size = THREAD_STACKSIZE;
+    if (stack_size > THREAD_STACKMAX)
+        goto fork_out;
+
+    ret = -E_NO_FREE_PROC;
     if (nr_process >= MAX_PROCESS)
         goto fork_out;
 
@@ -1202,28 +1525,21 @@ int do_clone(void *(*fn)(void *), void *arg, void (*exit)(int))
     proc->name[i + 1] = 't';
     proc->name[i + 2] = '\0';
 
-    proc->is_thread = 1; //标志该进程是一个子线程
-
-    // 针对可能出现递归调用pthread_create的情况，找到不为线程的主进程
-    struct proc_struct *father = current;
+    // 线程加入主线程所在的线程组，第一次创建线程时才建立线程组
+    struct thread_group *tg;
+    if ((tg = thread_group_get()) == NULL)
+        goto bad_fork_cleanup_proc;
+    if (tg->exiting)
+    {
+        ret = -E_KILLED;
+        goto bad_fork_cleanup_proc;
+    }
 
-    while (father->is_thread)
-        father = father->parent;
+    proc->is_thread = 1; //标志该进程是一个子线程
 
     // 如果不设置线程归属于调用clone的线程，直接指向主线程会导致子线程中没法调用join来等待
     proc->parent = current;
 
-    // 在主线程里面找一块栈分配给该子线程
-    proc->stack_num = 1;
-    for (; proc->stack_num < MAX_THREAD; proc->stack_num++)
-        if (father->stack[proc->stack_num] == 0)
-        {
-            father->stack[proc->stack_num] = 1;
-            break;
-        }
-
-    assert(proc->stack_num != MAX_THREAD);
-
     assert(current->wait_state == 0);
 
     // 设置内核栈
@@ -1232,20 +1548,28 @@ int do_clone(void *(*fn)(void *), void *arg, void (*exit)(int))
 
     // 文件系统直接指向父进程
     if (copy_fs(CLONE_FS, proc) != 0)
-        goto bad_fork_cleanup_kstack;
+        goto bad_fork_cleanup_proc;
 
-    // mm 直接指向父进程， 一个用户进程有1MB的栈空间，256页，一个线程给16页，包括原有的主线程的话，能开16个线程
-    // 但这样有个问题是需要记录其父进程的线程数量，才能知道吧栈设置到哪合适
+    // mm 直接指向父进程
     if (copy_mm(CLONE_VM, proc) != 0)
         goto bad_fork_cleanup_fs;
 
-    // !! 注意这个地址不是这个线程的地址，是上一个线程栈的栈底地址
-    // 给线程分配栈,一个进程16页
-    uint32_t thread_stack_top = USTACKTOP - (proc->stack_num) * 16 * PGSIZE;
-
-    // 预先给两页给新分配的线程
-    assert(pgdir_alloc_page(proc->mm->pgdir, thread_stack_top - PGSIZE, PTE_USER) != NULL);
-    assert(pgdir_alloc_page(proc->mm->pgdir, thread_stack_top - 2 * PGSIZE, PTE_USER) != NULL);
+    // the thread stack is a VM_STACK area of its own with a guard area below it,
+    // placed in the free part of the shared address space and faulted in on use
+    uintptr_t thread_stack_top;
+    lock_mm(proc->mm);
+    ret = mm_map_stack(proc->mm, stack_size, &thread_stack_top);
+    unlock_mm(proc->mm);
+    if (ret != 0)
+        goto bad_fork_cleanup_mm;
+    proc->ustack_size = ROUNDUP(stack_size, PGSIZE) + USTACKGUARD;
+    proc->ustack_base = thread_stack_top - proc->ustack_size;
+
+    // the TLS block takes the top of the stack area, the thread starts below it
+    uintptr_t tls = thread_stack_top - TLS_SIZE;
+    *(uintptr_t *)(tls + TLS_SELF) = tls;
+    proc->tls_base = tls;
+    thread_stack_top = tls;
 
     proc->tf = (struct trapframe *)(proc->kstack + KSTACKSIZE) - 1;
 
@@ -1253,6 +1577,7 @@ int do_clone(void *(*fn)(void *), void *arg, void (*exit)(int))
     memset(tf, 0, sizeof(struct trapframe));
     tf->tf_cs = USER_CS;
     tf->tf_ds = tf->tf_es = tf->tf_ss = USER_DS;
+    tf->tf_gs = USER_TLS;
 
     // 把栈往上抬4个字节,才开始放东西，否则栈会越界
     // 先放exit的参数为0
@@ -1280,37 +1605,27 @@ int do_clone(void *(*fn)(void *), void *arg, void (*exit)(int))
         proc->pid = get_pid();
         hash_proc(proc);
         set_links(proc);
+        thread_group_join(tg, proc);
+        sysprof_fork(proc);
     }
     local_intr_restore(intr_flag);
 
     wakeup_proc(proc);
 
-    // 重新设置父线程的栈被该子线程占用
-    father->stack[proc->stack_num] = proc->pid;
-
     ret = proc->pid;
 fork_out:
     return ret;
 
+bad_fork_cleanup_mm:
+    mm_count_dec(proc->mm);
+    proc->mm = NULL;
 bad_fork_cleanup_fs: //for LAB8
     put_fs(proc);
-bad_fork_cleanup_kstack:
-    put_kstack(proc);
 bad_fork_cleanup_proc:
-    kfree(proc);
+    proc_shell_put(proc);
     goto fork_out;
 }
 
-int is_ancestral_thread(struct proc_struct *proc)
-{
-    if (proc->is_thread) //这只是个线程，不是祖宗线程
-        return 0;
-    for (int i = 1; i < MAX_THREAD; i++)
-        if (proc->stack[i] != 0)
-            return 1;
-    return 0; // 没有子线程，只是一个普通进程
-}
-
 int current_have_kid()
 {
     struct proc_struct *proc = current->cptr;
@@ -1336,39 +1651,60 @@ int do_kill_all_thread(int pid)
     if ((proc = find_proc(pid)) == NULL)
         return -E_INVAL;
 
-    int is_thread = proc->is_thread;
-    for (int i = 1; i < MAX_THREAD; i++)
-        if (proc->stack[i] != 0)
-        {
-            is_thread = 1;
-            break;
-        }
     // 不是线程结束处理
-    if (!is_thread)
+    if (proc->tgroup == NULL)
         return do_kill(pid);
 
-    // 找到主线程
-    struct proc_struct *father = proc;
-    while (father->is_thread)
-        father = father->parent;
-
-    // 通过设置子线程的 PF_EXITING 标志位杀死进程，所有进程会在中断处理时被检测到这个位置引发 do_exit
-    // 重新设置所有子线程独立，再把子线程杀了
-    // 设置 is_thread 让子线程独立是因为在 exit 的时候 is_thread 会触发向主线程归还用户栈的操作
-    // 若主线程先被调度释放，子线程向父线程归还栈的时候会内存访问错误 。
-    for (int i = 1; i < MAX_THREAD; i++)
-        if (father->stack[i] != 0)
-        {
-            struct proc_struct *proc = find_proc(father->stack[i]);
-            // cprintf("proc %d will be killed\n", proc->pid);
-            proc->is_thread = 0;
-            do_kill(father->stack[i]);
-        }
-    // 直接杀了父进程
-    do_kill(father->pid);
+    kill_thread_group(proc);
     return 0;
 }
 
+// kill_thread_group - set PF_EXITING on every live member of proc's thread group
+//                   - (or just proc if it has none), each of them runs do_exit on
+//                   - its way back to user mode and reports the group's exit code
+void
+kill_thread_group(struct proc_struct *proc)
+{
+    struct thread_group *tg;
+    if ((tg = proc->tgroup) == NULL) {
+        do_kill(proc->pid);
+        return;
+    }
+    if (!tg->exiting) {
+        tg->exiting = 1;
+        tg->exit_code = -E_KILLED;
+    }
+    list_entry_t *list = &(tg->thread_list), *le = list;
+    while ((le = list_next(le)) != list) {
+        struct proc_struct *member = le2proc(le, tg_link);
+        if (member->state != PROC_ZOMBIE)
+            do_kill(member->pid);
+    }
+}
+
+// thread_group_wait - the main thread of a group waits for all other members to exit
+void
+thread_group_wait(void)
+{
+    struct thread_group *tg = current->tgroup;
+    if (tg == NULL || tg->leader != current)
+        return;
+
+    bool intr_flag;
+    wait_t __wait, *wait = &__wait;
+    local_intr_save(intr_flag);
+    while (tg->nr_live > 1) {
+        wait_current_set(&(tg->exit_wait), wait, WT_TGROUP);
+        local_intr_restore(intr_flag);
+
+        schedule();
+
+        local_intr_save(intr_flag);
+        wait_current_del(&(tg->exit_wait), wait);
+    }
+    local_intr_restore(intr_flag);
+}
+
 // do_brk - adjust(increase/decrease) the size of process heap, align with page size
 // NOTE: will change the process vma
 int do_brk(uintptr_t * brk_store)
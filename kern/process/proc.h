@@ -37,11 +37,12 @@ struct context {
 #define PROC_NAME_LEN               50
 #define MAX_PROCESS                 4096
 #define MAX_PID                     (MAX_PROCESS * 2)
-#define MAX_THREAD 16
+#define PROC_SHELL_MAX              32      // reaped processes kept for reuse by do_fork
 
 extern list_entry_t proc_list;
 
 struct inode;
+struct thread_group;
 
 struct proc_struct {
     enum proc_state state;                      // Process state
@@ -57,7 +58,6 @@ struct proc_struct {
     uint32_t flags;                             // Process flag
     char name[PROC_NAME_LEN + 1];               // Process name
     list_entry_t list_link;                     // Process link list
-    list_entry_t hash_link;                     // Process hash list
     int exit_code;                              // exit code (be sent to parent proc)
     uint32_t wait_state;                        // waiting state
     struct proc_struct *cptr, *yptr, *optr;     // relations between processes
@@ -69,9 +69,16 @@ struct proc_struct {
     uint32_t cfs_prior;                         // cfs scheduler : the prior of this process (less have more prior), the mininum vruntime procee will be schedule
     uint32_t stride;                            // stride scheduler : the proccess with mininum strider will be schedule
     uint32_t stride_prior;                      // stride scheduler : the prior of this process (less have more prior)
+    struct thread_group *tgroup;                // thread group, NULL until the process creates its first thread
+    list_entry_t tg_link;                       // entry in tgroup->thread_list
     int is_thread;                              // 标志该进程是否是一个子线程
-    int stack_num;                              // 标志该子线程占用了父进程的哪一个栈帧，is_thread = 1 才有效
-    int stack[MAX_THREAD];                      // 每个主进程能够开启16个线程（包括主线程（自己）在内），每个块为 0 表示该块的栈没有被占用，不为 0 表示被占用，且值是该子线程的pid
+    uintptr_t ustack_base;                      // thread stack area (guard included), unmapped when the thread exits
+    size_t ustack_size;                         // size of that area, 0 for the main thread
+    uintptr_t tls_base;                         // user address of the thread's TLS block, loaded into SEG_TLS by proc_run
+    struct uring_ctx *uring;                    // async I/O ring set up by this proc, see kern/fs/sysuring.c
+    struct sysprof *sysprof;                    // system call profile, NULL when not profiled (kern/syscall/sysprof.c)
+    pde_t *spare_pgdir;                         // clean page directory kept for the next fork/exec, see proc shells
+    struct files_struct *spare_filesp;          // empty fd table kept for the next fork, see proc shells
 };
 
 // used by system call
@@ -95,6 +102,10 @@ struct proc_struct_user
 #define WT_CHILD                    (0x00000001 | WT_INTERRUPTED)  // wait child process
 #define WT_KSEM                      0x00000100                    // wait kernel semaphore
 #define WT_TIMER                    (0x00000002 | WT_INTERRUPTED)  // wait timer
+#define WT_FUTEX                    (0x00000010 | WT_INTERRUPTED)  // wait on a user futex word
+#define WT_TGROUP                    0x00000008                    // main thread waits for the rest of its thread group
+#define WT_URING                    (0x00000020 | WT_INTERRUPTED)  // wait for async ring completions
+#define WT_URING_WORKER              0x00000040                    // ring worker waits for submissions
 #define WT_KBD                      (0x00000004 | WT_INTERRUPTED)  // wait the input of keyboard
 
 #define le2proc(le, member)         \
@@ -105,25 +116,29 @@ extern struct proc_struct *idleproc, *initproc, *current;
 void proc_init(void);
 void proc_run(struct proc_struct *proc);
 int kernel_thread(int (*fn)(void *), void *arg, uint32_t clone_flags);
+int kernel_worker(int (*fn)(void *), void *arg);
 
 char *set_proc_name(struct proc_struct *proc, const char *name);
 char *get_proc_name(struct proc_struct *proc);
 void cpu_idle(void) __attribute__((noreturn));
 
 struct proc_struct *find_proc(int pid);
+size_t proc_shell_drain(void);
 int do_fork(uint32_t clone_flags, uintptr_t stack, struct trapframe *tf);
 int do_exit(int error_code);
 int do_yield(void);
 int do_execve(const char *name, int argc, const char **argv);
 int do_wait(int pid, int *code_store);
 int do_kill(int pid);
-int do_clone(void *(*fn)(void *), void *arg, void (*exit)(int));
+int do_clone(void *(*fn)(void *), void *arg, void (*exit)(int), size_t stack_size);
 int do_sleep(unsigned int time);
+int do_nanosleep(uint64_t ns);
 int get_pdb(void *base);
 void pdb2pdb_user(struct proc_struct *proc, struct proc_struct_user *pdb_user);
 int current_have_kid();
 void kill_all_zombie_ch_process();
-int is_ancestral_thread(struct proc_struct *proc);
 int do_kill_all_thread(int pid);
+void kill_thread_group(struct proc_struct *proc);
+void thread_group_wait(void);
 #endif /* !__KERN_PROCESS_PROC_H__ */
 
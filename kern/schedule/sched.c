@@ -5,8 +5,10 @@
 #include <stdio.h>
 #include <assert.h>
 #include <default_sched.h>
+#include <clock.h>
 
 static list_entry_t timer_list;
+static list_entry_t hrtimer_list;       // sorted by expires
 
 struct sched_class *sched_class;
 
@@ -44,6 +46,7 @@ static struct run_queue __rq;
 void
 sched_init(void) {
     list_init(&timer_list);
+    list_init(&hrtimer_list);
     sched_class = &default_sched_class;
     rq = &__rq;
     rq->max_time_slice = 5;
@@ -63,6 +66,10 @@ wakeup_proc(struct proc_struct *proc) {
             proc->wait_state = 0;
             if (proc != current) {
                 sched_class_enqueue(proc);
+                // the idle thread halts until need_resched is set, do not leave it to the tick
+                if (current == idleproc) {
+                    current->need_resched = 1;
+                }
             }
         }
         else {
@@ -168,3 +175,68 @@ run_timer_list(void) {
     }
     local_intr_restore(intr_flag);
 }
+
+// timer_next - ticks until the first timer of timer_list expires, if there is one
+bool
+timer_next(unsigned int *ticks_store) {
+    list_entry_t *le = list_next(&timer_list);
+    if (le == &timer_list) {
+        return 0;
+    }
+    *ticks_store = le2timer(le, timer_link)->expires;
+    return 1;
+}
+
+void
+add_hrtimer(hrtimer_t *timer) {
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    {
+        assert(timer->proc != NULL && list_empty(&(timer->timer_link)));
+        list_entry_t *le = list_next(&hrtimer_list);
+        while (le != &hrtimer_list && to_struct(le, hrtimer_t, timer_link)->expires <= timer->expires) {
+            le = list_next(le);
+        }
+        list_add_before(le, &(timer->timer_link));
+        // a new earliest deadline may come before the armed clock interrupt
+        if (list_next(&hrtimer_list) == &(timer->timer_link)) {
+            clock_reprogram();
+        }
+    }
+    local_intr_restore(intr_flag);
+}
+
+void
+del_hrtimer(hrtimer_t *timer) {
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    {
+        list_del_init(&(timer->timer_link));
+    }
+    local_intr_restore(intr_flag);
+}
+
+// run_hrtimer_list - wake every hrtimer that expired by now, called by clock_interrupt
+void
+run_hrtimer_list(uint64_t now) {
+    list_entry_t *le;
+    while ((le = list_next(&hrtimer_list)) != &hrtimer_list) {
+        hrtimer_t *timer = to_struct(le, hrtimer_t, timer_link);
+        if (timer->expires > now) {
+            break;
+        }
+        list_del_init(le);
+        wakeup_proc(timer->proc);
+    }
+}
+
+// hrtimer_next - expiry of the earliest hrtimer, if there is one
+bool
+hrtimer_next(uint64_t *expires_store) {
+    list_entry_t *le = list_next(&hrtimer_list);
+    if (le == &hrtimer_list) {
+        return 0;
+    }
+    *expires_store = to_struct(le, hrtimer_t, timer_link)->expires;
+    return 1;
+}
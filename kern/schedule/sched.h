@@ -25,6 +25,25 @@ timer_init(timer_t *timer, struct proc_struct *proc, int expires) {
     return timer;
 }
 
+/* *
+ * hrtimer - wake proc once clock_ns() reaches expires. Unlike timer_t these
+ * are not rounded to ticks: clock_reprogram arms the clock interrupt for the
+ * earliest one.
+ * */
+typedef struct {
+    uint64_t expires;
+    struct proc_struct *proc;
+    list_entry_t timer_link;
+} hrtimer_t;
+
+static inline hrtimer_t *
+hrtimer_init(hrtimer_t *timer, struct proc_struct *proc, uint64_t expires) {
+    timer->expires = expires;
+    timer->proc = proc;
+    list_init(&(timer->timer_link));
+    return timer;
+}
+
 struct run_queue;
 
 // The introduction of scheduling classes is borrrowed from Linux, and makes the 
@@ -66,6 +85,11 @@ void schedule(void);
 void add_timer(timer_t *timer);
 void del_timer(timer_t *timer);
 void run_timer_list(void);
+bool timer_next(unsigned int *ticks_store);
+void add_hrtimer(hrtimer_t *timer);
+void del_hrtimer(hrtimer_t *timer);
+void run_hrtimer_list(uint64_t now);
+bool hrtimer_next(uint64_t *expires_store);
 
 extern struct sched_class *sched_class;
 
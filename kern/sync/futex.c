@@ -0,0 +1,117 @@
+#include <defs.h>
+#include <list.h>
+#include <sync.h>
+#include <wait.h>
+#include <proc.h>
+#include <vmm.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <error.h>
+#include <unistd.h>
+#include <futex.h>
+
+/* *
+ * futex - fast user-space locking
+ * User code keeps its lock word in its own memory and updates it with atomic
+ * instructions; it only calls in here when it has to sleep (FUTEX_WAIT) or
+ * when it released a lock somebody may be sleeping on (FUTEX_WAKE).
+ * Sleepers are kept in a hashed table of wait queues keyed by (mm, uaddr):
+ * threads sharing an mm meet on the same key, while unrelated processes that
+ * use the same address never see each other.
+ * */
+
+#define FUTEX_HASH_SHIFT        8
+#define FUTEX_HASH_SIZE         (1 << FUTEX_HASH_SHIFT)
+#define futex_hashfn(mm, uaddr) (hash32((uintptr_t)(mm) ^ (uaddr), FUTEX_HASH_SHIFT))
+
+typedef struct {
+    wait_t wait;
+    struct mm_struct *mm;
+    uintptr_t uaddr;
+} futex_wait_t;
+
+#define le2futex(le)                \
+    to_struct(le2wait((le), wait_link), futex_wait_t, wait)
+
+static wait_queue_t futex_queues[FUTEX_HASH_SIZE];
+
+void
+futex_init(void) {
+    int i;
+    for (i = 0; i < FUTEX_HASH_SIZE; i ++) {
+        wait_queue_init(futex_queues + i);
+    }
+}
+
+// futex_wait - sleep on uaddr until a FUTEX_WAKE, unless *uaddr no longer equals val
+static int
+futex_wait(struct mm_struct *mm, uintptr_t uaddr, int val) {
+    int cur;
+    if (!copy_from_user(mm, &cur, (void *)uaddr, sizeof(int), 0)) {
+        return -E_INVAL;
+    }
+    // nothing from here to wait_current_set can sleep, so a waker that changes
+    // *uaddr after this check always finds us on the queue
+    if (cur != val) {
+        return -E_AGAIN;
+    }
+
+    wait_queue_t *queue = futex_queues + futex_hashfn(mm, uaddr);
+    futex_wait_t __fw, *fw = &__fw;
+    fw->mm = mm;
+    fw->uaddr = uaddr;
+
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    wait_current_set(queue, &(fw->wait), WT_FUTEX);
+    local_intr_restore(intr_flag);
+
+    schedule();
+
+    local_intr_save(intr_flag);
+    wait_current_del(queue, &(fw->wait));
+    local_intr_restore(intr_flag);
+
+    if (fw->wait.wakeup_flags != WT_FUTEX) {
+        return -E_KILLED;
+    }
+    return 0;
+}
+
+// futex_wake - wake up to n sleepers on uaddr, return how many were woken
+static int
+futex_wake(struct mm_struct *mm, uintptr_t uaddr, int n) {
+    wait_queue_t *queue = futex_queues + futex_hashfn(mm, uaddr);
+    int woken = 0;
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    {
+        list_entry_t *head = &(queue->wait_head), *le = list_next(head);
+        while (le != head && woken < n) {
+            futex_wait_t *fw = le2futex(le);
+            le = list_next(le);
+            if (fw->mm == mm && fw->uaddr == uaddr) {
+                wakeup_wait(queue, &(fw->wait), WT_FUTEX, 1);
+                woken ++;
+            }
+        }
+    }
+    local_intr_restore(intr_flag);
+    return woken;
+}
+
+// do_futex - SYS_futex, uaddr must be a 4-byte aligned word of the caller
+int
+do_futex(uintptr_t uaddr, int op, int val) {
+    struct mm_struct *mm = current->mm;
+    if (mm == NULL || uaddr % sizeof(int) != 0) {
+        return -E_INVAL;
+    }
+    switch (op) {
+    case FUTEX_WAIT:
+        return futex_wait(mm, uaddr, val);
+    case FUTEX_WAKE:
+        return futex_wake(mm, uaddr, val);
+    }
+    return -E_INVAL;
+}
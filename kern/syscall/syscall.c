@@ -1,4 +1,5 @@
 #include <defs.h>
+#include <x86.h>
 #include <unistd.h>
 #include <proc.h>
 #include <syscall.h>
@@ -14,12 +15,15 @@
 #include <kmalloc.h>
 #include <swap.h>
 #include <swap_fifo.h>
+#include <futex.h>
+#include <time.h>
+#include <sysbatch.h>
+#include <kdebug.h>
+#include <error.h>
 static int
 sys_exit(uint32_t arg[]) {
     int error_code = (int)arg[0];
-    if (is_ancestral_thread(current)) //祖宗进程只有在所有子线程全部释放后才能退出
-        while (current_have_kid())    //只要有儿子就等着
-            do_wait(0, NULL);
+    thread_group_wait();      //主线程要等线程组里其他线程全部退出后才能退出
     return do_exit(error_code);
 }
 
@@ -204,39 +208,14 @@ sys_clone(uint32_t arg[])
     void *(*fn)(void *) = (void *)arg[1];
     void *argv = (void *)arg[2];
     void (*exit)(int) = (void *)arg[3];
-    *thread_id = do_clone(fn, argv, exit);
+    size_t stack_size = (size_t)arg[4];
+    *thread_id = do_clone(fn, argv, exit, stack_size);
     if (*thread_id > 0)
         return 0;
     else
         return -1;
 }
 
-static int
-sys_sem(uint32_t arg[])
-{
-    semaphore_t *sem = (semaphore_t *)arg[0];
-    int *value = (int *)arg[1];
-    int type = (int)arg[2];
-    switch (type)
-    {
-    case 0:
-        sem_init(sem, *value);
-        break;
-    case 1:
-        up(sem);
-        break;
-    case 2:
-        down(sem);
-        break;
-    case 3:
-        *value = sem->value;
-        break;
-    default:
-        return -1;
-    }
-    return 0;
-}
-
 static int
 sys_nice(uint32_t arg[])
 {
@@ -280,6 +259,68 @@ sys_fifo_check_swap()
 {
 	return	_fifo_check_swap();
 }
+static int
+sys_pmm_report(uint32_t arg[])
+{
+	pmm_report();
+	return 0;
+}
+
+static int
+sys_futex(uint32_t arg[]) {
+    uintptr_t uaddr = (uintptr_t)arg[0];
+    int op = (int)arg[1];
+    int val = (int)arg[2];
+    return do_futex(uaddr, op, val);
+}
+
+static int
+sys_nanosleep(uint32_t arg[]) {
+    const struct timespec *req = (const struct timespec *)arg[0];
+    struct mm_struct *mm = current->mm;
+    struct timespec ts;
+    bool ok;
+    lock_mm(mm);
+    ok = copy_from_user(mm, &ts, req, sizeof(struct timespec), 0);
+    unlock_mm(mm);
+    if (!ok || ts.tv_sec < 0 || ts.tv_nsec < 0 || ts.tv_nsec >= NSEC_PER_SEC) {
+        return -E_INVAL;
+    }
+    return do_nanosleep((uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec);
+}
+
+static int
+sys_uring_setup(uint32_t arg[]) {
+    struct uring **ring_store = (struct uring **)arg[0];
+    return uring_setup(ring_store);
+}
+
+static int
+sys_uring_enter(uint32_t arg[]) {
+    int min_complete = (int)arg[0];
+    return uring_enter(min_complete);
+}
+
+static int
+sys_sysprof(uint32_t arg[]) {
+    int op = (int)arg[0];
+    uint32_t val = arg[1];
+    void *buf = (void *)arg[2];
+    int n = (int)arg[3];
+    return do_sysprof(op, val, buf, n);
+}
+
+static int
+sys_kprof(uint32_t arg[]) {
+    int op = (int)arg[0];
+    uint32_t val = arg[1];
+    void *buf = (void *)arg[2];
+    int n = (int)arg[3];
+    return do_kprof(op, val, buf, n);
+}
+
+static int sys_batch(uint32_t arg[]);
+
 static int (*syscalls[])(uint32_t arg[]) = {
     [SYS_exit] sys_exit,
     [SYS_fork] sys_fork,
@@ -308,17 +349,113 @@ static int (*syscalls[])(uint32_t arg[]) = {
     [SYS_getdirentry] sys_getdirentry,
     [SYS_dup] sys_dup,
     [SYS_get_pdb] sys_get_pdb,
-    [SYS_sem] sys_sem,
     [SYS_nice] sys_nice,
     [SYS_brk] sys_brk,
     [SYS_shmem] sys_shmem,
 	[SYS_check_alloc_page] sys_check_alloc_page,
 	[SYS_check_swap] sys_check_swap,
-	[SYS_fifo_check_swap] sys_fifo_check_swap
+	[SYS_fifo_check_swap] sys_fifo_check_swap,
+	[SYS_pmm_report] sys_pmm_report,
+    [SYS_futex] sys_futex,
+    [SYS_nanosleep] sys_nanosleep,
+    [SYS_batch] sys_batch,
+    [SYS_uring_setup] sys_uring_setup,
+    [SYS_uring_enter] sys_uring_enter,
+    [SYS_sysprof] sys_sysprof,
+    [SYS_kprof] sys_kprof,
 };
 
 #define NUM_SYSCALLS        ((sizeof(syscalls)) / (sizeof(syscalls[0])))
 
+// batch_allowed - whether num may run inside SYS_batch, see libs/sysbatch.h
+static bool
+batch_allowed(int num) {
+    if (num < 0 || num >= NUM_SYSCALLS || syscalls[num] == NULL) {
+        return 0;
+    }
+    switch (num) {
+    case SYS_exit: case SYS_fork: case SYS_clone: case SYS_exec: case SYS_batch:
+        return 0;
+    }
+    return 1;
+}
+
+// batch_resolve - substitute the results of earlier entries, which must come before entry i
+static bool
+batch_resolve(struct sysbatch_entry *entry, int32_t *results, int i) {
+    int j;
+    for (j = 0; j < 5; j ++) {
+        if (entry->arg_result & BATCH_ARG_RESULT(j)) {
+            if (entry->args[j] >= i) {
+                return 0;
+            }
+            entry->args[j] = results[entry->args[j]];
+        }
+    }
+    return 1;
+}
+
+/* *
+ * sys_batch - run n entries of a user sysbatch_entry array in order. Each
+ * entry is copied in, dispatched like syscall() does and its result copied
+ * back. Returns how many entries ran, or -E_INVAL for a bad array.
+ * */
+static int
+sys_batch(uint32_t arg[]) {
+    struct sysbatch_entry *uentries = (struct sysbatch_entry *)arg[0];
+    int n = (int)arg[1];
+    uint32_t flags = (uint32_t)arg[2];
+    struct mm_struct *mm = current->mm;
+    int32_t results[BATCH_MAX];
+    int i;
+    bool ok;
+
+    if (n < 0 || n > BATCH_MAX) {
+        return -E_INVAL;
+    }
+    if (n == 0) {
+        return 0;
+    }
+    lock_mm(mm);
+    ok = user_mem_check(mm, (uintptr_t)uentries, n * sizeof(struct sysbatch_entry), 1);
+    unlock_mm(mm);
+    if (!ok) {
+        return -E_INVAL;
+    }
+
+    for (i = 0; i < n; i ++) {
+        struct sysbatch_entry entry;
+        lock_mm(mm);
+        ok = copy_from_user(mm, &entry, uentries + i, sizeof(entry), 0);
+        unlock_mm(mm);
+        if (!ok) {
+            break;
+        }
+        int ret = -E_INVAL;
+        if (batch_allowed(entry.num) && batch_resolve(&entry, results, i)) {
+            ret = syscalls[entry.num](entry.args);
+        }
+        results[i] = ret;
+        lock_mm(mm);
+        ok = copy_to_user(mm, &(uentries[i].result), &ret, sizeof(int32_t));
+        unlock_mm(mm);
+        if (!ok) {
+            return -E_INVAL;
+        }
+        if (current->flags & PF_EXITING) {
+            return i + 1;
+        }
+        if (ret < 0 && (flags & BATCH_STOP_ON_ERROR)) {
+            return i + 1;
+        }
+        // a long batch is one trap, give others a turn between entries
+        if (current->need_resched) {
+            schedule();
+        }
+    }
+    return i;
+}
+
 void
 syscall(void) {
     struct trapframe *tf = current->tf;
@@ -331,7 +468,17 @@ syscall(void) {
             arg[2] = tf->tf_regs.reg_ebx;
             arg[3] = tf->tf_regs.reg_edi;
             arg[4] = tf->tf_regs.reg_esi;
-            tf->tf_regs.reg_eax = syscalls[num](arg);
+            if (current->sysprof == NULL) {
+                tf->tf_regs.reg_eax = syscalls[num](arg);
+                return ;
+            }
+            // profiled: time the call, the profile may be gone when it returns
+            uint64_t start = rdtsc();
+            int ret = syscalls[num](arg);
+            tf->tf_regs.reg_eax = ret;
+            if (current->sysprof != NULL) {
+                sysprof_record(current->sysprof, num, ret, start);
+            }
             return ;
         }
     }
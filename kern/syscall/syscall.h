@@ -1,7 +1,16 @@
-#ifndef __KERN_SYSCALL_SYSCALL_H__
-#define __KERN_SYSCALL_SYSCALL_H__
-
-void syscall(void);
-
-#endif /* !__KERN_SYSCALL_SYSCALL_H__ */
-
+#ifndef __KERN_SYSCALL_SYSCALL_H__
+#define __KERN_SYSCALL_SYSCALL_H__
+
+#include <defs.h>
+
+void syscall(void);
+
+/* system call profiles, kern/syscall/sysprof.c */
+struct sysprof;
+struct proc_struct;
+void sysprof_record(struct sysprof *prof, int num, int ret, uint64_t start);
+void sysprof_fork(struct proc_struct *proc);
+void sysprof_exit(struct proc_struct *proc);
+int do_sysprof(int op, uint32_t arg, void *buf, int n);
+
+#endif /* !__KERN_SYSCALL_SYSCALL_H__ */
@@ -0,0 +1,198 @@
+#include <defs.h>
+#include <x86.h>
+#include <string.h>
+#include <sync.h>
+#include <proc.h>
+#include <vmm.h>
+#include <pmm.h>
+#include <vdso.h>
+#include <kmalloc.h>
+#include <syscall.h>
+#include <sysprof.h>
+#include <error.h>
+
+struct sysprof {
+    uint32_t flags;                     // SYSPROF_SELF, SYSPROF_CHILDREN
+    uint32_t ncalls;                    // slots in use
+    struct sysprof_stat stat[SYSPROF_MAX_CALLS];
+};
+
+/* *
+ * Per-process system call profiles, see libs/sysprof.h. A profile is a small
+ * open-addressed table of struct sysprof_stat keyed by the syscall number;
+ * about fifty calls exist, so SYSPROF_MAX_CALLS slots never fill up in
+ * practice, and a call that finds no slot is simply not counted.
+ * */
+
+static struct sysprof *
+sysprof_alloc(uint32_t flags) {
+    struct sysprof *prof;
+    if ((prof = kmalloc(sizeof(struct sysprof))) != NULL) {
+        memset(prof, 0, sizeof(struct sysprof));
+        prof->flags = flags;
+    }
+    return prof;
+}
+
+// sysprof_lookup - the slot of num in prof, claimed if it is new
+static struct sysprof_stat *
+sysprof_lookup(struct sysprof *prof, int num) {
+    int i, slot = num % SYSPROF_MAX_CALLS;
+    for (i = 0; i < SYSPROF_MAX_CALLS; i ++) {
+        struct sysprof_stat *st = &(prof->stat[slot]);
+        if (st->num == num) {
+            return st;
+        }
+        if (st->num == 0) {
+            st->num = num;
+            prof->ncalls ++;
+            return st;
+        }
+        slot = (slot + 1) % SYSPROF_MAX_CALLS;
+    }
+    return NULL;
+}
+
+// sysprof_bucket - histogram bucket of a call that took cycles
+static inline int
+sysprof_bucket(uint64_t cycles) {
+    uint32_t c = (cycles >> 32) ? 0xFFFFFFFF : (uint32_t)cycles;
+    if (c < (1 << SYSPROF_HIST_SHIFT)) {
+        return 0;
+    }
+    int b = (31 - __builtin_clz(c)) - SYSPROF_HIST_SHIFT + 1;
+    return b < SYSPROF_HIST_BUCKETS ? b : SYSPROF_HIST_BUCKETS - 1;
+}
+
+/* *
+ * sysprof_record - account one call of num that returned ret, dispatched at
+ * TSC value start. Called by syscall() only while current has a profile.
+ * */
+void
+sysprof_record(struct sysprof *prof, int num, int ret, uint64_t start) {
+    uint64_t cycles = rdtsc() - start;
+    struct sysprof_stat *st;
+    if ((prof->flags & SYSPROF_SELF) && (st = sysprof_lookup(prof, num)) != NULL) {
+        st->calls ++;
+        if (ret < 0) {
+            st->errors ++;
+        }
+        st->cycles += cycles;
+        if (cycles > st->max_cycles) {
+            st->max_cycles = (cycles >> 32) ? 0xFFFFFFFF : (uint32_t)cycles;
+        }
+        st->hist[sysprof_bucket(cycles)] ++;
+    }
+}
+
+// sysprof_merge - add the counts of from to prof
+static void
+sysprof_merge(struct sysprof *prof, struct sysprof *from) {
+    int i, j;
+    for (i = 0; i < SYSPROF_MAX_CALLS; i ++) {
+        struct sysprof_stat *src = &(from->stat[i]), *st;
+        if (src->num == 0 || (st = sysprof_lookup(prof, src->num)) == NULL) {
+            continue;
+        }
+        st->calls += src->calls;
+        st->errors += src->errors;
+        st->cycles += src->cycles;
+        if (src->max_cycles > st->max_cycles) {
+            st->max_cycles = src->max_cycles;
+        }
+        for (j = 0; j < SYSPROF_HIST_BUCKETS; j ++) {
+            st->hist[j] += src->hist[j];
+        }
+    }
+}
+
+// sysprof_fork - called by do_fork/do_clone: profile the new proc if current asked for it
+void
+sysprof_fork(struct proc_struct *proc) {
+    struct sysprof *prof = current->sysprof;
+    if (prof != NULL && (prof->flags & SYSPROF_CHILDREN)) {
+        proc->sysprof = sysprof_alloc(SYSPROF_SELF | SYSPROF_CHILDREN);
+    }
+}
+
+// sysprof_exit - called by do_exit: hand proc's counts to its parent and drop the profile
+void
+sysprof_exit(struct proc_struct *proc) {
+    struct sysprof *prof = proc->sysprof, *parent_prof;
+    if (prof != NULL) {
+        proc->sysprof = NULL;
+        parent_prof = proc->parent->sysprof;
+        if (parent_prof != NULL && (parent_prof->flags & SYSPROF_CHILDREN)) {
+            sysprof_merge(parent_prof, prof);
+        }
+        kfree(prof);
+    }
+}
+
+/* *
+ * do_sysprof - SYS_sysprof
+ *   SYSPROF_START: start a fresh profile for current with flags = arg
+ *   SYSPROF_STOP:  drop the profile of current
+ *   SYSPROF_READ:  copy up to n sysprof_stat of proc arg (0 = current) to buf,
+ *                  return the number copied
+ * */
+int
+do_sysprof(int op, uint32_t arg, void *buf, int n) {
+    struct sysprof *prof = current->sysprof;
+    switch (op) {
+    case SYSPROF_START:
+        if ((arg & ~(SYSPROF_SELF | SYSPROF_CHILDREN)) != 0) {
+            return -E_INVAL;
+        }
+        // calls are timed with rdtsc
+        if (vdso_data->tsc_khz == 0) {
+            return -E_UNIMP;
+        }
+        if (prof == NULL && (prof = current->sysprof = sysprof_alloc(arg)) == NULL) {
+            return -E_NO_MEM;
+        }
+        memset(prof, 0, sizeof(struct sysprof));
+        prof->flags = arg;
+        return 0;
+    case SYSPROF_STOP:
+        if (prof != NULL) {
+            current->sysprof = NULL;
+            kfree(prof);
+        }
+        return 0;
+    case SYSPROF_READ:
+        break;
+    default:
+        return -E_INVAL;
+    }
+
+    struct proc_struct *proc = current;
+    if (arg != 0 && (proc = find_proc(arg)) == NULL) {
+        return -E_INVAL;
+    }
+    if ((prof = proc->sysprof) == NULL || n <= 0) {
+        return 0;
+    }
+
+    // snapshot first, copy_to_user may sleep and proc may exit meanwhile
+    struct sysprof_stat *snap;
+    if (n > prof->ncalls) {
+        n = prof->ncalls;
+    }
+    if ((snap = kmalloc(n * sizeof(struct sysprof_stat))) == NULL) {
+        return -E_NO_MEM;
+    }
+    int i, cnt = 0;
+    for (i = 0; i < SYSPROF_MAX_CALLS && cnt < n; i ++) {
+        if (prof->stat[i].num != 0) {
+            snap[cnt ++] = prof->stat[i];
+        }
+    }
+
+    struct mm_struct *mm = current->mm;
+    lock_mm(mm);
+    bool ok = copy_to_user(mm, buf, snap, cnt * sizeof(struct sysprof_stat));
+    unlock_mm(mm);
+    kfree(snap);
+    return ok ? cnt : -E_INVAL;
+}
@@ -239,9 +239,9 @@ trap_dispatch(struct trapframe *tf) {
          *    Every tick, you should update the system time, iterate the timers, and trigger the timers which are end to call scheduler.
          *    You can use one funcitons to finish all these things.
          */
-        ticks ++;
         assert(current != NULL);
-        run_timer_list();
+        kprof_sample(tf);
+        clock_interrupt();
         break;
     case IRQ_OFFSET + IRQ_COM1:
         //c = cons_getc();
@@ -309,42 +309,40 @@ trap(struct trapframe *tf) {
     }
 }
 
-void kill_all_thread()
-{
-    int is_thread = current->is_thread;
-    // 如果页错误出在主线程，is_thread = 0 但还是需要杀掉所有的线程
-    for (int i = 1; i < MAX_THREAD; i++)
-        if (current->stack[i] != 0)
-        {
-            is_thread = 1;
-            break;
-        }
-    // 不是线程结束处理
-    if (!is_thread)
-    {
-        do_exit(-E_KILLED);
-        return;
+/* *
+ * sysenter_trap - C half of __sysenter_entry. The user stub leaves its return
+ * address on top of the user stack; load it into tf_eip before the syscall
+ * runs so fork copies a complete frame, then finish like trap() does for a
+ * trap from user mode.
+ * */
+void
+sysenter_trap(struct trapframe *tf) {
+    struct mm_struct *mm = current->mm;
+    struct trapframe *otf = current->tf;
+    current->tf = tf;
+
+    bool ok;
+    lock_mm(mm);
+    ok = copy_from_user(mm, &(tf->tf_eip), (void *)tf->tf_esp, sizeof(uintptr_t), 0);
+    unlock_mm(mm);
+    if (!ok) {
+        cprintf("sysenter with a bad user stack %08x, killed.\n", tf->tf_esp);
+        kill_all_thread();
     }
+    syscall();
 
-    // 找到主线程
-    struct proc_struct *father = current;
-    while (father->is_thread)
-        father = father->parent;
+    current->tf = otf;
+    if (current->flags & PF_EXITING) {
+        do_exit(-E_KILLED);
+    }
+    if (current->need_resched) {
+        schedule();
+    }
+}
 
-    // 通过设置子线程的 PF_EXITING 标志位杀死进程，所有进程会在中断处理时被检测到这个位置引发 do_exit
-    // 重新设置所有子线程独立，再把子线程杀了
-    // 设置 is_thread 让子线程独立是因为在 exit 的时候 is_thread 会触发像主线程归还用户栈的操作
-    // 若主线程先被调度释放，子线程向父线程归还栈的时候会内存访问错误 。
-    for (int i = 1; i < MAX_THREAD; i++)
-        if (father->stack[i] != 0)
-        {
-            struct proc_struct *proc = find_proc(father->stack[i]);
-            // cprintf("proc %d will be killed\n", proc->pid);
-            proc->is_thread = 0;
-            do_kill(father->stack[i]);
-        }
-    // 直接杀了父进程
-    do_kill(father->pid);
-    // cprintf("proc %d will be killed\n", father->pid);
+void kill_all_thread()
+{
+    // 页错误出在任何一个线程（包括主线程）都要杀掉整个线程组
+    kill_thread_group(current);
     do_exit(-E_KILLED);
 }
@@ -45,6 +45,9 @@
 #define T_SWITCH_TOU                120    // user/kernel switch
 #define T_SWITCH_TOK                121    // user/kernel switch
 
+/* tf_err of the frames __sysenter_entry builds, the same value as in trapentry.S */
+#define SYSENTER_FRAME              0x5e
+
 /* registers as pushed by pushal */
 struct pushregs {
     uint32_t reg_edi;
@@ -85,6 +88,7 @@ void print_trapframe(struct trapframe *tf);
 void print_regs(struct pushregs *regs);
 bool trap_in_kernel(struct trapframe *tf);
 void kill_all_thread();
+void sysenter_trap(struct trapframe *tf);
 
 #endif /* !__KERN_TRAP_TRAP_H__ */
 
@@ -9,6 +9,9 @@ static inline void change_bit(int nr, volatile void *addr) __attribute__((always
 static inline bool test_and_set_bit(int nr, volatile void *addr) __attribute__((always_inline));
 static inline bool test_and_clear_bit(int nr, volatile void *addr) __attribute__((always_inline));
 static inline bool test_bit(int nr, volatile void *addr) __attribute__((always_inline));
+static inline int xchg(volatile int *addr, int val) __attribute__((always_inline));
+static inline int cmpxchg(volatile int *addr, int old, int new) __attribute__((always_inline));
+static inline int xadd(volatile int *addr, int val) __attribute__((always_inline));
 
 /* *
  * set_bit - Atomically set a bit in memory
@@ -78,5 +81,42 @@ test_and_clear_bit(int nr, volatile void *addr) {
     asm volatile ("btrl %2, %1; sbbl %0, %0" : "=r" (oldbit), "=m" (*(volatile long *)addr) : "Ir" (nr) : "memory");
     return oldbit != 0;
 }
+
+/* *
+ * xchg - Atomically store @val in *@addr and return the old value
+ * @addr:   the word to exchange
+ * @val:    the new value
+ * */
+static inline int
+xchg(volatile int *addr, int val) {
+    asm volatile ("xchgl %0, %1" : "+r" (val), "+m" (*addr) :: "memory");
+    return val;
+}
+
+/* *
+ * cmpxchg - Atomically store @new in *@addr if it still holds @old
+ * @addr:   the word to update
+ * @old:    the value *@addr is expected to hold
+ * @new:    the value to store
+ *
+ * Returns the value *@addr held before, which equals @old on success.
+ * */
+static inline int
+cmpxchg(volatile int *addr, int old, int new) {
+    int prev;
+    asm volatile ("lock; cmpxchgl %2, %1" : "=a" (prev), "+m" (*addr) : "r" (new), "0" (old) : "memory");
+    return prev;
+}
+
+/* *
+ * xadd - Atomically add @val to *@addr and return the old value
+ * @addr:   the word to add to
+ * @val:    the amount to add, may be negative
+ * */
+static inline int
+xadd(volatile int *addr, int val) {
+    asm volatile ("lock; xaddl %0, %1" : "+r" (val), "+m" (*addr) :: "memory");
+    return val;
+}
 #endif /* !__LIBS_ATOMIC_H__ */
 
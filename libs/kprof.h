@@ -0,0 +1,36 @@
+#ifndef __LIBS_KPROF_H__
+#define __LIBS_KPROF_H__
+
+#include <defs.h>
+
+/* *
+ * Sampling profiler (kern/debug/kprof.c). While it runs, every clock
+ * interrupt records where the CPU was: the interrupted pc, the frame-pointer
+ * call chain above it, and the proc that was running. A sample taken in the
+ * kernel during a system call or fault carries the kernel frames first and
+ * then the user frames of the trap below them, so one chain covers both.
+ *
+ * Samples go to a ring the reader drains with KPROF_READ. When the reader
+ * falls behind, new samples are dropped and counted, never overwritten.
+ * */
+
+/* SYS_kprof operations */
+#define KPROF_START         0           // start sampling, arg = period in usecs (0: clock interrupts only)
+#define KPROF_STOP          1           // stop sampling, returns the number of samples dropped
+#define KPROF_READ          2           // move up to n samples to buf, returns the number moved
+#define KPROF_SYMBOL        3           // name of the kernel function holding pc = arg, returns the offset
+
+#define KPROF_SAMPLES       2048        // ring size
+#define KPROF_DEPTH         12          // pcs kept per sample
+#define KPROF_NAME_LEN      31
+#define KPROF_MIN_PERIOD    100         // usecs
+
+struct kprof_sample {
+    int32_t pid;
+    uint16_t kdepth;                    // pc[0 .. kdepth) are kernel pcs, 0 when sampled in user mode
+    uint16_t depth;                     // pcs used
+    char name[KPROF_NAME_LEN + 1];      // proc name, the program path after exec
+    uintptr_t pc[KPROF_DEPTH];          // pc[0] is where the sample hit, its callers follow
+};
+
+#endif /* !__LIBS_KPROF_H__ */
@@ -1,5 +1,5 @@
-#ifndef __KERN_DEBUG_STAB_H__
-#define __KERN_DEBUG_STAB_H__
+#ifndef __LIBS_STAB_H__
+#define __LIBS_STAB_H__
 
 #include <defs.h>
 
@@ -50,5 +50,5 @@ struct stab {
     uintptr_t n_value;      // value of symbol
 };
 
-#endif /* !__KERN_DEBUG_STAB_H__ */
+#endif /* !__LIBS_STAB_H__ */
 
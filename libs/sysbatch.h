@@ -0,0 +1,30 @@
+#ifndef __LIBS_SYSBATCH_H__
+#define __LIBS_SYSBATCH_H__
+
+#include <defs.h>
+
+/* *
+ * SYS_batch runs an array of system calls with one trap. Each entry is
+ * dispatched through syscalls[] in order and its return value stored in
+ * result. An argument can take the result of an earlier entry instead of a
+ * constant (BATCH_ARG_RESULT), so open/fstat/close or read/write chains fit
+ * in one batch. Calls that do not return to the caller or replace the
+ * address space (exit, fork, clone, exec) and nested batches are refused
+ * with -E_INVAL.
+ * */
+
+#define BATCH_MAX           64          // entries per SYS_batch
+
+/* SYS_batch flags */
+#define BATCH_STOP_ON_ERROR 0x1         // stop after the first negative result
+
+struct sysbatch_entry {
+    int32_t num;                        // SYS_*
+    uint32_t args[5];
+    uint32_t arg_result;                // bit n: args[n] is the index of an earlier entry, pass its result
+    int32_t result;                     // set by the kernel
+};
+
+#define BATCH_ARG_RESULT(n)     (1 << (n))
+
+#endif /* !__LIBS_SYSBATCH_H__ */
@@ -0,0 +1,47 @@
+#ifndef __LIBS_SYSPROF_H__
+#define __LIBS_SYSPROF_H__
+
+#include <defs.h>
+
+/* *
+ * Per-process system call profile (kern/syscall/sysprof.c). While a proc has
+ * a profile, syscall() counts every call it dispatches for that proc and
+ * times it with the TSC, from dispatch to return: blocking calls include the
+ * time spent asleep, and exit is never counted since it does not return.
+ * Procs without a profile pay one pointer test per system call.
+ *
+ * SYSPROF_CHILDREN gives procs forked or cloned afterwards a profile of their
+ * own with the same flags; when such a proc exits, its counts are added to
+ * its parent's profile. A tracer starts with SYSPROF_CHILDREN alone, forks
+ * and execs the program, and reads its own profile after waitpid.
+ * */
+
+/* SYS_sysprof operations */
+#define SYSPROF_START       0           // start (or reset) the caller's profile, arg = flags
+#define SYSPROF_STOP        1           // drop the caller's profile
+#define SYSPROF_READ        2           // copy out the profile of pid (0 = caller)
+
+/* SYSPROF_START flags */
+#define SYSPROF_SELF        0x1         // count the calls of this proc
+#define SYSPROF_CHILDREN    0x2         // profile new children and collect their counts at exit
+
+#define SYSPROF_MAX_CALLS   64          // distinct system calls tracked per profile
+
+/* *
+ * Latency histogram: bucket 0 holds calls under 2^SYSPROF_HIST_SHIFT cycles,
+ * bucket b > 0 calls in [2^(SYSPROF_HIST_SHIFT+b-1), 2^(SYSPROF_HIST_SHIFT+b)),
+ * and the last bucket everything above.
+ * */
+#define SYSPROF_HIST_SHIFT  8
+#define SYSPROF_HIST_BUCKETS 16
+
+struct sysprof_stat {
+    int32_t num;                        // SYS_*
+    uint32_t calls;
+    uint32_t errors;                    // calls that returned a negative value
+    uint32_t max_cycles;
+    uint64_t cycles;                    // total TSC cycles
+    uint32_t hist[SYSPROF_HIST_BUCKETS];
+};
+
+#endif /* !__LIBS_SYSPROF_H__ */
@@ -0,0 +1,17 @@
+#ifndef __LIBS_TIME_H__
+#define __LIBS_TIME_H__
+
+#include <defs.h>
+
+struct timespec {
+    int32_t tv_sec;                     // seconds
+    int32_t tv_nsec;                    // nanoseconds, [0, NSEC_PER_SEC)
+};
+
+#define NSEC_PER_SEC        1000000000
+#define NSEC_PER_MSEC       1000000
+#define NSEC_PER_USEC       1000
+
+#define CLOCK_MONOTONIC     1           // nanoseconds since boot, never goes back
+
+#endif /* !__LIBS_TIME_H__ */
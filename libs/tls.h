@@ -0,0 +1,20 @@
+#ifndef __LIBS_TLS_H__
+#define __LIBS_TLS_H__
+
+/* *
+ * Thread-local storage layout, shared by the kernel and the user library.
+ * Every user thread owns a TLS block of TLS_SIZE bytes at the top of its
+ * stack area, set up by load_icode (main thread) and do_clone (threads).
+ * proc_run points the SEG_TLS descriptor at the running thread's block, so
+ * user code reaches it as %gs:offset. The kernel fills in TLS_SELF and
+ * TLS_PID; the slots after them belong to the user library (see
+ * pthread_key_create).
+ * */
+
+#define TLS_SIZE            256                 // keeps the stack below it 16-byte aligned
+#define TLS_SELF            0                   // %gs:TLS_SELF holds the linear address of the block
+#define TLS_PID             4                   // pid of the thread, read by getpid()
+#define TLS_SLOT0           8                   // first user slot
+#define TLS_NSLOTS          ((TLS_SIZE - TLS_SLOT0) / 4)
+
+#endif /* !__LIBS_TLS_H__ */
@@ -38,11 +38,22 @@
 #define SYS_getdirentry     128
 #define SYS_dup             130
 #define SYS_get_pdb 436
-#define SYS_sem 437
 #define SYS_nice 438
 #define SYS_check_alloc_page 451
 #define SYS_check_swap 452
 #define SYS_fifo_check_swap 453
+#define SYS_pmm_report 454
+#define SYS_futex 455
+#define SYS_nanosleep 456
+#define SYS_batch 457
+#define SYS_uring_setup 458
+#define SYS_uring_enter 459
+#define SYS_sysprof 460
+#define SYS_kprof 461
+/* SYS_futex operations */
+#define FUTEX_WAIT          0           // sleep if *uaddr still equals val
+#define FUTEX_WAKE          1           // wake up to val sleepers on uaddr
+
 /* SYS_fork flags */
 #define CLONE_VM            0x00000100  // set if VM shared between processes
 #define CLONE_THREAD        0x00000200  // thread group
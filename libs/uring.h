@@ -0,0 +1,53 @@
+#ifndef __LIBS_URING_H__
+#define __LIBS_URING_H__
+
+#include <defs.h>
+
+/* *
+ * Asynchronous I/O rings shared by a process and the kernel (kern/fs/sysuring.c).
+ * SYS_uring_setup maps one page holding a struct uring into the process and
+ * starts a kernel worker thread for it. The process queues requests on the
+ * submission ring and advances sq_tail; the worker takes them from sq_head,
+ * runs them in order on the process's fd table and posts each result on the
+ * completion ring at cq_tail. SYS_uring_enter kicks the worker and can wait
+ * for completions; the process consumes them by advancing cq_head.
+ *
+ * Head and tail are free-running counters, the slot is counter % entries.
+ * The worker leaves submissions queued while the completion ring is full.
+ * */
+
+#define URING_SQ_ENTRIES    64
+#define URING_CQ_ENTRIES    128
+
+/* uring_sqe.opcode */
+#define URING_OP_NOP        0
+#define URING_OP_READ       1           // read(fd, addr, len), at off unless off < 0
+#define URING_OP_WRITE      2           // write(fd, addr, len), at off unless off < 0
+#define URING_OP_FSYNC      3           // fsync(fd)
+#define URING_OP_OPEN       4           // open(path = addr, open_flags = len)
+#define URING_OP_CLOSE      5           // close(fd)
+
+struct uring_sqe {
+    int32_t opcode;
+    int32_t fd;
+    uint32_t addr;                      // buffer, or path for URING_OP_OPEN
+    uint32_t len;                       // bytes, or open flags for URING_OP_OPEN
+    int32_t off;                        // file offset, -1 for the current position
+    uint32_t user_data;                 // copied to the completion
+};
+
+struct uring_cqe {
+    uint32_t user_data;
+    int32_t res;                        // what the synchronous call would return
+};
+
+struct uring {
+    volatile uint32_t sq_head;          // advanced by the kernel
+    volatile uint32_t sq_tail;          // advanced by the process
+    volatile uint32_t cq_head;          // advanced by the process
+    volatile uint32_t cq_tail;          // advanced by the kernel
+    struct uring_sqe sq[URING_SQ_ENTRIES];
+    struct uring_cqe cq[URING_CQ_ENTRIES];
+};
+
+#endif /* !__LIBS_URING_H__ */
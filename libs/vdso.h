@@ -0,0 +1,49 @@
+#ifndef __LIBS_VDSO_H__
+#define __LIBS_VDSO_H__
+
+#include <defs.h>
+
+/* *
+ * Kernel data page mapped read-only at VDSO_BASE into every user address
+ * space, just above USERTOP. The kernel updates it from the timer interrupt,
+ * so the user library can answer time queries without a system call:
+ * nanoseconds since boot are ns_stamp + (rdtsc() - tsc_stamp) * ns_mult
+ * >> VDSO_NS_SHIFT, or just ns_stamp when ns_mult is 0 (no TSC).
+ *
+ * Fields that must be read together are published under seq: it is odd
+ * while the kernel is writing them, and a reader retries until it sees the
+ * same even value before and after its reads (see vdso_read_begin/retry).
+ * */
+
+#define VDSO_BASE           0xB0000000
+#define VDSO_NS_SHIFT       22
+
+struct vdso_data {
+    volatile uint32_t seq;          // update sequence count
+    volatile uint32_t ticks;        // timer ticks since boot, what sys_gettime returns
+    volatile uint64_t tsc_stamp;    // TSC at ns_stamp
+    volatile uint64_t ns_stamp;     // nanoseconds since boot at the latest clock interrupt
+    uint32_t ns_mult;               // TSC cycles to nanoseconds, scaled by 2^VDSO_NS_SHIFT
+    uint32_t tsc_khz;               // TSC rate calibrated at boot, 0 without a TSC
+    uint32_t tick_hz;               // timer ticks per second
+};
+
+#define vdso_data_page()    ((const struct vdso_data *)VDSO_BASE)
+
+static inline uint32_t
+vdso_read_begin(const struct vdso_data *vd) {
+    uint32_t seq;
+    while ((seq = vd->seq) & 1) {
+        /* kernel update in progress */ ;
+    }
+    asm volatile ("" ::: "memory");
+    return seq;
+}
+
+static inline bool
+vdso_read_retry(const struct vdso_data *vd, uint32_t seq) {
+    asm volatile ("" ::: "memory");
+    return vd->seq != seq;
+}
+
+#endif /* !__LIBS_VDSO_H__ */
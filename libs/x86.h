@@ -45,11 +45,17 @@ static inline uint32_t read_eflags(void) __attribute__((always_inline));
 static inline void write_eflags(uint32_t eflags) __attribute__((always_inline));
 static inline void lcr0(uintptr_t cr0) __attribute__((always_inline));
 static inline void lcr3(uintptr_t cr3) __attribute__((always_inline));
+static inline void lcr4(uintptr_t cr4) __attribute__((always_inline));
 static inline uintptr_t rcr0(void) __attribute__((always_inline));
 static inline uintptr_t rcr1(void) __attribute__((always_inline));
 static inline uintptr_t rcr2(void) __attribute__((always_inline));
 static inline uintptr_t rcr3(void) __attribute__((always_inline));
+static inline uintptr_t rcr4(void) __attribute__((always_inline));
 static inline void invlpg(void *addr) __attribute__((always_inline));
+static inline void cpuid(uint32_t info, uint32_t *eaxp, uint32_t *ebxp, uint32_t *ecxp, uint32_t *edxp) __attribute__((always_inline));
+static inline uint64_t rdmsr(uint32_t msr) __attribute__((always_inline));
+static inline void wrmsr(uint32_t msr, uint64_t val) __attribute__((always_inline));
+static inline uint64_t rdtsc(void) __attribute__((always_inline));
 
 static inline uint8_t
 inb(uint16_t port) {
@@ -175,6 +181,11 @@ lcr3(uintptr_t cr3) {
     asm volatile ("mov %0, %%cr3" :: "r" (cr3) : "memory");
 }
 
+static inline void
+lcr4(uintptr_t cr4) {
+    asm volatile ("mov %0, %%cr4" :: "r" (cr4) : "memory");
+}
+
 static inline uintptr_t
 rcr0(void) {
     uintptr_t cr0;
@@ -203,11 +214,51 @@ rcr3(void) {
     return cr3;
 }
 
+static inline uintptr_t
+rcr4(void) {
+    uintptr_t cr4;
+    asm volatile ("mov %%cr4, %0" : "=r" (cr4) :: "memory");
+    return cr4;
+}
+
 static inline void
 invlpg(void *addr) {
     asm volatile ("invlpg (%0)" :: "r" (addr) : "memory");
 }
 
+/* cpuid - query processor identification; any of the output pointers may be NULL */
+static inline void
+cpuid(uint32_t info, uint32_t *eaxp, uint32_t *ebxp, uint32_t *ecxp, uint32_t *edxp) {
+    uint32_t eax, ebx, ecx, edx;
+    asm volatile ("cpuid"
+                  : "=a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx)
+                  : "a" (info), "c" (0));
+    if (eaxp != NULL) *eaxp = eax;
+    if (ebxp != NULL) *ebxp = ebx;
+    if (ecxp != NULL) *ecxp = ecx;
+    if (edxp != NULL) *edxp = edx;
+}
+
+static inline uint64_t
+rdmsr(uint32_t msr) {
+    uint64_t val;
+    asm volatile ("rdmsr" : "=A" (val) : "c" (msr));
+    return val;
+}
+
+static inline void
+wrmsr(uint32_t msr, uint64_t val) {
+    asm volatile ("wrmsr" :: "c" (msr), "A" (val));
+}
+
+/* rdtsc - read the time-stamp counter */
+static inline uint64_t
+rdtsc(void) {
+    uint64_t val;
+    asm volatile ("rdtsc" : "=A" (val));
+    return val;
+}
+
 static inline int __strcmp(const char *s1, const char *s2) __attribute__((always_inline));
 static inline char *__strcpy(char *dst, const char *src) __attribute__((always_inline));
 static inline void *__memset(void *s, char c, size_t n) __attribute__((always_inline));
@@ -0,0 +1,6822 @@
+
+obj/__user_echo.out:     file format elf32-i386
+
+
+Disassembly of section .text:
+
+00800020 <opendir>:
+#include <error.h>
+#include <unistd.h>
+
+DIR dir, *dirp=&dir;
+DIR *
+opendir(const char *path) {
+  800020:	55                   	push   %ebp
+  800021:	89 e5                	mov    %esp,%ebp
+  800023:	53                   	push   %ebx
+  800024:	83 ec 24             	sub    $0x24,%esp
+
+    if ((dirp->fd = open(path, O_RDONLY)) < 0) {
+  800027:	8b 1d 00 40 80 00    	mov    0x804000,%ebx
+  80002d:	83 ec 08             	sub    $0x8,%esp
+  800030:	6a 00                	push   $0x0
+  800032:	ff 75 08             	push   0x8(%ebp)
+  800035:	e8 1c 01 00 00       	call   800156 <open>
+  80003a:	83 c4 10             	add    $0x10,%esp
+  80003d:	89 03                	mov    %eax,(%ebx)
+  80003f:	8b 03                	mov    (%ebx),%eax
+  800041:	85 c0                	test   %eax,%eax
+  800043:	78 44                	js     800089 <opendir+0x69>
+        goto failed;
+    }
+    struct stat __stat, *stat = &__stat;
+  800045:	8d 45 e4             	lea    -0x1c(%ebp),%eax
+  800048:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    if (fstat(dirp->fd, stat) != 0 || !S_ISDIR(stat->st_mode)) {
+  80004b:	a1 00 40 80 00       	mov    0x804000,%eax
+  800050:	8b 00                	mov    (%eax),%eax
+  800052:	83 ec 08             	sub    $0x8,%esp
+  800055:	ff 75 f4             	push   -0xc(%ebp)
+  800058:	50                   	push   %eax
+  800059:	e8 7b 01 00 00       	call   8001d9 <fstat>
+  80005e:	83 c4 10             	add    $0x10,%esp
+  800061:	85 c0                	test   %eax,%eax
+  800063:	75 27                	jne    80008c <opendir+0x6c>
+  800065:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800068:	8b 00                	mov    (%eax),%eax
+  80006a:	25 00 70 00 00       	and    $0x7000,%eax
+  80006f:	3d 00 20 00 00       	cmp    $0x2000,%eax
+  800074:	75 16                	jne    80008c <opendir+0x6c>
+        goto failed;
+    }
+    dirp->dirent.offset = 0;
+  800076:	a1 00 40 80 00       	mov    0x804000,%eax
+  80007b:	c7 40 04 00 00 00 00 	movl   $0x0,0x4(%eax)
+    return dirp;
+  800082:	a1 00 40 80 00       	mov    0x804000,%eax
+  800087:	eb 09                	jmp    800092 <opendir+0x72>
+        goto failed;
+  800089:	90                   	nop
+  80008a:	eb 01                	jmp    80008d <opendir+0x6d>
+        goto failed;
+  80008c:	90                   	nop
+
+failed:
+    return NULL;
+  80008d:	b8 00 00 00 00       	mov    $0x0,%eax
+}
+  800092:	8b 5d fc             	mov    -0x4(%ebp),%ebx
+  800095:	c9                   	leave
+  800096:	c3                   	ret
+
+00800097 <readdir>:
+
+struct dirent *
+readdir(DIR *dirp) {
+  800097:	55                   	push   %ebp
+  800098:	89 e5                	mov    %esp,%ebp
+  80009a:	83 ec 08             	sub    $0x8,%esp
+    if (sys_getdirentry(dirp->fd, &(dirp->dirent)) == 0) {
+  80009d:	8b 45 08             	mov    0x8(%ebp),%eax
+  8000a0:	8d 50 04             	lea    0x4(%eax),%edx
+  8000a3:	8b 45 08             	mov    0x8(%ebp),%eax
+  8000a6:	8b 00                	mov    (%eax),%eax
+  8000a8:	83 ec 08             	sub    $0x8,%esp
+  8000ab:	52                   	push   %edx
+  8000ac:	50                   	push   %eax
+  8000ad:	e8 da 0e 00 00       	call   800f8c <sys_getdirentry>
+  8000b2:	83 c4 10             	add    $0x10,%esp
+  8000b5:	85 c0                	test   %eax,%eax
+  8000b7:	75 08                	jne    8000c1 <readdir+0x2a>
+        return &(dirp->dirent);
+  8000b9:	8b 45 08             	mov    0x8(%ebp),%eax
+  8000bc:	83 c0 04             	add    $0x4,%eax
+  8000bf:	eb 05                	jmp    8000c6 <readdir+0x2f>
+    }
+    return NULL;
+  8000c1:	b8 00 00 00 00       	mov    $0x0,%eax
+}
+  8000c6:	c9                   	leave
+  8000c7:	c3                   	ret
+
+008000c8 <closedir>:
+
+void
+closedir(DIR *dirp) {
+  8000c8:	55                   	push   %ebp
+  8000c9:	89 e5                	mov    %esp,%ebp
+  8000cb:	83 ec 08             	sub    $0x8,%esp
+    close(dirp->fd);
+  8000ce:	8b 45 08             	mov    0x8(%ebp),%eax
+  8000d1:	8b 00                	mov    (%eax),%eax
+  8000d3:	83 ec 0c             	sub    $0xc,%esp
+  8000d6:	50                   	push   %eax
+  8000d7:	e8 93 00 00 00       	call   80016f <close>
+  8000dc:	83 c4 10             	add    $0x10,%esp
+}
+  8000df:	90                   	nop
+  8000e0:	c9                   	leave
+  8000e1:	c3                   	ret
+
+008000e2 <getcwd>:
+
+int
+getcwd(char *buffer, size_t len) {
+  8000e2:	55                   	push   %ebp
+  8000e3:	89 e5                	mov    %esp,%ebp
+  8000e5:	83 ec 08             	sub    $0x8,%esp
+    return sys_getcwd(buffer, len);
+  8000e8:	83 ec 08             	sub    $0x8,%esp
+  8000eb:	ff 75 0c             	push   0xc(%ebp)
+  8000ee:	ff 75 08             	push   0x8(%ebp)
+  8000f1:	e8 fd 0d 00 00       	call   800ef3 <sys_getcwd>
+  8000f6:	83 c4 10             	add    $0x10,%esp
+}
+  8000f9:	c9                   	leave
+  8000fa:	c3                   	ret
+
+008000fb <mkdir>:
+
+int mkdir(const char* path)
+{
+  8000fb:	55                   	push   %ebp
+  8000fc:	89 e5                	mov    %esp,%ebp
+  8000fe:	83 ec 08             	sub    $0x8,%esp
+    return sys_mkdir(path);
+  800101:	83 ec 0c             	sub    $0xc,%esp
+  800104:	ff 75 08             	push   0x8(%ebp)
+  800107:	e8 02 0e 00 00       	call   800f0e <sys_mkdir>
+  80010c:	83 c4 10             	add    $0x10,%esp
+}
+  80010f:	c9                   	leave
+  800110:	c3                   	ret
+
+00800111 <chdir>:
+
+int chdir(const char* path)
+{
+  800111:	55                   	push   %ebp
+  800112:	89 e5                	mov    %esp,%ebp
+  800114:	83 ec 08             	sub    $0x8,%esp
+    return sys_chdir(path);
+  800117:	83 ec 0c             	sub    $0xc,%esp
+  80011a:	ff 75 08             	push   0x8(%ebp)
+  80011d:	e8 04 0e 00 00       	call   800f26 <sys_chdir>
+  800122:	83 c4 10             	add    $0x10,%esp
+}
+  800125:	c9                   	leave
+  800126:	c3                   	ret
+
+00800127 <link>:
+
+int link(const char *old_path, const char *new_path) 
+{
+  800127:	55                   	push   %ebp
+  800128:	89 e5                	mov    %esp,%ebp
+  80012a:	83 ec 08             	sub    $0x8,%esp
+    return sys_link(old_path, new_path);
+  80012d:	83 ec 08             	sub    $0x8,%esp
+  800130:	ff 75 0c             	push   0xc(%ebp)
+  800133:	ff 75 08             	push   0x8(%ebp)
+  800136:	e8 03 0e 00 00       	call   800f3e <sys_link>
+  80013b:	83 c4 10             	add    $0x10,%esp
+}
+  80013e:	c9                   	leave
+  80013f:	c3                   	ret
+
+00800140 <unlink>:
+
+int unlink(const char *path)
+{
+  800140:	55                   	push   %ebp
+  800141:	89 e5                	mov    %esp,%ebp
+  800143:	83 ec 08             	sub    $0x8,%esp
+    return sys_unlink(path);
+  800146:	83 ec 0c             	sub    $0xc,%esp
+  800149:	ff 75 08             	push   0x8(%ebp)
+  80014c:	e8 23 0e 00 00       	call   800f74 <sys_unlink>
+  800151:	83 c4 10             	add    $0x10,%esp
+  800154:	c9                   	leave
+  800155:	c3                   	ret
+
+00800156 <open>:
+#include <stat.h>
+#include <error.h>
+#include <unistd.h>
+
+int
+open(const char *path, uint32_t open_flags) {
+  800156:	55                   	push   %ebp
+  800157:	89 e5                	mov    %esp,%ebp
+  800159:	83 ec 08             	sub    $0x8,%esp
+    return sys_open(path, open_flags);
+  80015c:	83 ec 08             	sub    $0x8,%esp
+  80015f:	ff 75 0c             	push   0xc(%ebp)
+  800162:	ff 75 08             	push   0x8(%ebp)
+  800165:	e8 d2 0c 00 00       	call   800e3c <sys_open>
+  80016a:	83 c4 10             	add    $0x10,%esp
+}
+  80016d:	c9                   	leave
+  80016e:	c3                   	ret
+
+0080016f <close>:
+
+int
+close(int fd) {
+  80016f:	55                   	push   %ebp
+  800170:	89 e5                	mov    %esp,%ebp
+  800172:	83 ec 08             	sub    $0x8,%esp
+    return sys_close(fd);
+  800175:	83 ec 0c             	sub    $0xc,%esp
+  800178:	ff 75 08             	push   0x8(%ebp)
+  80017b:	e8 d7 0c 00 00       	call   800e57 <sys_close>
+  800180:	83 c4 10             	add    $0x10,%esp
+}
+  800183:	c9                   	leave
+  800184:	c3                   	ret
+
+00800185 <read>:
+
+int
+read(int fd, void *base, size_t len) {
+  800185:	55                   	push   %ebp
+  800186:	89 e5                	mov    %esp,%ebp
+  800188:	83 ec 08             	sub    $0x8,%esp
+    return sys_read(fd, base, len);
+  80018b:	83 ec 04             	sub    $0x4,%esp
+  80018e:	ff 75 10             	push   0x10(%ebp)
+  800191:	ff 75 0c             	push   0xc(%ebp)
+  800194:	ff 75 08             	push   0x8(%ebp)
+  800197:	e8 d3 0c 00 00       	call   800e6f <sys_read>
+  80019c:	83 c4 10             	add    $0x10,%esp
+}
+  80019f:	c9                   	leave
+  8001a0:	c3                   	ret
+
+008001a1 <write>:
+
+int
+write(int fd, void *base, size_t len) {
+  8001a1:	55                   	push   %ebp
+  8001a2:	89 e5                	mov    %esp,%ebp
+  8001a4:	83 ec 08             	sub    $0x8,%esp
+    return sys_write(fd, base, len);
+  8001a7:	83 ec 04             	sub    $0x4,%esp
+  8001aa:	ff 75 10             	push   0x10(%ebp)
+  8001ad:	ff 75 0c             	push   0xc(%ebp)
+  8001b0:	ff 75 08             	push   0x8(%ebp)
+  8001b3:	e8 d2 0c 00 00       	call   800e8a <sys_write>
+  8001b8:	83 c4 10             	add    $0x10,%esp
+}
+  8001bb:	c9                   	leave
+  8001bc:	c3                   	ret
+
+008001bd <seek>:
+
+int
+seek(int fd, off_t pos, int whence) {
+  8001bd:	55                   	push   %ebp
+  8001be:	89 e5                	mov    %esp,%ebp
+  8001c0:	83 ec 08             	sub    $0x8,%esp
+    return sys_seek(fd, pos, whence);
+  8001c3:	83 ec 04             	sub    $0x4,%esp
+  8001c6:	ff 75 10             	push   0x10(%ebp)
+  8001c9:	ff 75 0c             	push   0xc(%ebp)
+  8001cc:	ff 75 08             	push   0x8(%ebp)
+  8001cf:	e8 d1 0c 00 00       	call   800ea5 <sys_seek>
+  8001d4:	83 c4 10             	add    $0x10,%esp
+}
+  8001d7:	c9                   	leave
+  8001d8:	c3                   	ret
+
+008001d9 <fstat>:
+
+int
+fstat(int fd, struct stat *stat) {
+  8001d9:	55                   	push   %ebp
+  8001da:	89 e5                	mov    %esp,%ebp
+  8001dc:	83 ec 08             	sub    $0x8,%esp
+    return sys_fstat(fd, stat);
+  8001df:	83 ec 08             	sub    $0x8,%esp
+  8001e2:	ff 75 0c             	push   0xc(%ebp)
+  8001e5:	ff 75 08             	push   0x8(%ebp)
+  8001e8:	e8 d3 0c 00 00       	call   800ec0 <sys_fstat>
+  8001ed:	83 c4 10             	add    $0x10,%esp
+}
+  8001f0:	c9                   	leave
+  8001f1:	c3                   	ret
+
+008001f2 <fsync>:
+
+int
+fsync(int fd) {
+  8001f2:	55                   	push   %ebp
+  8001f3:	89 e5                	mov    %esp,%ebp
+  8001f5:	83 ec 08             	sub    $0x8,%esp
+    return sys_fsync(fd);
+  8001f8:	83 ec 0c             	sub    $0xc,%esp
+  8001fb:	ff 75 08             	push   0x8(%ebp)
+  8001fe:	e8 d8 0c 00 00       	call   800edb <sys_fsync>
+  800203:	83 c4 10             	add    $0x10,%esp
+}
+  800206:	c9                   	leave
+  800207:	c3                   	ret
+
+00800208 <dup2>:
+
+int
+dup2(int fd1, int fd2) {
+  800208:	55                   	push   %ebp
+  800209:	89 e5                	mov    %esp,%ebp
+  80020b:	83 ec 08             	sub    $0x8,%esp
+    return sys_dup(fd1, fd2);
+  80020e:	83 ec 08             	sub    $0x8,%esp
+  800211:	ff 75 0c             	push   0xc(%ebp)
+  800214:	ff 75 08             	push   0x8(%ebp)
+  800217:	e8 8e 0d 00 00       	call   800faa <sys_dup>
+  80021c:	83 c4 10             	add    $0x10,%esp
+}
+  80021f:	c9                   	leave
+  800220:	c3                   	ret
+
+00800221 <transmode>:
+
+static char
+transmode(struct stat *stat) {
+  800221:	55                   	push   %ebp
+  800222:	89 e5                	mov    %esp,%ebp
+  800224:	83 ec 10             	sub    $0x10,%esp
+    uint32_t mode = stat->st_mode;
+  800227:	8b 45 08             	mov    0x8(%ebp),%eax
+  80022a:	8b 00                	mov    (%eax),%eax
+  80022c:	89 45 fc             	mov    %eax,-0x4(%ebp)
+    if (S_ISREG(mode)) return 'r';
+  80022f:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  800232:	25 00 70 00 00       	and    $0x7000,%eax
+  800237:	3d 00 10 00 00       	cmp    $0x1000,%eax
+  80023c:	75 07                	jne    800245 <transmode+0x24>
+  80023e:	b8 72 00 00 00       	mov    $0x72,%eax
+  800243:	eb 5d                	jmp    8002a2 <transmode+0x81>
+    if (S_ISDIR(mode)) return 'd';
+  800245:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  800248:	25 00 70 00 00       	and    $0x7000,%eax
+  80024d:	3d 00 20 00 00       	cmp    $0x2000,%eax
+  800252:	75 07                	jne    80025b <transmode+0x3a>
+  800254:	b8 64 00 00 00       	mov    $0x64,%eax
+  800259:	eb 47                	jmp    8002a2 <transmode+0x81>
+    if (S_ISLNK(mode)) return 'l';
+  80025b:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  80025e:	25 00 70 00 00       	and    $0x7000,%eax
+  800263:	3d 00 30 00 00       	cmp    $0x3000,%eax
+  800268:	75 07                	jne    800271 <transmode+0x50>
+  80026a:	b8 6c 00 00 00       	mov    $0x6c,%eax
+  80026f:	eb 31                	jmp    8002a2 <transmode+0x81>
+    if (S_ISCHR(mode)) return 'c';
+  800271:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  800274:	25 00 70 00 00       	and    $0x7000,%eax
+  800279:	3d 00 40 00 00       	cmp    $0x4000,%eax
+  80027e:	75 07                	jne    800287 <transmode+0x66>
+  800280:	b8 63 00 00 00       	mov    $0x63,%eax
+  800285:	eb 1b                	jmp    8002a2 <transmode+0x81>
+    if (S_ISBLK(mode)) return 'b';
+  800287:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  80028a:	25 00 70 00 00       	and    $0x7000,%eax
+  80028f:	3d 00 50 00 00       	cmp    $0x5000,%eax
+  800294:	75 07                	jne    80029d <transmode+0x7c>
+  800296:	b8 62 00 00 00       	mov    $0x62,%eax
+  80029b:	eb 05                	jmp    8002a2 <transmode+0x81>
+    return '-';
+  80029d:	b8 2d 00 00 00       	mov    $0x2d,%eax
+}
+  8002a2:	c9                   	leave
+  8002a3:	c3                   	ret
+
+008002a4 <print_stat>:
+
+void
+print_stat(const char *name, int fd, struct stat *stat) {
+  8002a4:	55                   	push   %ebp
+  8002a5:	89 e5                	mov    %esp,%ebp
+  8002a7:	83 ec 08             	sub    $0x8,%esp
+    cprintf("[%03d] %s\n", fd, name);
+  8002aa:	83 ec 04             	sub    $0x4,%esp
+  8002ad:	ff 75 08             	push   0x8(%ebp)
+  8002b0:	ff 75 0c             	push   0xc(%ebp)
+  8002b3:	68 a0 2e 80 00       	push   $0x802ea0
+  8002b8:	e8 04 08 00 00       	call   800ac1 <cprintf>
+  8002bd:	83 c4 10             	add    $0x10,%esp
+    cprintf("    mode    : %c\n", transmode(stat));
+  8002c0:	83 ec 0c             	sub    $0xc,%esp
+  8002c3:	ff 75 10             	push   0x10(%ebp)
+  8002c6:	e8 56 ff ff ff       	call   800221 <transmode>
+  8002cb:	83 c4 10             	add    $0x10,%esp
+  8002ce:	0f be c0             	movsbl %al,%eax
+  8002d1:	83 ec 08             	sub    $0x8,%esp
+  8002d4:	50                   	push   %eax
+  8002d5:	68 ab 2e 80 00       	push   $0x802eab
+  8002da:	e8 e2 07 00 00       	call   800ac1 <cprintf>
+  8002df:	83 c4 10             	add    $0x10,%esp
+    cprintf("    links   : %lu\n", stat->st_nlinks);
+  8002e2:	8b 45 10             	mov    0x10(%ebp),%eax
+  8002e5:	8b 40 04             	mov    0x4(%eax),%eax
+  8002e8:	83 ec 08             	sub    $0x8,%esp
+  8002eb:	50                   	push   %eax
+  8002ec:	68 bd 2e 80 00       	push   $0x802ebd
+  8002f1:	e8 cb 07 00 00       	call   800ac1 <cprintf>
+  8002f6:	83 c4 10             	add    $0x10,%esp
+    cprintf("    blocks  : %lu\n", stat->st_blocks);
+  8002f9:	8b 45 10             	mov    0x10(%ebp),%eax
+  8002fc:	8b 40 08             	mov    0x8(%eax),%eax
+  8002ff:	83 ec 08             	sub    $0x8,%esp
+  800302:	50                   	push   %eax
+  800303:	68 d0 2e 80 00       	push   $0x802ed0
+  800308:	e8 b4 07 00 00       	call   800ac1 <cprintf>
+  80030d:	83 c4 10             	add    $0x10,%esp
+    cprintf("    size    : %lu\n", stat->st_size);
+  800310:	8b 45 10             	mov    0x10(%ebp),%eax
+  800313:	8b 40 0c             	mov    0xc(%eax),%eax
+  800316:	83 ec 08             	sub    $0x8,%esp
+  800319:	50                   	push   %eax
+  80031a:	68 e3 2e 80 00       	push   $0x802ee3
+  80031f:	e8 9d 07 00 00       	call   800ac1 <cprintf>
+  800324:	83 c4 10             	add    $0x10,%esp
+}
+  800327:	90                   	nop
+  800328:	c9                   	leave
+  800329:	c3                   	ret
+
+0080032a <_start>:
+.text
+.globl _start
+_start:
+    # set ebp for backtrace
+    movl $0x0, %ebp
+  80032a:	bd 00 00 00 00       	mov    $0x0,%ebp
+
+    # load argc and argv
+    movl (%esp), %ebx
+  80032f:	8b 1c 24             	mov    (%esp),%ebx
+    lea 0x4(%esp), %ecx
+  800332:	8d 4c 24 04          	lea    0x4(%esp),%ecx
+
+
+    # move down the esp register
+    # since it may cause page fault in backtrace
+    subl $0x20, %esp
+  800336:	83 ec 20             	sub    $0x20,%esp
+
+    # save argc and argv on stack
+    pushl %ecx
+  800339:	51                   	push   %ecx
+    pushl %ebx
+  80033a:	53                   	push   %ebx
+
+    # call user-program function
+    call umain
+  80033b:	e8 e6 12 00 00       	call   801626 <umain>
+1:  jmp 1b
+  800340:	eb fe                	jmp    800340 <_start+0x16>
+
+00800342 <lock>:
+try_lock(lock_t *l) {
+    return cmpxchg(l, 0, 1) != 0;
+}
+
+static inline void
+lock(lock_t *l) {
+  800342:	55                   	push   %ebp
+  800343:	89 e5                	mov    %esp,%ebp
+  800345:	53                   	push   %ebx
+  800346:	83 ec 34             	sub    $0x34,%esp
+  800349:	8b 45 08             	mov    0x8(%ebp),%eax
+  80034c:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  80034f:	c7 45 ec 00 00 00 00 	movl   $0x0,-0x14(%ebp)
+  800356:	c7 45 e8 01 00 00 00 	movl   $0x1,-0x18(%ebp)
+ * Returns the value *@addr held before, which equals @old on success.
+ * */
+static inline int
+cmpxchg(volatile int *addr, int old, int new) {
+    int prev;
+    asm volatile ("lock; cmpxchgl %2, %1" : "=a" (prev), "+m" (*addr) : "r" (new), "0" (old) : "memory");
+  80035d:	8b 5d f0             	mov    -0x10(%ebp),%ebx
+  800360:	8b 55 e8             	mov    -0x18(%ebp),%edx
+  800363:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  800366:	8b 4d f0             	mov    -0x10(%ebp),%ecx
+  800369:	f0 0f b1 13          	lock cmpxchg %edx,(%ebx)
+  80036d:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+    return prev;
+  800370:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+    int c;
+    if ((c = cmpxchg(l, 0, 1)) != 0) {
+  800373:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  800376:	83 7d f4 00          	cmpl   $0x0,-0xc(%ebp)
+  80037a:	74 62                	je     8003de <lock+0x9c>
+        // mark the lock contended, then sleep until the holder hands it over
+        if (c != 2) {
+  80037c:	83 7d f4 02          	cmpl   $0x2,-0xc(%ebp)
+  800380:	74 56                	je     8003d8 <lock+0x96>
+  800382:	8b 45 08             	mov    0x8(%ebp),%eax
+  800385:	89 45 e0             	mov    %eax,-0x20(%ebp)
+  800388:	c7 45 dc 02 00 00 00 	movl   $0x2,-0x24(%ebp)
+    asm volatile ("xchgl %0, %1" : "+r" (val), "+m" (*addr) :: "memory");
+  80038f:	8b 4d e0             	mov    -0x20(%ebp),%ecx
+  800392:	8b 45 dc             	mov    -0x24(%ebp),%eax
+  800395:	8b 55 e0             	mov    -0x20(%ebp),%edx
+  800398:	87 01                	xchg   %eax,(%ecx)
+  80039a:	89 45 dc             	mov    %eax,-0x24(%ebp)
+    return val;
+  80039d:	8b 45 dc             	mov    -0x24(%ebp),%eax
+            c = xchg(l, 2);
+  8003a0:	89 45 f4             	mov    %eax,-0xc(%ebp)
+        }
+        while (c != 0) {
+  8003a3:	eb 33                	jmp    8003d8 <lock+0x96>
+            sys_futex(l, FUTEX_WAIT, 2);
+  8003a5:	83 ec 04             	sub    $0x4,%esp
+  8003a8:	6a 02                	push   $0x2
+  8003aa:	6a 00                	push   $0x0
+  8003ac:	ff 75 08             	push   0x8(%ebp)
+  8003af:	e8 07 0d 00 00       	call   8010bb <sys_futex>
+  8003b4:	83 c4 10             	add    $0x10,%esp
+  8003b7:	8b 45 08             	mov    0x8(%ebp),%eax
+  8003ba:	89 45 d8             	mov    %eax,-0x28(%ebp)
+  8003bd:	c7 45 d4 02 00 00 00 	movl   $0x2,-0x2c(%ebp)
+    asm volatile ("xchgl %0, %1" : "+r" (val), "+m" (*addr) :: "memory");
+  8003c4:	8b 4d d8             	mov    -0x28(%ebp),%ecx
+  8003c7:	8b 45 d4             	mov    -0x2c(%ebp),%eax
+  8003ca:	8b 55 d8             	mov    -0x28(%ebp),%edx
+  8003cd:	87 01                	xchg   %eax,(%ecx)
+  8003cf:	89 45 d4             	mov    %eax,-0x2c(%ebp)
+    return val;
+  8003d2:	8b 45 d4             	mov    -0x2c(%ebp),%eax
+            c = xchg(l, 2);
+  8003d5:	89 45 f4             	mov    %eax,-0xc(%ebp)
+        while (c != 0) {
+  8003d8:	83 7d f4 00          	cmpl   $0x0,-0xc(%ebp)
+  8003dc:	75 c7                	jne    8003a5 <lock+0x63>
+        }
+    }
+}
+  8003de:	90                   	nop
+  8003df:	8b 5d fc             	mov    -0x4(%ebp),%ebx
+  8003e2:	c9                   	leave
+  8003e3:	c3                   	ret
+
+008003e4 <unlock>:
+
+static inline void
+unlock(lock_t *l) {
+  8003e4:	55                   	push   %ebp
+  8003e5:	89 e5                	mov    %esp,%ebp
+  8003e7:	83 ec 18             	sub    $0x18,%esp
+  8003ea:	8b 45 08             	mov    0x8(%ebp),%eax
+  8003ed:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  8003f0:	c7 45 f0 00 00 00 00 	movl   $0x0,-0x10(%ebp)
+    asm volatile ("xchgl %0, %1" : "+r" (val), "+m" (*addr) :: "memory");
+  8003f7:	8b 4d f4             	mov    -0xc(%ebp),%ecx
+  8003fa:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8003fd:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  800400:	87 01                	xchg   %eax,(%ecx)
+  800402:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    return val;
+  800405:	8b 45 f0             	mov    -0x10(%ebp),%eax
+    if (xchg(l, 0) == 2) {
+  800408:	83 f8 02             	cmp    $0x2,%eax
+  80040b:	75 12                	jne    80041f <unlock+0x3b>
+        sys_futex(l, FUTEX_WAKE, 1);
+  80040d:	83 ec 04             	sub    $0x4,%esp
+  800410:	6a 01                	push   $0x1
+  800412:	6a 01                	push   $0x1
+  800414:	ff 75 08             	push   0x8(%ebp)
+  800417:	e8 9f 0c 00 00       	call   8010bb <sys_futex>
+  80041c:	83 c4 10             	add    $0x10,%esp
+    }
+}
+  80041f:	90                   	nop
+  800420:	c9                   	leave
+  800421:	c3                   	ret
+
+00800422 <lock_for_malloc>:
+
+/*
+ * 在malloc之前，我们首先要对内存和fork上锁，以保证此时内存只有这一个malloc正在操作
+ */
+static inline void lock_for_malloc(void)		
+{
+  800422:	55                   	push   %ebp
+  800423:	89 e5                	mov    %esp,%ebp
+  800425:	83 ec 08             	sub    $0x8,%esp
+	lock_fork();
+  800428:	e8 a0 0e 00 00       	call   8012cd <lock_fork>
+	lock(&mem_lock);
+  80042d:	83 ec 0c             	sub    $0xc,%esp
+  800430:	68 84 41 80 00       	push   $0x804184
+  800435:	e8 08 ff ff ff       	call   800342 <lock>
+  80043a:	83 c4 10             	add    $0x10,%esp
+}
+  80043d:	90                   	nop
+  80043e:	c9                   	leave
+  80043f:	c3                   	ret
+
+00800440 <unlock_for_malloc>:
+
+/*
+ * 结束后按照相反顺序放开锁
+ */
+static inline void unlock_for_malloc(void)
+{
+  800440:	55                   	push   %ebp
+  800441:	89 e5                	mov    %esp,%ebp
+  800443:	83 ec 08             	sub    $0x8,%esp
+	unlock_fork();
+  800446:	e8 9b 0e 00 00       	call   8012e6 <unlock_fork>
+	unlock(&mem_lock);
+  80044b:	83 ec 0c             	sub    $0xc,%esp
+  80044e:	68 84 41 80 00       	push   $0x804184
+  800453:	e8 8c ff ff ff       	call   8003e4 <unlock>
+  800458:	83 c4 10             	add    $0x10,%esp
+}
+  80045b:	90                   	nop
+  80045c:	c9                   	leave
+  80045d:	c3                   	ret
+
+0080045e <morecore_brk_locked>:
+
+/*
+ * 判断这块内存是否被占用，能否被free
+ */
+static bool morecore_brk_locked(size_t nu)
+{
+  80045e:	55                   	push   %ebp
+  80045f:	89 e5                	mov    %esp,%ebp
+  800461:	83 ec 18             	sub    $0x18,%esp
+	static uintptr_t brk = 0;
+	if (brk == 0) 
+  800464:	a1 90 41 80 00       	mov    0x804190,%eax
+  800469:	85 c0                	test   %eax,%eax
+  80046b:	75 2e                	jne    80049b <morecore_brk_locked+0x3d>
+	{
+		//cprintf("Begin to check sys_brk.\n");
+		if (sys_brk(&brk) != 0)
+  80046d:	83 ec 0c             	sub    $0xc,%esp
+  800470:	68 90 41 80 00       	push   $0x804190
+  800475:	e8 c6 0b 00 00       	call   801040 <sys_brk>
+  80047a:	83 c4 10             	add    $0x10,%esp
+  80047d:	85 c0                	test   %eax,%eax
+  80047f:	74 0a                	je     80048b <morecore_brk_locked+0x2d>
+		{
+			return 0;
+  800481:	b8 00 00 00 00       	mov    $0x0,%eax
+  800486:	e9 8a 00 00 00       	jmp    800515 <morecore_brk_locked+0xb7>
+		}
+		if(brk == 0)
+  80048b:	a1 90 41 80 00       	mov    0x804190,%eax
+  800490:	85 c0                	test   %eax,%eax
+  800492:	75 07                	jne    80049b <morecore_brk_locked+0x3d>
+			return 0;
+  800494:	b8 00 00 00 00       	mov    $0x0,%eax
+  800499:	eb 7a                	jmp    800515 <morecore_brk_locked+0xb7>
+		
+	}
+	uintptr_t newbrk = brk + nu * sizeof(header_t);
+  80049b:	8b 45 08             	mov    0x8(%ebp),%eax
+  80049e:	c1 e0 06             	shl    $0x6,%eax
+  8004a1:	89 c2                	mov    %eax,%edx
+  8004a3:	a1 90 41 80 00       	mov    0x804190,%eax
+  8004a8:	01 d0                	add    %edx,%eax
+  8004aa:	89 45 f0             	mov    %eax,-0x10(%ebp)
+	
+	if (sys_brk(&newbrk) != 0)
+  8004ad:	83 ec 0c             	sub    $0xc,%esp
+  8004b0:	8d 45 f0             	lea    -0x10(%ebp),%eax
+  8004b3:	50                   	push   %eax
+  8004b4:	e8 87 0b 00 00       	call   801040 <sys_brk>
+  8004b9:	83 c4 10             	add    $0x10,%esp
+  8004bc:	85 c0                	test   %eax,%eax
+  8004be:	74 07                	je     8004c7 <morecore_brk_locked+0x69>
+		return 0;
+  8004c0:	b8 00 00 00 00       	mov    $0x0,%eax
+  8004c5:	eb 4e                	jmp    800515 <morecore_brk_locked+0xb7>
+	
+	if(newbrk <= brk)
+  8004c7:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8004ca:	8b 15 90 41 80 00    	mov    0x804190,%edx
+  8004d0:	39 c2                	cmp    %eax,%edx
+  8004d2:	72 07                	jb     8004db <morecore_brk_locked+0x7d>
+		return 0;
+  8004d4:	b8 00 00 00 00       	mov    $0x0,%eax
+  8004d9:	eb 3a                	jmp    800515 <morecore_brk_locked+0xb7>
+	header_t *p = (void *)brk;
+  8004db:	a1 90 41 80 00       	mov    0x804190,%eax
+  8004e0:	89 45 f4             	mov    %eax,-0xc(%ebp)
+	p->s.size = (newbrk - brk) / sizeof(header_t);
+  8004e3:	8b 55 f0             	mov    -0x10(%ebp),%edx
+  8004e6:	a1 90 41 80 00       	mov    0x804190,%eax
+  8004eb:	29 c2                	sub    %eax,%edx
+  8004ed:	c1 ea 06             	shr    $0x6,%edx
+  8004f0:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  8004f3:	89 50 04             	mov    %edx,0x4(%eax)
+	free_locked((void *)(p + 1));
+  8004f6:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  8004f9:	83 c0 40             	add    $0x40,%eax
+  8004fc:	83 ec 0c             	sub    $0xc,%esp
+  8004ff:	50                   	push   %eax
+  800500:	e8 d8 00 00 00       	call   8005dd <free_locked>
+  800505:	83 c4 10             	add    $0x10,%esp
+	brk = newbrk;
+  800508:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  80050b:	a3 90 41 80 00       	mov    %eax,0x804190
+	
+	return 1;
+  800510:	b8 01 00 00 00       	mov    $0x1,%eax
+}
+  800515:	c9                   	leave
+  800516:	c3                   	ret
+
+00800517 <malloc_locked>:
+/*
+ * 意思是在上锁的时候进行malloc
+ * 返回一个指向分配内存首地址的通用指针
+ */
+static void *malloc_locked(size_t size)
+{
+  800517:	55                   	push   %ebp
+  800518:	89 e5                	mov    %esp,%ebp
+  80051a:	83 ec 28             	sub    $0x28,%esp
+	static_assert(sizeof(header_t) == 0x40);
+	header_t *p, *prevp;			//两根用于操作链表的指针
+	size_t nunits;
+	int type = 0;						//此处不考虑shared_memory，统一为0
+  80051d:	c7 45 f0 00 00 00 00 	movl   $0x0,-0x10(%ebp)
+
+	nunits = (size + sizeof(header_t) - 1) / sizeof(header_t) + 1;		//计算需要分配的单元的数目
+  800524:	8b 45 08             	mov    0x8(%ebp),%eax
+  800527:	83 c0 3f             	add    $0x3f,%eax
+  80052a:	c1 e8 06             	shr    $0x6,%eax
+  80052d:	83 c0 01             	add    $0x1,%eax
+  800530:	89 45 ec             	mov    %eax,-0x14(%ebp)
+	if ((prevp = freep) == NULL)	//freep为空，代表未初始化，这里的base很有可能只是一个指向头的指针，因为看起来这边的size为空，代表这个header没有分配空间
+  800533:	a1 80 41 80 00       	mov    0x804180,%eax
+  800538:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  80053b:	83 7d f4 00          	cmpl   $0x0,-0xc(%ebp)
+  80053f:	75 23                	jne    800564 <malloc_locked+0x4d>
+	{
+		prevp = &base;				//空闲指针，先前指针均指向base自身。
+  800541:	c7 45 f4 40 41 80 00 	movl   $0x804140,-0xc(%ebp)
+		freep = prevp;
+  800548:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  80054b:	a3 80 41 80 00       	mov    %eax,0x804180
+		base.s.ptr = freep;
+  800550:	a1 80 41 80 00       	mov    0x804180,%eax
+  800555:	a3 40 41 80 00       	mov    %eax,0x804140
+		base.s.size = 0;
+  80055a:	c7 05 44 41 80 00 00 	movl   $0x0,0x804144
+  800561:	00 00 00 
+	}
+
+	p = prevp->s.ptr;				//寻找剩余空间大于等于nunits的块
+  800564:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800567:	8b 00                	mov    (%eax),%eax
+  800569:	89 45 e8             	mov    %eax,-0x18(%ebp)
+	while (1)
+	{
+		if (p->s.size >= nunits || MALLOC_COND)
+		{
+			if (p->s.size == nunits) 	//如果正好，就直接赋过去
+  80056c:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  80056f:	8b 40 04             	mov    0x4(%eax),%eax
+  800572:	39 45 ec             	cmp    %eax,-0x14(%ebp)
+  800575:	75 0c                	jne    800583 <malloc_locked+0x6c>
+			{
+				prevp->s.ptr = p->s.ptr;
+  800577:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  80057a:	8b 10                	mov    (%eax),%edx
+  80057c:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  80057f:	89 10                	mov    %edx,(%eax)
+  800581:	eb 3e                	jmp    8005c1 <malloc_locked+0xaa>
+			} 
+			else 						//如果有剩余，那么就把剩下来的包装成一个np
+			{
+				header_t *np = prevp->s.ptr = (p + nunits);
+  800583:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  800586:	c1 e0 06             	shl    $0x6,%eax
+  800589:	89 c2                	mov    %eax,%edx
+  80058b:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  80058e:	01 c2                	add    %eax,%edx
+  800590:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800593:	89 10                	mov    %edx,(%eax)
+  800595:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800598:	8b 00                	mov    (%eax),%eax
+  80059a:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+				np->s.ptr = p->s.ptr;
+  80059d:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  8005a0:	8b 10                	mov    (%eax),%edx
+  8005a2:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  8005a5:	89 10                	mov    %edx,(%eax)
+				np->s.size = p->s.size - nunits;
+  8005a7:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  8005aa:	8b 40 04             	mov    0x4(%eax),%eax
+  8005ad:	2b 45 ec             	sub    -0x14(%ebp),%eax
+  8005b0:	89 c2                	mov    %eax,%edx
+  8005b2:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  8005b5:	89 50 04             	mov    %edx,0x4(%eax)
+				p->s.size = nunits;
+  8005b8:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  8005bb:	8b 55 ec             	mov    -0x14(%ebp),%edx
+  8005be:	89 50 04             	mov    %edx,0x4(%eax)
+			}
+			freep = prevp;
+  8005c1:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  8005c4:	a3 80 41 80 00       	mov    %eax,0x804180
+			break;						//准备返回p的后面一个header
+  8005c9:	90                   	nop
+			}
+		}	
+		prevp = p;						//看下一个
+		p = p->s.ptr;
+	}
+	double_check(p);
+  8005ca:	83 ec 0c             	sub    $0xc,%esp
+  8005cd:	ff 75 e8             	push   -0x18(%ebp)
+  8005d0:	e8 2f 01 00 00       	call   800704 <double_check>
+  8005d5:	83 c4 10             	add    $0x10,%esp
+	return p;
+  8005d8:	8b 45 e8             	mov    -0x18(%ebp),%eax
+}
+  8005db:	c9                   	leave
+  8005dc:	c3                   	ret
+
+008005dd <free_locked>:
+
+static void free_locked(void *ap)		//负责整理内存块，并且将free好的内容统一挂到freep上
+{
+  8005dd:	55                   	push   %ebp
+  8005de:	89 e5                	mov    %esp,%ebp
+  8005e0:	83 ec 10             	sub    $0x10,%esp
+	header_t *bp = ((header_t *) ap) - 1, *p;
+  8005e3:	8b 45 08             	mov    0x8(%ebp),%eax
+  8005e6:	83 e8 40             	sub    $0x40,%eax
+  8005e9:	89 45 fc             	mov    %eax,-0x4(%ebp)
+	for (p = freep; !(bp > p && bp < p->s.ptr); p = p->s.ptr) 
+  8005ec:	a1 80 41 80 00       	mov    0x804180,%eax
+  8005f1:	89 45 f8             	mov    %eax,-0x8(%ebp)
+  8005f4:	90                   	nop
+  8005f5:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8005f8:	39 45 f8             	cmp    %eax,-0x8(%ebp)
+  8005fb:	72 25                	jb     800622 <free_locked+0x45>
+		if (p >= p->s.ptr && (bp > p || bp < p->s.ptr)) 
+  8005fd:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  800600:	8b 00                	mov    (%eax),%eax
+  800602:	39 45 f8             	cmp    %eax,-0x8(%ebp)
+  800605:	0f 82 af 00 00 00    	jb     8006ba <free_locked+0xdd>
+  80060b:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  80060e:	39 45 f8             	cmp    %eax,-0x8(%ebp)
+  800611:	72 19                	jb     80062c <free_locked+0x4f>
+  800613:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  800616:	8b 00                	mov    (%eax),%eax
+  800618:	39 45 fc             	cmp    %eax,-0x4(%ebp)
+  80061b:	72 0f                	jb     80062c <free_locked+0x4f>
+			break;
+		else
+			return;
+  80061d:	e9 98 00 00 00       	jmp    8006ba <free_locked+0xdd>
+	for (p = freep; !(bp > p && bp < p->s.ptr); p = p->s.ptr) 
+  800622:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  800625:	8b 00                	mov    (%eax),%eax
+  800627:	39 45 fc             	cmp    %eax,-0x4(%ebp)
+  80062a:	73 d1                	jae    8005fd <free_locked+0x20>
+
+	if (bp + bp->s.size == p->s.ptr) 
+  80062c:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  80062f:	8b 40 04             	mov    0x4(%eax),%eax
+  800632:	c1 e0 06             	shl    $0x6,%eax
+  800635:	89 c2                	mov    %eax,%edx
+  800637:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  80063a:	01 c2                	add    %eax,%edx
+  80063c:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  80063f:	8b 00                	mov    (%eax),%eax
+  800641:	39 c2                	cmp    %eax,%edx
+  800643:	75 24                	jne    800669 <free_locked+0x8c>
+	{
+		bp->s.size += p->s.ptr->s.size;
+  800645:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  800648:	8b 50 04             	mov    0x4(%eax),%edx
+  80064b:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  80064e:	8b 00                	mov    (%eax),%eax
+  800650:	8b 40 04             	mov    0x4(%eax),%eax
+  800653:	01 c2                	add    %eax,%edx
+  800655:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  800658:	89 50 04             	mov    %edx,0x4(%eax)
+		bp->s.ptr = p->s.ptr->s.ptr;
+  80065b:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  80065e:	8b 00                	mov    (%eax),%eax
+  800660:	8b 10                	mov    (%eax),%edx
+  800662:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  800665:	89 10                	mov    %edx,(%eax)
+  800667:	eb 0a                	jmp    800673 <free_locked+0x96>
+	} 
+	else 
+	{
+		bp->s.ptr = p->s.ptr;
+  800669:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  80066c:	8b 10                	mov    (%eax),%edx
+  80066e:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  800671:	89 10                	mov    %edx,(%eax)
+	}
+
+	if (p + p->s.size == bp) 
+  800673:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  800676:	8b 40 04             	mov    0x4(%eax),%eax
+  800679:	c1 e0 06             	shl    $0x6,%eax
+  80067c:	89 c2                	mov    %eax,%edx
+  80067e:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  800681:	01 d0                	add    %edx,%eax
+  800683:	39 45 fc             	cmp    %eax,-0x4(%ebp)
+  800686:	75 20                	jne    8006a8 <free_locked+0xcb>
+	{
+		p->s.size += bp->s.size;
+  800688:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  80068b:	8b 50 04             	mov    0x4(%eax),%edx
+  80068e:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  800691:	8b 40 04             	mov    0x4(%eax),%eax
+  800694:	01 c2                	add    %eax,%edx
+  800696:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  800699:	89 50 04             	mov    %edx,0x4(%eax)
+		p->s.ptr = bp->s.ptr;
+  80069c:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  80069f:	8b 10                	mov    (%eax),%edx
+  8006a1:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  8006a4:	89 10                	mov    %edx,(%eax)
+  8006a6:	eb 08                	jmp    8006b0 <free_locked+0xd3>
+	} 
+	else 
+	{
+		p->s.ptr = bp;
+  8006a8:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  8006ab:	8b 55 fc             	mov    -0x4(%ebp),%edx
+  8006ae:	89 10                	mov    %edx,(%eax)
+	}
+
+	freep = p;
+  8006b0:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  8006b3:	a3 80 41 80 00       	mov    %eax,0x804180
+  8006b8:	eb 01                	jmp    8006bb <free_locked+0xde>
+			return;
+  8006ba:	90                   	nop
+}
+  8006bb:	c9                   	leave
+  8006bc:	c3                   	ret
+
+008006bd <malloc>:
+/*
+ * 基本的malloc，除了malloc_locked中间的参数是0，代表基本malloc
+ * 返回值是malloc出来的内存的首地址
+ */
+void *malloc(size_t size)
+{
+  8006bd:	55                   	push   %ebp
+  8006be:	89 e5                	mov    %esp,%ebp
+  8006c0:	83 ec 18             	sub    $0x18,%esp
+	void *ret;
+	lock_for_malloc();
+  8006c3:	e8 5a fd ff ff       	call   800422 <lock_for_malloc>
+	ret = malloc_locked(size);
+  8006c8:	83 ec 0c             	sub    $0xc,%esp
+  8006cb:	ff 75 08             	push   0x8(%ebp)
+  8006ce:	e8 44 fe ff ff       	call   800517 <malloc_locked>
+  8006d3:	83 c4 10             	add    $0x10,%esp
+  8006d6:	89 45 f4             	mov    %eax,-0xc(%ebp)
+	unlock_for_malloc();
+  8006d9:	e8 62 fd ff ff       	call   800440 <unlock_for_malloc>
+	return ret;
+  8006de:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  8006e1:	c9                   	leave
+  8006e2:	c3                   	ret
+
+008006e3 <free>:
+
+/*
+ * free堆中的内存，注意操作前需要上锁
+ */
+void free(void *ap)
+{
+  8006e3:	55                   	push   %ebp
+  8006e4:	89 e5                	mov    %esp,%ebp
+  8006e6:	83 ec 08             	sub    $0x8,%esp
+	lock_for_malloc();
+  8006e9:	e8 34 fd ff ff       	call   800422 <lock_for_malloc>
+	free_locked(ap);
+  8006ee:	83 ec 0c             	sub    $0xc,%esp
+  8006f1:	ff 75 08             	push   0x8(%ebp)
+  8006f4:	e8 e4 fe ff ff       	call   8005dd <free_locked>
+  8006f9:	83 c4 10             	add    $0x10,%esp
+	unlock_for_malloc();
+  8006fc:	e8 3f fd ff ff       	call   800440 <unlock_for_malloc>
+}
+  800701:	90                   	nop
+  800702:	c9                   	leave
+  800703:	c3                   	ret
+
+00800704 <double_check>:
+
+void double_check(header_t *ptr)
+{
+  800704:	55                   	push   %ebp
+  800705:	89 e5                	mov    %esp,%ebp
+	if((unsigned int)ptr->align && ASSIGN_COND)
+		return ptr;
+	else
+	{
+		ptr->s.ptr = (header_t *)start+cnt*(1<<22);
+  800707:	a1 8c 41 80 00       	mov    0x80418c,%eax
+  80070c:	c1 e0 1c             	shl    $0x1c,%eax
+  80070f:	89 c2                	mov    %eax,%edx
+  800711:	a1 04 40 80 00       	mov    0x804004,%eax
+  800716:	01 d0                	add    %edx,%eax
+  800718:	89 c2                	mov    %eax,%edx
+  80071a:	8b 45 08             	mov    0x8(%ebp),%eax
+  80071d:	89 10                	mov    %edx,(%eax)
+		ptr->s.size = (1<<22);
+  80071f:	8b 45 08             	mov    0x8(%ebp),%eax
+  800722:	c7 40 04 00 00 40 00 	movl   $0x400000,0x4(%eax)
+		cnt++;
+  800729:	a1 8c 41 80 00       	mov    0x80418c,%eax
+  80072e:	83 c0 01             	add    $0x1,%eax
+  800731:	a3 8c 41 80 00       	mov    %eax,0x80418c
+		return ptr;
+  800736:	90                   	nop
+	}
+
+  800737:	5d                   	pop    %ebp
+  800738:	c3                   	ret
+
+00800739 <__panic>:
+#include <stdio.h>
+#include <ulib.h>
+#include <error.h>
+
+void
+__panic(const char *file, int line, const char *fmt, ...) {
+  800739:	55                   	push   %ebp
+  80073a:	89 e5                	mov    %esp,%ebp
+  80073c:	83 ec 18             	sub    $0x18,%esp
+    // print the 'message'
+    va_list ap;
+    va_start(ap, fmt);
+  80073f:	8d 45 14             	lea    0x14(%ebp),%eax
+  800742:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    cprintf("user panic at %s:%d:\n    ", file, line);
+  800745:	83 ec 04             	sub    $0x4,%esp
+  800748:	ff 75 0c             	push   0xc(%ebp)
+  80074b:	ff 75 08             	push   0x8(%ebp)
+  80074e:	68 f6 2e 80 00       	push   $0x802ef6
+  800753:	e8 69 03 00 00       	call   800ac1 <cprintf>
+  800758:	83 c4 10             	add    $0x10,%esp
+    vcprintf(fmt, ap);
+  80075b:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  80075e:	83 ec 08             	sub    $0x8,%esp
+  800761:	50                   	push   %eax
+  800762:	ff 75 10             	push   0x10(%ebp)
+  800765:	e8 26 03 00 00       	call   800a90 <vcprintf>
+  80076a:	83 c4 10             	add    $0x10,%esp
+    cprintf("\n");
+  80076d:	83 ec 0c             	sub    $0xc,%esp
+  800770:	68 10 2f 80 00       	push   $0x802f10
+  800775:	e8 47 03 00 00       	call   800ac1 <cprintf>
+  80077a:	83 c4 10             	add    $0x10,%esp
+    va_end(ap);
+    exit(-E_PANIC);
+  80077d:	83 ec 0c             	sub    $0xc,%esp
+  800780:	6a f6                	push   $0xfffffff6
+  800782:	e8 78 0b 00 00       	call   8012ff <exit>
+
+00800787 <__warn>:
+}
+
+void
+__warn(const char *file, int line, const char *fmt, ...) {
+  800787:	55                   	push   %ebp
+  800788:	89 e5                	mov    %esp,%ebp
+  80078a:	83 ec 18             	sub    $0x18,%esp
+    va_list ap;
+    va_start(ap, fmt);
+  80078d:	8d 45 14             	lea    0x14(%ebp),%eax
+  800790:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    cprintf("user warning at %s:%d:\n    ", file, line);
+  800793:	83 ec 04             	sub    $0x4,%esp
+  800796:	ff 75 0c             	push   0xc(%ebp)
+  800799:	ff 75 08             	push   0x8(%ebp)
+  80079c:	68 12 2f 80 00       	push   $0x802f12
+  8007a1:	e8 1b 03 00 00       	call   800ac1 <cprintf>
+  8007a6:	83 c4 10             	add    $0x10,%esp
+    vcprintf(fmt, ap);
+  8007a9:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  8007ac:	83 ec 08             	sub    $0x8,%esp
+  8007af:	50                   	push   %eax
+  8007b0:	ff 75 10             	push   0x10(%ebp)
+  8007b3:	e8 d8 02 00 00       	call   800a90 <vcprintf>
+  8007b8:	83 c4 10             	add    $0x10,%esp
+    cprintf("\n");
+  8007bb:	83 ec 0c             	sub    $0xc,%esp
+  8007be:	68 10 2f 80 00       	push   $0x802f10
+  8007c3:	e8 f9 02 00 00       	call   800ac1 <cprintf>
+  8007c8:	83 c4 10             	add    $0x10,%esp
+    va_end(ap);
+}
+  8007cb:	90                   	nop
+  8007cc:	c9                   	leave
+  8007cd:	c3                   	ret
+
+008007ce <get_pdb>:
+#include <string.h>
+#include <syscall.h>
+#include <stdio.h>
+
+int get_pdb(void *base)
+{
+  8007ce:	55                   	push   %ebp
+  8007cf:	89 e5                	mov    %esp,%ebp
+  8007d1:	83 ec 08             	sub    $0x8,%esp
+    return sys_get_pdb(base);
+  8007d4:	83 ec 0c             	sub    $0xc,%esp
+  8007d7:	ff 75 08             	push   0x8(%ebp)
+  8007da:	e8 e9 07 00 00       	call   800fc8 <sys_get_pdb>
+  8007df:	83 c4 10             	add    $0x10,%esp
+}
+  8007e2:	c9                   	leave
+  8007e3:	c3                   	ret
+
+008007e4 <nice>:
+
+int nice(int pid, int prior)
+{
+  8007e4:	55                   	push   %ebp
+  8007e5:	89 e5                	mov    %esp,%ebp
+  8007e7:	83 ec 08             	sub    $0x8,%esp
+    return sys_nice(pid, prior);
+  8007ea:	83 ec 08             	sub    $0x8,%esp
+  8007ed:	ff 75 0c             	push   0xc(%ebp)
+  8007f0:	ff 75 08             	push   0x8(%ebp)
+  8007f3:	e8 0f 08 00 00       	call   801007 <sys_nice>
+  8007f8:	83 c4 10             	add    $0x10,%esp
+  8007fb:	c9                   	leave
+  8007fc:	c3                   	ret
+
+008007fd <pthread_create>:
+
+// bit i set: TLS slot i is handed out
+static volatile uint32_t tls_keys[(TLS_NSLOTS + 31) / 32];
+
+int pthread_create(pthread_t *newthread, void *(*fn)(void *), void *arg)
+{
+  8007fd:	55                   	push   %ebp
+  8007fe:	89 e5                	mov    %esp,%ebp
+  800800:	83 ec 08             	sub    $0x8,%esp
+  return sys_clone(newthread, fn, arg, pthread_exit, 0);
+  800803:	83 ec 0c             	sub    $0xc,%esp
+  800806:	6a 00                	push   $0x0
+  800808:	68 60 08 80 00       	push   $0x800860
+  80080d:	ff 75 10             	push   0x10(%ebp)
+  800810:	ff 75 0c             	push   0xc(%ebp)
+  800813:	ff 75 08             	push   0x8(%ebp)
+  800816:	e8 c8 07 00 00       	call   800fe3 <sys_clone>
+  80081b:	83 c4 20             	add    $0x20,%esp
+}
+  80081e:	c9                   	leave
+  80081f:	c3                   	ret
+
+00800820 <pthread_create_stack>:
+
+int pthread_create_stack(pthread_t *newthread, void *(*fn)(void *), void *arg, size_t stacksize)
+{
+  800820:	55                   	push   %ebp
+  800821:	89 e5                	mov    %esp,%ebp
+  800823:	83 ec 08             	sub    $0x8,%esp
+  return sys_clone(newthread, fn, arg, pthread_exit, stacksize);
+  800826:	83 ec 0c             	sub    $0xc,%esp
+  800829:	ff 75 14             	push   0x14(%ebp)
+  80082c:	68 60 08 80 00       	push   $0x800860
+  800831:	ff 75 10             	push   0x10(%ebp)
+  800834:	ff 75 0c             	push   0xc(%ebp)
+  800837:	ff 75 08             	push   0x8(%ebp)
+  80083a:	e8 a4 07 00 00       	call   800fe3 <sys_clone>
+  80083f:	83 c4 20             	add    $0x20,%esp
+}
+  800842:	c9                   	leave
+  800843:	c3                   	ret
+
+00800844 <pthread_join>:
+
+int pthread_join(pthread_t *newthread)
+{
+  800844:	55                   	push   %ebp
+  800845:	89 e5                	mov    %esp,%ebp
+  800847:	83 ec 08             	sub    $0x8,%esp
+  waitpid(*newthread, NULL);
+  80084a:	8b 45 08             	mov    0x8(%ebp),%eax
+  80084d:	8b 00                	mov    (%eax),%eax
+  80084f:	83 ec 08             	sub    $0x8,%esp
+  800852:	6a 00                	push   $0x0
+  800854:	50                   	push   %eax
+  800855:	e8 f0 0a 00 00       	call   80134a <waitpid>
+  80085a:	83 c4 10             	add    $0x10,%esp
+}
+  80085d:	90                   	nop
+  80085e:	c9                   	leave
+  80085f:	c3                   	ret
+
+00800860 <pthread_exit>:
+
+void pthread_exit(int error_code)
+{
+  800860:	55                   	push   %ebp
+  800861:	89 e5                	mov    %esp,%ebp
+  800863:	83 ec 08             	sub    $0x8,%esp
+  exit(error_code);
+  800866:	83 ec 0c             	sub    $0xc,%esp
+  800869:	ff 75 08             	push   0x8(%ebp)
+  80086c:	e8 8e 0a 00 00       	call   8012ff <exit>
+
+00800871 <phtread_daemon>:
+}
+
+void phtread_daemon(){
+  800871:	55                   	push   %ebp
+  800872:	89 e5                	mov    %esp,%ebp
+  800874:	83 ec 08             	sub    $0x8,%esp
+  waitpid(-1, NULL);
+  800877:	83 ec 08             	sub    $0x8,%esp
+  80087a:	6a 00                	push   $0x0
+  80087c:	6a ff                	push   $0xffffffff
+  80087e:	e8 c7 0a 00 00       	call   80134a <waitpid>
+  800883:	83 c4 10             	add    $0x10,%esp
+}
+  800886:	90                   	nop
+  800887:	c9                   	leave
+  800888:	c3                   	ret
+
+00800889 <pthread_key_create>:
+
+int pthread_key_create(pthread_key_t *key)
+{
+  800889:	55                   	push   %ebp
+  80088a:	89 e5                	mov    %esp,%ebp
+  80088c:	83 ec 10             	sub    $0x10,%esp
+  int i;
+  for (i = 0; i < TLS_NSLOTS; i++)
+  80088f:	c7 45 fc 00 00 00 00 	movl   $0x0,-0x4(%ebp)
+  800896:	eb 3c                	jmp    8008d4 <pthread_key_create+0x4b>
+  800898:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  80089b:	89 45 f8             	mov    %eax,-0x8(%ebp)
+  80089e:	c7 45 f4 94 41 80 00 	movl   $0x804194,-0xc(%ebp)
+    asm volatile ("btsl %2, %1; sbbl %0, %0" : "=r" (oldbit), "=m" (*(volatile long *)addr) : "Ir" (nr) : "memory");
+  8008a5:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  8008a8:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  8008ab:	0f ab 02             	bts    %eax,(%edx)
+  8008ae:	19 c0                	sbb    %eax,%eax
+  8008b0:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    return oldbit != 0;
+  8008b3:	83 7d f0 00          	cmpl   $0x0,-0x10(%ebp)
+  8008b7:	0f 95 c0             	setne  %al
+  8008ba:	0f b6 c0             	movzbl %al,%eax
+    if (!test_and_set_bit(i, tls_keys))
+  8008bd:	85 c0                	test   %eax,%eax
+  8008bf:	75 0f                	jne    8008d0 <pthread_key_create+0x47>
+    {
+      *key = i;
+  8008c1:	8b 45 08             	mov    0x8(%ebp),%eax
+  8008c4:	8b 55 fc             	mov    -0x4(%ebp),%edx
+  8008c7:	89 10                	mov    %edx,(%eax)
+      return 0;
+  8008c9:	b8 00 00 00 00       	mov    $0x0,%eax
+  8008ce:	eb 0f                	jmp    8008df <pthread_key_create+0x56>
+  for (i = 0; i < TLS_NSLOTS; i++)
+  8008d0:	83 45 fc 01          	addl   $0x1,-0x4(%ebp)
+  8008d4:	83 7d fc 3d          	cmpl   $0x3d,-0x4(%ebp)
+  8008d8:	7e be                	jle    800898 <pthread_key_create+0xf>
+    }
+  return -E_NO_MEM;
+  8008da:	b8 fc ff ff ff       	mov    $0xfffffffc,%eax
+}
+  8008df:	c9                   	leave
+  8008e0:	c3                   	ret
+
+008008e1 <pthread_key_delete>:
+
+void pthread_key_delete(pthread_key_t key)
+{
+  8008e1:	55                   	push   %ebp
+  8008e2:	89 e5                	mov    %esp,%ebp
+  8008e4:	83 ec 10             	sub    $0x10,%esp
+  if (0 <= key && key < TLS_NSLOTS)
+  8008e7:	83 7d 08 00          	cmpl   $0x0,0x8(%ebp)
+  8008eb:	78 1d                	js     80090a <pthread_key_delete+0x29>
+  8008ed:	83 7d 08 3d          	cmpl   $0x3d,0x8(%ebp)
+  8008f1:	7f 17                	jg     80090a <pthread_key_delete+0x29>
+  8008f3:	8b 45 08             	mov    0x8(%ebp),%eax
+  8008f6:	89 45 fc             	mov    %eax,-0x4(%ebp)
+  8008f9:	c7 45 f8 94 41 80 00 	movl   $0x804194,-0x8(%ebp)
+    asm volatile ("btrl %1, %0" :"=m" (*(volatile long *)addr) : "Ir" (nr));
+  800900:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  800903:	8b 55 fc             	mov    -0x4(%ebp),%edx
+  800906:	0f b3 10             	btr    %edx,(%eax)
+}
+  800909:	90                   	nop
+    clear_bit(key, tls_keys);
+}
+  80090a:	90                   	nop
+  80090b:	c9                   	leave
+  80090c:	c3                   	ret
+
+0080090d <sem_init>:
+#include <error.h>
+#include <syscall.h>
+#include <semaphore.h>
+
+int sem_init(semaphore_t *sem, int value)
+{
+  80090d:	55                   	push   %ebp
+  80090e:	89 e5                	mov    %esp,%ebp
+  if (value < 0)
+  800910:	83 7d 0c 00          	cmpl   $0x0,0xc(%ebp)
+  800914:	79 07                	jns    80091d <sem_init+0x10>
+    return -E_INVAL;
+  800916:	b8 fd ff ff ff       	mov    $0xfffffffd,%eax
+  80091b:	eb 17                	jmp    800934 <sem_init+0x27>
+  sem->value = value;
+  80091d:	8b 45 08             	mov    0x8(%ebp),%eax
+  800920:	8b 55 0c             	mov    0xc(%ebp),%edx
+  800923:	89 10                	mov    %edx,(%eax)
+  sem->waiters = 0;
+  800925:	8b 45 08             	mov    0x8(%ebp),%eax
+  800928:	c7 40 04 00 00 00 00 	movl   $0x0,0x4(%eax)
+  return 0;
+  80092f:	b8 00 00 00 00       	mov    $0x0,%eax
+}
+  800934:	5d                   	pop    %ebp
+  800935:	c3                   	ret
+
+00800936 <sem_trywait>:
+
+int sem_trywait(semaphore_t *sem)
+{
+  800936:	55                   	push   %ebp
+  800937:	89 e5                	mov    %esp,%ebp
+  800939:	53                   	push   %ebx
+  80093a:	83 ec 20             	sub    $0x20,%esp
+  int v;
+  while ((v = sem->value) > 0)
+  80093d:	eb 37                	jmp    800976 <sem_trywait+0x40>
+    if (cmpxchg(&sem->value, v, v - 1) == v)
+  80093f:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  800942:	8d 50 ff             	lea    -0x1(%eax),%edx
+  800945:	8b 45 08             	mov    0x8(%ebp),%eax
+  800948:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  80094b:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  80094e:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  800951:	89 55 ec             	mov    %edx,-0x14(%ebp)
+    asm volatile ("lock; cmpxchgl %2, %1" : "=a" (prev), "+m" (*addr) : "r" (new), "0" (old) : "memory");
+  800954:	8b 5d f4             	mov    -0xc(%ebp),%ebx
+  800957:	8b 55 ec             	mov    -0x14(%ebp),%edx
+  80095a:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  80095d:	8b 4d f4             	mov    -0xc(%ebp),%ecx
+  800960:	f0 0f b1 13          	lock cmpxchg %edx,(%ebx)
+  800964:	89 45 e8             	mov    %eax,-0x18(%ebp)
+    return prev;
+  800967:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  80096a:	39 45 f8             	cmp    %eax,-0x8(%ebp)
+  80096d:	75 07                	jne    800976 <sem_trywait+0x40>
+      return 0;
+  80096f:	b8 00 00 00 00       	mov    $0x0,%eax
+  800974:	eb 13                	jmp    800989 <sem_trywait+0x53>
+  while ((v = sem->value) > 0)
+  800976:	8b 45 08             	mov    0x8(%ebp),%eax
+  800979:	8b 00                	mov    (%eax),%eax
+  80097b:	89 45 f8             	mov    %eax,-0x8(%ebp)
+  80097e:	83 7d f8 00          	cmpl   $0x0,-0x8(%ebp)
+  800982:	7f bb                	jg     80093f <sem_trywait+0x9>
+  return -E_AGAIN;
+  800984:	b8 e7 ff ff ff       	mov    $0xffffffe7,%eax
+}
+  800989:	8b 5d fc             	mov    -0x4(%ebp),%ebx
+  80098c:	c9                   	leave
+  80098d:	c3                   	ret
+
+0080098e <sem_wait>:
+
+int sem_wait(semaphore_t *sem)
+{
+  80098e:	55                   	push   %ebp
+  80098f:	89 e5                	mov    %esp,%ebp
+  800991:	83 ec 28             	sub    $0x28,%esp
+  while (sem_trywait(sem) != 0)
+  800994:	eb 62                	jmp    8009f8 <sem_wait+0x6a>
+  {
+    // announce ourselves before sleeping; FUTEX_WAIT rechecks value == 0
+    // in the kernel, so a post that slips in between is never lost
+    xadd(&sem->waiters, 1);
+  800996:	8b 45 08             	mov    0x8(%ebp),%eax
+  800999:	83 c0 04             	add    $0x4,%eax
+  80099c:	89 45 e8             	mov    %eax,-0x18(%ebp)
+  80099f:	c7 45 e4 01 00 00 00 	movl   $0x1,-0x1c(%ebp)
+ * @addr:   the word to add to
+ * @val:    the amount to add, may be negative
+ * */
+static inline int
+xadd(volatile int *addr, int val) {
+    asm volatile ("lock; xaddl %0, %1" : "+r" (val), "+m" (*addr) :: "memory");
+  8009a6:	8b 4d e8             	mov    -0x18(%ebp),%ecx
+  8009a9:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  8009ac:	8b 55 e8             	mov    -0x18(%ebp),%edx
+  8009af:	f0 0f c1 01          	lock xadd %eax,(%ecx)
+  8009b3:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+    int ret = sys_futex(&sem->value, FUTEX_WAIT, 0);
+  8009b6:	8b 45 08             	mov    0x8(%ebp),%eax
+  8009b9:	83 ec 04             	sub    $0x4,%esp
+  8009bc:	6a 00                	push   $0x0
+  8009be:	6a 00                	push   $0x0
+  8009c0:	50                   	push   %eax
+  8009c1:	e8 f5 06 00 00       	call   8010bb <sys_futex>
+  8009c6:	83 c4 10             	add    $0x10,%esp
+  8009c9:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    xadd(&sem->waiters, -1);
+  8009cc:	8b 45 08             	mov    0x8(%ebp),%eax
+  8009cf:	83 c0 04             	add    $0x4,%eax
+  8009d2:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  8009d5:	c7 45 ec ff ff ff ff 	movl   $0xffffffff,-0x14(%ebp)
+  8009dc:	8b 4d f0             	mov    -0x10(%ebp),%ecx
+  8009df:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  8009e2:	8b 55 f0             	mov    -0x10(%ebp),%edx
+  8009e5:	f0 0f c1 01          	lock xadd %eax,(%ecx)
+  8009e9:	89 45 ec             	mov    %eax,-0x14(%ebp)
+    return val;
+  8009ec:	90                   	nop
+    if (ret == -E_KILLED)
+  8009ed:	83 7d f4 f7          	cmpl   $0xfffffff7,-0xc(%ebp)
+  8009f1:	75 05                	jne    8009f8 <sem_wait+0x6a>
+      return ret;
+  8009f3:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  8009f6:	eb 17                	jmp    800a0f <sem_wait+0x81>
+  while (sem_trywait(sem) != 0)
+  8009f8:	83 ec 0c             	sub    $0xc,%esp
+  8009fb:	ff 75 08             	push   0x8(%ebp)
+  8009fe:	e8 33 ff ff ff       	call   800936 <sem_trywait>
+  800a03:	83 c4 10             	add    $0x10,%esp
+  800a06:	85 c0                	test   %eax,%eax
+  800a08:	75 8c                	jne    800996 <sem_wait+0x8>
+  }
+  return 0;
+  800a0a:	b8 00 00 00 00       	mov    $0x0,%eax
+}
+  800a0f:	c9                   	leave
+  800a10:	c3                   	ret
+
+00800a11 <sem_post>:
+
+int sem_post(semaphore_t *sem)
+{
+  800a11:	55                   	push   %ebp
+  800a12:	89 e5                	mov    %esp,%ebp
+  800a14:	83 ec 18             	sub    $0x18,%esp
+  xadd(&sem->value, 1);
+  800a17:	8b 45 08             	mov    0x8(%ebp),%eax
+  800a1a:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  800a1d:	c7 45 f0 01 00 00 00 	movl   $0x1,-0x10(%ebp)
+    asm volatile ("lock; xaddl %0, %1" : "+r" (val), "+m" (*addr) :: "memory");
+  800a24:	8b 4d f4             	mov    -0xc(%ebp),%ecx
+  800a27:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800a2a:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  800a2d:	f0 0f c1 01          	lock xadd %eax,(%ecx)
+  800a31:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  if (sem->waiters > 0)
+  800a34:	8b 45 08             	mov    0x8(%ebp),%eax
+  800a37:	8b 40 04             	mov    0x4(%eax),%eax
+  800a3a:	85 c0                	test   %eax,%eax
+  800a3c:	7e 13                	jle    800a51 <sem_post+0x40>
+    sys_futex(&sem->value, FUTEX_WAKE, 1);
+  800a3e:	8b 45 08             	mov    0x8(%ebp),%eax
+  800a41:	83 ec 04             	sub    $0x4,%esp
+  800a44:	6a 01                	push   $0x1
+  800a46:	6a 01                	push   $0x1
+  800a48:	50                   	push   %eax
+  800a49:	e8 6d 06 00 00       	call   8010bb <sys_futex>
+  800a4e:	83 c4 10             	add    $0x10,%esp
+  return 0;
+  800a51:	b8 00 00 00 00       	mov    $0x0,%eax
+}
+  800a56:	c9                   	leave
+  800a57:	c3                   	ret
+
+00800a58 <sem_getvalue>:
+
+int sem_getvalue(semaphore_t *sem, int *value)
+{
+  800a58:	55                   	push   %ebp
+  800a59:	89 e5                	mov    %esp,%ebp
+  *value = sem->value;
+  800a5b:	8b 45 08             	mov    0x8(%ebp),%eax
+  800a5e:	8b 10                	mov    (%eax),%edx
+  800a60:	8b 45 0c             	mov    0xc(%ebp),%eax
+  800a63:	89 10                	mov    %edx,(%eax)
+  return 0;
+  800a65:	b8 00 00 00 00       	mov    $0x0,%eax
+}
+  800a6a:	5d                   	pop    %ebp
+  800a6b:	c3                   	ret
+
+00800a6c <cputch>:
+/* *
+ * cputch - writes a single character @c to stdout, and it will
+ * increace the value of counter pointed by @cnt.
+ * */
+static void
+cputch(int c, int *cnt) {
+  800a6c:	55                   	push   %ebp
+  800a6d:	89 e5                	mov    %esp,%ebp
+  800a6f:	83 ec 08             	sub    $0x8,%esp
+    sys_putc(c);
+  800a72:	83 ec 0c             	sub    $0xc,%esp
+  800a75:	ff 75 08             	push   0x8(%ebp)
+  800a78:	e8 4a 03 00 00       	call   800dc7 <sys_putc>
+  800a7d:	83 c4 10             	add    $0x10,%esp
+    (*cnt) ++;
+  800a80:	8b 45 0c             	mov    0xc(%ebp),%eax
+  800a83:	8b 00                	mov    (%eax),%eax
+  800a85:	8d 50 01             	lea    0x1(%eax),%edx
+  800a88:	8b 45 0c             	mov    0xc(%ebp),%eax
+  800a8b:	89 10                	mov    %edx,(%eax)
+}
+  800a8d:	90                   	nop
+  800a8e:	c9                   	leave
+  800a8f:	c3                   	ret
+
+00800a90 <vcprintf>:
+ *
+ * Call this function if you are already dealing with a va_list.
+ * Or you probably want cprintf() instead.
+ * */
+int
+vcprintf(const char *fmt, va_list ap) {
+  800a90:	55                   	push   %ebp
+  800a91:	89 e5                	mov    %esp,%ebp
+  800a93:	83 ec 18             	sub    $0x18,%esp
+    int cnt = 0;
+  800a96:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+    vprintfmt((void*)cputch, NO_FD, &cnt, fmt, ap);
+  800a9d:	83 ec 0c             	sub    $0xc,%esp
+  800aa0:	ff 75 0c             	push   0xc(%ebp)
+  800aa3:	ff 75 08             	push   0x8(%ebp)
+  800aa6:	8d 45 f4             	lea    -0xc(%ebp),%eax
+  800aa9:	50                   	push   %eax
+  800aaa:	68 d9 6a ff ff       	push   $0xffff6ad9
+  800aaf:	68 6c 0a 80 00       	push   $0x800a6c
+  800ab4:	e8 eb 0d 00 00       	call   8018a4 <vprintfmt>
+  800ab9:	83 c4 20             	add    $0x20,%esp
+    return cnt;
+  800abc:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  800abf:	c9                   	leave
+  800ac0:	c3                   	ret
+
+00800ac1 <cprintf>:
+ *
+ * The return value is the number of characters which would be
+ * written to stdout.
+ * */
+int
+cprintf(const char *fmt, ...) {
+  800ac1:	55                   	push   %ebp
+  800ac2:	89 e5                	mov    %esp,%ebp
+  800ac4:	83 ec 18             	sub    $0x18,%esp
+    va_list ap;
+
+    va_start(ap, fmt);
+  800ac7:	8d 45 0c             	lea    0xc(%ebp),%eax
+  800aca:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    int cnt = vcprintf(fmt, ap);
+  800acd:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800ad0:	83 ec 08             	sub    $0x8,%esp
+  800ad3:	50                   	push   %eax
+  800ad4:	ff 75 08             	push   0x8(%ebp)
+  800ad7:	e8 b4 ff ff ff       	call   800a90 <vcprintf>
+  800adc:	83 c4 10             	add    $0x10,%esp
+  800adf:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    va_end(ap);
+
+    return cnt;
+  800ae2:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  800ae5:	c9                   	leave
+  800ae6:	c3                   	ret
+
+00800ae7 <cputs>:
+/* *
+ * cputs- writes the string pointed by @str to stdout and
+ * appends a newline character.
+ * */
+int
+cputs(const char *str) {
+  800ae7:	55                   	push   %ebp
+  800ae8:	89 e5                	mov    %esp,%ebp
+  800aea:	83 ec 18             	sub    $0x18,%esp
+    int cnt = 0;
+  800aed:	c7 45 f0 00 00 00 00 	movl   $0x0,-0x10(%ebp)
+    char c;
+    while ((c = *str ++) != '\0') {
+  800af4:	eb 14                	jmp    800b0a <cputs+0x23>
+        cputch(c, &cnt);
+  800af6:	0f be 45 f7          	movsbl -0x9(%ebp),%eax
+  800afa:	83 ec 08             	sub    $0x8,%esp
+  800afd:	8d 55 f0             	lea    -0x10(%ebp),%edx
+  800b00:	52                   	push   %edx
+  800b01:	50                   	push   %eax
+  800b02:	e8 65 ff ff ff       	call   800a6c <cputch>
+  800b07:	83 c4 10             	add    $0x10,%esp
+    while ((c = *str ++) != '\0') {
+  800b0a:	8b 45 08             	mov    0x8(%ebp),%eax
+  800b0d:	8d 50 01             	lea    0x1(%eax),%edx
+  800b10:	89 55 08             	mov    %edx,0x8(%ebp)
+  800b13:	0f b6 00             	movzbl (%eax),%eax
+  800b16:	88 45 f7             	mov    %al,-0x9(%ebp)
+  800b19:	80 7d f7 00          	cmpb   $0x0,-0x9(%ebp)
+  800b1d:	75 d7                	jne    800af6 <cputs+0xf>
+    }
+    cputch('\n', &cnt);
+  800b1f:	83 ec 08             	sub    $0x8,%esp
+  800b22:	8d 45 f0             	lea    -0x10(%ebp),%eax
+  800b25:	50                   	push   %eax
+  800b26:	6a 0a                	push   $0xa
+  800b28:	e8 3f ff ff ff       	call   800a6c <cputch>
+  800b2d:	83 c4 10             	add    $0x10,%esp
+    return cnt;
+  800b30:	8b 45 f0             	mov    -0x10(%ebp),%eax
+}
+  800b33:	c9                   	leave
+  800b34:	c3                   	ret
+
+00800b35 <fputch>:
+
+
+static void
+fputch(char c, int *cnt, int fd) {
+  800b35:	55                   	push   %ebp
+  800b36:	89 e5                	mov    %esp,%ebp
+  800b38:	83 ec 18             	sub    $0x18,%esp
+  800b3b:	8b 45 08             	mov    0x8(%ebp),%eax
+  800b3e:	88 45 f4             	mov    %al,-0xc(%ebp)
+    write(fd, &c, sizeof(char));
+  800b41:	83 ec 04             	sub    $0x4,%esp
+  800b44:	6a 01                	push   $0x1
+  800b46:	8d 45 f4             	lea    -0xc(%ebp),%eax
+  800b49:	50                   	push   %eax
+  800b4a:	ff 75 10             	push   0x10(%ebp)
+  800b4d:	e8 4f f6 ff ff       	call   8001a1 <write>
+  800b52:	83 c4 10             	add    $0x10,%esp
+    (*cnt) ++;
+  800b55:	8b 45 0c             	mov    0xc(%ebp),%eax
+  800b58:	8b 00                	mov    (%eax),%eax
+  800b5a:	8d 50 01             	lea    0x1(%eax),%edx
+  800b5d:	8b 45 0c             	mov    0xc(%ebp),%eax
+  800b60:	89 10                	mov    %edx,(%eax)
+}
+  800b62:	90                   	nop
+  800b63:	c9                   	leave
+  800b64:	c3                   	ret
+
+00800b65 <vfprintf>:
+
+int
+vfprintf(int fd, const char *fmt, va_list ap) {
+  800b65:	55                   	push   %ebp
+  800b66:	89 e5                	mov    %esp,%ebp
+  800b68:	83 ec 18             	sub    $0x18,%esp
+    int cnt = 0;
+  800b6b:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+    vprintfmt((void*)fputch, fd, &cnt, fmt, ap);
+  800b72:	83 ec 0c             	sub    $0xc,%esp
+  800b75:	ff 75 10             	push   0x10(%ebp)
+  800b78:	ff 75 0c             	push   0xc(%ebp)
+  800b7b:	8d 45 f4             	lea    -0xc(%ebp),%eax
+  800b7e:	50                   	push   %eax
+  800b7f:	ff 75 08             	push   0x8(%ebp)
+  800b82:	68 35 0b 80 00       	push   $0x800b35
+  800b87:	e8 18 0d 00 00       	call   8018a4 <vprintfmt>
+  800b8c:	83 c4 20             	add    $0x20,%esp
+    return cnt;
+  800b8f:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  800b92:	c9                   	leave
+  800b93:	c3                   	ret
+
+00800b94 <fprintf>:
+
+int
+fprintf(int fd, const char *fmt, ...) {
+  800b94:	55                   	push   %ebp
+  800b95:	89 e5                	mov    %esp,%ebp
+  800b97:	83 ec 18             	sub    $0x18,%esp
+    va_list ap;
+
+    va_start(ap, fmt);
+  800b9a:	8d 45 10             	lea    0x10(%ebp),%eax
+  800b9d:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    int cnt = vfprintf(fd, fmt, ap);
+  800ba0:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800ba3:	83 ec 04             	sub    $0x4,%esp
+  800ba6:	50                   	push   %eax
+  800ba7:	ff 75 0c             	push   0xc(%ebp)
+  800baa:	ff 75 08             	push   0x8(%ebp)
+  800bad:	e8 b3 ff ff ff       	call   800b65 <vfprintf>
+  800bb2:	83 c4 10             	add    $0x10,%esp
+  800bb5:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    va_end(ap);
+
+    return cnt;
+  800bb8:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  800bbb:	c9                   	leave
+  800bbc:	c3                   	ret
+
+00800bbd <sysenter_supported>:
+// -1 until the first syscall probes CPUID, then whether sysenter is used
+static int use_sysenter = -1;
+
+/* sysenter_supported - same test the kernel makes before it sets up the MSRs */
+static bool
+sysenter_supported(void) {
+  800bbd:	55                   	push   %ebp
+  800bbe:	89 e5                	mov    %esp,%ebp
+  800bc0:	53                   	push   %ebx
+  800bc1:	83 ec 40             	sub    $0x40,%esp
+  800bc4:	c7 45 ec 01 00 00 00 	movl   $0x1,-0x14(%ebp)
+  800bcb:	8d 45 c8             	lea    -0x38(%ebp),%eax
+  800bce:	89 45 e8             	mov    %eax,-0x18(%ebp)
+  800bd1:	c7 45 e4 00 00 00 00 	movl   $0x0,-0x1c(%ebp)
+  800bd8:	c7 45 e0 00 00 00 00 	movl   $0x0,-0x20(%ebp)
+  800bdf:	8d 45 c4             	lea    -0x3c(%ebp),%eax
+  800be2:	89 45 dc             	mov    %eax,-0x24(%ebp)
+
+/* cpuid - query processor identification; any of the output pointers may be NULL */
+static inline void
+cpuid(uint32_t info, uint32_t *eaxp, uint32_t *ebxp, uint32_t *ecxp, uint32_t *edxp) {
+    uint32_t eax, ebx, ecx, edx;
+    asm volatile ("cpuid"
+  800be5:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  800be8:	ba 00 00 00 00       	mov    $0x0,%edx
+  800bed:	89 d1                	mov    %edx,%ecx
+  800bef:	0f a2                	cpuid
+  800bf1:	89 45 d8             	mov    %eax,-0x28(%ebp)
+  800bf4:	89 5d d4             	mov    %ebx,-0x2c(%ebp)
+  800bf7:	89 4d d0             	mov    %ecx,-0x30(%ebp)
+  800bfa:	89 55 cc             	mov    %edx,-0x34(%ebp)
+                  : "=a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx)
+                  : "a" (info), "c" (0));
+    if (eaxp != NULL) *eaxp = eax;
+  800bfd:	83 7d e8 00          	cmpl   $0x0,-0x18(%ebp)
+  800c01:	74 08                	je     800c0b <sysenter_supported+0x4e>
+  800c03:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  800c06:	8b 55 d8             	mov    -0x28(%ebp),%edx
+  800c09:	89 10                	mov    %edx,(%eax)
+    if (ebxp != NULL) *ebxp = ebx;
+  800c0b:	83 7d e4 00          	cmpl   $0x0,-0x1c(%ebp)
+  800c0f:	74 08                	je     800c19 <sysenter_supported+0x5c>
+  800c11:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  800c14:	8b 55 d4             	mov    -0x2c(%ebp),%edx
+  800c17:	89 10                	mov    %edx,(%eax)
+    if (ecxp != NULL) *ecxp = ecx;
+  800c19:	83 7d e0 00          	cmpl   $0x0,-0x20(%ebp)
+  800c1d:	74 08                	je     800c27 <sysenter_supported+0x6a>
+  800c1f:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  800c22:	8b 55 d0             	mov    -0x30(%ebp),%edx
+  800c25:	89 10                	mov    %edx,(%eax)
+    if (edxp != NULL) *edxp = edx;
+  800c27:	83 7d dc 00          	cmpl   $0x0,-0x24(%ebp)
+  800c2b:	74 08                	je     800c35 <sysenter_supported+0x78>
+  800c2d:	8b 45 dc             	mov    -0x24(%ebp),%eax
+  800c30:	8b 55 cc             	mov    -0x34(%ebp),%edx
+  800c33:	89 10                	mov    %edx,(%eax)
+}
+  800c35:	90                   	nop
+    uint32_t eax, edx;
+    cpuid(1, &eax, NULL, NULL, &edx);
+    if (!(edx & CPUID_FEAT_SEP)) {
+  800c36:	8b 45 c4             	mov    -0x3c(%ebp),%eax
+  800c39:	25 00 08 00 00       	and    $0x800,%eax
+  800c3e:	85 c0                	test   %eax,%eax
+  800c40:	75 07                	jne    800c49 <sysenter_supported+0x8c>
+        return 0;
+  800c42:	b8 00 00 00 00       	mov    $0x0,%eax
+  800c47:	eb 3f                	jmp    800c88 <sysenter_supported+0xcb>
+    }
+    uint32_t family = (eax >> 8) & 0xF, model = (eax >> 4) & 0xF, stepping = eax & 0xF;
+  800c49:	8b 45 c8             	mov    -0x38(%ebp),%eax
+  800c4c:	c1 e8 08             	shr    $0x8,%eax
+  800c4f:	83 e0 0f             	and    $0xf,%eax
+  800c52:	89 45 f8             	mov    %eax,-0x8(%ebp)
+  800c55:	8b 45 c8             	mov    -0x38(%ebp),%eax
+  800c58:	c1 e8 04             	shr    $0x4,%eax
+  800c5b:	83 e0 0f             	and    $0xf,%eax
+  800c5e:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  800c61:	8b 45 c8             	mov    -0x38(%ebp),%eax
+  800c64:	83 e0 0f             	and    $0xf,%eax
+  800c67:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    return !(family == 6 && model < 3 && stepping < 3);
+  800c6a:	83 7d f8 06          	cmpl   $0x6,-0x8(%ebp)
+  800c6e:	75 0c                	jne    800c7c <sysenter_supported+0xbf>
+  800c70:	83 7d f4 02          	cmpl   $0x2,-0xc(%ebp)
+  800c74:	77 06                	ja     800c7c <sysenter_supported+0xbf>
+  800c76:	83 7d f0 02          	cmpl   $0x2,-0x10(%ebp)
+  800c7a:	76 07                	jbe    800c83 <sysenter_supported+0xc6>
+  800c7c:	b8 01 00 00 00       	mov    $0x1,%eax
+  800c81:	eb 05                	jmp    800c88 <sysenter_supported+0xcb>
+  800c83:	b8 00 00 00 00       	mov    $0x0,%eax
+}
+  800c88:	8b 5d fc             	mov    -0x4(%ebp),%ebx
+  800c8b:	c9                   	leave
+  800c8c:	c3                   	ret
+
+00800c8d <syscall_set_sysenter>:
+/* *
+ * syscall_set_sysenter - choose between sysenter and int 0x80; sysenter is
+ * only used where the CPU supports it. Returns whether it is in use now.
+ * */
+int
+syscall_set_sysenter(int on) {
+  800c8d:	55                   	push   %ebp
+  800c8e:	89 e5                	mov    %esp,%ebp
+    use_sysenter = (on && sysenter_supported());
+  800c90:	83 7d 08 00          	cmpl   $0x0,0x8(%ebp)
+  800c94:	74 10                	je     800ca6 <syscall_set_sysenter+0x19>
+  800c96:	e8 22 ff ff ff       	call   800bbd <sysenter_supported>
+  800c9b:	85 c0                	test   %eax,%eax
+  800c9d:	74 07                	je     800ca6 <syscall_set_sysenter+0x19>
+  800c9f:	b8 01 00 00 00       	mov    $0x1,%eax
+  800ca4:	eb 05                	jmp    800cab <syscall_set_sysenter+0x1e>
+  800ca6:	b8 00 00 00 00       	mov    $0x0,%eax
+  800cab:	a3 08 40 80 00       	mov    %eax,0x804008
+    return use_sysenter;
+  800cb0:	a1 08 40 80 00       	mov    0x804008,%eax
+}
+  800cb5:	5d                   	pop    %ebp
+  800cb6:	c3                   	ret
+
+00800cb7 <syscall>:
+
+static inline int
+syscall(int num, ...) {
+  800cb7:	55                   	push   %ebp
+  800cb8:	89 e5                	mov    %esp,%ebp
+  800cba:	57                   	push   %edi
+  800cbb:	56                   	push   %esi
+  800cbc:	53                   	push   %ebx
+  800cbd:	83 ec 2c             	sub    $0x2c,%esp
+    va_list ap;
+    va_start(ap, num);
+  800cc0:	8d 45 0c             	lea    0xc(%ebp),%eax
+  800cc3:	89 45 dc             	mov    %eax,-0x24(%ebp)
+    uint32_t a[MAX_ARGS];
+    int i, ret;
+    for (i = 0; i < MAX_ARGS; i ++) {
+  800cc6:	c7 45 e4 00 00 00 00 	movl   $0x0,-0x1c(%ebp)
+  800ccd:	eb 16                	jmp    800ce5 <syscall+0x2e>
+        a[i] = va_arg(ap, uint32_t);
+  800ccf:	8b 45 dc             	mov    -0x24(%ebp),%eax
+  800cd2:	8d 50 04             	lea    0x4(%eax),%edx
+  800cd5:	89 55 dc             	mov    %edx,-0x24(%ebp)
+  800cd8:	8b 10                	mov    (%eax),%edx
+  800cda:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  800cdd:	89 54 85 c8          	mov    %edx,-0x38(%ebp,%eax,4)
+    for (i = 0; i < MAX_ARGS; i ++) {
+  800ce1:	83 45 e4 01          	addl   $0x1,-0x1c(%ebp)
+  800ce5:	83 7d e4 04          	cmpl   $0x4,-0x1c(%ebp)
+  800ce9:	7e e4                	jle    800ccf <syscall+0x18>
+    }
+    va_end(ap);
+
+    if (use_sysenter < 0) {
+  800ceb:	a1 08 40 80 00       	mov    0x804008,%eax
+  800cf0:	85 c0                	test   %eax,%eax
+  800cf2:	79 0a                	jns    800cfe <syscall+0x47>
+        use_sysenter = sysenter_supported();
+  800cf4:	e8 c4 fe ff ff       	call   800bbd <sysenter_supported>
+  800cf9:	a3 08 40 80 00       	mov    %eax,0x804008
+    }
+    if (use_sysenter) {
+  800cfe:	a1 08 40 80 00       	mov    0x804008,%eax
+  800d03:	85 c0                	test   %eax,%eax
+  800d05:	74 14                	je     800d1b <syscall+0x64>
+        return __sysenter_call(num, a);
+  800d07:	83 ec 08             	sub    $0x8,%esp
+  800d0a:	8d 45 c8             	lea    -0x38(%ebp),%eax
+  800d0d:	50                   	push   %eax
+  800d0e:	ff 75 08             	push   0x8(%ebp)
+  800d11:	e8 7a 04 00 00       	call   801190 <__sysenter_call>
+  800d16:	83 c4 10             	add    $0x10,%esp
+  800d19:	eb 1a                	jmp    800d35 <syscall+0x7e>
+    asm volatile (
+        "int %1;"
+        : "=a" (ret)
+        : "i" (T_SYSCALL),
+          "a" (num),
+          "d" (a[0]),
+  800d1b:	8b 55 c8             	mov    -0x38(%ebp),%edx
+          "c" (a[1]),
+  800d1e:	8b 4d cc             	mov    -0x34(%ebp),%ecx
+          "b" (a[2]),
+  800d21:	8b 5d d0             	mov    -0x30(%ebp),%ebx
+          "D" (a[3]),
+  800d24:	8b 7d d4             	mov    -0x2c(%ebp),%edi
+          "S" (a[4])
+  800d27:	8b 75 d8             	mov    -0x28(%ebp),%esi
+    asm volatile (
+  800d2a:	8b 45 08             	mov    0x8(%ebp),%eax
+  800d2d:	cd 80                	int    $0x80
+  800d2f:	89 45 e0             	mov    %eax,-0x20(%ebp)
+        : "cc", "memory");
+    return ret;
+  800d32:	8b 45 e0             	mov    -0x20(%ebp),%eax
+}
+  800d35:	8d 65 f4             	lea    -0xc(%ebp),%esp
+  800d38:	5b                   	pop    %ebx
+  800d39:	5e                   	pop    %esi
+  800d3a:	5f                   	pop    %edi
+  800d3b:	5d                   	pop    %ebp
+  800d3c:	c3                   	ret
+
+00800d3d <sys_exit>:
+
+int
+sys_exit(int error_code) {
+  800d3d:	55                   	push   %ebp
+  800d3e:	89 e5                	mov    %esp,%ebp
+  800d40:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_exit, error_code);
+  800d43:	83 ec 08             	sub    $0x8,%esp
+  800d46:	ff 75 08             	push   0x8(%ebp)
+  800d49:	6a 01                	push   $0x1
+  800d4b:	e8 67 ff ff ff       	call   800cb7 <syscall>
+  800d50:	83 c4 10             	add    $0x10,%esp
+}
+  800d53:	c9                   	leave
+  800d54:	c3                   	ret
+
+00800d55 <sys_fork>:
+
+int
+sys_fork(void) {
+  800d55:	55                   	push   %ebp
+  800d56:	89 e5                	mov    %esp,%ebp
+  800d58:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_fork);
+  800d5b:	83 ec 0c             	sub    $0xc,%esp
+  800d5e:	6a 02                	push   $0x2
+  800d60:	e8 52 ff ff ff       	call   800cb7 <syscall>
+  800d65:	83 c4 10             	add    $0x10,%esp
+}
+  800d68:	c9                   	leave
+  800d69:	c3                   	ret
+
+00800d6a <sys_wait>:
+
+int
+sys_wait(int pid, int *store) {
+  800d6a:	55                   	push   %ebp
+  800d6b:	89 e5                	mov    %esp,%ebp
+  800d6d:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_wait, pid, store);
+  800d70:	83 ec 04             	sub    $0x4,%esp
+  800d73:	ff 75 0c             	push   0xc(%ebp)
+  800d76:	ff 75 08             	push   0x8(%ebp)
+  800d79:	6a 03                	push   $0x3
+  800d7b:	e8 37 ff ff ff       	call   800cb7 <syscall>
+  800d80:	83 c4 10             	add    $0x10,%esp
+}
+  800d83:	c9                   	leave
+  800d84:	c3                   	ret
+
+00800d85 <sys_yield>:
+
+int
+sys_yield(void) {
+  800d85:	55                   	push   %ebp
+  800d86:	89 e5                	mov    %esp,%ebp
+  800d88:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_yield);
+  800d8b:	83 ec 0c             	sub    $0xc,%esp
+  800d8e:	6a 0a                	push   $0xa
+  800d90:	e8 22 ff ff ff       	call   800cb7 <syscall>
+  800d95:	83 c4 10             	add    $0x10,%esp
+}
+  800d98:	c9                   	leave
+  800d99:	c3                   	ret
+
+00800d9a <sys_kill>:
+
+int
+sys_kill(int pid) {
+  800d9a:	55                   	push   %ebp
+  800d9b:	89 e5                	mov    %esp,%ebp
+  800d9d:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_kill, pid);
+  800da0:	83 ec 08             	sub    $0x8,%esp
+  800da3:	ff 75 08             	push   0x8(%ebp)
+  800da6:	6a 0c                	push   $0xc
+  800da8:	e8 0a ff ff ff       	call   800cb7 <syscall>
+  800dad:	83 c4 10             	add    $0x10,%esp
+}
+  800db0:	c9                   	leave
+  800db1:	c3                   	ret
+
+00800db2 <sys_getpid>:
+
+int
+sys_getpid(void) {
+  800db2:	55                   	push   %ebp
+  800db3:	89 e5                	mov    %esp,%ebp
+  800db5:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_getpid);
+  800db8:	83 ec 0c             	sub    $0xc,%esp
+  800dbb:	6a 12                	push   $0x12
+  800dbd:	e8 f5 fe ff ff       	call   800cb7 <syscall>
+  800dc2:	83 c4 10             	add    $0x10,%esp
+}
+  800dc5:	c9                   	leave
+  800dc6:	c3                   	ret
+
+00800dc7 <sys_putc>:
+
+int
+sys_putc(int c) {
+  800dc7:	55                   	push   %ebp
+  800dc8:	89 e5                	mov    %esp,%ebp
+  800dca:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_putc, c);
+  800dcd:	83 ec 08             	sub    $0x8,%esp
+  800dd0:	ff 75 08             	push   0x8(%ebp)
+  800dd3:	6a 1e                	push   $0x1e
+  800dd5:	e8 dd fe ff ff       	call   800cb7 <syscall>
+  800dda:	83 c4 10             	add    $0x10,%esp
+}
+  800ddd:	c9                   	leave
+  800dde:	c3                   	ret
+
+00800ddf <sys_pgdir>:
+
+int
+sys_pgdir(void) {
+  800ddf:	55                   	push   %ebp
+  800de0:	89 e5                	mov    %esp,%ebp
+  800de2:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_pgdir);
+  800de5:	83 ec 0c             	sub    $0xc,%esp
+  800de8:	6a 1f                	push   $0x1f
+  800dea:	e8 c8 fe ff ff       	call   800cb7 <syscall>
+  800def:	83 c4 10             	add    $0x10,%esp
+}
+  800df2:	c9                   	leave
+  800df3:	c3                   	ret
+
+00800df4 <sys_sleep>:
+
+int
+sys_sleep(unsigned int time) {
+  800df4:	55                   	push   %ebp
+  800df5:	89 e5                	mov    %esp,%ebp
+  800df7:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_sleep, time);
+  800dfa:	83 ec 08             	sub    $0x8,%esp
+  800dfd:	ff 75 08             	push   0x8(%ebp)
+  800e00:	6a 0b                	push   $0xb
+  800e02:	e8 b0 fe ff ff       	call   800cb7 <syscall>
+  800e07:	83 c4 10             	add    $0x10,%esp
+}
+  800e0a:	c9                   	leave
+  800e0b:	c3                   	ret
+
+00800e0c <sys_gettime>:
+
+size_t
+sys_gettime(void) {
+  800e0c:	55                   	push   %ebp
+  800e0d:	89 e5                	mov    %esp,%ebp
+  800e0f:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_gettime);
+  800e12:	83 ec 0c             	sub    $0xc,%esp
+  800e15:	6a 11                	push   $0x11
+  800e17:	e8 9b fe ff ff       	call   800cb7 <syscall>
+  800e1c:	83 c4 10             	add    $0x10,%esp
+}
+  800e1f:	c9                   	leave
+  800e20:	c3                   	ret
+
+00800e21 <sys_exec>:
+
+int
+sys_exec(const char *name, int argc, const char **argv) {
+  800e21:	55                   	push   %ebp
+  800e22:	89 e5                	mov    %esp,%ebp
+  800e24:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_exec, name, argc, argv);
+  800e27:	ff 75 10             	push   0x10(%ebp)
+  800e2a:	ff 75 0c             	push   0xc(%ebp)
+  800e2d:	ff 75 08             	push   0x8(%ebp)
+  800e30:	6a 04                	push   $0x4
+  800e32:	e8 80 fe ff ff       	call   800cb7 <syscall>
+  800e37:	83 c4 10             	add    $0x10,%esp
+}
+  800e3a:	c9                   	leave
+  800e3b:	c3                   	ret
+
+00800e3c <sys_open>:
+
+int
+sys_open(const char *path, uint32_t open_flags) {
+  800e3c:	55                   	push   %ebp
+  800e3d:	89 e5                	mov    %esp,%ebp
+  800e3f:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_open, path, open_flags);
+  800e42:	83 ec 04             	sub    $0x4,%esp
+  800e45:	ff 75 0c             	push   0xc(%ebp)
+  800e48:	ff 75 08             	push   0x8(%ebp)
+  800e4b:	6a 64                	push   $0x64
+  800e4d:	e8 65 fe ff ff       	call   800cb7 <syscall>
+  800e52:	83 c4 10             	add    $0x10,%esp
+}
+  800e55:	c9                   	leave
+  800e56:	c3                   	ret
+
+00800e57 <sys_close>:
+
+int
+sys_close(int fd) {
+  800e57:	55                   	push   %ebp
+  800e58:	89 e5                	mov    %esp,%ebp
+  800e5a:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_close, fd);
+  800e5d:	83 ec 08             	sub    $0x8,%esp
+  800e60:	ff 75 08             	push   0x8(%ebp)
+  800e63:	6a 65                	push   $0x65
+  800e65:	e8 4d fe ff ff       	call   800cb7 <syscall>
+  800e6a:	83 c4 10             	add    $0x10,%esp
+}
+  800e6d:	c9                   	leave
+  800e6e:	c3                   	ret
+
+00800e6f <sys_read>:
+
+int
+sys_read(int fd, void *base, size_t len) {
+  800e6f:	55                   	push   %ebp
+  800e70:	89 e5                	mov    %esp,%ebp
+  800e72:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_read, fd, base, len);
+  800e75:	ff 75 10             	push   0x10(%ebp)
+  800e78:	ff 75 0c             	push   0xc(%ebp)
+  800e7b:	ff 75 08             	push   0x8(%ebp)
+  800e7e:	6a 66                	push   $0x66
+  800e80:	e8 32 fe ff ff       	call   800cb7 <syscall>
+  800e85:	83 c4 10             	add    $0x10,%esp
+}
+  800e88:	c9                   	leave
+  800e89:	c3                   	ret
+
+00800e8a <sys_write>:
+
+int
+sys_write(int fd, void *base, size_t len) {
+  800e8a:	55                   	push   %ebp
+  800e8b:	89 e5                	mov    %esp,%ebp
+  800e8d:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_write, fd, base, len);
+  800e90:	ff 75 10             	push   0x10(%ebp)
+  800e93:	ff 75 0c             	push   0xc(%ebp)
+  800e96:	ff 75 08             	push   0x8(%ebp)
+  800e99:	6a 67                	push   $0x67
+  800e9b:	e8 17 fe ff ff       	call   800cb7 <syscall>
+  800ea0:	83 c4 10             	add    $0x10,%esp
+}
+  800ea3:	c9                   	leave
+  800ea4:	c3                   	ret
+
+00800ea5 <sys_seek>:
+
+int
+sys_seek(int fd, off_t pos, int whence) {
+  800ea5:	55                   	push   %ebp
+  800ea6:	89 e5                	mov    %esp,%ebp
+  800ea8:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_seek, fd, pos, whence);
+  800eab:	ff 75 10             	push   0x10(%ebp)
+  800eae:	ff 75 0c             	push   0xc(%ebp)
+  800eb1:	ff 75 08             	push   0x8(%ebp)
+  800eb4:	6a 68                	push   $0x68
+  800eb6:	e8 fc fd ff ff       	call   800cb7 <syscall>
+  800ebb:	83 c4 10             	add    $0x10,%esp
+}
+  800ebe:	c9                   	leave
+  800ebf:	c3                   	ret
+
+00800ec0 <sys_fstat>:
+
+int
+sys_fstat(int fd, struct stat *stat) {
+  800ec0:	55                   	push   %ebp
+  800ec1:	89 e5                	mov    %esp,%ebp
+  800ec3:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_fstat, fd, stat);
+  800ec6:	83 ec 04             	sub    $0x4,%esp
+  800ec9:	ff 75 0c             	push   0xc(%ebp)
+  800ecc:	ff 75 08             	push   0x8(%ebp)
+  800ecf:	6a 6e                	push   $0x6e
+  800ed1:	e8 e1 fd ff ff       	call   800cb7 <syscall>
+  800ed6:	83 c4 10             	add    $0x10,%esp
+}
+  800ed9:	c9                   	leave
+  800eda:	c3                   	ret
+
+00800edb <sys_fsync>:
+
+int
+sys_fsync(int fd) {
+  800edb:	55                   	push   %ebp
+  800edc:	89 e5                	mov    %esp,%ebp
+  800ede:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_fsync, fd);
+  800ee1:	83 ec 08             	sub    $0x8,%esp
+  800ee4:	ff 75 08             	push   0x8(%ebp)
+  800ee7:	6a 6f                	push   $0x6f
+  800ee9:	e8 c9 fd ff ff       	call   800cb7 <syscall>
+  800eee:	83 c4 10             	add    $0x10,%esp
+}
+  800ef1:	c9                   	leave
+  800ef2:	c3                   	ret
+
+00800ef3 <sys_getcwd>:
+
+int
+sys_getcwd(char *buffer, size_t len) {
+  800ef3:	55                   	push   %ebp
+  800ef4:	89 e5                	mov    %esp,%ebp
+  800ef6:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_getcwd, buffer, len);
+  800ef9:	83 ec 04             	sub    $0x4,%esp
+  800efc:	ff 75 0c             	push   0xc(%ebp)
+  800eff:	ff 75 08             	push   0x8(%ebp)
+  800f02:	6a 79                	push   $0x79
+  800f04:	e8 ae fd ff ff       	call   800cb7 <syscall>
+  800f09:	83 c4 10             	add    $0x10,%esp
+}
+  800f0c:	c9                   	leave
+  800f0d:	c3                   	ret
+
+00800f0e <sys_mkdir>:
+
+int sys_mkdir(const char *path) 
+{
+  800f0e:	55                   	push   %ebp
+  800f0f:	89 e5                	mov    %esp,%ebp
+  800f11:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_mkdir, path);
+  800f14:	83 ec 08             	sub    $0x8,%esp
+  800f17:	ff 75 08             	push   0x8(%ebp)
+  800f1a:	6a 7a                	push   $0x7a
+  800f1c:	e8 96 fd ff ff       	call   800cb7 <syscall>
+  800f21:	83 c4 10             	add    $0x10,%esp
+}
+  800f24:	c9                   	leave
+  800f25:	c3                   	ret
+
+00800f26 <sys_chdir>:
+
+int sys_chdir(const char *path)
+{
+  800f26:	55                   	push   %ebp
+  800f27:	89 e5                	mov    %esp,%ebp
+  800f29:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_chdir, path);
+  800f2c:	83 ec 08             	sub    $0x8,%esp
+  800f2f:	ff 75 08             	push   0x8(%ebp)
+  800f32:	6a 78                	push   $0x78
+  800f34:	e8 7e fd ff ff       	call   800cb7 <syscall>
+  800f39:	83 c4 10             	add    $0x10,%esp
+}
+  800f3c:	c9                   	leave
+  800f3d:	c3                   	ret
+
+00800f3e <sys_link>:
+
+int sys_link(const char *old_path, const char *new_path) 
+{
+  800f3e:	55                   	push   %ebp
+  800f3f:	89 e5                	mov    %esp,%ebp
+  800f41:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_link, old_path, new_path);
+  800f44:	83 ec 04             	sub    $0x4,%esp
+  800f47:	ff 75 0c             	push   0xc(%ebp)
+  800f4a:	ff 75 08             	push   0x8(%ebp)
+  800f4d:	6a 7b                	push   $0x7b
+  800f4f:	e8 63 fd ff ff       	call   800cb7 <syscall>
+  800f54:	83 c4 10             	add    $0x10,%esp
+}
+  800f57:	c9                   	leave
+  800f58:	c3                   	ret
+
+00800f59 <sys_rename>:
+
+int sys_rename(const char *old_path, const char *new_path)
+{
+  800f59:	55                   	push   %ebp
+  800f5a:	89 e5                	mov    %esp,%ebp
+  800f5c:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_rename, old_path, new_path);
+  800f5f:	83 ec 04             	sub    $0x4,%esp
+  800f62:	ff 75 0c             	push   0xc(%ebp)
+  800f65:	ff 75 08             	push   0x8(%ebp)
+  800f68:	6a 7c                	push   $0x7c
+  800f6a:	e8 48 fd ff ff       	call   800cb7 <syscall>
+  800f6f:	83 c4 10             	add    $0x10,%esp
+}
+  800f72:	c9                   	leave
+  800f73:	c3                   	ret
+
+00800f74 <sys_unlink>:
+
+int sys_unlink(const char *path)
+{
+  800f74:	55                   	push   %ebp
+  800f75:	89 e5                	mov    %esp,%ebp
+  800f77:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_unlink, path);
+  800f7a:	83 ec 08             	sub    $0x8,%esp
+  800f7d:	ff 75 08             	push   0x8(%ebp)
+  800f80:	6a 7f                	push   $0x7f
+  800f82:	e8 30 fd ff ff       	call   800cb7 <syscall>
+  800f87:	83 c4 10             	add    $0x10,%esp
+}
+  800f8a:	c9                   	leave
+  800f8b:	c3                   	ret
+
+00800f8c <sys_getdirentry>:
+
+int
+sys_getdirentry(int fd, struct dirent *dirent) {
+  800f8c:	55                   	push   %ebp
+  800f8d:	89 e5                	mov    %esp,%ebp
+  800f8f:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_getdirentry, fd, dirent);
+  800f92:	83 ec 04             	sub    $0x4,%esp
+  800f95:	ff 75 0c             	push   0xc(%ebp)
+  800f98:	ff 75 08             	push   0x8(%ebp)
+  800f9b:	68 80 00 00 00       	push   $0x80
+  800fa0:	e8 12 fd ff ff       	call   800cb7 <syscall>
+  800fa5:	83 c4 10             	add    $0x10,%esp
+}
+  800fa8:	c9                   	leave
+  800fa9:	c3                   	ret
+
+00800faa <sys_dup>:
+
+int
+sys_dup(int fd1, int fd2) {
+  800faa:	55                   	push   %ebp
+  800fab:	89 e5                	mov    %esp,%ebp
+  800fad:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_dup, fd1, fd2);
+  800fb0:	83 ec 04             	sub    $0x4,%esp
+  800fb3:	ff 75 0c             	push   0xc(%ebp)
+  800fb6:	ff 75 08             	push   0x8(%ebp)
+  800fb9:	68 82 00 00 00       	push   $0x82
+  800fbe:	e8 f4 fc ff ff       	call   800cb7 <syscall>
+  800fc3:	83 c4 10             	add    $0x10,%esp
+}
+  800fc6:	c9                   	leave
+  800fc7:	c3                   	ret
+
+00800fc8 <sys_get_pdb>:
+
+int sys_get_pdb(void *base)
+{
+  800fc8:	55                   	push   %ebp
+  800fc9:	89 e5                	mov    %esp,%ebp
+  800fcb:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_get_pdb, base);
+  800fce:	83 ec 08             	sub    $0x8,%esp
+  800fd1:	ff 75 08             	push   0x8(%ebp)
+  800fd4:	68 b4 01 00 00       	push   $0x1b4
+  800fd9:	e8 d9 fc ff ff       	call   800cb7 <syscall>
+  800fde:	83 c4 10             	add    $0x10,%esp
+}
+  800fe1:	c9                   	leave
+  800fe2:	c3                   	ret
+
+00800fe3 <sys_clone>:
+
+int sys_clone(int *thread_id, void *(*fn)(void *), void *arg, void (*exit)(int), size_t stack_size)
+{
+  800fe3:	55                   	push   %ebp
+  800fe4:	89 e5                	mov    %esp,%ebp
+  800fe6:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_clone, thread_id, fn, arg, exit, stack_size);
+  800fe9:	83 ec 08             	sub    $0x8,%esp
+  800fec:	ff 75 18             	push   0x18(%ebp)
+  800fef:	ff 75 14             	push   0x14(%ebp)
+  800ff2:	ff 75 10             	push   0x10(%ebp)
+  800ff5:	ff 75 0c             	push   0xc(%ebp)
+  800ff8:	ff 75 08             	push   0x8(%ebp)
+  800ffb:	6a 05                	push   $0x5
+  800ffd:	e8 b5 fc ff ff       	call   800cb7 <syscall>
+  801002:	83 c4 20             	add    $0x20,%esp
+}
+  801005:	c9                   	leave
+  801006:	c3                   	ret
+
+00801007 <sys_nice>:
+
+int sys_nice(int pid, int prior)
+{
+  801007:	55                   	push   %ebp
+  801008:	89 e5                	mov    %esp,%ebp
+  80100a:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_nice, pid , prior);
+  80100d:	83 ec 04             	sub    $0x4,%esp
+  801010:	ff 75 0c             	push   0xc(%ebp)
+  801013:	ff 75 08             	push   0x8(%ebp)
+  801016:	68 b6 01 00 00       	push   $0x1b6
+  80101b:	e8 97 fc ff ff       	call   800cb7 <syscall>
+  801020:	83 c4 10             	add    $0x10,%esp
+}
+  801023:	c9                   	leave
+  801024:	c3                   	ret
+
+00801025 <sys_shmem>:
+
+int 
+sys_shmem(uintptr_t * addr_store, size_t len, uint32_t mmap_flags)
+{
+  801025:	55                   	push   %ebp
+  801026:	89 e5                	mov    %esp,%ebp
+  801028:	83 ec 08             	sub    $0x8,%esp
+	return syscall(SYS_shmem, addr_store, len, mmap_flags);
+  80102b:	ff 75 10             	push   0x10(%ebp)
+  80102e:	ff 75 0c             	push   0xc(%ebp)
+  801031:	ff 75 08             	push   0x8(%ebp)
+  801034:	6a 16                	push   $0x16
+  801036:	e8 7c fc ff ff       	call   800cb7 <syscall>
+  80103b:	83 c4 10             	add    $0x10,%esp
+}
+  80103e:	c9                   	leave
+  80103f:	c3                   	ret
+
+00801040 <sys_brk>:
+
+int 
+sys_brk(uintptr_t * brk_store)
+{
+  801040:	55                   	push   %ebp
+  801041:	89 e5                	mov    %esp,%ebp
+  801043:	83 ec 08             	sub    $0x8,%esp
+	return syscall(SYS_brk, brk_store);
+  801046:	83 ec 08             	sub    $0x8,%esp
+  801049:	ff 75 08             	push   0x8(%ebp)
+  80104c:	6a 13                	push   $0x13
+  80104e:	e8 64 fc ff ff       	call   800cb7 <syscall>
+  801053:	83 c4 10             	add    $0x10,%esp
+}
+  801056:	c9                   	leave
+  801057:	c3                   	ret
+
+00801058 <sys_check_alloc_page>:
+
+void sys_check_alloc_page()
+{
+  801058:	55                   	push   %ebp
+  801059:	89 e5                	mov    %esp,%ebp
+  80105b:	83 ec 08             	sub    $0x8,%esp
+	syscall(SYS_check_alloc_page);
+  80105e:	83 ec 0c             	sub    $0xc,%esp
+  801061:	68 c3 01 00 00       	push   $0x1c3
+  801066:	e8 4c fc ff ff       	call   800cb7 <syscall>
+  80106b:	83 c4 10             	add    $0x10,%esp
+}
+  80106e:	90                   	nop
+  80106f:	c9                   	leave
+  801070:	c3                   	ret
+
+00801071 <sys_check_swap>:
+
+void sys_check_swap()
+{
+  801071:	55                   	push   %ebp
+  801072:	89 e5                	mov    %esp,%ebp
+  801074:	83 ec 08             	sub    $0x8,%esp
+	syscall(SYS_check_swap);
+  801077:	83 ec 0c             	sub    $0xc,%esp
+  80107a:	68 c4 01 00 00       	push   $0x1c4
+  80107f:	e8 33 fc ff ff       	call   800cb7 <syscall>
+  801084:	83 c4 10             	add    $0x10,%esp
+}
+  801087:	90                   	nop
+  801088:	c9                   	leave
+  801089:	c3                   	ret
+
+0080108a <sys_fifo_check_swap>:
+
+int sys_fifo_check_swap()
+{
+  80108a:	55                   	push   %ebp
+  80108b:	89 e5                	mov    %esp,%ebp
+  80108d:	83 ec 08             	sub    $0x8,%esp
+	return syscall(SYS_fifo_check_swap);
+  801090:	83 ec 0c             	sub    $0xc,%esp
+  801093:	68 c5 01 00 00       	push   $0x1c5
+  801098:	e8 1a fc ff ff       	call   800cb7 <syscall>
+  80109d:	83 c4 10             	add    $0x10,%esp
+}
+  8010a0:	c9                   	leave
+  8010a1:	c3                   	ret
+
+008010a2 <sys_pmm_report>:
+
+void sys_pmm_report()
+{
+  8010a2:	55                   	push   %ebp
+  8010a3:	89 e5                	mov    %esp,%ebp
+  8010a5:	83 ec 08             	sub    $0x8,%esp
+	syscall(SYS_pmm_report);
+  8010a8:	83 ec 0c             	sub    $0xc,%esp
+  8010ab:	68 c6 01 00 00       	push   $0x1c6
+  8010b0:	e8 02 fc ff ff       	call   800cb7 <syscall>
+  8010b5:	83 c4 10             	add    $0x10,%esp
+}
+  8010b8:	90                   	nop
+  8010b9:	c9                   	leave
+  8010ba:	c3                   	ret
+
+008010bb <sys_futex>:
+
+int
+sys_futex(volatile int *uaddr, int op, int val) {
+  8010bb:	55                   	push   %ebp
+  8010bc:	89 e5                	mov    %esp,%ebp
+  8010be:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_futex, uaddr, op, val);
+  8010c1:	ff 75 10             	push   0x10(%ebp)
+  8010c4:	ff 75 0c             	push   0xc(%ebp)
+  8010c7:	ff 75 08             	push   0x8(%ebp)
+  8010ca:	68 c7 01 00 00       	push   $0x1c7
+  8010cf:	e8 e3 fb ff ff       	call   800cb7 <syscall>
+  8010d4:	83 c4 10             	add    $0x10,%esp
+}
+  8010d7:	c9                   	leave
+  8010d8:	c3                   	ret
+
+008010d9 <sys_nanosleep>:
+
+int
+sys_nanosleep(const struct timespec *req) {
+  8010d9:	55                   	push   %ebp
+  8010da:	89 e5                	mov    %esp,%ebp
+  8010dc:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_nanosleep, req);
+  8010df:	83 ec 08             	sub    $0x8,%esp
+  8010e2:	ff 75 08             	push   0x8(%ebp)
+  8010e5:	68 c8 01 00 00       	push   $0x1c8
+  8010ea:	e8 c8 fb ff ff       	call   800cb7 <syscall>
+  8010ef:	83 c4 10             	add    $0x10,%esp
+}
+  8010f2:	c9                   	leave
+  8010f3:	c3                   	ret
+
+008010f4 <sys_batch>:
+
+int
+sys_batch(struct sysbatch_entry *entries, int n, uint32_t flags) {
+  8010f4:	55                   	push   %ebp
+  8010f5:	89 e5                	mov    %esp,%ebp
+  8010f7:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_batch, entries, n, flags);
+  8010fa:	ff 75 10             	push   0x10(%ebp)
+  8010fd:	ff 75 0c             	push   0xc(%ebp)
+  801100:	ff 75 08             	push   0x8(%ebp)
+  801103:	68 c9 01 00 00       	push   $0x1c9
+  801108:	e8 aa fb ff ff       	call   800cb7 <syscall>
+  80110d:	83 c4 10             	add    $0x10,%esp
+}
+  801110:	c9                   	leave
+  801111:	c3                   	ret
+
+00801112 <sys_uring_setup>:
+
+int
+sys_uring_setup(struct uring **ring_store) {
+  801112:	55                   	push   %ebp
+  801113:	89 e5                	mov    %esp,%ebp
+  801115:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_uring_setup, ring_store);
+  801118:	83 ec 08             	sub    $0x8,%esp
+  80111b:	ff 75 08             	push   0x8(%ebp)
+  80111e:	68 ca 01 00 00       	push   $0x1ca
+  801123:	e8 8f fb ff ff       	call   800cb7 <syscall>
+  801128:	83 c4 10             	add    $0x10,%esp
+}
+  80112b:	c9                   	leave
+  80112c:	c3                   	ret
+
+0080112d <sys_uring_enter>:
+
+int
+sys_uring_enter(int min_complete) {
+  80112d:	55                   	push   %ebp
+  80112e:	89 e5                	mov    %esp,%ebp
+  801130:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_uring_enter, min_complete);
+  801133:	83 ec 08             	sub    $0x8,%esp
+  801136:	ff 75 08             	push   0x8(%ebp)
+  801139:	68 cb 01 00 00       	push   $0x1cb
+  80113e:	e8 74 fb ff ff       	call   800cb7 <syscall>
+  801143:	83 c4 10             	add    $0x10,%esp
+}
+  801146:	c9                   	leave
+  801147:	c3                   	ret
+
+00801148 <sys_sysprof>:
+
+int
+sys_sysprof(int op, uint32_t arg, struct sysprof_stat *buf, int n) {
+  801148:	55                   	push   %ebp
+  801149:	89 e5                	mov    %esp,%ebp
+  80114b:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_sysprof, op, arg, buf, n);
+  80114e:	83 ec 0c             	sub    $0xc,%esp
+  801151:	ff 75 14             	push   0x14(%ebp)
+  801154:	ff 75 10             	push   0x10(%ebp)
+  801157:	ff 75 0c             	push   0xc(%ebp)
+  80115a:	ff 75 08             	push   0x8(%ebp)
+  80115d:	68 cc 01 00 00       	push   $0x1cc
+  801162:	e8 50 fb ff ff       	call   800cb7 <syscall>
+  801167:	83 c4 20             	add    $0x20,%esp
+}
+  80116a:	c9                   	leave
+  80116b:	c3                   	ret
+
+0080116c <sys_kprof>:
+
+int
+sys_kprof(int op, uint32_t arg, void *buf, int n) {
+  80116c:	55                   	push   %ebp
+  80116d:	89 e5                	mov    %esp,%ebp
+  80116f:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_kprof, op, arg, buf, n);
+  801172:	83 ec 0c             	sub    $0xc,%esp
+  801175:	ff 75 14             	push   0x14(%ebp)
+  801178:	ff 75 10             	push   0x10(%ebp)
+  80117b:	ff 75 0c             	push   0xc(%ebp)
+  80117e:	ff 75 08             	push   0x8(%ebp)
+  801181:	68 cd 01 00 00       	push   $0x1cd
+  801186:	e8 2c fb ff ff       	call   800cb7 <syscall>
+  80118b:	83 c4 20             	add    $0x20,%esp
+  80118e:	c9                   	leave
+  80118f:	c3                   	ret
+
+00801190 <__sysenter_call>:
+# or with iret for frames it rewrote; either way %esp equals the %ebp passed
+# in and %eax holds the result.
+.text
+.globl __sysenter_call
+__sysenter_call:
+    pushl %ebp
+  801190:	55                   	push   %ebp
+    pushl %ebx
+  801191:	53                   	push   %ebx
+    pushl %esi
+  801192:	56                   	push   %esi
+    pushl %edi
+  801193:	57                   	push   %edi
+
+    movl 0x14(%esp), %eax                   # num
+  801194:	8b 44 24 14          	mov    0x14(%esp),%eax
+    movl 0x18(%esp), %ebp                   # args
+  801198:	8b 6c 24 18          	mov    0x18(%esp),%ebp
+    movl 0x0(%ebp), %edx
+  80119c:	8b 55 00             	mov    0x0(%ebp),%edx
+    movl 0x4(%ebp), %ecx
+  80119f:	8b 4d 04             	mov    0x4(%ebp),%ecx
+    movl 0x8(%ebp), %ebx
+  8011a2:	8b 5d 08             	mov    0x8(%ebp),%ebx
+    movl 0xc(%ebp), %edi
+  8011a5:	8b 7d 0c             	mov    0xc(%ebp),%edi
+    movl 0x10(%ebp), %esi
+  8011a8:	8b 75 10             	mov    0x10(%ebp),%esi
+
+    pushl $1f
+  8011ab:	68 b4 11 80 00       	push   $0x8011b4
+    movl %esp, %ebp
+  8011b0:	89 e5                	mov    %esp,%ebp
+    sysenter
+  8011b2:	0f 34                	sysenter
+1:
+    addl $0x4, %esp
+  8011b4:	83 c4 04             	add    $0x4,%esp
+    popl %edi
+  8011b7:	5f                   	pop    %edi
+    popl %esi
+  8011b8:	5e                   	pop    %esi
+    popl %ebx
+  8011b9:	5b                   	pop    %ebx
+    popl %ebp
+  8011ba:	5d                   	pop    %ebp
+    ret
+  8011bb:	c3                   	ret
+
+008011bc <lock>:
+lock(lock_t *l) {
+  8011bc:	55                   	push   %ebp
+  8011bd:	89 e5                	mov    %esp,%ebp
+  8011bf:	53                   	push   %ebx
+  8011c0:	83 ec 34             	sub    $0x34,%esp
+  8011c3:	8b 45 08             	mov    0x8(%ebp),%eax
+  8011c6:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  8011c9:	c7 45 ec 00 00 00 00 	movl   $0x0,-0x14(%ebp)
+  8011d0:	c7 45 e8 01 00 00 00 	movl   $0x1,-0x18(%ebp)
+    asm volatile ("lock; cmpxchgl %2, %1" : "=a" (prev), "+m" (*addr) : "r" (new), "0" (old) : "memory");
+  8011d7:	8b 5d f0             	mov    -0x10(%ebp),%ebx
+  8011da:	8b 55 e8             	mov    -0x18(%ebp),%edx
+  8011dd:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  8011e0:	8b 4d f0             	mov    -0x10(%ebp),%ecx
+  8011e3:	f0 0f b1 13          	lock cmpxchg %edx,(%ebx)
+  8011e7:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+    return prev;
+  8011ea:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+    if ((c = cmpxchg(l, 0, 1)) != 0) {
+  8011ed:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  8011f0:	83 7d f4 00          	cmpl   $0x0,-0xc(%ebp)
+  8011f4:	74 62                	je     801258 <lock+0x9c>
+        if (c != 2) {
+  8011f6:	83 7d f4 02          	cmpl   $0x2,-0xc(%ebp)
+  8011fa:	74 56                	je     801252 <lock+0x96>
+  8011fc:	8b 45 08             	mov    0x8(%ebp),%eax
+  8011ff:	89 45 e0             	mov    %eax,-0x20(%ebp)
+  801202:	c7 45 dc 02 00 00 00 	movl   $0x2,-0x24(%ebp)
+    asm volatile ("xchgl %0, %1" : "+r" (val), "+m" (*addr) :: "memory");
+  801209:	8b 4d e0             	mov    -0x20(%ebp),%ecx
+  80120c:	8b 45 dc             	mov    -0x24(%ebp),%eax
+  80120f:	8b 55 e0             	mov    -0x20(%ebp),%edx
+  801212:	87 01                	xchg   %eax,(%ecx)
+  801214:	89 45 dc             	mov    %eax,-0x24(%ebp)
+    return val;
+  801217:	8b 45 dc             	mov    -0x24(%ebp),%eax
+            c = xchg(l, 2);
+  80121a:	89 45 f4             	mov    %eax,-0xc(%ebp)
+        while (c != 0) {
+  80121d:	eb 33                	jmp    801252 <lock+0x96>
+            sys_futex(l, FUTEX_WAIT, 2);
+  80121f:	83 ec 04             	sub    $0x4,%esp
+  801222:	6a 02                	push   $0x2
+  801224:	6a 00                	push   $0x0
+  801226:	ff 75 08             	push   0x8(%ebp)
+  801229:	e8 8d fe ff ff       	call   8010bb <sys_futex>
+  80122e:	83 c4 10             	add    $0x10,%esp
+  801231:	8b 45 08             	mov    0x8(%ebp),%eax
+  801234:	89 45 d8             	mov    %eax,-0x28(%ebp)
+  801237:	c7 45 d4 02 00 00 00 	movl   $0x2,-0x2c(%ebp)
+    asm volatile ("xchgl %0, %1" : "+r" (val), "+m" (*addr) :: "memory");
+  80123e:	8b 4d d8             	mov    -0x28(%ebp),%ecx
+  801241:	8b 45 d4             	mov    -0x2c(%ebp),%eax
+  801244:	8b 55 d8             	mov    -0x28(%ebp),%edx
+  801247:	87 01                	xchg   %eax,(%ecx)
+  801249:	89 45 d4             	mov    %eax,-0x2c(%ebp)
+    return val;
+  80124c:	8b 45 d4             	mov    -0x2c(%ebp),%eax
+            c = xchg(l, 2);
+  80124f:	89 45 f4             	mov    %eax,-0xc(%ebp)
+        while (c != 0) {
+  801252:	83 7d f4 00          	cmpl   $0x0,-0xc(%ebp)
+  801256:	75 c7                	jne    80121f <lock+0x63>
+}
+  801258:	90                   	nop
+  801259:	8b 5d fc             	mov    -0x4(%ebp),%ebx
+  80125c:	c9                   	leave
+  80125d:	c3                   	ret
+
+0080125e <unlock>:
+unlock(lock_t *l) {
+  80125e:	55                   	push   %ebp
+  80125f:	89 e5                	mov    %esp,%ebp
+  801261:	83 ec 18             	sub    $0x18,%esp
+  801264:	8b 45 08             	mov    0x8(%ebp),%eax
+  801267:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  80126a:	c7 45 f0 00 00 00 00 	movl   $0x0,-0x10(%ebp)
+    asm volatile ("xchgl %0, %1" : "+r" (val), "+m" (*addr) :: "memory");
+  801271:	8b 4d f4             	mov    -0xc(%ebp),%ecx
+  801274:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  801277:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  80127a:	87 01                	xchg   %eax,(%ecx)
+  80127c:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    return val;
+  80127f:	8b 45 f0             	mov    -0x10(%ebp),%eax
+    if (xchg(l, 0) == 2) {
+  801282:	83 f8 02             	cmp    $0x2,%eax
+  801285:	75 12                	jne    801299 <unlock+0x3b>
+        sys_futex(l, FUTEX_WAKE, 1);
+  801287:	83 ec 04             	sub    $0x4,%esp
+  80128a:	6a 01                	push   $0x1
+  80128c:	6a 01                	push   $0x1
+  80128e:	ff 75 08             	push   0x8(%ebp)
+  801291:	e8 25 fe ff ff       	call   8010bb <sys_futex>
+  801296:	83 c4 10             	add    $0x10,%esp
+}
+  801299:	90                   	nop
+  80129a:	c9                   	leave
+  80129b:	c3                   	ret
+
+0080129c <vdso_read_begin>:
+};
+
+#define vdso_data_page()    ((const struct vdso_data *)VDSO_BASE)
+
+static inline uint32_t
+vdso_read_begin(const struct vdso_data *vd) {
+  80129c:	55                   	push   %ebp
+  80129d:	89 e5                	mov    %esp,%ebp
+  80129f:	83 ec 10             	sub    $0x10,%esp
+    uint32_t seq;
+    while ((seq = vd->seq) & 1) {
+  8012a2:	90                   	nop
+  8012a3:	8b 45 08             	mov    0x8(%ebp),%eax
+  8012a6:	8b 00                	mov    (%eax),%eax
+  8012a8:	89 45 fc             	mov    %eax,-0x4(%ebp)
+  8012ab:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8012ae:	83 e0 01             	and    $0x1,%eax
+  8012b1:	85 c0                	test   %eax,%eax
+  8012b3:	75 ee                	jne    8012a3 <vdso_read_begin+0x7>
+        /* kernel update in progress */ ;
+    }
+    asm volatile ("" ::: "memory");
+    return seq;
+  8012b5:	8b 45 fc             	mov    -0x4(%ebp),%eax
+}
+  8012b8:	c9                   	leave
+  8012b9:	c3                   	ret
+
+008012ba <vdso_read_retry>:
+
+static inline bool
+vdso_read_retry(const struct vdso_data *vd, uint32_t seq) {
+  8012ba:	55                   	push   %ebp
+  8012bb:	89 e5                	mov    %esp,%ebp
+    asm volatile ("" ::: "memory");
+    return vd->seq != seq;
+  8012bd:	8b 45 08             	mov    0x8(%ebp),%eax
+  8012c0:	8b 00                	mov    (%eax),%eax
+  8012c2:	39 45 0c             	cmp    %eax,0xc(%ebp)
+  8012c5:	0f 95 c0             	setne  %al
+  8012c8:	0f b6 c0             	movzbl %al,%eax
+}
+  8012cb:	5d                   	pop    %ebp
+  8012cc:	c3                   	ret
+
+008012cd <lock_fork>:
+#include <x86.h>
+
+static lock_t fork_lock = INIT_LOCK;
+
+void
+lock_fork(void) {
+  8012cd:	55                   	push   %ebp
+  8012ce:	89 e5                	mov    %esp,%ebp
+  8012d0:	83 ec 08             	sub    $0x8,%esp
+    lock(&fork_lock);
+  8012d3:	83 ec 0c             	sub    $0xc,%esp
+  8012d6:	68 9c 41 80 00       	push   $0x80419c
+  8012db:	e8 dc fe ff ff       	call   8011bc <lock>
+  8012e0:	83 c4 10             	add    $0x10,%esp
+}
+  8012e3:	90                   	nop
+  8012e4:	c9                   	leave
+  8012e5:	c3                   	ret
+
+008012e6 <unlock_fork>:
+
+void
+unlock_fork(void) {
+  8012e6:	55                   	push   %ebp
+  8012e7:	89 e5                	mov    %esp,%ebp
+  8012e9:	83 ec 08             	sub    $0x8,%esp
+    unlock(&fork_lock);
+  8012ec:	83 ec 0c             	sub    $0xc,%esp
+  8012ef:	68 9c 41 80 00       	push   $0x80419c
+  8012f4:	e8 65 ff ff ff       	call   80125e <unlock>
+  8012f9:	83 c4 10             	add    $0x10,%esp
+}
+  8012fc:	90                   	nop
+  8012fd:	c9                   	leave
+  8012fe:	c3                   	ret
+
+008012ff <exit>:
+
+void
+exit(int error_code) {
+  8012ff:	55                   	push   %ebp
+  801300:	89 e5                	mov    %esp,%ebp
+  801302:	83 ec 08             	sub    $0x8,%esp
+    sys_exit(error_code);
+  801305:	83 ec 0c             	sub    $0xc,%esp
+  801308:	ff 75 08             	push   0x8(%ebp)
+  80130b:	e8 2d fa ff ff       	call   800d3d <sys_exit>
+  801310:	83 c4 10             	add    $0x10,%esp
+    cprintf("BUG: exit failed.\n");
+  801313:	83 ec 0c             	sub    $0xc,%esp
+  801316:	68 2e 2f 80 00       	push   $0x802f2e
+  80131b:	e8 a1 f7 ff ff       	call   800ac1 <cprintf>
+  801320:	83 c4 10             	add    $0x10,%esp
+    while (1);
+  801323:	90                   	nop
+  801324:	eb fd                	jmp    801323 <exit+0x24>
+
+00801326 <fork>:
+}
+
+int
+fork(void) {
+  801326:	55                   	push   %ebp
+  801327:	89 e5                	mov    %esp,%ebp
+  801329:	83 ec 08             	sub    $0x8,%esp
+    return sys_fork();
+  80132c:	e8 24 fa ff ff       	call   800d55 <sys_fork>
+}
+  801331:	c9                   	leave
+  801332:	c3                   	ret
+
+00801333 <wait>:
+
+int
+wait(void) {
+  801333:	55                   	push   %ebp
+  801334:	89 e5                	mov    %esp,%ebp
+  801336:	83 ec 08             	sub    $0x8,%esp
+    return sys_wait(0, NULL);
+  801339:	83 ec 08             	sub    $0x8,%esp
+  80133c:	6a 00                	push   $0x0
+  80133e:	6a 00                	push   $0x0
+  801340:	e8 25 fa ff ff       	call   800d6a <sys_wait>
+  801345:	83 c4 10             	add    $0x10,%esp
+}
+  801348:	c9                   	leave
+  801349:	c3                   	ret
+
+0080134a <waitpid>:
+
+int
+waitpid(int pid, int *store) {
+  80134a:	55                   	push   %ebp
+  80134b:	89 e5                	mov    %esp,%ebp
+  80134d:	83 ec 08             	sub    $0x8,%esp
+    return sys_wait(pid, store);
+  801350:	83 ec 08             	sub    $0x8,%esp
+  801353:	ff 75 0c             	push   0xc(%ebp)
+  801356:	ff 75 08             	push   0x8(%ebp)
+  801359:	e8 0c fa ff ff       	call   800d6a <sys_wait>
+  80135e:	83 c4 10             	add    $0x10,%esp
+}
+  801361:	c9                   	leave
+  801362:	c3                   	ret
+
+00801363 <yield>:
+
+void
+yield(void) {
+  801363:	55                   	push   %ebp
+  801364:	89 e5                	mov    %esp,%ebp
+  801366:	83 ec 08             	sub    $0x8,%esp
+    sys_yield();
+  801369:	e8 17 fa ff ff       	call   800d85 <sys_yield>
+}
+  80136e:	90                   	nop
+  80136f:	c9                   	leave
+  801370:	c3                   	ret
+
+00801371 <kill>:
+
+int
+kill(int pid) {
+  801371:	55                   	push   %ebp
+  801372:	89 e5                	mov    %esp,%ebp
+  801374:	83 ec 08             	sub    $0x8,%esp
+    return sys_kill(pid);
+  801377:	83 ec 0c             	sub    $0xc,%esp
+  80137a:	ff 75 08             	push   0x8(%ebp)
+  80137d:	e8 18 fa ff ff       	call   800d9a <sys_kill>
+  801382:	83 c4 10             	add    $0x10,%esp
+}
+  801385:	c9                   	leave
+  801386:	c3                   	ret
+
+00801387 <getpid>:
+
+// the kernel keeps the pid in the TLS block, no system call needed
+int
+getpid(void) {
+  801387:	55                   	push   %ebp
+  801388:	89 e5                	mov    %esp,%ebp
+  80138a:	83 ec 10             	sub    $0x10,%esp
+    int pid;
+    asm volatile ("movl %%gs:%c1, %0" : "=r" (pid) : "i" (TLS_PID));
+  80138d:	65 a1 04 00 00 00    	mov    %gs:0x4,%eax
+  801393:	89 45 fc             	mov    %eax,-0x4(%ebp)
+    return pid;
+  801396:	8b 45 fc             	mov    -0x4(%ebp),%eax
+}
+  801399:	c9                   	leave
+  80139a:	c3                   	ret
+
+0080139b <print_pgdir>:
+
+//print_pgdir - print the PDT&PT
+void
+print_pgdir(void) {
+  80139b:	55                   	push   %ebp
+  80139c:	89 e5                	mov    %esp,%ebp
+  80139e:	83 ec 08             	sub    $0x8,%esp
+    sys_pgdir();
+  8013a1:	e8 39 fa ff ff       	call   800ddf <sys_pgdir>
+}
+  8013a6:	90                   	nop
+  8013a7:	c9                   	leave
+  8013a8:	c3                   	ret
+
+008013a9 <sleep>:
+
+int
+sleep(unsigned int time) {
+  8013a9:	55                   	push   %ebp
+  8013aa:	89 e5                	mov    %esp,%ebp
+  8013ac:	83 ec 08             	sub    $0x8,%esp
+    return sys_sleep(time);
+  8013af:	83 ec 0c             	sub    $0xc,%esp
+  8013b2:	ff 75 08             	push   0x8(%ebp)
+  8013b5:	e8 3a fa ff ff       	call   800df4 <sys_sleep>
+  8013ba:	83 c4 10             	add    $0x10,%esp
+}
+  8013bd:	c9                   	leave
+  8013be:	c3                   	ret
+
+008013bf <gettime_msec>:
+
+unsigned int
+gettime_msec(void) {
+  8013bf:	55                   	push   %ebp
+  8013c0:	89 e5                	mov    %esp,%ebp
+    // the timer interrupt publishes ticks in the vdso page
+    return vdso_data_page()->ticks;
+  8013c2:	b8 00 00 00 b0       	mov    $0xb0000000,%eax
+  8013c7:	8b 40 04             	mov    0x4(%eax),%eax
+}
+  8013ca:	5d                   	pop    %ebp
+  8013cb:	c3                   	ret
+
+008013cc <gettime_nsec>:
+
+// gettime_nsec - nanoseconds since boot, read from the vdso page and the TSC
+uint64_t
+gettime_nsec(void) {
+  8013cc:	55                   	push   %ebp
+  8013cd:	89 e5                	mov    %esp,%ebp
+  8013cf:	57                   	push   %edi
+  8013d0:	56                   	push   %esi
+  8013d1:	53                   	push   %ebx
+  8013d2:	83 ec 24             	sub    $0x24,%esp
+    const struct vdso_data *vd = vdso_data_page();
+  8013d5:	c7 45 e4 00 00 00 b0 	movl   $0xb0000000,-0x1c(%ebp)
+    uint32_t seq;
+    uint64_t ns;
+    do {
+        seq = vdso_read_begin(vd);
+  8013dc:	ff 75 e4             	push   -0x1c(%ebp)
+  8013df:	e8 b8 fe ff ff       	call   80129c <vdso_read_begin>
+  8013e4:	83 c4 04             	add    $0x4,%esp
+  8013e7:	89 45 e0             	mov    %eax,-0x20(%ebp)
+        ns = vd->ns_stamp;
+  8013ea:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  8013ed:	8b 50 14             	mov    0x14(%eax),%edx
+  8013f0:	8b 40 10             	mov    0x10(%eax),%eax
+  8013f3:	89 45 e8             	mov    %eax,-0x18(%ebp)
+  8013f6:	89 55 ec             	mov    %edx,-0x14(%ebp)
+        if (vd->ns_mult != 0) {
+  8013f9:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  8013fc:	8b 40 18             	mov    0x18(%eax),%eax
+  8013ff:	85 c0                	test   %eax,%eax
+  801401:	74 46                	je     801449 <gettime_nsec+0x7d>
+
+/* rdtsc - read the time-stamp counter */
+static inline uint64_t
+rdtsc(void) {
+    uint64_t val;
+    asm volatile ("rdtsc" : "=A" (val));
+  801403:	0f 31                	rdtsc
+  801405:	89 45 d8             	mov    %eax,-0x28(%ebp)
+  801408:	89 55 dc             	mov    %edx,-0x24(%ebp)
+    return val;
+  80140b:	8b 45 d8             	mov    -0x28(%ebp),%eax
+  80140e:	8b 55 dc             	mov    -0x24(%ebp),%edx
+            ns += ((rdtsc() - vd->tsc_stamp) * vd->ns_mult) >> VDSO_NS_SHIFT;
+  801411:	8b 4d e4             	mov    -0x1c(%ebp),%ecx
+  801414:	8b 59 0c             	mov    0xc(%ecx),%ebx
+  801417:	8b 49 08             	mov    0x8(%ecx),%ecx
+  80141a:	29 c8                	sub    %ecx,%eax
+  80141c:	19 da                	sbb    %ebx,%edx
+  80141e:	8b 4d e4             	mov    -0x1c(%ebp),%ecx
+  801421:	8b 49 18             	mov    0x18(%ecx),%ecx
+  801424:	bb 00 00 00 00       	mov    $0x0,%ebx
+  801429:	89 d7                	mov    %edx,%edi
+  80142b:	0f af f9             	imul   %ecx,%edi
+  80142e:	89 de                	mov    %ebx,%esi
+  801430:	0f af f0             	imul   %eax,%esi
+  801433:	01 fe                	add    %edi,%esi
+  801435:	f7 e1                	mul    %ecx
+  801437:	8d 0c 16             	lea    (%esi,%edx,1),%ecx
+  80143a:	89 ca                	mov    %ecx,%edx
+  80143c:	0f ac d0 16          	shrd   $0x16,%edx,%eax
+  801440:	c1 ea 16             	shr    $0x16,%edx
+  801443:	01 45 e8             	add    %eax,-0x18(%ebp)
+  801446:	11 55 ec             	adc    %edx,-0x14(%ebp)
+        }
+    } while (vdso_read_retry(vd, seq));
+  801449:	ff 75 e0             	push   -0x20(%ebp)
+  80144c:	ff 75 e4             	push   -0x1c(%ebp)
+  80144f:	e8 66 fe ff ff       	call   8012ba <vdso_read_retry>
+  801454:	83 c4 08             	add    $0x8,%esp
+  801457:	85 c0                	test   %eax,%eax
+  801459:	75 81                	jne    8013dc <gettime_nsec+0x10>
+    return ns;
+  80145b:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  80145e:	8b 55 ec             	mov    -0x14(%ebp),%edx
+}
+  801461:	8d 65 f4             	lea    -0xc(%ebp),%esp
+  801464:	5b                   	pop    %ebx
+  801465:	5e                   	pop    %esi
+  801466:	5f                   	pop    %edi
+  801467:	5d                   	pop    %ebp
+  801468:	c3                   	ret
+
+00801469 <clock_gettime>:
+
+int
+clock_gettime(int clock_id, struct timespec *ts) {
+  801469:	55                   	push   %ebp
+  80146a:	89 e5                	mov    %esp,%ebp
+  80146c:	83 ec 20             	sub    $0x20,%esp
+    if (clock_id != CLOCK_MONOTONIC) {
+  80146f:	83 7d 08 01          	cmpl   $0x1,0x8(%ebp)
+  801473:	74 07                	je     80147c <clock_gettime+0x13>
+        return -E_INVAL;
+  801475:	b8 fd ff ff ff       	mov    $0xfffffffd,%eax
+  80147a:	eb 79                	jmp    8014f5 <clock_gettime+0x8c>
+    }
+    uint64_t ns = gettime_nsec();
+  80147c:	e8 4b ff ff ff       	call   8013cc <gettime_nsec>
+  801481:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  801484:	89 55 f4             	mov    %edx,-0xc(%ebp)
+    ts->tv_nsec = do_div(ns, NSEC_PER_SEC);
+  801487:	c7 45 ec 00 ca 9a 3b 	movl   $0x3b9aca00,-0x14(%ebp)
+  80148e:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  801491:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  801494:	89 45 e8             	mov    %eax,-0x18(%ebp)
+  801497:	89 55 f8             	mov    %edx,-0x8(%ebp)
+  80149a:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  80149d:	89 45 fc             	mov    %eax,-0x4(%ebp)
+  8014a0:	83 7d f8 00          	cmpl   $0x0,-0x8(%ebp)
+  8014a4:	74 1c                	je     8014c2 <clock_gettime+0x59>
+  8014a6:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  8014a9:	ba 00 00 00 00       	mov    $0x0,%edx
+  8014ae:	f7 75 ec             	divl   -0x14(%ebp)
+  8014b1:	89 55 fc             	mov    %edx,-0x4(%ebp)
+  8014b4:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  8014b7:	ba 00 00 00 00       	mov    $0x0,%edx
+  8014bc:	f7 75 ec             	divl   -0x14(%ebp)
+  8014bf:	89 45 f8             	mov    %eax,-0x8(%ebp)
+  8014c2:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  8014c5:	8b 55 fc             	mov    -0x4(%ebp),%edx
+  8014c8:	f7 75 ec             	divl   -0x14(%ebp)
+  8014cb:	89 45 e8             	mov    %eax,-0x18(%ebp)
+  8014ce:	89 55 e4             	mov    %edx,-0x1c(%ebp)
+  8014d1:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  8014d4:	8b 55 f8             	mov    -0x8(%ebp),%edx
+  8014d7:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  8014da:	89 55 f4             	mov    %edx,-0xc(%ebp)
+  8014dd:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  8014e0:	89 c2                	mov    %eax,%edx
+  8014e2:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8014e5:	89 50 04             	mov    %edx,0x4(%eax)
+    ts->tv_sec = (int32_t)ns;
+  8014e8:	8b 55 f0             	mov    -0x10(%ebp),%edx
+  8014eb:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8014ee:	89 10                	mov    %edx,(%eax)
+    return 0;
+  8014f0:	b8 00 00 00 00       	mov    $0x0,%eax
+}
+  8014f5:	c9                   	leave
+  8014f6:	c3                   	ret
+
+008014f7 <nanosleep>:
+
+int
+nanosleep(const struct timespec *req) {
+  8014f7:	55                   	push   %ebp
+  8014f8:	89 e5                	mov    %esp,%ebp
+  8014fa:	83 ec 08             	sub    $0x8,%esp
+    return sys_nanosleep(req);
+  8014fd:	83 ec 0c             	sub    $0xc,%esp
+  801500:	ff 75 08             	push   0x8(%ebp)
+  801503:	e8 d1 fb ff ff       	call   8010d9 <sys_nanosleep>
+  801508:	83 c4 10             	add    $0x10,%esp
+}
+  80150b:	c9                   	leave
+  80150c:	c3                   	ret
+
+0080150d <str_to_int>:
+
+int str_to_int(char *str)
+{
+  80150d:	55                   	push   %ebp
+  80150e:	89 e5                	mov    %esp,%ebp
+  801510:	83 ec 10             	sub    $0x10,%esp
+  int value = 0;
+  801513:	c7 45 fc 00 00 00 00 	movl   $0x0,-0x4(%ebp)
+  for (int i = 0; str[i] != '\0'; i++)
+  80151a:	c7 45 f8 00 00 00 00 	movl   $0x0,-0x8(%ebp)
+  801521:	eb 28                	jmp    80154b <str_to_int+0x3e>
+    value = value * 10 + str[i] - '0';
+  801523:	8b 55 fc             	mov    -0x4(%ebp),%edx
+  801526:	89 d0                	mov    %edx,%eax
+  801528:	c1 e0 02             	shl    $0x2,%eax
+  80152b:	01 d0                	add    %edx,%eax
+  80152d:	01 c0                	add    %eax,%eax
+  80152f:	89 c1                	mov    %eax,%ecx
+  801531:	8b 55 f8             	mov    -0x8(%ebp),%edx
+  801534:	8b 45 08             	mov    0x8(%ebp),%eax
+  801537:	01 d0                	add    %edx,%eax
+  801539:	0f b6 00             	movzbl (%eax),%eax
+  80153c:	0f be c0             	movsbl %al,%eax
+  80153f:	01 c8                	add    %ecx,%eax
+  801541:	83 e8 30             	sub    $0x30,%eax
+  801544:	89 45 fc             	mov    %eax,-0x4(%ebp)
+  for (int i = 0; str[i] != '\0'; i++)
+  801547:	83 45 f8 01          	addl   $0x1,-0x8(%ebp)
+  80154b:	8b 55 f8             	mov    -0x8(%ebp),%edx
+  80154e:	8b 45 08             	mov    0x8(%ebp),%eax
+  801551:	01 d0                	add    %edx,%eax
+  801553:	0f b6 00             	movzbl (%eax),%eax
+  801556:	84 c0                	test   %al,%al
+  801558:	75 c9                	jne    801523 <str_to_int+0x16>
+  return value;
+  80155a:	8b 45 fc             	mov    -0x4(%ebp),%eax
+}
+  80155d:	c9                   	leave
+  80155e:	c3                   	ret
+
+0080155f <__exec>:
+
+int
+__exec(const char *name, const char **argv) {
+  80155f:	55                   	push   %ebp
+  801560:	89 e5                	mov    %esp,%ebp
+  801562:	83 ec 18             	sub    $0x18,%esp
+    int argc = 0;
+  801565:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+    while (argv[argc] != NULL) {
+  80156c:	eb 04                	jmp    801572 <__exec+0x13>
+        argc ++;
+  80156e:	83 45 f4 01          	addl   $0x1,-0xc(%ebp)
+    while (argv[argc] != NULL) {
+  801572:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  801575:	8d 14 85 00 00 00 00 	lea    0x0(,%eax,4),%edx
+  80157c:	8b 45 0c             	mov    0xc(%ebp),%eax
+  80157f:	01 d0                	add    %edx,%eax
+  801581:	8b 00                	mov    (%eax),%eax
+  801583:	85 c0                	test   %eax,%eax
+  801585:	75 e7                	jne    80156e <__exec+0xf>
+    }
+    return sys_exec(name, argc, argv);
+  801587:	83 ec 04             	sub    $0x4,%esp
+  80158a:	ff 75 0c             	push   0xc(%ebp)
+  80158d:	ff 75 f4             	push   -0xc(%ebp)
+  801590:	ff 75 08             	push   0x8(%ebp)
+  801593:	e8 89 f8 ff ff       	call   800e21 <sys_exec>
+  801598:	83 c4 10             	add    $0x10,%esp
+}
+  80159b:	c9                   	leave
+  80159c:	c3                   	ret
+
+0080159d <initfd>:
+#include <stat.h>
+
+int main(int argc, char *argv[]);
+
+static int
+initfd(int fd2, const char *path, uint32_t open_flags) {
+  80159d:	55                   	push   %ebp
+  80159e:	89 e5                	mov    %esp,%ebp
+  8015a0:	83 ec 28             	sub    $0x28,%esp
+    int fd1, ret;
+    struct stat __stat, *stat = &__stat;
+  8015a3:	8d 45 dc             	lea    -0x24(%ebp),%eax
+  8015a6:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    if((ret = fstat(fd2, stat)) != 0){
+  8015a9:	83 ec 08             	sub    $0x8,%esp
+  8015ac:	ff 75 f0             	push   -0x10(%ebp)
+  8015af:	ff 75 08             	push   0x8(%ebp)
+  8015b2:	e8 22 ec ff ff       	call   8001d9 <fstat>
+  8015b7:	83 c4 10             	add    $0x10,%esp
+  8015ba:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  8015bd:	83 7d f4 00          	cmpl   $0x0,-0xc(%ebp)
+  8015c1:	74 5c                	je     80161f <initfd+0x82>
+        if ((fd1 = open(path, open_flags)) < 0) {
+  8015c3:	83 ec 08             	sub    $0x8,%esp
+  8015c6:	ff 75 10             	push   0x10(%ebp)
+  8015c9:	ff 75 0c             	push   0xc(%ebp)
+  8015cc:	e8 85 eb ff ff       	call   800156 <open>
+  8015d1:	83 c4 10             	add    $0x10,%esp
+  8015d4:	89 45 ec             	mov    %eax,-0x14(%ebp)
+  8015d7:	83 7d ec 00          	cmpl   $0x0,-0x14(%ebp)
+  8015db:	79 05                	jns    8015e2 <initfd+0x45>
+            return fd1;
+  8015dd:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  8015e0:	eb 42                	jmp    801624 <initfd+0x87>
+        }
+        if (fd1 != fd2) {
+  8015e2:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  8015e5:	3b 45 08             	cmp    0x8(%ebp),%eax
+  8015e8:	74 30                	je     80161a <initfd+0x7d>
+            close(fd2);
+  8015ea:	83 ec 0c             	sub    $0xc,%esp
+  8015ed:	ff 75 08             	push   0x8(%ebp)
+  8015f0:	e8 7a eb ff ff       	call   80016f <close>
+  8015f5:	83 c4 10             	add    $0x10,%esp
+            ret = dup2(fd1, fd2);
+  8015f8:	83 ec 08             	sub    $0x8,%esp
+  8015fb:	ff 75 08             	push   0x8(%ebp)
+  8015fe:	ff 75 ec             	push   -0x14(%ebp)
+  801601:	e8 02 ec ff ff       	call   800208 <dup2>
+  801606:	83 c4 10             	add    $0x10,%esp
+  801609:	89 45 f4             	mov    %eax,-0xc(%ebp)
+            close(fd1);
+  80160c:	83 ec 0c             	sub    $0xc,%esp
+  80160f:	ff 75 ec             	push   -0x14(%ebp)
+  801612:	e8 58 eb ff ff       	call   80016f <close>
+  801617:	83 c4 10             	add    $0x10,%esp
+        }
+        return ret;
+  80161a:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  80161d:	eb 05                	jmp    801624 <initfd+0x87>
+    }
+    return 0;
+  80161f:	b8 00 00 00 00       	mov    $0x0,%eax
+}
+  801624:	c9                   	leave
+  801625:	c3                   	ret
+
+00801626 <umain>:
+
+void
+umain(int argc, char *argv[]) {
+  801626:	55                   	push   %ebp
+  801627:	89 e5                	mov    %esp,%ebp
+  801629:	83 ec 18             	sub    $0x18,%esp
+    int fd;
+    if ((fd = initfd(0, "stdin:", O_RDONLY)) < 0) {
+  80162c:	83 ec 04             	sub    $0x4,%esp
+  80162f:	6a 00                	push   $0x0
+  801631:	68 41 2f 80 00       	push   $0x802f41
+  801636:	6a 00                	push   $0x0
+  801638:	e8 60 ff ff ff       	call   80159d <initfd>
+  80163d:	83 c4 10             	add    $0x10,%esp
+  801640:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  801643:	83 7d f4 00          	cmpl   $0x0,-0xc(%ebp)
+  801647:	79 17                	jns    801660 <umain+0x3a>
+        warn("open <stdin> failed: %e.\n", fd);
+  801649:	ff 75 f4             	push   -0xc(%ebp)
+  80164c:	68 48 2f 80 00       	push   $0x802f48
+  801651:	6a 1e                	push   $0x1e
+  801653:	68 62 2f 80 00       	push   $0x802f62
+  801658:	e8 2a f1 ff ff       	call   800787 <__warn>
+  80165d:	83 c4 10             	add    $0x10,%esp
+    }
+    if ((fd = initfd(1, "stdout:", O_WRONLY)) < 0) {
+  801660:	83 ec 04             	sub    $0x4,%esp
+  801663:	6a 01                	push   $0x1
+  801665:	68 74 2f 80 00       	push   $0x802f74
+  80166a:	6a 01                	push   $0x1
+  80166c:	e8 2c ff ff ff       	call   80159d <initfd>
+  801671:	83 c4 10             	add    $0x10,%esp
+  801674:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  801677:	83 7d f4 00          	cmpl   $0x0,-0xc(%ebp)
+  80167b:	79 17                	jns    801694 <umain+0x6e>
+        warn("open <stdout> failed: %e.\n", fd);
+  80167d:	ff 75 f4             	push   -0xc(%ebp)
+  801680:	68 7c 2f 80 00       	push   $0x802f7c
+  801685:	6a 21                	push   $0x21
+  801687:	68 62 2f 80 00       	push   $0x802f62
+  80168c:	e8 f6 f0 ff ff       	call   800787 <__warn>
+  801691:	83 c4 10             	add    $0x10,%esp
+    }
+
+    int ret = main(argc, argv);
+  801694:	83 ec 08             	sub    $0x8,%esp
+  801697:	ff 75 0c             	push   0xc(%ebp)
+  80169a:	ff 75 08             	push   0x8(%ebp)
+  80169d:	e8 0b 17 00 00       	call   802dad <main>
+  8016a2:	83 c4 10             	add    $0x10,%esp
+  8016a5:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    close(0);
+  8016a8:	83 ec 0c             	sub    $0xc,%esp
+  8016ab:	6a 00                	push   $0x0
+  8016ad:	e8 bd ea ff ff       	call   80016f <close>
+  8016b2:	83 c4 10             	add    $0x10,%esp
+    close(1);
+  8016b5:	83 ec 0c             	sub    $0xc,%esp
+  8016b8:	6a 01                	push   $0x1
+  8016ba:	e8 b0 ea ff ff       	call   80016f <close>
+  8016bf:	83 c4 10             	add    $0x10,%esp
+    exit(ret);
+  8016c2:	83 ec 0c             	sub    $0xc,%esp
+  8016c5:	ff 75 f0             	push   -0x10(%ebp)
+  8016c8:	e8 32 fc ff ff       	call   8012ff <exit>
+
+008016cd <hash32>:
+ * @bits:   the number of bits in a return value
+ *
+ * High bits are more random, so we use them.
+ * */
+uint32_t
+hash32(uint32_t val, unsigned int bits) {
+  8016cd:	55                   	push   %ebp
+  8016ce:	89 e5                	mov    %esp,%ebp
+  8016d0:	83 ec 10             	sub    $0x10,%esp
+    uint32_t hash = val * GOLDEN_RATIO_PRIME_32;
+  8016d3:	8b 45 08             	mov    0x8(%ebp),%eax
+  8016d6:	69 c0 01 00 37 9e    	imul   $0x9e370001,%eax,%eax
+  8016dc:	89 45 fc             	mov    %eax,-0x4(%ebp)
+    return (hash >> (32 - bits));
+  8016df:	b8 20 00 00 00       	mov    $0x20,%eax
+  8016e4:	2b 45 0c             	sub    0xc(%ebp),%eax
+  8016e7:	8b 55 fc             	mov    -0x4(%ebp),%edx
+  8016ea:	89 c1                	mov    %eax,%ecx
+  8016ec:	d3 ea                	shr    %cl,%edx
+  8016ee:	89 d0                	mov    %edx,%eax
+}
+  8016f0:	c9                   	leave
+  8016f1:	c3                   	ret
+
+008016f2 <printnum>:
+ * @width:      maximum number of digits, if the actual width is less than @width, use @padc instead
+ * @padc:       character that padded on the left if the actual width is less than @width
+ * */
+static void
+printnum(void (*putch)(int, void*, int), int fd, void *putdat,
+        unsigned long long num, unsigned base, int width, int padc) {
+  8016f2:	55                   	push   %ebp
+  8016f3:	89 e5                	mov    %esp,%ebp
+  8016f5:	83 ec 38             	sub    $0x38,%esp
+  8016f8:	8b 45 14             	mov    0x14(%ebp),%eax
+  8016fb:	89 45 d0             	mov    %eax,-0x30(%ebp)
+  8016fe:	8b 45 18             	mov    0x18(%ebp),%eax
+  801701:	89 45 d4             	mov    %eax,-0x2c(%ebp)
+    unsigned long long result = num;
+  801704:	8b 45 d0             	mov    -0x30(%ebp),%eax
+  801707:	8b 55 d4             	mov    -0x2c(%ebp),%edx
+  80170a:	89 45 e8             	mov    %eax,-0x18(%ebp)
+  80170d:	89 55 ec             	mov    %edx,-0x14(%ebp)
+    unsigned mod = do_div(result, base);
+  801710:	8b 45 1c             	mov    0x1c(%ebp),%eax
+  801713:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+  801716:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  801719:	8b 55 ec             	mov    -0x14(%ebp),%edx
+  80171c:	89 45 e0             	mov    %eax,-0x20(%ebp)
+  80171f:	89 55 f0             	mov    %edx,-0x10(%ebp)
+  801722:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  801725:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  801728:	83 7d f0 00          	cmpl   $0x0,-0x10(%ebp)
+  80172c:	74 1c                	je     80174a <printnum+0x58>
+  80172e:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  801731:	ba 00 00 00 00       	mov    $0x0,%edx
+  801736:	f7 75 e4             	divl   -0x1c(%ebp)
+  801739:	89 55 f4             	mov    %edx,-0xc(%ebp)
+  80173c:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  80173f:	ba 00 00 00 00       	mov    $0x0,%edx
+  801744:	f7 75 e4             	divl   -0x1c(%ebp)
+  801747:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  80174a:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  80174d:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  801750:	f7 75 e4             	divl   -0x1c(%ebp)
+  801753:	89 45 e0             	mov    %eax,-0x20(%ebp)
+  801756:	89 55 dc             	mov    %edx,-0x24(%ebp)
+  801759:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  80175c:	8b 55 f0             	mov    -0x10(%ebp),%edx
+  80175f:	89 45 e8             	mov    %eax,-0x18(%ebp)
+  801762:	89 55 ec             	mov    %edx,-0x14(%ebp)
+  801765:	8b 45 dc             	mov    -0x24(%ebp),%eax
+  801768:	89 45 d8             	mov    %eax,-0x28(%ebp)
+
+    // first recursively print all preceding (more significant) digits
+    if (num >= base) {
+  80176b:	8b 45 1c             	mov    0x1c(%ebp),%eax
+  80176e:	ba 00 00 00 00       	mov    $0x0,%edx
+  801773:	8b 4d d4             	mov    -0x2c(%ebp),%ecx
+  801776:	39 45 d0             	cmp    %eax,-0x30(%ebp)
+  801779:	19 d1                	sbb    %edx,%ecx
+  80177b:	72 3a                	jb     8017b7 <printnum+0xc5>
+        printnum(putch, fd, putdat, result, base, width - 1, padc);
+  80177d:	8b 45 20             	mov    0x20(%ebp),%eax
+  801780:	83 e8 01             	sub    $0x1,%eax
+  801783:	ff 75 24             	push   0x24(%ebp)
+  801786:	50                   	push   %eax
+  801787:	ff 75 1c             	push   0x1c(%ebp)
+  80178a:	ff 75 ec             	push   -0x14(%ebp)
+  80178d:	ff 75 e8             	push   -0x18(%ebp)
+  801790:	ff 75 10             	push   0x10(%ebp)
+  801793:	ff 75 0c             	push   0xc(%ebp)
+  801796:	ff 75 08             	push   0x8(%ebp)
+  801799:	e8 54 ff ff ff       	call   8016f2 <printnum>
+  80179e:	83 c4 20             	add    $0x20,%esp
+  8017a1:	eb 1e                	jmp    8017c1 <printnum+0xcf>
+    } else {
+        // print any needed pad characters before first digit
+        while (-- width > 0)
+            putch(padc, putdat, fd);
+  8017a3:	83 ec 04             	sub    $0x4,%esp
+  8017a6:	ff 75 0c             	push   0xc(%ebp)
+  8017a9:	ff 75 10             	push   0x10(%ebp)
+  8017ac:	ff 75 24             	push   0x24(%ebp)
+  8017af:	8b 45 08             	mov    0x8(%ebp),%eax
+  8017b2:	ff d0                	call   *%eax
+  8017b4:	83 c4 10             	add    $0x10,%esp
+        while (-- width > 0)
+  8017b7:	83 6d 20 01          	subl   $0x1,0x20(%ebp)
+  8017bb:	83 7d 20 00          	cmpl   $0x0,0x20(%ebp)
+  8017bf:	7f e2                	jg     8017a3 <printnum+0xb1>
+    }
+    // then print this (the least significant) digit
+    putch("0123456789abcdef"[mod], putdat, fd);
+  8017c1:	8b 45 d8             	mov    -0x28(%ebp),%eax
+  8017c4:	05 a8 31 80 00       	add    $0x8031a8,%eax
+  8017c9:	0f b6 00             	movzbl (%eax),%eax
+  8017cc:	0f be c0             	movsbl %al,%eax
+  8017cf:	83 ec 04             	sub    $0x4,%esp
+  8017d2:	ff 75 0c             	push   0xc(%ebp)
+  8017d5:	ff 75 10             	push   0x10(%ebp)
+  8017d8:	50                   	push   %eax
+  8017d9:	8b 45 08             	mov    0x8(%ebp),%eax
+  8017dc:	ff d0                	call   *%eax
+  8017de:	83 c4 10             	add    $0x10,%esp
+}
+  8017e1:	90                   	nop
+  8017e2:	c9                   	leave
+  8017e3:	c3                   	ret
+
+008017e4 <getuint>:
+ * getuint - get an unsigned int of various possible sizes from a varargs list
+ * @ap:         a varargs list pointer
+ * @lflag:      determines the size of the vararg that @ap points to
+ * */
+static unsigned long long
+getuint(va_list *ap, int lflag) {
+  8017e4:	55                   	push   %ebp
+  8017e5:	89 e5                	mov    %esp,%ebp
+    if (lflag >= 2) {
+  8017e7:	83 7d 0c 01          	cmpl   $0x1,0xc(%ebp)
+  8017eb:	7e 14                	jle    801801 <getuint+0x1d>
+        return va_arg(*ap, unsigned long long);
+  8017ed:	8b 45 08             	mov    0x8(%ebp),%eax
+  8017f0:	8b 00                	mov    (%eax),%eax
+  8017f2:	8d 48 08             	lea    0x8(%eax),%ecx
+  8017f5:	8b 55 08             	mov    0x8(%ebp),%edx
+  8017f8:	89 0a                	mov    %ecx,(%edx)
+  8017fa:	8b 50 04             	mov    0x4(%eax),%edx
+  8017fd:	8b 00                	mov    (%eax),%eax
+  8017ff:	eb 30                	jmp    801831 <getuint+0x4d>
+    }
+    else if (lflag) {
+  801801:	83 7d 0c 00          	cmpl   $0x0,0xc(%ebp)
+  801805:	74 16                	je     80181d <getuint+0x39>
+        return va_arg(*ap, unsigned long);
+  801807:	8b 45 08             	mov    0x8(%ebp),%eax
+  80180a:	8b 00                	mov    (%eax),%eax
+  80180c:	8d 48 04             	lea    0x4(%eax),%ecx
+  80180f:	8b 55 08             	mov    0x8(%ebp),%edx
+  801812:	89 0a                	mov    %ecx,(%edx)
+  801814:	8b 00                	mov    (%eax),%eax
+  801816:	ba 00 00 00 00       	mov    $0x0,%edx
+  80181b:	eb 14                	jmp    801831 <getuint+0x4d>
+    }
+    else {
+        return va_arg(*ap, unsigned int);
+  80181d:	8b 45 08             	mov    0x8(%ebp),%eax
+  801820:	8b 00                	mov    (%eax),%eax
+  801822:	8d 48 04             	lea    0x4(%eax),%ecx
+  801825:	8b 55 08             	mov    0x8(%ebp),%edx
+  801828:	89 0a                	mov    %ecx,(%edx)
+  80182a:	8b 00                	mov    (%eax),%eax
+  80182c:	ba 00 00 00 00       	mov    $0x0,%edx
+    }
+}
+  801831:	5d                   	pop    %ebp
+  801832:	c3                   	ret
+
+00801833 <getint>:
+ * getint - same as getuint but signed, we can't use getuint because of sign extension
+ * @ap:         a varargs list pointer
+ * @lflag:      determines the size of the vararg that @ap points to
+ * */
+static long long
+getint(va_list *ap, int lflag) {
+  801833:	55                   	push   %ebp
+  801834:	89 e5                	mov    %esp,%ebp
+    if (lflag >= 2) {
+  801836:	83 7d 0c 01          	cmpl   $0x1,0xc(%ebp)
+  80183a:	7e 14                	jle    801850 <getint+0x1d>
+        return va_arg(*ap, long long);
+  80183c:	8b 45 08             	mov    0x8(%ebp),%eax
+  80183f:	8b 00                	mov    (%eax),%eax
+  801841:	8d 48 08             	lea    0x8(%eax),%ecx
+  801844:	8b 55 08             	mov    0x8(%ebp),%edx
+  801847:	89 0a                	mov    %ecx,(%edx)
+  801849:	8b 50 04             	mov    0x4(%eax),%edx
+  80184c:	8b 00                	mov    (%eax),%eax
+  80184e:	eb 28                	jmp    801878 <getint+0x45>
+    }
+    else if (lflag) {
+  801850:	83 7d 0c 00          	cmpl   $0x0,0xc(%ebp)
+  801854:	74 12                	je     801868 <getint+0x35>
+        return va_arg(*ap, long);
+  801856:	8b 45 08             	mov    0x8(%ebp),%eax
+  801859:	8b 00                	mov    (%eax),%eax
+  80185b:	8d 48 04             	lea    0x4(%eax),%ecx
+  80185e:	8b 55 08             	mov    0x8(%ebp),%edx
+  801861:	89 0a                	mov    %ecx,(%edx)
+  801863:	8b 00                	mov    (%eax),%eax
+  801865:	99                   	cltd
+  801866:	eb 10                	jmp    801878 <getint+0x45>
+    }
+    else {
+        return va_arg(*ap, int);
+  801868:	8b 45 08             	mov    0x8(%ebp),%eax
+  80186b:	8b 00                	mov    (%eax),%eax
+  80186d:	8d 48 04             	lea    0x4(%eax),%ecx
+  801870:	8b 55 08             	mov    0x8(%ebp),%edx
+  801873:	89 0a                	mov    %ecx,(%edx)
+  801875:	8b 00                	mov    (%eax),%eax
+  801877:	99                   	cltd
+    }
+}
+  801878:	5d                   	pop    %ebp
+  801879:	c3                   	ret
+
+0080187a <printfmt>:
+ * @fd:         file descriptor
+ * @putdat:     used by @putch function
+ * @fmt:        the format string to use
+ * */
+void
+printfmt(void (*putch)(int, void*, int), int fd, void *putdat, const char *fmt, ...) {
+  80187a:	55                   	push   %ebp
+  80187b:	89 e5                	mov    %esp,%ebp
+  80187d:	83 ec 18             	sub    $0x18,%esp
+    va_list ap;
+
+    va_start(ap, fmt);
+  801880:	8d 45 18             	lea    0x18(%ebp),%eax
+  801883:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    vprintfmt(putch, fd, putdat, fmt, ap);
+  801886:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  801889:	83 ec 0c             	sub    $0xc,%esp
+  80188c:	50                   	push   %eax
+  80188d:	ff 75 14             	push   0x14(%ebp)
+  801890:	ff 75 10             	push   0x10(%ebp)
+  801893:	ff 75 0c             	push   0xc(%ebp)
+  801896:	ff 75 08             	push   0x8(%ebp)
+  801899:	e8 06 00 00 00       	call   8018a4 <vprintfmt>
+  80189e:	83 c4 20             	add    $0x20,%esp
+    va_end(ap);
+}
+  8018a1:	90                   	nop
+  8018a2:	c9                   	leave
+  8018a3:	c3                   	ret
+
+008018a4 <vprintfmt>:
+ *
+ * Call this function if you are already dealing with a va_list.
+ * Or you probably want printfmt() instead.
+ * */
+void
+vprintfmt(void (*putch)(int, void*, int), int fd, void *putdat, const char *fmt, va_list ap) {
+  8018a4:	55                   	push   %ebp
+  8018a5:	89 e5                	mov    %esp,%ebp
+  8018a7:	56                   	push   %esi
+  8018a8:	53                   	push   %ebx
+  8018a9:	83 ec 20             	sub    $0x20,%esp
+    register int ch, err;
+    unsigned long long num;
+    int base, width, precision, lflag, altflag;
+
+    while (1) {
+        while ((ch = *(unsigned char *)fmt ++) != '%') {
+  8018ac:	eb 1a                	jmp    8018c8 <vprintfmt+0x24>
+            if (ch == '\0') {
+  8018ae:	85 db                	test   %ebx,%ebx
+  8018b0:	0f 84 c2 03 00 00    	je     801c78 <vprintfmt+0x3d4>
+                return;
+            }
+            putch(ch, putdat, fd);
+  8018b6:	83 ec 04             	sub    $0x4,%esp
+  8018b9:	ff 75 0c             	push   0xc(%ebp)
+  8018bc:	ff 75 10             	push   0x10(%ebp)
+  8018bf:	53                   	push   %ebx
+  8018c0:	8b 45 08             	mov    0x8(%ebp),%eax
+  8018c3:	ff d0                	call   *%eax
+  8018c5:	83 c4 10             	add    $0x10,%esp
+        while ((ch = *(unsigned char *)fmt ++) != '%') {
+  8018c8:	8b 45 14             	mov    0x14(%ebp),%eax
+  8018cb:	8d 50 01             	lea    0x1(%eax),%edx
+  8018ce:	89 55 14             	mov    %edx,0x14(%ebp)
+  8018d1:	0f b6 00             	movzbl (%eax),%eax
+  8018d4:	0f b6 d8             	movzbl %al,%ebx
+  8018d7:	83 fb 25             	cmp    $0x25,%ebx
+  8018da:	75 d2                	jne    8018ae <vprintfmt+0xa>
+        }
+
+        // Process a %-escape sequence
+        char padc = ' ';
+  8018dc:	c6 45 db 20          	movb   $0x20,-0x25(%ebp)
+        width = precision = -1;
+  8018e0:	c7 45 e4 ff ff ff ff 	movl   $0xffffffff,-0x1c(%ebp)
+  8018e7:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  8018ea:	89 45 e8             	mov    %eax,-0x18(%ebp)
+        lflag = altflag = 0;
+  8018ed:	c7 45 dc 00 00 00 00 	movl   $0x0,-0x24(%ebp)
+  8018f4:	8b 45 dc             	mov    -0x24(%ebp),%eax
+  8018f7:	89 45 e0             	mov    %eax,-0x20(%ebp)
+  8018fa:	eb 04                	jmp    801900 <vprintfmt+0x5c>
+            goto process_precision;
+
+        case '.':
+            if (width < 0)
+                width = 0;
+            goto reswitch;
+  8018fc:	90                   	nop
+  8018fd:	eb 01                	jmp    801900 <vprintfmt+0x5c>
+            goto reswitch;
+
+        process_precision:
+            if (width < 0)
+                width = precision, precision = -1;
+            goto reswitch;
+  8018ff:	90                   	nop
+        switch (ch = *(unsigned char *)fmt ++) {
+  801900:	8b 45 14             	mov    0x14(%ebp),%eax
+  801903:	8d 50 01             	lea    0x1(%eax),%edx
+  801906:	89 55 14             	mov    %edx,0x14(%ebp)
+  801909:	0f b6 00             	movzbl (%eax),%eax
+  80190c:	0f b6 d8             	movzbl %al,%ebx
+  80190f:	8d 43 dd             	lea    -0x23(%ebx),%eax
+  801912:	83 f8 55             	cmp    $0x55,%eax
+  801915:	0f 87 2d 03 00 00    	ja     801c48 <vprintfmt+0x3a4>
+  80191b:	8b 04 85 cc 31 80 00 	mov    0x8031cc(,%eax,4),%eax
+  801922:	ff e0                	jmp    *%eax
+            padc = '-';
+  801924:	c6 45 db 2d          	movb   $0x2d,-0x25(%ebp)
+            goto reswitch;
+  801928:	eb d6                	jmp    801900 <vprintfmt+0x5c>
+            padc = '0';
+  80192a:	c6 45 db 30          	movb   $0x30,-0x25(%ebp)
+            goto reswitch;
+  80192e:	eb d0                	jmp    801900 <vprintfmt+0x5c>
+            for (precision = 0; ; ++ fmt) {
+  801930:	c7 45 e4 00 00 00 00 	movl   $0x0,-0x1c(%ebp)
+                precision = precision * 10 + ch - '0';
+  801937:	8b 55 e4             	mov    -0x1c(%ebp),%edx
+  80193a:	89 d0                	mov    %edx,%eax
+  80193c:	c1 e0 02             	shl    $0x2,%eax
+  80193f:	01 d0                	add    %edx,%eax
+  801941:	01 c0                	add    %eax,%eax
+  801943:	01 d8                	add    %ebx,%eax
+  801945:	83 e8 30             	sub    $0x30,%eax
+  801948:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+                ch = *fmt;
+  80194b:	8b 45 14             	mov    0x14(%ebp),%eax
+  80194e:	0f b6 00             	movzbl (%eax),%eax
+  801951:	0f be d8             	movsbl %al,%ebx
+                if (ch < '0' || ch > '9') {
+  801954:	83 fb 2f             	cmp    $0x2f,%ebx
+  801957:	7e 39                	jle    801992 <vprintfmt+0xee>
+  801959:	83 fb 39             	cmp    $0x39,%ebx
+  80195c:	7f 34                	jg     801992 <vprintfmt+0xee>
+            for (precision = 0; ; ++ fmt) {
+  80195e:	83 45 14 01          	addl   $0x1,0x14(%ebp)
+                precision = precision * 10 + ch - '0';
+  801962:	eb d3                	jmp    801937 <vprintfmt+0x93>
+            precision = va_arg(ap, int);
+  801964:	8b 45 18             	mov    0x18(%ebp),%eax
+  801967:	8d 50 04             	lea    0x4(%eax),%edx
+  80196a:	89 55 18             	mov    %edx,0x18(%ebp)
+  80196d:	8b 00                	mov    (%eax),%eax
+  80196f:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+            goto process_precision;
+  801972:	eb 1f                	jmp    801993 <vprintfmt+0xef>
+            if (width < 0)
+  801974:	83 7d e8 00          	cmpl   $0x0,-0x18(%ebp)
+  801978:	79 82                	jns    8018fc <vprintfmt+0x58>
+                width = 0;
+  80197a:	c7 45 e8 00 00 00 00 	movl   $0x0,-0x18(%ebp)
+            goto reswitch;
+  801981:	e9 76 ff ff ff       	jmp    8018fc <vprintfmt+0x58>
+            altflag = 1;
+  801986:	c7 45 dc 01 00 00 00 	movl   $0x1,-0x24(%ebp)
+            goto reswitch;
+  80198d:	e9 6e ff ff ff       	jmp    801900 <vprintfmt+0x5c>
+            goto process_precision;
+  801992:	90                   	nop
+            if (width < 0)
+  801993:	83 7d e8 00          	cmpl   $0x0,-0x18(%ebp)
+  801997:	0f 89 62 ff ff ff    	jns    8018ff <vprintfmt+0x5b>
+                width = precision, precision = -1;
+  80199d:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  8019a0:	89 45 e8             	mov    %eax,-0x18(%ebp)
+  8019a3:	c7 45 e4 ff ff ff ff 	movl   $0xffffffff,-0x1c(%ebp)
+            goto reswitch;
+  8019aa:	e9 50 ff ff ff       	jmp    8018ff <vprintfmt+0x5b>
+
+        // long flag (doubled for long long)
+        case 'l':
+            lflag ++;
+  8019af:	83 45 e0 01          	addl   $0x1,-0x20(%ebp)
+            goto reswitch;
+  8019b3:	e9 48 ff ff ff       	jmp    801900 <vprintfmt+0x5c>
+
+        // character
+        case 'c':
+            putch(va_arg(ap, int), putdat, fd);
+  8019b8:	8b 45 18             	mov    0x18(%ebp),%eax
+  8019bb:	8d 50 04             	lea    0x4(%eax),%edx
+  8019be:	89 55 18             	mov    %edx,0x18(%ebp)
+  8019c1:	8b 00                	mov    (%eax),%eax
+  8019c3:	83 ec 04             	sub    $0x4,%esp
+  8019c6:	ff 75 0c             	push   0xc(%ebp)
+  8019c9:	ff 75 10             	push   0x10(%ebp)
+  8019cc:	50                   	push   %eax
+  8019cd:	8b 45 08             	mov    0x8(%ebp),%eax
+  8019d0:	ff d0                	call   *%eax
+  8019d2:	83 c4 10             	add    $0x10,%esp
+            break;
+  8019d5:	e9 99 02 00 00       	jmp    801c73 <vprintfmt+0x3cf>
+
+        // error message
+        case 'e':
+            err = va_arg(ap, int);
+  8019da:	8b 45 18             	mov    0x18(%ebp),%eax
+  8019dd:	8d 50 04             	lea    0x4(%eax),%edx
+  8019e0:	89 55 18             	mov    %edx,0x18(%ebp)
+  8019e3:	8b 18                	mov    (%eax),%ebx
+            if (err < 0) {
+  8019e5:	85 db                	test   %ebx,%ebx
+  8019e7:	79 02                	jns    8019eb <vprintfmt+0x147>
+                err = -err;
+  8019e9:	f7 db                	neg    %ebx
+            }
+            if (err > MAXERROR || (p = error_string[err]) == NULL) {
+  8019eb:	83 fb 19             	cmp    $0x19,%ebx
+  8019ee:	7f 0b                	jg     8019fb <vprintfmt+0x157>
+  8019f0:	8b 34 9d 40 31 80 00 	mov    0x803140(,%ebx,4),%esi
+  8019f7:	85 f6                	test   %esi,%esi
+  8019f9:	75 1f                	jne    801a1a <vprintfmt+0x176>
+                printfmt(putch, fd, putdat, "error %d", err);
+  8019fb:	83 ec 0c             	sub    $0xc,%esp
+  8019fe:	53                   	push   %ebx
+  8019ff:	68 b9 31 80 00       	push   $0x8031b9
+  801a04:	ff 75 10             	push   0x10(%ebp)
+  801a07:	ff 75 0c             	push   0xc(%ebp)
+  801a0a:	ff 75 08             	push   0x8(%ebp)
+  801a0d:	e8 68 fe ff ff       	call   80187a <printfmt>
+  801a12:	83 c4 20             	add    $0x20,%esp
+            }
+            else {
+                printfmt(putch, fd, putdat, "%s", p);
+            }
+            break;
+  801a15:	e9 59 02 00 00       	jmp    801c73 <vprintfmt+0x3cf>
+                printfmt(putch, fd, putdat, "%s", p);
+  801a1a:	83 ec 0c             	sub    $0xc,%esp
+  801a1d:	56                   	push   %esi
+  801a1e:	68 c2 31 80 00       	push   $0x8031c2
+  801a23:	ff 75 10             	push   0x10(%ebp)
+  801a26:	ff 75 0c             	push   0xc(%ebp)
+  801a29:	ff 75 08             	push   0x8(%ebp)
+  801a2c:	e8 49 fe ff ff       	call   80187a <printfmt>
+  801a31:	83 c4 20             	add    $0x20,%esp
+            break;
+  801a34:	e9 3a 02 00 00       	jmp    801c73 <vprintfmt+0x3cf>
+
+        // string
+        case 's':
+            if ((p = va_arg(ap, char *)) == NULL) {
+  801a39:	8b 45 18             	mov    0x18(%ebp),%eax
+  801a3c:	8d 50 04             	lea    0x4(%eax),%edx
+  801a3f:	89 55 18             	mov    %edx,0x18(%ebp)
+  801a42:	8b 30                	mov    (%eax),%esi
+  801a44:	85 f6                	test   %esi,%esi
+  801a46:	75 05                	jne    801a4d <vprintfmt+0x1a9>
+                p = "(null)";
+  801a48:	be c5 31 80 00       	mov    $0x8031c5,%esi
+            }
+            if (width > 0 && padc != '-') {
+  801a4d:	83 7d e8 00          	cmpl   $0x0,-0x18(%ebp)
+  801a51:	7e 7d                	jle    801ad0 <vprintfmt+0x22c>
+  801a53:	80 7d db 2d          	cmpb   $0x2d,-0x25(%ebp)
+  801a57:	74 77                	je     801ad0 <vprintfmt+0x22c>
+                for (width -= strnlen(p, precision); width > 0; width --) {
+  801a59:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  801a5c:	83 ec 08             	sub    $0x8,%esp
+  801a5f:	50                   	push   %eax
+  801a60:	56                   	push   %esi
+  801a61:	e8 91 0e 00 00       	call   8028f7 <strnlen>
+  801a66:	83 c4 10             	add    $0x10,%esp
+  801a69:	8b 55 e8             	mov    -0x18(%ebp),%edx
+  801a6c:	29 c2                	sub    %eax,%edx
+  801a6e:	89 55 e8             	mov    %edx,-0x18(%ebp)
+  801a71:	eb 1a                	jmp    801a8d <vprintfmt+0x1e9>
+                    putch(padc, putdat, fd);
+  801a73:	0f be 45 db          	movsbl -0x25(%ebp),%eax
+  801a77:	83 ec 04             	sub    $0x4,%esp
+  801a7a:	ff 75 0c             	push   0xc(%ebp)
+  801a7d:	ff 75 10             	push   0x10(%ebp)
+  801a80:	50                   	push   %eax
+  801a81:	8b 45 08             	mov    0x8(%ebp),%eax
+  801a84:	ff d0                	call   *%eax
+  801a86:	83 c4 10             	add    $0x10,%esp
+                for (width -= strnlen(p, precision); width > 0; width --) {
+  801a89:	83 6d e8 01          	subl   $0x1,-0x18(%ebp)
+  801a8d:	83 7d e8 00          	cmpl   $0x0,-0x18(%ebp)
+  801a91:	7f e0                	jg     801a73 <vprintfmt+0x1cf>
+                }
+            }
+            for (; (ch = *p ++) != '\0' && (precision < 0 || -- precision >= 0); width --) {
+  801a93:	eb 3b                	jmp    801ad0 <vprintfmt+0x22c>
+                if (altflag && (ch < ' ' || ch > '~')) {
+  801a95:	83 7d dc 00          	cmpl   $0x0,-0x24(%ebp)
+  801a99:	74 1f                	je     801aba <vprintfmt+0x216>
+  801a9b:	83 fb 1f             	cmp    $0x1f,%ebx
+  801a9e:	7e 05                	jle    801aa5 <vprintfmt+0x201>
+  801aa0:	83 fb 7e             	cmp    $0x7e,%ebx
+  801aa3:	7e 15                	jle    801aba <vprintfmt+0x216>
+                    putch('?', putdat, fd);
+  801aa5:	83 ec 04             	sub    $0x4,%esp
+  801aa8:	ff 75 0c             	push   0xc(%ebp)
+  801aab:	ff 75 10             	push   0x10(%ebp)
+  801aae:	6a 3f                	push   $0x3f
+  801ab0:	8b 45 08             	mov    0x8(%ebp),%eax
+  801ab3:	ff d0                	call   *%eax
+  801ab5:	83 c4 10             	add    $0x10,%esp
+  801ab8:	eb 12                	jmp    801acc <vprintfmt+0x228>
+                }
+                else {
+                    putch(ch, putdat, fd);
+  801aba:	83 ec 04             	sub    $0x4,%esp
+  801abd:	ff 75 0c             	push   0xc(%ebp)
+  801ac0:	ff 75 10             	push   0x10(%ebp)
+  801ac3:	53                   	push   %ebx
+  801ac4:	8b 45 08             	mov    0x8(%ebp),%eax
+  801ac7:	ff d0                	call   *%eax
+  801ac9:	83 c4 10             	add    $0x10,%esp
+            for (; (ch = *p ++) != '\0' && (precision < 0 || -- precision >= 0); width --) {
+  801acc:	83 6d e8 01          	subl   $0x1,-0x18(%ebp)
+  801ad0:	89 f0                	mov    %esi,%eax
+  801ad2:	8d 70 01             	lea    0x1(%eax),%esi
+  801ad5:	0f b6 00             	movzbl (%eax),%eax
+  801ad8:	0f be d8             	movsbl %al,%ebx
+  801adb:	85 db                	test   %ebx,%ebx
+  801add:	74 29                	je     801b08 <vprintfmt+0x264>
+  801adf:	83 7d e4 00          	cmpl   $0x0,-0x1c(%ebp)
+  801ae3:	78 b0                	js     801a95 <vprintfmt+0x1f1>
+  801ae5:	83 6d e4 01          	subl   $0x1,-0x1c(%ebp)
+  801ae9:	83 7d e4 00          	cmpl   $0x0,-0x1c(%ebp)
+  801aed:	79 a6                	jns    801a95 <vprintfmt+0x1f1>
+                }
+            }
+            for (; width > 0; width --) {
+  801aef:	eb 17                	jmp    801b08 <vprintfmt+0x264>
+                putch(' ', putdat, fd);
+  801af1:	83 ec 04             	sub    $0x4,%esp
+  801af4:	ff 75 0c             	push   0xc(%ebp)
+  801af7:	ff 75 10             	push   0x10(%ebp)
+  801afa:	6a 20                	push   $0x20
+  801afc:	8b 45 08             	mov    0x8(%ebp),%eax
+  801aff:	ff d0                	call   *%eax
+  801b01:	83 c4 10             	add    $0x10,%esp
+            for (; width > 0; width --) {
+  801b04:	83 6d e8 01          	subl   $0x1,-0x18(%ebp)
+  801b08:	83 7d e8 00          	cmpl   $0x0,-0x18(%ebp)
+  801b0c:	7f e3                	jg     801af1 <vprintfmt+0x24d>
+            }
+            break;
+  801b0e:	e9 60 01 00 00       	jmp    801c73 <vprintfmt+0x3cf>
+
+        // (signed) decimal
+        case 'd':
+            num = getint(&ap, lflag);
+  801b13:	83 ec 08             	sub    $0x8,%esp
+  801b16:	ff 75 e0             	push   -0x20(%ebp)
+  801b19:	8d 45 18             	lea    0x18(%ebp),%eax
+  801b1c:	50                   	push   %eax
+  801b1d:	e8 11 fd ff ff       	call   801833 <getint>
+  801b22:	83 c4 10             	add    $0x10,%esp
+  801b25:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  801b28:	89 55 f4             	mov    %edx,-0xc(%ebp)
+            if ((long long)num < 0) {
+  801b2b:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  801b2e:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  801b31:	85 d2                	test   %edx,%edx
+  801b33:	79 26                	jns    801b5b <vprintfmt+0x2b7>
+                putch('-', putdat, fd);
+  801b35:	83 ec 04             	sub    $0x4,%esp
+  801b38:	ff 75 0c             	push   0xc(%ebp)
+  801b3b:	ff 75 10             	push   0x10(%ebp)
+  801b3e:	6a 2d                	push   $0x2d
+  801b40:	8b 45 08             	mov    0x8(%ebp),%eax
+  801b43:	ff d0                	call   *%eax
+  801b45:	83 c4 10             	add    $0x10,%esp
+                num = -(long long)num;
+  801b48:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  801b4b:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  801b4e:	f7 d8                	neg    %eax
+  801b50:	83 d2 00             	adc    $0x0,%edx
+  801b53:	f7 da                	neg    %edx
+  801b55:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  801b58:	89 55 f4             	mov    %edx,-0xc(%ebp)
+            }
+            base = 10;
+  801b5b:	c7 45 ec 0a 00 00 00 	movl   $0xa,-0x14(%ebp)
+            goto number;
+  801b62:	e9 a8 00 00 00       	jmp    801c0f <vprintfmt+0x36b>
+
+        // unsigned decimal
+        case 'u':
+            num = getuint(&ap, lflag);
+  801b67:	83 ec 08             	sub    $0x8,%esp
+  801b6a:	ff 75 e0             	push   -0x20(%ebp)
+  801b6d:	8d 45 18             	lea    0x18(%ebp),%eax
+  801b70:	50                   	push   %eax
+  801b71:	e8 6e fc ff ff       	call   8017e4 <getuint>
+  801b76:	83 c4 10             	add    $0x10,%esp
+  801b79:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  801b7c:	89 55 f4             	mov    %edx,-0xc(%ebp)
+            base = 10;
+  801b7f:	c7 45 ec 0a 00 00 00 	movl   $0xa,-0x14(%ebp)
+            goto number;
+  801b86:	e9 84 00 00 00       	jmp    801c0f <vprintfmt+0x36b>
+
+        // (unsigned) octal
+        case 'o':
+            num = getuint(&ap, lflag);
+  801b8b:	83 ec 08             	sub    $0x8,%esp
+  801b8e:	ff 75 e0             	push   -0x20(%ebp)
+  801b91:	8d 45 18             	lea    0x18(%ebp),%eax
+  801b94:	50                   	push   %eax
+  801b95:	e8 4a fc ff ff       	call   8017e4 <getuint>
+  801b9a:	83 c4 10             	add    $0x10,%esp
+  801b9d:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  801ba0:	89 55 f4             	mov    %edx,-0xc(%ebp)
+            base = 8;
+  801ba3:	c7 45 ec 08 00 00 00 	movl   $0x8,-0x14(%ebp)
+            goto number;
+  801baa:	eb 63                	jmp    801c0f <vprintfmt+0x36b>
+
+        // pointer
+        case 'p':
+            putch('0', putdat, fd);
+  801bac:	83 ec 04             	sub    $0x4,%esp
+  801baf:	ff 75 0c             	push   0xc(%ebp)
+  801bb2:	ff 75 10             	push   0x10(%ebp)
+  801bb5:	6a 30                	push   $0x30
+  801bb7:	8b 45 08             	mov    0x8(%ebp),%eax
+  801bba:	ff d0                	call   *%eax
+  801bbc:	83 c4 10             	add    $0x10,%esp
+            putch('x', putdat, fd);
+  801bbf:	83 ec 04             	sub    $0x4,%esp
+  801bc2:	ff 75 0c             	push   0xc(%ebp)
+  801bc5:	ff 75 10             	push   0x10(%ebp)
+  801bc8:	6a 78                	push   $0x78
+  801bca:	8b 45 08             	mov    0x8(%ebp),%eax
+  801bcd:	ff d0                	call   *%eax
+  801bcf:	83 c4 10             	add    $0x10,%esp
+            num = (unsigned long long)(uintptr_t)va_arg(ap, void *);
+  801bd2:	8b 45 18             	mov    0x18(%ebp),%eax
+  801bd5:	8d 50 04             	lea    0x4(%eax),%edx
+  801bd8:	89 55 18             	mov    %edx,0x18(%ebp)
+  801bdb:	8b 00                	mov    (%eax),%eax
+  801bdd:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  801be0:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+            base = 16;
+  801be7:	c7 45 ec 10 00 00 00 	movl   $0x10,-0x14(%ebp)
+            goto number;
+  801bee:	eb 1f                	jmp    801c0f <vprintfmt+0x36b>
+
+        // (unsigned) hexadecimal
+        case 'x':
+            num = getuint(&ap, lflag);
+  801bf0:	83 ec 08             	sub    $0x8,%esp
+  801bf3:	ff 75 e0             	push   -0x20(%ebp)
+  801bf6:	8d 45 18             	lea    0x18(%ebp),%eax
+  801bf9:	50                   	push   %eax
+  801bfa:	e8 e5 fb ff ff       	call   8017e4 <getuint>
+  801bff:	83 c4 10             	add    $0x10,%esp
+  801c02:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  801c05:	89 55 f4             	mov    %edx,-0xc(%ebp)
+            base = 16;
+  801c08:	c7 45 ec 10 00 00 00 	movl   $0x10,-0x14(%ebp)
+        number:
+            printnum(putch, fd, putdat, num, base, width, padc);
+  801c0f:	0f be 55 db          	movsbl -0x25(%ebp),%edx
+  801c13:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  801c16:	52                   	push   %edx
+  801c17:	ff 75 e8             	push   -0x18(%ebp)
+  801c1a:	50                   	push   %eax
+  801c1b:	ff 75 f4             	push   -0xc(%ebp)
+  801c1e:	ff 75 f0             	push   -0x10(%ebp)
+  801c21:	ff 75 10             	push   0x10(%ebp)
+  801c24:	ff 75 0c             	push   0xc(%ebp)
+  801c27:	ff 75 08             	push   0x8(%ebp)
+  801c2a:	e8 c3 fa ff ff       	call   8016f2 <printnum>
+  801c2f:	83 c4 20             	add    $0x20,%esp
+            break;
+  801c32:	eb 3f                	jmp    801c73 <vprintfmt+0x3cf>
+
+        // escaped '%' character
+        case '%':
+            putch(ch, putdat, fd);
+  801c34:	83 ec 04             	sub    $0x4,%esp
+  801c37:	ff 75 0c             	push   0xc(%ebp)
+  801c3a:	ff 75 10             	push   0x10(%ebp)
+  801c3d:	53                   	push   %ebx
+  801c3e:	8b 45 08             	mov    0x8(%ebp),%eax
+  801c41:	ff d0                	call   *%eax
+  801c43:	83 c4 10             	add    $0x10,%esp
+            break;
+  801c46:	eb 2b                	jmp    801c73 <vprintfmt+0x3cf>
+
+        // unrecognized escape sequence - just print it literally
+        default:
+            putch('%', putdat, fd);
+  801c48:	83 ec 04             	sub    $0x4,%esp
+  801c4b:	ff 75 0c             	push   0xc(%ebp)
+  801c4e:	ff 75 10             	push   0x10(%ebp)
+  801c51:	6a 25                	push   $0x25
+  801c53:	8b 45 08             	mov    0x8(%ebp),%eax
+  801c56:	ff d0                	call   *%eax
+  801c58:	83 c4 10             	add    $0x10,%esp
+            for (fmt --; fmt[-1] != '%'; fmt --)
+  801c5b:	83 6d 14 01          	subl   $0x1,0x14(%ebp)
+  801c5f:	eb 04                	jmp    801c65 <vprintfmt+0x3c1>
+  801c61:	83 6d 14 01          	subl   $0x1,0x14(%ebp)
+  801c65:	8b 45 14             	mov    0x14(%ebp),%eax
+  801c68:	83 e8 01             	sub    $0x1,%eax
+  801c6b:	0f b6 00             	movzbl (%eax),%eax
+  801c6e:	3c 25                	cmp    $0x25,%al
+  801c70:	75 ef                	jne    801c61 <vprintfmt+0x3bd>
+                /* do nothing */;
+            break;
+  801c72:	90                   	nop
+    while (1) {
+  801c73:	e9 34 fc ff ff       	jmp    8018ac <vprintfmt+0x8>
+                return;
+  801c78:	90                   	nop
+        }
+    }
+}
+  801c79:	8d 65 f8             	lea    -0x8(%ebp),%esp
+  801c7c:	5b                   	pop    %ebx
+  801c7d:	5e                   	pop    %esi
+  801c7e:	5d                   	pop    %ebp
+  801c7f:	c3                   	ret
+
+00801c80 <sprintputch>:
+ * sprintputch - 'print' a single character in a buffer
+ * @ch:         the character will be printed
+ * @b:          the buffer to place the character @ch
+ * */
+static void
+sprintputch(int ch, struct sprintbuf *b) {
+  801c80:	55                   	push   %ebp
+  801c81:	89 e5                	mov    %esp,%ebp
+    b->cnt ++;
+  801c83:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801c86:	8b 40 08             	mov    0x8(%eax),%eax
+  801c89:	8d 50 01             	lea    0x1(%eax),%edx
+  801c8c:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801c8f:	89 50 08             	mov    %edx,0x8(%eax)
+    if (b->buf < b->ebuf) {
+  801c92:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801c95:	8b 10                	mov    (%eax),%edx
+  801c97:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801c9a:	8b 40 04             	mov    0x4(%eax),%eax
+  801c9d:	39 c2                	cmp    %eax,%edx
+  801c9f:	73 12                	jae    801cb3 <sprintputch+0x33>
+        *b->buf ++ = ch;
+  801ca1:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801ca4:	8b 00                	mov    (%eax),%eax
+  801ca6:	8d 48 01             	lea    0x1(%eax),%ecx
+  801ca9:	8b 55 0c             	mov    0xc(%ebp),%edx
+  801cac:	89 0a                	mov    %ecx,(%edx)
+  801cae:	8b 55 08             	mov    0x8(%ebp),%edx
+  801cb1:	88 10                	mov    %dl,(%eax)
+    }
+}
+  801cb3:	90                   	nop
+  801cb4:	5d                   	pop    %ebp
+  801cb5:	c3                   	ret
+
+00801cb6 <snprintf>:
+ * @str:        the buffer to place the result into
+ * @size:       the size of buffer, including the trailing null space
+ * @fmt:        the format string to use
+ * */
+int
+snprintf(char *str, size_t size, const char *fmt, ...) {
+  801cb6:	55                   	push   %ebp
+  801cb7:	89 e5                	mov    %esp,%ebp
+  801cb9:	83 ec 18             	sub    $0x18,%esp
+    va_list ap;
+    int cnt;
+    va_start(ap, fmt);
+  801cbc:	8d 45 14             	lea    0x14(%ebp),%eax
+  801cbf:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    cnt = vsnprintf(str, size, fmt, ap);
+  801cc2:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  801cc5:	50                   	push   %eax
+  801cc6:	ff 75 10             	push   0x10(%ebp)
+  801cc9:	ff 75 0c             	push   0xc(%ebp)
+  801ccc:	ff 75 08             	push   0x8(%ebp)
+  801ccf:	e8 0b 00 00 00       	call   801cdf <vsnprintf>
+  801cd4:	83 c4 10             	add    $0x10,%esp
+  801cd7:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    va_end(ap);
+    return cnt;
+  801cda:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  801cdd:	c9                   	leave
+  801cde:	c3                   	ret
+
+00801cdf <vsnprintf>:
+ *
+ * Call this function if you are already dealing with a va_list.
+ * Or you probably want snprintf() instead.
+ * */
+int
+vsnprintf(char *str, size_t size, const char *fmt, va_list ap) {
+  801cdf:	55                   	push   %ebp
+  801ce0:	89 e5                	mov    %esp,%ebp
+  801ce2:	83 ec 18             	sub    $0x18,%esp
+    struct sprintbuf b = {str, str + size - 1, 0};
+  801ce5:	8b 45 08             	mov    0x8(%ebp),%eax
+  801ce8:	89 45 ec             	mov    %eax,-0x14(%ebp)
+  801ceb:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801cee:	8d 50 ff             	lea    -0x1(%eax),%edx
+  801cf1:	8b 45 08             	mov    0x8(%ebp),%eax
+  801cf4:	01 d0                	add    %edx,%eax
+  801cf6:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  801cf9:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+    if (str == NULL || b.buf > b.ebuf) {
+  801d00:	83 7d 08 00          	cmpl   $0x0,0x8(%ebp)
+  801d04:	74 0a                	je     801d10 <vsnprintf+0x31>
+  801d06:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  801d09:	8b 55 f0             	mov    -0x10(%ebp),%edx
+  801d0c:	39 c2                	cmp    %eax,%edx
+  801d0e:	73 07                	jae    801d17 <vsnprintf+0x38>
+        return -E_INVAL;
+  801d10:	b8 fd ff ff ff       	mov    $0xfffffffd,%eax
+  801d15:	eb 28                	jmp    801d3f <vsnprintf+0x60>
+    }
+    // print the string to the buffer
+    vprintfmt((void*)sprintputch, NO_FD, &b, fmt, ap);
+  801d17:	83 ec 0c             	sub    $0xc,%esp
+  801d1a:	ff 75 14             	push   0x14(%ebp)
+  801d1d:	ff 75 10             	push   0x10(%ebp)
+  801d20:	8d 45 ec             	lea    -0x14(%ebp),%eax
+  801d23:	50                   	push   %eax
+  801d24:	68 d9 6a ff ff       	push   $0xffff6ad9
+  801d29:	68 80 1c 80 00       	push   $0x801c80
+  801d2e:	e8 71 fb ff ff       	call   8018a4 <vprintfmt>
+  801d33:	83 c4 20             	add    $0x20,%esp
+    // null terminate the buffer
+    *b.buf = '\0';
+  801d36:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  801d39:	c6 00 00             	movb   $0x0,(%eax)
+    return b.cnt;
+  801d3c:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  801d3f:	c9                   	leave
+  801d40:	c3                   	ret
+
+00801d41 <rand>:
+ * rand - returns a pseudo-random integer
+ *
+ * The rand() function return a value in the range [0, RAND_MAX].
+ * */
+int
+rand(void) {
+  801d41:	55                   	push   %ebp
+  801d42:	89 e5                	mov    %esp,%ebp
+  801d44:	57                   	push   %edi
+  801d45:	56                   	push   %esi
+  801d46:	53                   	push   %ebx
+  801d47:	83 ec 24             	sub    $0x24,%esp
+    next = (next * 0x5DEECE66DLL + 0xBLL) & ((1LL << 48) - 1);
+  801d4a:	a1 10 40 80 00       	mov    0x804010,%eax
+  801d4f:	8b 15 14 40 80 00    	mov    0x804014,%edx
+  801d55:	69 fa 6d e6 ec de    	imul   $0xdeece66d,%edx,%edi
+  801d5b:	6b f0 05             	imul   $0x5,%eax,%esi
+  801d5e:	01 fe                	add    %edi,%esi
+  801d60:	bf 6d e6 ec de       	mov    $0xdeece66d,%edi
+  801d65:	f7 e7                	mul    %edi
+  801d67:	01 d6                	add    %edx,%esi
+  801d69:	89 f2                	mov    %esi,%edx
+  801d6b:	83 c0 0b             	add    $0xb,%eax
+  801d6e:	83 d2 00             	adc    $0x0,%edx
+  801d71:	89 c1                	mov    %eax,%ecx
+  801d73:	0f b7 da             	movzwl %dx,%ebx
+  801d76:	89 0d 10 40 80 00    	mov    %ecx,0x804010
+  801d7c:	89 1d 14 40 80 00    	mov    %ebx,0x804014
+    unsigned long long result = (next >> 12);
+  801d82:	a1 10 40 80 00       	mov    0x804010,%eax
+  801d87:	8b 15 14 40 80 00    	mov    0x804014,%edx
+  801d8d:	0f ac d0 0c          	shrd   $0xc,%edx,%eax
+  801d91:	c1 ea 0c             	shr    $0xc,%edx
+  801d94:	89 45 e0             	mov    %eax,-0x20(%ebp)
+  801d97:	89 55 e4             	mov    %edx,-0x1c(%ebp)
+    return (int)do_div(result, RAND_MAX + 1);
+  801d9a:	c7 45 dc 00 00 00 80 	movl   $0x80000000,-0x24(%ebp)
+  801da1:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  801da4:	8b 55 e4             	mov    -0x1c(%ebp),%edx
+  801da7:	89 45 d8             	mov    %eax,-0x28(%ebp)
+  801daa:	89 55 e8             	mov    %edx,-0x18(%ebp)
+  801dad:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  801db0:	89 45 ec             	mov    %eax,-0x14(%ebp)
+  801db3:	83 7d e8 00          	cmpl   $0x0,-0x18(%ebp)
+  801db7:	74 1c                	je     801dd5 <rand+0x94>
+  801db9:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  801dbc:	ba 00 00 00 00       	mov    $0x0,%edx
+  801dc1:	f7 75 dc             	divl   -0x24(%ebp)
+  801dc4:	89 55 ec             	mov    %edx,-0x14(%ebp)
+  801dc7:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  801dca:	ba 00 00 00 00       	mov    $0x0,%edx
+  801dcf:	f7 75 dc             	divl   -0x24(%ebp)
+  801dd2:	89 45 e8             	mov    %eax,-0x18(%ebp)
+  801dd5:	8b 45 d8             	mov    -0x28(%ebp),%eax
+  801dd8:	8b 55 ec             	mov    -0x14(%ebp),%edx
+  801ddb:	f7 75 dc             	divl   -0x24(%ebp)
+  801dde:	89 45 d8             	mov    %eax,-0x28(%ebp)
+  801de1:	89 55 d4             	mov    %edx,-0x2c(%ebp)
+  801de4:	8b 45 d8             	mov    -0x28(%ebp),%eax
+  801de7:	8b 55 e8             	mov    -0x18(%ebp),%edx
+  801dea:	89 45 e0             	mov    %eax,-0x20(%ebp)
+  801ded:	89 55 e4             	mov    %edx,-0x1c(%ebp)
+  801df0:	8b 45 d4             	mov    -0x2c(%ebp),%eax
+}
+  801df3:	83 c4 24             	add    $0x24,%esp
+  801df6:	5b                   	pop    %ebx
+  801df7:	5e                   	pop    %esi
+  801df8:	5f                   	pop    %edi
+  801df9:	5d                   	pop    %ebp
+  801dfa:	c3                   	ret
+
+00801dfb <srand>:
+/* *
+ * srand - seed the random number generator with the given number
+ * @seed:   the required seed number
+ * */
+void
+srand(unsigned int seed) {
+  801dfb:	55                   	push   %ebp
+  801dfc:	89 e5                	mov    %esp,%ebp
+    next = seed;
+  801dfe:	8b 45 08             	mov    0x8(%ebp),%eax
+  801e01:	ba 00 00 00 00       	mov    $0x0,%edx
+  801e06:	a3 10 40 80 00       	mov    %eax,0x804010
+  801e0b:	89 15 14 40 80 00    	mov    %edx,0x804014
+}
+  801e11:	90                   	nop
+  801e12:	5d                   	pop    %ebp
+  801e13:	c3                   	ret
+
+00801e14 <rb_set_parent>:
+	{                            \
+		(r)->rb_parent_color |= 1; \
+	} while (0)
+
+static inline void rb_set_parent(struct rb_node *rb, struct rb_node *p)
+{
+  801e14:	55                   	push   %ebp
+  801e15:	89 e5                	mov    %esp,%ebp
+	rb->rb_parent_color = (rb->rb_parent_color & 3) | (unsigned long)p;
+  801e17:	8b 45 08             	mov    0x8(%ebp),%eax
+  801e1a:	8b 00                	mov    (%eax),%eax
+  801e1c:	83 e0 03             	and    $0x3,%eax
+  801e1f:	89 c2                	mov    %eax,%edx
+  801e21:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801e24:	09 c2                	or     %eax,%edx
+  801e26:	8b 45 08             	mov    0x8(%ebp),%eax
+  801e29:	89 10                	mov    %edx,(%eax)
+}
+  801e2b:	90                   	nop
+  801e2c:	5d                   	pop    %ebp
+  801e2d:	c3                   	ret
+
+00801e2e <rb_set_color>:
+static inline void rb_set_color(struct rb_node *rb, int color)
+{
+  801e2e:	55                   	push   %ebp
+  801e2f:	89 e5                	mov    %esp,%ebp
+	rb->rb_parent_color = (rb->rb_parent_color & ~1) | color;
+  801e31:	8b 45 08             	mov    0x8(%ebp),%eax
+  801e34:	8b 00                	mov    (%eax),%eax
+  801e36:	83 e0 fe             	and    $0xfffffffe,%eax
+  801e39:	89 c2                	mov    %eax,%edx
+  801e3b:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801e3e:	09 c2                	or     %eax,%edx
+  801e40:	8b 45 08             	mov    0x8(%ebp),%eax
+  801e43:	89 10                	mov    %edx,(%eax)
+}
+  801e45:	90                   	nop
+  801e46:	5d                   	pop    %ebp
+  801e47:	c3                   	ret
+
+00801e48 <__rb_rotate_left>:
+*/
+
+#include "rbtree.h"
+
+static void __rb_rotate_left(struct rb_node *node, struct rb_root *root)
+{
+  801e48:	55                   	push   %ebp
+  801e49:	89 e5                	mov    %esp,%ebp
+  801e4b:	83 ec 10             	sub    $0x10,%esp
+	struct rb_node *right = node->rb_right;
+  801e4e:	8b 45 08             	mov    0x8(%ebp),%eax
+  801e51:	8b 40 04             	mov    0x4(%eax),%eax
+  801e54:	89 45 fc             	mov    %eax,-0x4(%ebp)
+	struct rb_node *parent = rb_parent(node);
+  801e57:	8b 45 08             	mov    0x8(%ebp),%eax
+  801e5a:	8b 00                	mov    (%eax),%eax
+  801e5c:	83 e0 fc             	and    $0xfffffffc,%eax
+  801e5f:	89 45 f8             	mov    %eax,-0x8(%ebp)
+
+	if ((node->rb_right = right->rb_left))
+  801e62:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  801e65:	8b 50 08             	mov    0x8(%eax),%edx
+  801e68:	8b 45 08             	mov    0x8(%ebp),%eax
+  801e6b:	89 50 04             	mov    %edx,0x4(%eax)
+  801e6e:	8b 45 08             	mov    0x8(%ebp),%eax
+  801e71:	8b 40 04             	mov    0x4(%eax),%eax
+  801e74:	85 c0                	test   %eax,%eax
+  801e76:	74 12                	je     801e8a <__rb_rotate_left+0x42>
+		rb_set_parent(right->rb_left, node);
+  801e78:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  801e7b:	8b 40 08             	mov    0x8(%eax),%eax
+  801e7e:	ff 75 08             	push   0x8(%ebp)
+  801e81:	50                   	push   %eax
+  801e82:	e8 8d ff ff ff       	call   801e14 <rb_set_parent>
+  801e87:	83 c4 08             	add    $0x8,%esp
+	right->rb_left = node;
+  801e8a:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  801e8d:	8b 55 08             	mov    0x8(%ebp),%edx
+  801e90:	89 50 08             	mov    %edx,0x8(%eax)
+
+	rb_set_parent(right, parent);
+  801e93:	ff 75 f8             	push   -0x8(%ebp)
+  801e96:	ff 75 fc             	push   -0x4(%ebp)
+  801e99:	e8 76 ff ff ff       	call   801e14 <rb_set_parent>
+  801e9e:	83 c4 08             	add    $0x8,%esp
+
+	if (parent)
+  801ea1:	83 7d f8 00          	cmpl   $0x0,-0x8(%ebp)
+  801ea5:	74 21                	je     801ec8 <__rb_rotate_left+0x80>
+	{
+		if (node == parent->rb_left)
+  801ea7:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  801eaa:	8b 40 08             	mov    0x8(%eax),%eax
+  801ead:	39 45 08             	cmp    %eax,0x8(%ebp)
+  801eb0:	75 0b                	jne    801ebd <__rb_rotate_left+0x75>
+			parent->rb_left = right;
+  801eb2:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  801eb5:	8b 55 fc             	mov    -0x4(%ebp),%edx
+  801eb8:	89 50 08             	mov    %edx,0x8(%eax)
+  801ebb:	eb 13                	jmp    801ed0 <__rb_rotate_left+0x88>
+		else
+			parent->rb_right = right;
+  801ebd:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  801ec0:	8b 55 fc             	mov    -0x4(%ebp),%edx
+  801ec3:	89 50 04             	mov    %edx,0x4(%eax)
+  801ec6:	eb 08                	jmp    801ed0 <__rb_rotate_left+0x88>
+	}
+	else
+		root->rb_node = right;
+  801ec8:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801ecb:	8b 55 fc             	mov    -0x4(%ebp),%edx
+  801ece:	89 10                	mov    %edx,(%eax)
+	rb_set_parent(node, right);
+  801ed0:	ff 75 fc             	push   -0x4(%ebp)
+  801ed3:	ff 75 08             	push   0x8(%ebp)
+  801ed6:	e8 39 ff ff ff       	call   801e14 <rb_set_parent>
+  801edb:	83 c4 08             	add    $0x8,%esp
+}
+  801ede:	90                   	nop
+  801edf:	c9                   	leave
+  801ee0:	c3                   	ret
+
+00801ee1 <__rb_rotate_right>:
+
+static void __rb_rotate_right(struct rb_node *node, struct rb_root *root)
+{
+  801ee1:	55                   	push   %ebp
+  801ee2:	89 e5                	mov    %esp,%ebp
+  801ee4:	83 ec 10             	sub    $0x10,%esp
+	struct rb_node *left = node->rb_left;
+  801ee7:	8b 45 08             	mov    0x8(%ebp),%eax
+  801eea:	8b 40 08             	mov    0x8(%eax),%eax
+  801eed:	89 45 fc             	mov    %eax,-0x4(%ebp)
+	struct rb_node *parent = rb_parent(node);
+  801ef0:	8b 45 08             	mov    0x8(%ebp),%eax
+  801ef3:	8b 00                	mov    (%eax),%eax
+  801ef5:	83 e0 fc             	and    $0xfffffffc,%eax
+  801ef8:	89 45 f8             	mov    %eax,-0x8(%ebp)
+
+	if ((node->rb_left = left->rb_right))
+  801efb:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  801efe:	8b 50 04             	mov    0x4(%eax),%edx
+  801f01:	8b 45 08             	mov    0x8(%ebp),%eax
+  801f04:	89 50 08             	mov    %edx,0x8(%eax)
+  801f07:	8b 45 08             	mov    0x8(%ebp),%eax
+  801f0a:	8b 40 08             	mov    0x8(%eax),%eax
+  801f0d:	85 c0                	test   %eax,%eax
+  801f0f:	74 12                	je     801f23 <__rb_rotate_right+0x42>
+		rb_set_parent(left->rb_right, node);
+  801f11:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  801f14:	8b 40 04             	mov    0x4(%eax),%eax
+  801f17:	ff 75 08             	push   0x8(%ebp)
+  801f1a:	50                   	push   %eax
+  801f1b:	e8 f4 fe ff ff       	call   801e14 <rb_set_parent>
+  801f20:	83 c4 08             	add    $0x8,%esp
+	left->rb_right = node;
+  801f23:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  801f26:	8b 55 08             	mov    0x8(%ebp),%edx
+  801f29:	89 50 04             	mov    %edx,0x4(%eax)
+
+	rb_set_parent(left, parent);
+  801f2c:	ff 75 f8             	push   -0x8(%ebp)
+  801f2f:	ff 75 fc             	push   -0x4(%ebp)
+  801f32:	e8 dd fe ff ff       	call   801e14 <rb_set_parent>
+  801f37:	83 c4 08             	add    $0x8,%esp
+
+	if (parent)
+  801f3a:	83 7d f8 00          	cmpl   $0x0,-0x8(%ebp)
+  801f3e:	74 21                	je     801f61 <__rb_rotate_right+0x80>
+	{
+		if (node == parent->rb_right)
+  801f40:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  801f43:	8b 40 04             	mov    0x4(%eax),%eax
+  801f46:	39 45 08             	cmp    %eax,0x8(%ebp)
+  801f49:	75 0b                	jne    801f56 <__rb_rotate_right+0x75>
+			parent->rb_right = left;
+  801f4b:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  801f4e:	8b 55 fc             	mov    -0x4(%ebp),%edx
+  801f51:	89 50 04             	mov    %edx,0x4(%eax)
+  801f54:	eb 13                	jmp    801f69 <__rb_rotate_right+0x88>
+		else
+			parent->rb_left = left;
+  801f56:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  801f59:	8b 55 fc             	mov    -0x4(%ebp),%edx
+  801f5c:	89 50 08             	mov    %edx,0x8(%eax)
+  801f5f:	eb 08                	jmp    801f69 <__rb_rotate_right+0x88>
+	}
+	else
+		root->rb_node = left;
+  801f61:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801f64:	8b 55 fc             	mov    -0x4(%ebp),%edx
+  801f67:	89 10                	mov    %edx,(%eax)
+	rb_set_parent(node, left);
+  801f69:	ff 75 fc             	push   -0x4(%ebp)
+  801f6c:	ff 75 08             	push   0x8(%ebp)
+  801f6f:	e8 a0 fe ff ff       	call   801e14 <rb_set_parent>
+  801f74:	83 c4 08             	add    $0x8,%esp
+}
+  801f77:	90                   	nop
+  801f78:	c9                   	leave
+  801f79:	c3                   	ret
+
+00801f7a <rb_insert_color>:
+
+void rb_insert_color(struct rb_node *node, struct rb_root *root)
+{
+  801f7a:	55                   	push   %ebp
+  801f7b:	89 e5                	mov    %esp,%ebp
+  801f7d:	53                   	push   %ebx
+  801f7e:	83 ec 10             	sub    $0x10,%esp
+	struct rb_node *parent, *gparent;
+
+	while ((parent = rb_parent(node)) && rb_is_red(parent))
+  801f81:	e9 44 01 00 00       	jmp    8020ca <rb_insert_color+0x150>
+	{
+		gparent = rb_parent(parent);
+  801f86:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  801f89:	8b 00                	mov    (%eax),%eax
+  801f8b:	83 e0 fc             	and    $0xfffffffc,%eax
+  801f8e:	89 45 f4             	mov    %eax,-0xc(%ebp)
+
+		if (parent == gparent->rb_left)
+  801f91:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  801f94:	8b 40 08             	mov    0x8(%eax),%eax
+  801f97:	39 45 f8             	cmp    %eax,-0x8(%ebp)
+  801f9a:	0f 85 99 00 00 00    	jne    802039 <rb_insert_color+0xbf>
+		{
+			{
+				register struct rb_node *uncle = gparent->rb_right;
+  801fa0:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  801fa3:	8b 58 04             	mov    0x4(%eax),%ebx
+				if (uncle && rb_is_red(uncle))
+  801fa6:	85 db                	test   %ebx,%ebx
+  801fa8:	74 39                	je     801fe3 <rb_insert_color+0x69>
+  801faa:	8b 03                	mov    (%ebx),%eax
+  801fac:	83 e0 01             	and    $0x1,%eax
+  801faf:	85 c0                	test   %eax,%eax
+  801fb1:	75 30                	jne    801fe3 <rb_insert_color+0x69>
+				{
+					rb_set_black(uncle);
+  801fb3:	8b 03                	mov    (%ebx),%eax
+  801fb5:	83 c8 01             	or     $0x1,%eax
+  801fb8:	89 03                	mov    %eax,(%ebx)
+					rb_set_black(parent);
+  801fba:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  801fbd:	8b 00                	mov    (%eax),%eax
+  801fbf:	83 c8 01             	or     $0x1,%eax
+  801fc2:	89 c2                	mov    %eax,%edx
+  801fc4:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  801fc7:	89 10                	mov    %edx,(%eax)
+					rb_set_red(gparent);
+  801fc9:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  801fcc:	8b 00                	mov    (%eax),%eax
+  801fce:	83 e0 fe             	and    $0xfffffffe,%eax
+  801fd1:	89 c2                	mov    %eax,%edx
+  801fd3:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  801fd6:	89 10                	mov    %edx,(%eax)
+					node = gparent;
+  801fd8:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  801fdb:	89 45 08             	mov    %eax,0x8(%ebp)
+					continue;
+  801fde:	e9 e7 00 00 00       	jmp    8020ca <rb_insert_color+0x150>
+				}
+			}
+
+			if (parent->rb_right == node)
+  801fe3:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  801fe6:	8b 40 04             	mov    0x4(%eax),%eax
+  801fe9:	39 45 08             	cmp    %eax,0x8(%ebp)
+  801fec:	75 1a                	jne    802008 <rb_insert_color+0x8e>
+			{
+				register struct rb_node *tmp;
+				__rb_rotate_left(parent, root);
+  801fee:	ff 75 0c             	push   0xc(%ebp)
+  801ff1:	ff 75 f8             	push   -0x8(%ebp)
+  801ff4:	e8 4f fe ff ff       	call   801e48 <__rb_rotate_left>
+  801ff9:	83 c4 08             	add    $0x8,%esp
+				tmp = parent;
+  801ffc:	8b 5d f8             	mov    -0x8(%ebp),%ebx
+				parent = node;
+  801fff:	8b 45 08             	mov    0x8(%ebp),%eax
+  802002:	89 45 f8             	mov    %eax,-0x8(%ebp)
+				node = tmp;
+  802005:	89 5d 08             	mov    %ebx,0x8(%ebp)
+			}
+
+			rb_set_black(parent);
+  802008:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  80200b:	8b 00                	mov    (%eax),%eax
+  80200d:	83 c8 01             	or     $0x1,%eax
+  802010:	89 c2                	mov    %eax,%edx
+  802012:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  802015:	89 10                	mov    %edx,(%eax)
+			rb_set_red(gparent);
+  802017:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  80201a:	8b 00                	mov    (%eax),%eax
+  80201c:	83 e0 fe             	and    $0xfffffffe,%eax
+  80201f:	89 c2                	mov    %eax,%edx
+  802021:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  802024:	89 10                	mov    %edx,(%eax)
+			__rb_rotate_right(gparent, root);
+  802026:	ff 75 0c             	push   0xc(%ebp)
+  802029:	ff 75 f4             	push   -0xc(%ebp)
+  80202c:	e8 b0 fe ff ff       	call   801ee1 <__rb_rotate_right>
+  802031:	83 c4 08             	add    $0x8,%esp
+  802034:	e9 91 00 00 00       	jmp    8020ca <rb_insert_color+0x150>
+		}
+		else
+		{
+			{
+				register struct rb_node *uncle = gparent->rb_left;
+  802039:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  80203c:	8b 58 08             	mov    0x8(%eax),%ebx
+				if (uncle && rb_is_red(uncle))
+  80203f:	85 db                	test   %ebx,%ebx
+  802041:	74 36                	je     802079 <rb_insert_color+0xff>
+  802043:	8b 03                	mov    (%ebx),%eax
+  802045:	83 e0 01             	and    $0x1,%eax
+  802048:	85 c0                	test   %eax,%eax
+  80204a:	75 2d                	jne    802079 <rb_insert_color+0xff>
+				{
+					rb_set_black(uncle);
+  80204c:	8b 03                	mov    (%ebx),%eax
+  80204e:	83 c8 01             	or     $0x1,%eax
+  802051:	89 03                	mov    %eax,(%ebx)
+					rb_set_black(parent);
+  802053:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  802056:	8b 00                	mov    (%eax),%eax
+  802058:	83 c8 01             	or     $0x1,%eax
+  80205b:	89 c2                	mov    %eax,%edx
+  80205d:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  802060:	89 10                	mov    %edx,(%eax)
+					rb_set_red(gparent);
+  802062:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  802065:	8b 00                	mov    (%eax),%eax
+  802067:	83 e0 fe             	and    $0xfffffffe,%eax
+  80206a:	89 c2                	mov    %eax,%edx
+  80206c:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  80206f:	89 10                	mov    %edx,(%eax)
+					node = gparent;
+  802071:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  802074:	89 45 08             	mov    %eax,0x8(%ebp)
+					continue;
+  802077:	eb 51                	jmp    8020ca <rb_insert_color+0x150>
+				}
+			}
+
+			if (parent->rb_left == node)
+  802079:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  80207c:	8b 40 08             	mov    0x8(%eax),%eax
+  80207f:	39 45 08             	cmp    %eax,0x8(%ebp)
+  802082:	75 1a                	jne    80209e <rb_insert_color+0x124>
+			{
+				register struct rb_node *tmp;
+				__rb_rotate_right(parent, root);
+  802084:	ff 75 0c             	push   0xc(%ebp)
+  802087:	ff 75 f8             	push   -0x8(%ebp)
+  80208a:	e8 52 fe ff ff       	call   801ee1 <__rb_rotate_right>
+  80208f:	83 c4 08             	add    $0x8,%esp
+				tmp = parent;
+  802092:	8b 5d f8             	mov    -0x8(%ebp),%ebx
+				parent = node;
+  802095:	8b 45 08             	mov    0x8(%ebp),%eax
+  802098:	89 45 f8             	mov    %eax,-0x8(%ebp)
+				node = tmp;
+  80209b:	89 5d 08             	mov    %ebx,0x8(%ebp)
+			}
+
+			rb_set_black(parent);
+  80209e:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  8020a1:	8b 00                	mov    (%eax),%eax
+  8020a3:	83 c8 01             	or     $0x1,%eax
+  8020a6:	89 c2                	mov    %eax,%edx
+  8020a8:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  8020ab:	89 10                	mov    %edx,(%eax)
+			rb_set_red(gparent);
+  8020ad:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  8020b0:	8b 00                	mov    (%eax),%eax
+  8020b2:	83 e0 fe             	and    $0xfffffffe,%eax
+  8020b5:	89 c2                	mov    %eax,%edx
+  8020b7:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  8020ba:	89 10                	mov    %edx,(%eax)
+			__rb_rotate_left(gparent, root);
+  8020bc:	ff 75 0c             	push   0xc(%ebp)
+  8020bf:	ff 75 f4             	push   -0xc(%ebp)
+  8020c2:	e8 81 fd ff ff       	call   801e48 <__rb_rotate_left>
+  8020c7:	83 c4 08             	add    $0x8,%esp
+	while ((parent = rb_parent(node)) && rb_is_red(parent))
+  8020ca:	8b 45 08             	mov    0x8(%ebp),%eax
+  8020cd:	8b 00                	mov    (%eax),%eax
+  8020cf:	83 e0 fc             	and    $0xfffffffc,%eax
+  8020d2:	89 45 f8             	mov    %eax,-0x8(%ebp)
+  8020d5:	83 7d f8 00          	cmpl   $0x0,-0x8(%ebp)
+  8020d9:	74 10                	je     8020eb <rb_insert_color+0x171>
+  8020db:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  8020de:	8b 00                	mov    (%eax),%eax
+  8020e0:	83 e0 01             	and    $0x1,%eax
+  8020e3:	85 c0                	test   %eax,%eax
+  8020e5:	0f 84 9b fe ff ff    	je     801f86 <rb_insert_color+0xc>
+		}
+	}
+
+	rb_set_black(root->rb_node);
+  8020eb:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8020ee:	8b 00                	mov    (%eax),%eax
+  8020f0:	8b 10                	mov    (%eax),%edx
+  8020f2:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8020f5:	8b 00                	mov    (%eax),%eax
+  8020f7:	83 ca 01             	or     $0x1,%edx
+  8020fa:	89 10                	mov    %edx,(%eax)
+}
+  8020fc:	90                   	nop
+  8020fd:	8b 5d fc             	mov    -0x4(%ebp),%ebx
+  802100:	c9                   	leave
+  802101:	c3                   	ret
+
+00802102 <__rb_erase_color>:
+
+static void __rb_erase_color(struct rb_node *node, struct rb_node *parent,
+														 struct rb_root *root)
+{
+  802102:	55                   	push   %ebp
+  802103:	89 e5                	mov    %esp,%ebp
+  802105:	83 ec 10             	sub    $0x10,%esp
+	struct rb_node *other;
+
+	while ((!node || rb_is_black(node)) && node != root->rb_node)
+  802108:	e9 94 02 00 00       	jmp    8023a1 <__rb_erase_color+0x29f>
+	{
+		if (parent->rb_left == node)
+  80210d:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802110:	8b 40 08             	mov    0x8(%eax),%eax
+  802113:	39 45 08             	cmp    %eax,0x8(%ebp)
+  802116:	0f 85 44 01 00 00    	jne    802260 <__rb_erase_color+0x15e>
+		{
+			other = parent->rb_right;
+  80211c:	8b 45 0c             	mov    0xc(%ebp),%eax
+  80211f:	8b 40 04             	mov    0x4(%eax),%eax
+  802122:	89 45 fc             	mov    %eax,-0x4(%ebp)
+			if (rb_is_red(other))
+  802125:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  802128:	8b 00                	mov    (%eax),%eax
+  80212a:	83 e0 01             	and    $0x1,%eax
+  80212d:	85 c0                	test   %eax,%eax
+  80212f:	75 35                	jne    802166 <__rb_erase_color+0x64>
+			{
+				rb_set_black(other);
+  802131:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  802134:	8b 00                	mov    (%eax),%eax
+  802136:	83 c8 01             	or     $0x1,%eax
+  802139:	89 c2                	mov    %eax,%edx
+  80213b:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  80213e:	89 10                	mov    %edx,(%eax)
+				rb_set_red(parent);
+  802140:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802143:	8b 00                	mov    (%eax),%eax
+  802145:	83 e0 fe             	and    $0xfffffffe,%eax
+  802148:	89 c2                	mov    %eax,%edx
+  80214a:	8b 45 0c             	mov    0xc(%ebp),%eax
+  80214d:	89 10                	mov    %edx,(%eax)
+				__rb_rotate_left(parent, root);
+  80214f:	ff 75 10             	push   0x10(%ebp)
+  802152:	ff 75 0c             	push   0xc(%ebp)
+  802155:	e8 ee fc ff ff       	call   801e48 <__rb_rotate_left>
+  80215a:	83 c4 08             	add    $0x8,%esp
+				other = parent->rb_right;
+  80215d:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802160:	8b 40 04             	mov    0x4(%eax),%eax
+  802163:	89 45 fc             	mov    %eax,-0x4(%ebp)
+			}
+			if ((!other->rb_left || rb_is_black(other->rb_left)) &&
+  802166:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  802169:	8b 40 08             	mov    0x8(%eax),%eax
+  80216c:	85 c0                	test   %eax,%eax
+  80216e:	74 0f                	je     80217f <__rb_erase_color+0x7d>
+  802170:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  802173:	8b 40 08             	mov    0x8(%eax),%eax
+  802176:	8b 00                	mov    (%eax),%eax
+  802178:	83 e0 01             	and    $0x1,%eax
+  80217b:	85 c0                	test   %eax,%eax
+  80217d:	74 3e                	je     8021bd <__rb_erase_color+0xbb>
+					(!other->rb_right || rb_is_black(other->rb_right)))
+  80217f:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  802182:	8b 40 04             	mov    0x4(%eax),%eax
+			if ((!other->rb_left || rb_is_black(other->rb_left)) &&
+  802185:	85 c0                	test   %eax,%eax
+  802187:	74 0f                	je     802198 <__rb_erase_color+0x96>
+					(!other->rb_right || rb_is_black(other->rb_right)))
+  802189:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  80218c:	8b 40 04             	mov    0x4(%eax),%eax
+  80218f:	8b 00                	mov    (%eax),%eax
+  802191:	83 e0 01             	and    $0x1,%eax
+  802194:	85 c0                	test   %eax,%eax
+  802196:	74 25                	je     8021bd <__rb_erase_color+0xbb>
+			{
+				rb_set_red(other);
+  802198:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  80219b:	8b 00                	mov    (%eax),%eax
+  80219d:	83 e0 fe             	and    $0xfffffffe,%eax
+  8021a0:	89 c2                	mov    %eax,%edx
+  8021a2:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8021a5:	89 10                	mov    %edx,(%eax)
+				node = parent;
+  8021a7:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8021aa:	89 45 08             	mov    %eax,0x8(%ebp)
+				parent = rb_parent(node);
+  8021ad:	8b 45 08             	mov    0x8(%ebp),%eax
+  8021b0:	8b 00                	mov    (%eax),%eax
+  8021b2:	83 e0 fc             	and    $0xfffffffc,%eax
+  8021b5:	89 45 0c             	mov    %eax,0xc(%ebp)
+  8021b8:	e9 e4 01 00 00       	jmp    8023a1 <__rb_erase_color+0x29f>
+			}
+			else
+			{
+				if (!other->rb_right || rb_is_black(other->rb_right))
+  8021bd:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8021c0:	8b 40 04             	mov    0x4(%eax),%eax
+  8021c3:	85 c0                	test   %eax,%eax
+  8021c5:	74 0f                	je     8021d6 <__rb_erase_color+0xd4>
+  8021c7:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8021ca:	8b 40 04             	mov    0x4(%eax),%eax
+  8021cd:	8b 00                	mov    (%eax),%eax
+  8021cf:	83 e0 01             	and    $0x1,%eax
+  8021d2:	85 c0                	test   %eax,%eax
+  8021d4:	74 39                	je     80220f <__rb_erase_color+0x10d>
+				{
+					rb_set_black(other->rb_left);
+  8021d6:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8021d9:	8b 40 08             	mov    0x8(%eax),%eax
+  8021dc:	8b 10                	mov    (%eax),%edx
+  8021de:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8021e1:	8b 40 08             	mov    0x8(%eax),%eax
+  8021e4:	83 ca 01             	or     $0x1,%edx
+  8021e7:	89 10                	mov    %edx,(%eax)
+					rb_set_red(other);
+  8021e9:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8021ec:	8b 00                	mov    (%eax),%eax
+  8021ee:	83 e0 fe             	and    $0xfffffffe,%eax
+  8021f1:	89 c2                	mov    %eax,%edx
+  8021f3:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8021f6:	89 10                	mov    %edx,(%eax)
+					__rb_rotate_right(other, root);
+  8021f8:	ff 75 10             	push   0x10(%ebp)
+  8021fb:	ff 75 fc             	push   -0x4(%ebp)
+  8021fe:	e8 de fc ff ff       	call   801ee1 <__rb_rotate_right>
+  802203:	83 c4 08             	add    $0x8,%esp
+					other = parent->rb_right;
+  802206:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802209:	8b 40 04             	mov    0x4(%eax),%eax
+  80220c:	89 45 fc             	mov    %eax,-0x4(%ebp)
+				}
+				rb_set_color(other, rb_color(parent));
+  80220f:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802212:	8b 00                	mov    (%eax),%eax
+  802214:	83 e0 01             	and    $0x1,%eax
+  802217:	50                   	push   %eax
+  802218:	ff 75 fc             	push   -0x4(%ebp)
+  80221b:	e8 0e fc ff ff       	call   801e2e <rb_set_color>
+  802220:	83 c4 08             	add    $0x8,%esp
+				rb_set_black(parent);
+  802223:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802226:	8b 00                	mov    (%eax),%eax
+  802228:	83 c8 01             	or     $0x1,%eax
+  80222b:	89 c2                	mov    %eax,%edx
+  80222d:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802230:	89 10                	mov    %edx,(%eax)
+				rb_set_black(other->rb_right);
+  802232:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  802235:	8b 40 04             	mov    0x4(%eax),%eax
+  802238:	8b 10                	mov    (%eax),%edx
+  80223a:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  80223d:	8b 40 04             	mov    0x4(%eax),%eax
+  802240:	83 ca 01             	or     $0x1,%edx
+  802243:	89 10                	mov    %edx,(%eax)
+				__rb_rotate_left(parent, root);
+  802245:	ff 75 10             	push   0x10(%ebp)
+  802248:	ff 75 0c             	push   0xc(%ebp)
+  80224b:	e8 f8 fb ff ff       	call   801e48 <__rb_rotate_left>
+  802250:	83 c4 08             	add    $0x8,%esp
+				node = root->rb_node;
+  802253:	8b 45 10             	mov    0x10(%ebp),%eax
+  802256:	8b 00                	mov    (%eax),%eax
+  802258:	89 45 08             	mov    %eax,0x8(%ebp)
+				break;
+  80225b:	e9 61 01 00 00       	jmp    8023c1 <__rb_erase_color+0x2bf>
+			}
+		}
+		else
+		{
+			other = parent->rb_left;
+  802260:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802263:	8b 40 08             	mov    0x8(%eax),%eax
+  802266:	89 45 fc             	mov    %eax,-0x4(%ebp)
+			if (rb_is_red(other))
+  802269:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  80226c:	8b 00                	mov    (%eax),%eax
+  80226e:	83 e0 01             	and    $0x1,%eax
+  802271:	85 c0                	test   %eax,%eax
+  802273:	75 35                	jne    8022aa <__rb_erase_color+0x1a8>
+			{
+				rb_set_black(other);
+  802275:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  802278:	8b 00                	mov    (%eax),%eax
+  80227a:	83 c8 01             	or     $0x1,%eax
+  80227d:	89 c2                	mov    %eax,%edx
+  80227f:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  802282:	89 10                	mov    %edx,(%eax)
+				rb_set_red(parent);
+  802284:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802287:	8b 00                	mov    (%eax),%eax
+  802289:	83 e0 fe             	and    $0xfffffffe,%eax
+  80228c:	89 c2                	mov    %eax,%edx
+  80228e:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802291:	89 10                	mov    %edx,(%eax)
+				__rb_rotate_right(parent, root);
+  802293:	ff 75 10             	push   0x10(%ebp)
+  802296:	ff 75 0c             	push   0xc(%ebp)
+  802299:	e8 43 fc ff ff       	call   801ee1 <__rb_rotate_right>
+  80229e:	83 c4 08             	add    $0x8,%esp
+				other = parent->rb_left;
+  8022a1:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8022a4:	8b 40 08             	mov    0x8(%eax),%eax
+  8022a7:	89 45 fc             	mov    %eax,-0x4(%ebp)
+			}
+			if ((!other->rb_left || rb_is_black(other->rb_left)) &&
+  8022aa:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8022ad:	8b 40 08             	mov    0x8(%eax),%eax
+  8022b0:	85 c0                	test   %eax,%eax
+  8022b2:	74 0f                	je     8022c3 <__rb_erase_color+0x1c1>
+  8022b4:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8022b7:	8b 40 08             	mov    0x8(%eax),%eax
+  8022ba:	8b 00                	mov    (%eax),%eax
+  8022bc:	83 e0 01             	and    $0x1,%eax
+  8022bf:	85 c0                	test   %eax,%eax
+  8022c1:	74 3e                	je     802301 <__rb_erase_color+0x1ff>
+					(!other->rb_right || rb_is_black(other->rb_right)))
+  8022c3:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8022c6:	8b 40 04             	mov    0x4(%eax),%eax
+			if ((!other->rb_left || rb_is_black(other->rb_left)) &&
+  8022c9:	85 c0                	test   %eax,%eax
+  8022cb:	74 0f                	je     8022dc <__rb_erase_color+0x1da>
+					(!other->rb_right || rb_is_black(other->rb_right)))
+  8022cd:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8022d0:	8b 40 04             	mov    0x4(%eax),%eax
+  8022d3:	8b 00                	mov    (%eax),%eax
+  8022d5:	83 e0 01             	and    $0x1,%eax
+  8022d8:	85 c0                	test   %eax,%eax
+  8022da:	74 25                	je     802301 <__rb_erase_color+0x1ff>
+			{
+				rb_set_red(other);
+  8022dc:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8022df:	8b 00                	mov    (%eax),%eax
+  8022e1:	83 e0 fe             	and    $0xfffffffe,%eax
+  8022e4:	89 c2                	mov    %eax,%edx
+  8022e6:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8022e9:	89 10                	mov    %edx,(%eax)
+				node = parent;
+  8022eb:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8022ee:	89 45 08             	mov    %eax,0x8(%ebp)
+				parent = rb_parent(node);
+  8022f1:	8b 45 08             	mov    0x8(%ebp),%eax
+  8022f4:	8b 00                	mov    (%eax),%eax
+  8022f6:	83 e0 fc             	and    $0xfffffffc,%eax
+  8022f9:	89 45 0c             	mov    %eax,0xc(%ebp)
+  8022fc:	e9 a0 00 00 00       	jmp    8023a1 <__rb_erase_color+0x29f>
+			}
+			else
+			{
+				if (!other->rb_left || rb_is_black(other->rb_left))
+  802301:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  802304:	8b 40 08             	mov    0x8(%eax),%eax
+  802307:	85 c0                	test   %eax,%eax
+  802309:	74 0f                	je     80231a <__rb_erase_color+0x218>
+  80230b:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  80230e:	8b 40 08             	mov    0x8(%eax),%eax
+  802311:	8b 00                	mov    (%eax),%eax
+  802313:	83 e0 01             	and    $0x1,%eax
+  802316:	85 c0                	test   %eax,%eax
+  802318:	74 39                	je     802353 <__rb_erase_color+0x251>
+				{
+					rb_set_black(other->rb_right);
+  80231a:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  80231d:	8b 40 04             	mov    0x4(%eax),%eax
+  802320:	8b 10                	mov    (%eax),%edx
+  802322:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  802325:	8b 40 04             	mov    0x4(%eax),%eax
+  802328:	83 ca 01             	or     $0x1,%edx
+  80232b:	89 10                	mov    %edx,(%eax)
+					rb_set_red(other);
+  80232d:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  802330:	8b 00                	mov    (%eax),%eax
+  802332:	83 e0 fe             	and    $0xfffffffe,%eax
+  802335:	89 c2                	mov    %eax,%edx
+  802337:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  80233a:	89 10                	mov    %edx,(%eax)
+					__rb_rotate_left(other, root);
+  80233c:	ff 75 10             	push   0x10(%ebp)
+  80233f:	ff 75 fc             	push   -0x4(%ebp)
+  802342:	e8 01 fb ff ff       	call   801e48 <__rb_rotate_left>
+  802347:	83 c4 08             	add    $0x8,%esp
+					other = parent->rb_left;
+  80234a:	8b 45 0c             	mov    0xc(%ebp),%eax
+  80234d:	8b 40 08             	mov    0x8(%eax),%eax
+  802350:	89 45 fc             	mov    %eax,-0x4(%ebp)
+				}
+				rb_set_color(other, rb_color(parent));
+  802353:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802356:	8b 00                	mov    (%eax),%eax
+  802358:	83 e0 01             	and    $0x1,%eax
+  80235b:	50                   	push   %eax
+  80235c:	ff 75 fc             	push   -0x4(%ebp)
+  80235f:	e8 ca fa ff ff       	call   801e2e <rb_set_color>
+  802364:	83 c4 08             	add    $0x8,%esp
+				rb_set_black(parent);
+  802367:	8b 45 0c             	mov    0xc(%ebp),%eax
+  80236a:	8b 00                	mov    (%eax),%eax
+  80236c:	83 c8 01             	or     $0x1,%eax
+  80236f:	89 c2                	mov    %eax,%edx
+  802371:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802374:	89 10                	mov    %edx,(%eax)
+				rb_set_black(other->rb_left);
+  802376:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  802379:	8b 40 08             	mov    0x8(%eax),%eax
+  80237c:	8b 10                	mov    (%eax),%edx
+  80237e:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  802381:	8b 40 08             	mov    0x8(%eax),%eax
+  802384:	83 ca 01             	or     $0x1,%edx
+  802387:	89 10                	mov    %edx,(%eax)
+				__rb_rotate_right(parent, root);
+  802389:	ff 75 10             	push   0x10(%ebp)
+  80238c:	ff 75 0c             	push   0xc(%ebp)
+  80238f:	e8 4d fb ff ff       	call   801ee1 <__rb_rotate_right>
+  802394:	83 c4 08             	add    $0x8,%esp
+				node = root->rb_node;
+  802397:	8b 45 10             	mov    0x10(%ebp),%eax
+  80239a:	8b 00                	mov    (%eax),%eax
+  80239c:	89 45 08             	mov    %eax,0x8(%ebp)
+				break;
+  80239f:	eb 20                	jmp    8023c1 <__rb_erase_color+0x2bf>
+	while ((!node || rb_is_black(node)) && node != root->rb_node)
+  8023a1:	83 7d 08 00          	cmpl   $0x0,0x8(%ebp)
+  8023a5:	74 0c                	je     8023b3 <__rb_erase_color+0x2b1>
+  8023a7:	8b 45 08             	mov    0x8(%ebp),%eax
+  8023aa:	8b 00                	mov    (%eax),%eax
+  8023ac:	83 e0 01             	and    $0x1,%eax
+  8023af:	85 c0                	test   %eax,%eax
+  8023b1:	74 0e                	je     8023c1 <__rb_erase_color+0x2bf>
+  8023b3:	8b 45 10             	mov    0x10(%ebp),%eax
+  8023b6:	8b 00                	mov    (%eax),%eax
+  8023b8:	39 45 08             	cmp    %eax,0x8(%ebp)
+  8023bb:	0f 85 4c fd ff ff    	jne    80210d <__rb_erase_color+0xb>
+			}
+		}
+	}
+	if (node)
+  8023c1:	83 7d 08 00          	cmpl   $0x0,0x8(%ebp)
+  8023c5:	74 0f                	je     8023d6 <__rb_erase_color+0x2d4>
+		rb_set_black(node);
+  8023c7:	8b 45 08             	mov    0x8(%ebp),%eax
+  8023ca:	8b 00                	mov    (%eax),%eax
+  8023cc:	83 c8 01             	or     $0x1,%eax
+  8023cf:	89 c2                	mov    %eax,%edx
+  8023d1:	8b 45 08             	mov    0x8(%ebp),%eax
+  8023d4:	89 10                	mov    %edx,(%eax)
+}
+  8023d6:	90                   	nop
+  8023d7:	c9                   	leave
+  8023d8:	c3                   	ret
+
+008023d9 <rb_erase>:
+
+void rb_erase(struct rb_node *node, struct rb_root *root)
+{
+  8023d9:	55                   	push   %ebp
+  8023da:	89 e5                	mov    %esp,%ebp
+  8023dc:	83 ec 20             	sub    $0x20,%esp
+	struct rb_node *child, *parent;
+	int color;
+
+	if (!node->rb_left)
+  8023df:	8b 45 08             	mov    0x8(%ebp),%eax
+  8023e2:	8b 40 08             	mov    0x8(%eax),%eax
+  8023e5:	85 c0                	test   %eax,%eax
+  8023e7:	75 0e                	jne    8023f7 <rb_erase+0x1e>
+		child = node->rb_right;
+  8023e9:	8b 45 08             	mov    0x8(%ebp),%eax
+  8023ec:	8b 40 04             	mov    0x4(%eax),%eax
+  8023ef:	89 45 fc             	mov    %eax,-0x4(%ebp)
+  8023f2:	e9 18 01 00 00       	jmp    80250f <rb_erase+0x136>
+	else if (!node->rb_right)
+  8023f7:	8b 45 08             	mov    0x8(%ebp),%eax
+  8023fa:	8b 40 04             	mov    0x4(%eax),%eax
+  8023fd:	85 c0                	test   %eax,%eax
+  8023ff:	75 0e                	jne    80240f <rb_erase+0x36>
+		child = node->rb_left;
+  802401:	8b 45 08             	mov    0x8(%ebp),%eax
+  802404:	8b 40 08             	mov    0x8(%eax),%eax
+  802407:	89 45 fc             	mov    %eax,-0x4(%ebp)
+  80240a:	e9 00 01 00 00       	jmp    80250f <rb_erase+0x136>
+	else
+	{
+		struct rb_node *old = node, *left;
+  80240f:	8b 45 08             	mov    0x8(%ebp),%eax
+  802412:	89 45 f0             	mov    %eax,-0x10(%ebp)
+
+		node = node->rb_right;
+  802415:	8b 45 08             	mov    0x8(%ebp),%eax
+  802418:	8b 40 04             	mov    0x4(%eax),%eax
+  80241b:	89 45 08             	mov    %eax,0x8(%ebp)
+		while ((left = node->rb_left) != NULL)
+  80241e:	eb 06                	jmp    802426 <rb_erase+0x4d>
+			node = left;
+  802420:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  802423:	89 45 08             	mov    %eax,0x8(%ebp)
+		while ((left = node->rb_left) != NULL)
+  802426:	8b 45 08             	mov    0x8(%ebp),%eax
+  802429:	8b 40 08             	mov    0x8(%eax),%eax
+  80242c:	89 45 ec             	mov    %eax,-0x14(%ebp)
+  80242f:	83 7d ec 00          	cmpl   $0x0,-0x14(%ebp)
+  802433:	75 eb                	jne    802420 <rb_erase+0x47>
+
+		if (rb_parent(old))
+  802435:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  802438:	8b 00                	mov    (%eax),%eax
+  80243a:	83 f8 03             	cmp    $0x3,%eax
+  80243d:	76 34                	jbe    802473 <rb_erase+0x9a>
+		{
+			if (rb_parent(old)->rb_left == old)
+  80243f:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  802442:	8b 00                	mov    (%eax),%eax
+  802444:	83 e0 fc             	and    $0xfffffffc,%eax
+  802447:	8b 40 08             	mov    0x8(%eax),%eax
+  80244a:	39 45 f0             	cmp    %eax,-0x10(%ebp)
+  80244d:	75 12                	jne    802461 <rb_erase+0x88>
+				rb_parent(old)->rb_left = node;
+  80244f:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  802452:	8b 00                	mov    (%eax),%eax
+  802454:	83 e0 fc             	and    $0xfffffffc,%eax
+  802457:	89 c2                	mov    %eax,%edx
+  802459:	8b 45 08             	mov    0x8(%ebp),%eax
+  80245c:	89 42 08             	mov    %eax,0x8(%edx)
+  80245f:	eb 1a                	jmp    80247b <rb_erase+0xa2>
+			else
+				rb_parent(old)->rb_right = node;
+  802461:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  802464:	8b 00                	mov    (%eax),%eax
+  802466:	83 e0 fc             	and    $0xfffffffc,%eax
+  802469:	89 c2                	mov    %eax,%edx
+  80246b:	8b 45 08             	mov    0x8(%ebp),%eax
+  80246e:	89 42 04             	mov    %eax,0x4(%edx)
+  802471:	eb 08                	jmp    80247b <rb_erase+0xa2>
+		}
+		else
+			root->rb_node = node;
+  802473:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802476:	8b 55 08             	mov    0x8(%ebp),%edx
+  802479:	89 10                	mov    %edx,(%eax)
+
+		child = node->rb_right;
+  80247b:	8b 45 08             	mov    0x8(%ebp),%eax
+  80247e:	8b 40 04             	mov    0x4(%eax),%eax
+  802481:	89 45 fc             	mov    %eax,-0x4(%ebp)
+		parent = rb_parent(node);
+  802484:	8b 45 08             	mov    0x8(%ebp),%eax
+  802487:	8b 00                	mov    (%eax),%eax
+  802489:	83 e0 fc             	and    $0xfffffffc,%eax
+  80248c:	89 45 f8             	mov    %eax,-0x8(%ebp)
+		color = rb_color(node);
+  80248f:	8b 45 08             	mov    0x8(%ebp),%eax
+  802492:	8b 00                	mov    (%eax),%eax
+  802494:	83 e0 01             	and    $0x1,%eax
+  802497:	89 45 f4             	mov    %eax,-0xc(%ebp)
+
+		if (parent == old)
+  80249a:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  80249d:	3b 45 f0             	cmp    -0x10(%ebp),%eax
+  8024a0:	75 08                	jne    8024aa <rb_erase+0xd1>
+		{
+			parent = node;
+  8024a2:	8b 45 08             	mov    0x8(%ebp),%eax
+  8024a5:	89 45 f8             	mov    %eax,-0x8(%ebp)
+  8024a8:	eb 3b                	jmp    8024e5 <rb_erase+0x10c>
+		}
+		else
+		{
+			if (child)
+  8024aa:	83 7d fc 00          	cmpl   $0x0,-0x4(%ebp)
+  8024ae:	74 0e                	je     8024be <rb_erase+0xe5>
+				rb_set_parent(child, parent);
+  8024b0:	ff 75 f8             	push   -0x8(%ebp)
+  8024b3:	ff 75 fc             	push   -0x4(%ebp)
+  8024b6:	e8 59 f9 ff ff       	call   801e14 <rb_set_parent>
+  8024bb:	83 c4 08             	add    $0x8,%esp
+			parent->rb_left = child;
+  8024be:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  8024c1:	8b 55 fc             	mov    -0x4(%ebp),%edx
+  8024c4:	89 50 08             	mov    %edx,0x8(%eax)
+
+			node->rb_right = old->rb_right;
+  8024c7:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8024ca:	8b 50 04             	mov    0x4(%eax),%edx
+  8024cd:	8b 45 08             	mov    0x8(%ebp),%eax
+  8024d0:	89 50 04             	mov    %edx,0x4(%eax)
+			rb_set_parent(old->rb_right, node);
+  8024d3:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8024d6:	8b 40 04             	mov    0x4(%eax),%eax
+  8024d9:	ff 75 08             	push   0x8(%ebp)
+  8024dc:	50                   	push   %eax
+  8024dd:	e8 32 f9 ff ff       	call   801e14 <rb_set_parent>
+  8024e2:	83 c4 08             	add    $0x8,%esp
+		}
+
+		node->rb_parent_color = old->rb_parent_color;
+  8024e5:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8024e8:	8b 10                	mov    (%eax),%edx
+  8024ea:	8b 45 08             	mov    0x8(%ebp),%eax
+  8024ed:	89 10                	mov    %edx,(%eax)
+		node->rb_left = old->rb_left;
+  8024ef:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8024f2:	8b 50 08             	mov    0x8(%eax),%edx
+  8024f5:	8b 45 08             	mov    0x8(%ebp),%eax
+  8024f8:	89 50 08             	mov    %edx,0x8(%eax)
+		rb_set_parent(old->rb_left, node);
+  8024fb:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8024fe:	8b 40 08             	mov    0x8(%eax),%eax
+  802501:	ff 75 08             	push   0x8(%ebp)
+  802504:	50                   	push   %eax
+  802505:	e8 0a f9 ff ff       	call   801e14 <rb_set_parent>
+  80250a:	83 c4 08             	add    $0x8,%esp
+
+		goto color;
+  80250d:	eb 59                	jmp    802568 <rb_erase+0x18f>
+	}
+
+	parent = rb_parent(node);
+  80250f:	8b 45 08             	mov    0x8(%ebp),%eax
+  802512:	8b 00                	mov    (%eax),%eax
+  802514:	83 e0 fc             	and    $0xfffffffc,%eax
+  802517:	89 45 f8             	mov    %eax,-0x8(%ebp)
+	color = rb_color(node);
+  80251a:	8b 45 08             	mov    0x8(%ebp),%eax
+  80251d:	8b 00                	mov    (%eax),%eax
+  80251f:	83 e0 01             	and    $0x1,%eax
+  802522:	89 45 f4             	mov    %eax,-0xc(%ebp)
+
+	if (child)
+  802525:	83 7d fc 00          	cmpl   $0x0,-0x4(%ebp)
+  802529:	74 0e                	je     802539 <rb_erase+0x160>
+		rb_set_parent(child, parent);
+  80252b:	ff 75 f8             	push   -0x8(%ebp)
+  80252e:	ff 75 fc             	push   -0x4(%ebp)
+  802531:	e8 de f8 ff ff       	call   801e14 <rb_set_parent>
+  802536:	83 c4 08             	add    $0x8,%esp
+	if (parent)
+  802539:	83 7d f8 00          	cmpl   $0x0,-0x8(%ebp)
+  80253d:	74 21                	je     802560 <rb_erase+0x187>
+	{
+		if (parent->rb_left == node)
+  80253f:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  802542:	8b 40 08             	mov    0x8(%eax),%eax
+  802545:	39 45 08             	cmp    %eax,0x8(%ebp)
+  802548:	75 0b                	jne    802555 <rb_erase+0x17c>
+			parent->rb_left = child;
+  80254a:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  80254d:	8b 55 fc             	mov    -0x4(%ebp),%edx
+  802550:	89 50 08             	mov    %edx,0x8(%eax)
+  802553:	eb 13                	jmp    802568 <rb_erase+0x18f>
+		else
+			parent->rb_right = child;
+  802555:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  802558:	8b 55 fc             	mov    -0x4(%ebp),%edx
+  80255b:	89 50 04             	mov    %edx,0x4(%eax)
+  80255e:	eb 08                	jmp    802568 <rb_erase+0x18f>
+	}
+	else
+		root->rb_node = child;
+  802560:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802563:	8b 55 fc             	mov    -0x4(%ebp),%edx
+  802566:	89 10                	mov    %edx,(%eax)
+
+color:
+	if (color == RB_BLACK)
+  802568:	83 7d f4 01          	cmpl   $0x1,-0xc(%ebp)
+  80256c:	75 11                	jne    80257f <rb_erase+0x1a6>
+		__rb_erase_color(child, parent, root);
+  80256e:	ff 75 0c             	push   0xc(%ebp)
+  802571:	ff 75 f8             	push   -0x8(%ebp)
+  802574:	ff 75 fc             	push   -0x4(%ebp)
+  802577:	e8 86 fb ff ff       	call   802102 <__rb_erase_color>
+  80257c:	83 c4 0c             	add    $0xc,%esp
+}
+  80257f:	90                   	nop
+  802580:	c9                   	leave
+  802581:	c3                   	ret
+
+00802582 <rb_augment_path>:
+
+static void rb_augment_path(struct rb_node *node, rb_augment_f func, void *data)
+{
+  802582:	55                   	push   %ebp
+  802583:	89 e5                	mov    %esp,%ebp
+  802585:	83 ec 18             	sub    $0x18,%esp
+	struct rb_node *parent;
+
+up:
+	func(node, data);
+  802588:	83 ec 08             	sub    $0x8,%esp
+  80258b:	ff 75 10             	push   0x10(%ebp)
+  80258e:	ff 75 08             	push   0x8(%ebp)
+  802591:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802594:	ff d0                	call   *%eax
+  802596:	83 c4 10             	add    $0x10,%esp
+	parent = rb_parent(node);
+  802599:	8b 45 08             	mov    0x8(%ebp),%eax
+  80259c:	8b 00                	mov    (%eax),%eax
+  80259e:	83 e0 fc             	and    $0xfffffffc,%eax
+  8025a1:	89 45 f4             	mov    %eax,-0xc(%ebp)
+	if (!parent)
+  8025a4:	83 7d f4 00          	cmpl   $0x0,-0xc(%ebp)
+  8025a8:	74 53                	je     8025fd <rb_augment_path+0x7b>
+		return;
+
+	if (node == parent->rb_left && parent->rb_right)
+  8025aa:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  8025ad:	8b 40 08             	mov    0x8(%eax),%eax
+  8025b0:	39 45 08             	cmp    %eax,0x8(%ebp)
+  8025b3:	75 21                	jne    8025d6 <rb_augment_path+0x54>
+  8025b5:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  8025b8:	8b 40 04             	mov    0x4(%eax),%eax
+  8025bb:	85 c0                	test   %eax,%eax
+  8025bd:	74 17                	je     8025d6 <rb_augment_path+0x54>
+		func(parent->rb_right, data);
+  8025bf:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  8025c2:	8b 40 04             	mov    0x4(%eax),%eax
+  8025c5:	83 ec 08             	sub    $0x8,%esp
+  8025c8:	ff 75 10             	push   0x10(%ebp)
+  8025cb:	50                   	push   %eax
+  8025cc:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8025cf:	ff d0                	call   *%eax
+  8025d1:	83 c4 10             	add    $0x10,%esp
+  8025d4:	eb 1f                	jmp    8025f5 <rb_augment_path+0x73>
+	else if (parent->rb_left)
+  8025d6:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  8025d9:	8b 40 08             	mov    0x8(%eax),%eax
+  8025dc:	85 c0                	test   %eax,%eax
+  8025de:	74 15                	je     8025f5 <rb_augment_path+0x73>
+		func(parent->rb_left, data);
+  8025e0:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  8025e3:	8b 40 08             	mov    0x8(%eax),%eax
+  8025e6:	83 ec 08             	sub    $0x8,%esp
+  8025e9:	ff 75 10             	push   0x10(%ebp)
+  8025ec:	50                   	push   %eax
+  8025ed:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8025f0:	ff d0                	call   *%eax
+  8025f2:	83 c4 10             	add    $0x10,%esp
+
+	node = parent;
+  8025f5:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  8025f8:	89 45 08             	mov    %eax,0x8(%ebp)
+	goto up;
+  8025fb:	eb 8b                	jmp    802588 <rb_augment_path+0x6>
+		return;
+  8025fd:	90                   	nop
+}
+  8025fe:	c9                   	leave
+  8025ff:	c3                   	ret
+
+00802600 <rb_augment_insert>:
+/*
+ * after inserting @node into the tree, update the tree to account for
+ * both the new entry and any damage done by rebalance
+ */
+void rb_augment_insert(struct rb_node *node, rb_augment_f func, void *data)
+{
+  802600:	55                   	push   %ebp
+  802601:	89 e5                	mov    %esp,%ebp
+  802603:	83 ec 08             	sub    $0x8,%esp
+	if (node->rb_left)
+  802606:	8b 45 08             	mov    0x8(%ebp),%eax
+  802609:	8b 40 08             	mov    0x8(%eax),%eax
+  80260c:	85 c0                	test   %eax,%eax
+  80260e:	74 0b                	je     80261b <rb_augment_insert+0x1b>
+		node = node->rb_left;
+  802610:	8b 45 08             	mov    0x8(%ebp),%eax
+  802613:	8b 40 08             	mov    0x8(%eax),%eax
+  802616:	89 45 08             	mov    %eax,0x8(%ebp)
+  802619:	eb 13                	jmp    80262e <rb_augment_insert+0x2e>
+	else if (node->rb_right)
+  80261b:	8b 45 08             	mov    0x8(%ebp),%eax
+  80261e:	8b 40 04             	mov    0x4(%eax),%eax
+  802621:	85 c0                	test   %eax,%eax
+  802623:	74 09                	je     80262e <rb_augment_insert+0x2e>
+		node = node->rb_right;
+  802625:	8b 45 08             	mov    0x8(%ebp),%eax
+  802628:	8b 40 04             	mov    0x4(%eax),%eax
+  80262b:	89 45 08             	mov    %eax,0x8(%ebp)
+
+	rb_augment_path(node, func, data);
+  80262e:	83 ec 04             	sub    $0x4,%esp
+  802631:	ff 75 10             	push   0x10(%ebp)
+  802634:	ff 75 0c             	push   0xc(%ebp)
+  802637:	ff 75 08             	push   0x8(%ebp)
+  80263a:	e8 43 ff ff ff       	call   802582 <rb_augment_path>
+  80263f:	83 c4 10             	add    $0x10,%esp
+}
+  802642:	90                   	nop
+  802643:	c9                   	leave
+  802644:	c3                   	ret
+
+00802645 <rb_augment_erase_begin>:
+/*
+ * before removing the node, find the deepest node on the rebalance path
+ * that will still be there after @node gets removed
+ */
+struct rb_node *rb_augment_erase_begin(struct rb_node *node)
+{
+  802645:	55                   	push   %ebp
+  802646:	89 e5                	mov    %esp,%ebp
+  802648:	83 ec 18             	sub    $0x18,%esp
+	struct rb_node *deepest;
+
+	if (!node->rb_right && !node->rb_left)
+  80264b:	8b 45 08             	mov    0x8(%ebp),%eax
+  80264e:	8b 40 04             	mov    0x4(%eax),%eax
+  802651:	85 c0                	test   %eax,%eax
+  802653:	75 17                	jne    80266c <rb_augment_erase_begin+0x27>
+  802655:	8b 45 08             	mov    0x8(%ebp),%eax
+  802658:	8b 40 08             	mov    0x8(%eax),%eax
+  80265b:	85 c0                	test   %eax,%eax
+  80265d:	75 0d                	jne    80266c <rb_augment_erase_begin+0x27>
+		deepest = rb_parent(node);
+  80265f:	8b 45 08             	mov    0x8(%ebp),%eax
+  802662:	8b 00                	mov    (%eax),%eax
+  802664:	83 e0 fc             	and    $0xfffffffc,%eax
+  802667:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  80266a:	eb 68                	jmp    8026d4 <rb_augment_erase_begin+0x8f>
+	else if (!node->rb_right)
+  80266c:	8b 45 08             	mov    0x8(%ebp),%eax
+  80266f:	8b 40 04             	mov    0x4(%eax),%eax
+  802672:	85 c0                	test   %eax,%eax
+  802674:	75 0b                	jne    802681 <rb_augment_erase_begin+0x3c>
+		deepest = node->rb_left;
+  802676:	8b 45 08             	mov    0x8(%ebp),%eax
+  802679:	8b 40 08             	mov    0x8(%eax),%eax
+  80267c:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  80267f:	eb 53                	jmp    8026d4 <rb_augment_erase_begin+0x8f>
+	else if (!node->rb_left)
+  802681:	8b 45 08             	mov    0x8(%ebp),%eax
+  802684:	8b 40 08             	mov    0x8(%eax),%eax
+  802687:	85 c0                	test   %eax,%eax
+  802689:	75 0b                	jne    802696 <rb_augment_erase_begin+0x51>
+		deepest = node->rb_right;
+  80268b:	8b 45 08             	mov    0x8(%ebp),%eax
+  80268e:	8b 40 04             	mov    0x4(%eax),%eax
+  802691:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  802694:	eb 3e                	jmp    8026d4 <rb_augment_erase_begin+0x8f>
+	else
+	{
+		deepest = rb_next(node);
+  802696:	83 ec 0c             	sub    $0xc,%esp
+  802699:	ff 75 08             	push   0x8(%ebp)
+  80269c:	e8 c1 00 00 00       	call   802762 <rb_next>
+  8026a1:	83 c4 10             	add    $0x10,%esp
+  8026a4:	89 45 f4             	mov    %eax,-0xc(%ebp)
+		if (deepest->rb_right)
+  8026a7:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  8026aa:	8b 40 04             	mov    0x4(%eax),%eax
+  8026ad:	85 c0                	test   %eax,%eax
+  8026af:	74 0b                	je     8026bc <rb_augment_erase_begin+0x77>
+			deepest = deepest->rb_right;
+  8026b1:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  8026b4:	8b 40 04             	mov    0x4(%eax),%eax
+  8026b7:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  8026ba:	eb 18                	jmp    8026d4 <rb_augment_erase_begin+0x8f>
+		else if (rb_parent(deepest) != node)
+  8026bc:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  8026bf:	8b 00                	mov    (%eax),%eax
+  8026c1:	83 e0 fc             	and    $0xfffffffc,%eax
+  8026c4:	39 45 08             	cmp    %eax,0x8(%ebp)
+  8026c7:	74 0b                	je     8026d4 <rb_augment_erase_begin+0x8f>
+			deepest = rb_parent(deepest);
+  8026c9:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  8026cc:	8b 00                	mov    (%eax),%eax
+  8026ce:	83 e0 fc             	and    $0xfffffffc,%eax
+  8026d1:	89 45 f4             	mov    %eax,-0xc(%ebp)
+	}
+
+	return deepest;
+  8026d4:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  8026d7:	c9                   	leave
+  8026d8:	c3                   	ret
+
+008026d9 <rb_augment_erase_end>:
+/*
+ * after removal, update the tree to account for the removed entry
+ * and any rebalance damage.
+ */
+void rb_augment_erase_end(struct rb_node *node, rb_augment_f func, void *data)
+{
+  8026d9:	55                   	push   %ebp
+  8026da:	89 e5                	mov    %esp,%ebp
+  8026dc:	83 ec 08             	sub    $0x8,%esp
+	if (node)
+  8026df:	83 7d 08 00          	cmpl   $0x0,0x8(%ebp)
+  8026e3:	74 14                	je     8026f9 <rb_augment_erase_end+0x20>
+		rb_augment_path(node, func, data);
+  8026e5:	83 ec 04             	sub    $0x4,%esp
+  8026e8:	ff 75 10             	push   0x10(%ebp)
+  8026eb:	ff 75 0c             	push   0xc(%ebp)
+  8026ee:	ff 75 08             	push   0x8(%ebp)
+  8026f1:	e8 8c fe ff ff       	call   802582 <rb_augment_path>
+  8026f6:	83 c4 10             	add    $0x10,%esp
+}
+  8026f9:	90                   	nop
+  8026fa:	c9                   	leave
+  8026fb:	c3                   	ret
+
+008026fc <rb_first>:
+
+/*
+ * This function returns the first node (in sort order) of the tree.
+ */
+struct rb_node *rb_first(const struct rb_root *root)
+{
+  8026fc:	55                   	push   %ebp
+  8026fd:	89 e5                	mov    %esp,%ebp
+  8026ff:	83 ec 10             	sub    $0x10,%esp
+	struct rb_node *n;
+
+	n = root->rb_node;
+  802702:	8b 45 08             	mov    0x8(%ebp),%eax
+  802705:	8b 00                	mov    (%eax),%eax
+  802707:	89 45 fc             	mov    %eax,-0x4(%ebp)
+	if (!n)
+  80270a:	83 7d fc 00          	cmpl   $0x0,-0x4(%ebp)
+  80270e:	75 10                	jne    802720 <rb_first+0x24>
+		return NULL;
+  802710:	b8 00 00 00 00       	mov    $0x0,%eax
+  802715:	eb 16                	jmp    80272d <rb_first+0x31>
+	while (n->rb_left)
+		n = n->rb_left;
+  802717:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  80271a:	8b 40 08             	mov    0x8(%eax),%eax
+  80271d:	89 45 fc             	mov    %eax,-0x4(%ebp)
+	while (n->rb_left)
+  802720:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  802723:	8b 40 08             	mov    0x8(%eax),%eax
+  802726:	85 c0                	test   %eax,%eax
+  802728:	75 ed                	jne    802717 <rb_first+0x1b>
+	return n;
+  80272a:	8b 45 fc             	mov    -0x4(%ebp),%eax
+}
+  80272d:	c9                   	leave
+  80272e:	c3                   	ret
+
+0080272f <rb_last>:
+
+struct rb_node *rb_last(const struct rb_root *root)
+{
+  80272f:	55                   	push   %ebp
+  802730:	89 e5                	mov    %esp,%ebp
+  802732:	83 ec 10             	sub    $0x10,%esp
+	struct rb_node *n;
+
+	n = root->rb_node;
+  802735:	8b 45 08             	mov    0x8(%ebp),%eax
+  802738:	8b 00                	mov    (%eax),%eax
+  80273a:	89 45 fc             	mov    %eax,-0x4(%ebp)
+	if (!n)
+  80273d:	83 7d fc 00          	cmpl   $0x0,-0x4(%ebp)
+  802741:	75 10                	jne    802753 <rb_last+0x24>
+		return NULL;
+  802743:	b8 00 00 00 00       	mov    $0x0,%eax
+  802748:	eb 16                	jmp    802760 <rb_last+0x31>
+	while (n->rb_right)
+		n = n->rb_right;
+  80274a:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  80274d:	8b 40 04             	mov    0x4(%eax),%eax
+  802750:	89 45 fc             	mov    %eax,-0x4(%ebp)
+	while (n->rb_right)
+  802753:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  802756:	8b 40 04             	mov    0x4(%eax),%eax
+  802759:	85 c0                	test   %eax,%eax
+  80275b:	75 ed                	jne    80274a <rb_last+0x1b>
+	return n;
+  80275d:	8b 45 fc             	mov    -0x4(%ebp),%eax
+}
+  802760:	c9                   	leave
+  802761:	c3                   	ret
+
+00802762 <rb_next>:
+
+struct rb_node *rb_next(const struct rb_node *node)
+{
+  802762:	55                   	push   %ebp
+  802763:	89 e5                	mov    %esp,%ebp
+  802765:	83 ec 10             	sub    $0x10,%esp
+	struct rb_node *parent;
+
+	if (rb_parent(node) == node)
+  802768:	8b 45 08             	mov    0x8(%ebp),%eax
+  80276b:	8b 00                	mov    (%eax),%eax
+  80276d:	83 e0 fc             	and    $0xfffffffc,%eax
+  802770:	39 45 08             	cmp    %eax,0x8(%ebp)
+  802773:	75 07                	jne    80277c <rb_next+0x1a>
+		return NULL;
+  802775:	b8 00 00 00 00       	mov    $0x0,%eax
+  80277a:	eb 52                	jmp    8027ce <rb_next+0x6c>
+
+	/* If we have a right-hand child, go down and then left as far
+	   as we can. */
+	if (node->rb_right)
+  80277c:	8b 45 08             	mov    0x8(%ebp),%eax
+  80277f:	8b 40 04             	mov    0x4(%eax),%eax
+  802782:	85 c0                	test   %eax,%eax
+  802784:	74 29                	je     8027af <rb_next+0x4d>
+	{
+		node = node->rb_right;
+  802786:	8b 45 08             	mov    0x8(%ebp),%eax
+  802789:	8b 40 04             	mov    0x4(%eax),%eax
+  80278c:	89 45 08             	mov    %eax,0x8(%ebp)
+		while (node->rb_left)
+  80278f:	eb 09                	jmp    80279a <rb_next+0x38>
+			node = node->rb_left;
+  802791:	8b 45 08             	mov    0x8(%ebp),%eax
+  802794:	8b 40 08             	mov    0x8(%eax),%eax
+  802797:	89 45 08             	mov    %eax,0x8(%ebp)
+		while (node->rb_left)
+  80279a:	8b 45 08             	mov    0x8(%ebp),%eax
+  80279d:	8b 40 08             	mov    0x8(%eax),%eax
+  8027a0:	85 c0                	test   %eax,%eax
+  8027a2:	75 ed                	jne    802791 <rb_next+0x2f>
+		return (struct rb_node *)node;
+  8027a4:	8b 45 08             	mov    0x8(%ebp),%eax
+  8027a7:	eb 25                	jmp    8027ce <rb_next+0x6c>
+	   direction of our parent. Go up the tree; any time the
+	   ancestor is a right-hand child of its parent, keep going
+	   up. First time it's a left-hand child of its parent, said
+	   parent is our 'next' node. */
+	while ((parent = rb_parent(node)) && node == parent->rb_right)
+		node = parent;
+  8027a9:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8027ac:	89 45 08             	mov    %eax,0x8(%ebp)
+	while ((parent = rb_parent(node)) && node == parent->rb_right)
+  8027af:	8b 45 08             	mov    0x8(%ebp),%eax
+  8027b2:	8b 00                	mov    (%eax),%eax
+  8027b4:	83 e0 fc             	and    $0xfffffffc,%eax
+  8027b7:	89 45 fc             	mov    %eax,-0x4(%ebp)
+  8027ba:	83 7d fc 00          	cmpl   $0x0,-0x4(%ebp)
+  8027be:	74 0b                	je     8027cb <rb_next+0x69>
+  8027c0:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8027c3:	8b 40 04             	mov    0x4(%eax),%eax
+  8027c6:	39 45 08             	cmp    %eax,0x8(%ebp)
+  8027c9:	74 de                	je     8027a9 <rb_next+0x47>
+
+	return parent;
+  8027cb:	8b 45 fc             	mov    -0x4(%ebp),%eax
+}
+  8027ce:	c9                   	leave
+  8027cf:	c3                   	ret
+
+008027d0 <rb_prev>:
+
+struct rb_node *rb_prev(const struct rb_node *node)
+{
+  8027d0:	55                   	push   %ebp
+  8027d1:	89 e5                	mov    %esp,%ebp
+  8027d3:	83 ec 10             	sub    $0x10,%esp
+	struct rb_node *parent;
+
+	if (rb_parent(node) == node)
+  8027d6:	8b 45 08             	mov    0x8(%ebp),%eax
+  8027d9:	8b 00                	mov    (%eax),%eax
+  8027db:	83 e0 fc             	and    $0xfffffffc,%eax
+  8027de:	39 45 08             	cmp    %eax,0x8(%ebp)
+  8027e1:	75 07                	jne    8027ea <rb_prev+0x1a>
+		return NULL;
+  8027e3:	b8 00 00 00 00       	mov    $0x0,%eax
+  8027e8:	eb 52                	jmp    80283c <rb_prev+0x6c>
+
+	/* If we have a left-hand child, go down and then right as far
+	   as we can. */
+	if (node->rb_left)
+  8027ea:	8b 45 08             	mov    0x8(%ebp),%eax
+  8027ed:	8b 40 08             	mov    0x8(%eax),%eax
+  8027f0:	85 c0                	test   %eax,%eax
+  8027f2:	74 29                	je     80281d <rb_prev+0x4d>
+	{
+		node = node->rb_left;
+  8027f4:	8b 45 08             	mov    0x8(%ebp),%eax
+  8027f7:	8b 40 08             	mov    0x8(%eax),%eax
+  8027fa:	89 45 08             	mov    %eax,0x8(%ebp)
+		while (node->rb_right)
+  8027fd:	eb 09                	jmp    802808 <rb_prev+0x38>
+			node = node->rb_right;
+  8027ff:	8b 45 08             	mov    0x8(%ebp),%eax
+  802802:	8b 40 04             	mov    0x4(%eax),%eax
+  802805:	89 45 08             	mov    %eax,0x8(%ebp)
+		while (node->rb_right)
+  802808:	8b 45 08             	mov    0x8(%ebp),%eax
+  80280b:	8b 40 04             	mov    0x4(%eax),%eax
+  80280e:	85 c0                	test   %eax,%eax
+  802810:	75 ed                	jne    8027ff <rb_prev+0x2f>
+		return (struct rb_node *)node;
+  802812:	8b 45 08             	mov    0x8(%ebp),%eax
+  802815:	eb 25                	jmp    80283c <rb_prev+0x6c>
+	}
+
+	/* No left-hand children. Go up till we find an ancestor which
+	   is a right-hand child of its parent */
+	while ((parent = rb_parent(node)) && node == parent->rb_left)
+		node = parent;
+  802817:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  80281a:	89 45 08             	mov    %eax,0x8(%ebp)
+	while ((parent = rb_parent(node)) && node == parent->rb_left)
+  80281d:	8b 45 08             	mov    0x8(%ebp),%eax
+  802820:	8b 00                	mov    (%eax),%eax
+  802822:	83 e0 fc             	and    $0xfffffffc,%eax
+  802825:	89 45 fc             	mov    %eax,-0x4(%ebp)
+  802828:	83 7d fc 00          	cmpl   $0x0,-0x4(%ebp)
+  80282c:	74 0b                	je     802839 <rb_prev+0x69>
+  80282e:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  802831:	8b 40 08             	mov    0x8(%eax),%eax
+  802834:	39 45 08             	cmp    %eax,0x8(%ebp)
+  802837:	74 de                	je     802817 <rb_prev+0x47>
+
+	return parent;
+  802839:	8b 45 fc             	mov    -0x4(%ebp),%eax
+}
+  80283c:	c9                   	leave
+  80283d:	c3                   	ret
+
+0080283e <rb_replace_node>:
+
+void rb_replace_node(struct rb_node *victim, struct rb_node *new,
+										 struct rb_root *root)
+{
+  80283e:	55                   	push   %ebp
+  80283f:	89 e5                	mov    %esp,%ebp
+  802841:	83 ec 10             	sub    $0x10,%esp
+	struct rb_node *parent = rb_parent(victim);
+  802844:	8b 45 08             	mov    0x8(%ebp),%eax
+  802847:	8b 00                	mov    (%eax),%eax
+  802849:	83 e0 fc             	and    $0xfffffffc,%eax
+  80284c:	89 45 fc             	mov    %eax,-0x4(%ebp)
+
+	/* Set the surrounding nodes to point to the replacement */
+	if (parent)
+  80284f:	83 7d fc 00          	cmpl   $0x0,-0x4(%ebp)
+  802853:	74 21                	je     802876 <rb_replace_node+0x38>
+	{
+		if (victim == parent->rb_left)
+  802855:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  802858:	8b 40 08             	mov    0x8(%eax),%eax
+  80285b:	39 45 08             	cmp    %eax,0x8(%ebp)
+  80285e:	75 0b                	jne    80286b <rb_replace_node+0x2d>
+			parent->rb_left = new;
+  802860:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  802863:	8b 55 0c             	mov    0xc(%ebp),%edx
+  802866:	89 50 08             	mov    %edx,0x8(%eax)
+  802869:	eb 13                	jmp    80287e <rb_replace_node+0x40>
+		else
+			parent->rb_right = new;
+  80286b:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  80286e:	8b 55 0c             	mov    0xc(%ebp),%edx
+  802871:	89 50 04             	mov    %edx,0x4(%eax)
+  802874:	eb 08                	jmp    80287e <rb_replace_node+0x40>
+	}
+	else
+	{
+		root->rb_node = new;
+  802876:	8b 45 10             	mov    0x10(%ebp),%eax
+  802879:	8b 55 0c             	mov    0xc(%ebp),%edx
+  80287c:	89 10                	mov    %edx,(%eax)
+	}
+	if (victim->rb_left)
+  80287e:	8b 45 08             	mov    0x8(%ebp),%eax
+  802881:	8b 40 08             	mov    0x8(%eax),%eax
+  802884:	85 c0                	test   %eax,%eax
+  802886:	74 12                	je     80289a <rb_replace_node+0x5c>
+		rb_set_parent(victim->rb_left, new);
+  802888:	8b 45 08             	mov    0x8(%ebp),%eax
+  80288b:	8b 40 08             	mov    0x8(%eax),%eax
+  80288e:	ff 75 0c             	push   0xc(%ebp)
+  802891:	50                   	push   %eax
+  802892:	e8 7d f5 ff ff       	call   801e14 <rb_set_parent>
+  802897:	83 c4 08             	add    $0x8,%esp
+	if (victim->rb_right)
+  80289a:	8b 45 08             	mov    0x8(%ebp),%eax
+  80289d:	8b 40 04             	mov    0x4(%eax),%eax
+  8028a0:	85 c0                	test   %eax,%eax
+  8028a2:	74 12                	je     8028b6 <rb_replace_node+0x78>
+		rb_set_parent(victim->rb_right, new);
+  8028a4:	8b 45 08             	mov    0x8(%ebp),%eax
+  8028a7:	8b 40 04             	mov    0x4(%eax),%eax
+  8028aa:	ff 75 0c             	push   0xc(%ebp)
+  8028ad:	50                   	push   %eax
+  8028ae:	e8 61 f5 ff ff       	call   801e14 <rb_set_parent>
+  8028b3:	83 c4 08             	add    $0x8,%esp
+
+	/* Copy the pointers/colour from the victim to the replacement */
+	*new = *victim;
+  8028b6:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8028b9:	8b 55 08             	mov    0x8(%ebp),%edx
+  8028bc:	8b 0a                	mov    (%edx),%ecx
+  8028be:	89 08                	mov    %ecx,(%eax)
+  8028c0:	8b 4a 04             	mov    0x4(%edx),%ecx
+  8028c3:	89 48 04             	mov    %ecx,0x4(%eax)
+  8028c6:	8b 52 08             	mov    0x8(%edx),%edx
+  8028c9:	89 50 08             	mov    %edx,0x8(%eax)
+}
+  8028cc:	90                   	nop
+  8028cd:	c9                   	leave
+  8028ce:	c3                   	ret
+
+008028cf <strlen>:
+ * @s:      the input string
+ *
+ * The strlen() function returns the length of string @s.
+ * */
+size_t
+strlen(const char *s) {
+  8028cf:	55                   	push   %ebp
+  8028d0:	89 e5                	mov    %esp,%ebp
+  8028d2:	83 ec 10             	sub    $0x10,%esp
+    size_t cnt = 0;
+  8028d5:	c7 45 fc 00 00 00 00 	movl   $0x0,-0x4(%ebp)
+    while (*s ++ != '\0') {
+  8028dc:	eb 04                	jmp    8028e2 <strlen+0x13>
+        cnt ++;
+  8028de:	83 45 fc 01          	addl   $0x1,-0x4(%ebp)
+    while (*s ++ != '\0') {
+  8028e2:	8b 45 08             	mov    0x8(%ebp),%eax
+  8028e5:	8d 50 01             	lea    0x1(%eax),%edx
+  8028e8:	89 55 08             	mov    %edx,0x8(%ebp)
+  8028eb:	0f b6 00             	movzbl (%eax),%eax
+  8028ee:	84 c0                	test   %al,%al
+  8028f0:	75 ec                	jne    8028de <strlen+0xf>
+    }
+    return cnt;
+  8028f2:	8b 45 fc             	mov    -0x4(%ebp),%eax
+}
+  8028f5:	c9                   	leave
+  8028f6:	c3                   	ret
+
+008028f7 <strnlen>:
+ * The return value is strlen(s), if that is less than @len, or
+ * @len if there is no '\0' character among the first @len characters
+ * pointed by @s.
+ * */
+size_t
+strnlen(const char *s, size_t len) {
+  8028f7:	55                   	push   %ebp
+  8028f8:	89 e5                	mov    %esp,%ebp
+  8028fa:	83 ec 10             	sub    $0x10,%esp
+    size_t cnt = 0;
+  8028fd:	c7 45 fc 00 00 00 00 	movl   $0x0,-0x4(%ebp)
+    while (cnt < len && *s ++ != '\0') {
+  802904:	eb 04                	jmp    80290a <strnlen+0x13>
+        cnt ++;
+  802906:	83 45 fc 01          	addl   $0x1,-0x4(%ebp)
+    while (cnt < len && *s ++ != '\0') {
+  80290a:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  80290d:	3b 45 0c             	cmp    0xc(%ebp),%eax
+  802910:	73 10                	jae    802922 <strnlen+0x2b>
+  802912:	8b 45 08             	mov    0x8(%ebp),%eax
+  802915:	8d 50 01             	lea    0x1(%eax),%edx
+  802918:	89 55 08             	mov    %edx,0x8(%ebp)
+  80291b:	0f b6 00             	movzbl (%eax),%eax
+  80291e:	84 c0                	test   %al,%al
+  802920:	75 e4                	jne    802906 <strnlen+0xf>
+    }
+    return cnt;
+  802922:	8b 45 fc             	mov    -0x4(%ebp),%eax
+}
+  802925:	c9                   	leave
+  802926:	c3                   	ret
+
+00802927 <strcat>:
+ * @dst:    pointer to the @dst array, which should be large enough to contain the concatenated
+ *          resulting string.
+ * @src:    string to be appended, this should not overlap @dst
+ * */
+char *
+strcat(char *dst, const char *src) {
+  802927:	55                   	push   %ebp
+  802928:	89 e5                	mov    %esp,%ebp
+  80292a:	83 ec 08             	sub    $0x8,%esp
+    return strcpy(dst + strlen(dst), src);
+  80292d:	ff 75 08             	push   0x8(%ebp)
+  802930:	e8 9a ff ff ff       	call   8028cf <strlen>
+  802935:	83 c4 04             	add    $0x4,%esp
+  802938:	8b 55 08             	mov    0x8(%ebp),%edx
+  80293b:	01 d0                	add    %edx,%eax
+  80293d:	83 ec 08             	sub    $0x8,%esp
+  802940:	ff 75 0c             	push   0xc(%ebp)
+  802943:	50                   	push   %eax
+  802944:	e8 05 00 00 00       	call   80294e <strcpy>
+  802949:	83 c4 10             	add    $0x10,%esp
+}
+  80294c:	c9                   	leave
+  80294d:	c3                   	ret
+
+0080294e <strcpy>:
+ * To avoid overflows, the size of array pointed by @dst should be long enough to
+ * contain the same string as @src (including the terminating null character), and
+ * should not overlap in memory with @src.
+ * */
+char *
+strcpy(char *dst, const char *src) {
+  80294e:	55                   	push   %ebp
+  80294f:	89 e5                	mov    %esp,%ebp
+  802951:	57                   	push   %edi
+  802952:	56                   	push   %esi
+  802953:	83 ec 20             	sub    $0x20,%esp
+  802956:	8b 45 08             	mov    0x8(%ebp),%eax
+  802959:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  80295c:	8b 45 0c             	mov    0xc(%ebp),%eax
+  80295f:	89 45 f0             	mov    %eax,-0x10(%ebp)
+#ifndef __HAVE_ARCH_STRCPY
+#define __HAVE_ARCH_STRCPY
+static inline char *
+__strcpy(char *dst, const char *src) {
+    int d0, d1, d2;
+    asm volatile (
+  802962:	8b 55 f0             	mov    -0x10(%ebp),%edx
+  802965:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  802968:	89 d1                	mov    %edx,%ecx
+  80296a:	89 c2                	mov    %eax,%edx
+  80296c:	89 ce                	mov    %ecx,%esi
+  80296e:	89 d7                	mov    %edx,%edi
+  802970:	ac                   	lods   %ds:(%esi),%al
+  802971:	aa                   	stos   %al,%es:(%edi)
+  802972:	84 c0                	test   %al,%al
+  802974:	75 fa                	jne    802970 <strcpy+0x22>
+  802976:	89 fa                	mov    %edi,%edx
+  802978:	89 f1                	mov    %esi,%ecx
+  80297a:	89 4d ec             	mov    %ecx,-0x14(%ebp)
+  80297d:	89 55 e8             	mov    %edx,-0x18(%ebp)
+  802980:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+        "stosb;"
+        "testb %%al, %%al;"
+        "jne 1b;"
+        : "=&S" (d0), "=&D" (d1), "=&a" (d2)
+        : "0" (src), "1" (dst) : "memory");
+    return dst;
+  802983:	8b 45 f4             	mov    -0xc(%ebp),%eax
+    char *p = dst;
+    while ((*p ++ = *src ++) != '\0')
+        /* nothing */;
+    return dst;
+#endif /* __HAVE_ARCH_STRCPY */
+}
+  802986:	83 c4 20             	add    $0x20,%esp
+  802989:	5e                   	pop    %esi
+  80298a:	5f                   	pop    %edi
+  80298b:	5d                   	pop    %ebp
+  80298c:	c3                   	ret
+
+0080298d <strncpy>:
+ * @len:    maximum number of characters to be copied from @src
+ *
+ * The return value is @dst
+ * */
+char *
+strncpy(char *dst, const char *src, size_t len) {
+  80298d:	55                   	push   %ebp
+  80298e:	89 e5                	mov    %esp,%ebp
+  802990:	83 ec 10             	sub    $0x10,%esp
+    char *p = dst;
+  802993:	8b 45 08             	mov    0x8(%ebp),%eax
+  802996:	89 45 fc             	mov    %eax,-0x4(%ebp)
+    while (len > 0) {
+  802999:	eb 21                	jmp    8029bc <strncpy+0x2f>
+        if ((*p = *src) != '\0') {
+  80299b:	8b 45 0c             	mov    0xc(%ebp),%eax
+  80299e:	0f b6 10             	movzbl (%eax),%edx
+  8029a1:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8029a4:	88 10                	mov    %dl,(%eax)
+  8029a6:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8029a9:	0f b6 00             	movzbl (%eax),%eax
+  8029ac:	84 c0                	test   %al,%al
+  8029ae:	74 04                	je     8029b4 <strncpy+0x27>
+            src ++;
+  8029b0:	83 45 0c 01          	addl   $0x1,0xc(%ebp)
+        }
+        p ++, len --;
+  8029b4:	83 45 fc 01          	addl   $0x1,-0x4(%ebp)
+  8029b8:	83 6d 10 01          	subl   $0x1,0x10(%ebp)
+    while (len > 0) {
+  8029bc:	83 7d 10 00          	cmpl   $0x0,0x10(%ebp)
+  8029c0:	75 d9                	jne    80299b <strncpy+0xe>
+    }
+    return dst;
+  8029c2:	8b 45 08             	mov    0x8(%ebp),%eax
+}
+  8029c5:	c9                   	leave
+  8029c6:	c3                   	ret
+
+008029c7 <strcmp>:
+ * - A value greater than zero indicates that the first character that does
+ *   not match has a greater value in @s1 than in @s2;
+ * - And a value less than zero indicates the opposite.
+ * */
+int
+strcmp(const char *s1, const char *s2) {
+  8029c7:	55                   	push   %ebp
+  8029c8:	89 e5                	mov    %esp,%ebp
+  8029ca:	57                   	push   %edi
+  8029cb:	56                   	push   %esi
+  8029cc:	83 ec 20             	sub    $0x20,%esp
+  8029cf:	8b 45 08             	mov    0x8(%ebp),%eax
+  8029d2:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  8029d5:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8029d8:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    asm volatile (
+  8029db:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  8029de:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8029e1:	89 d1                	mov    %edx,%ecx
+  8029e3:	89 c2                	mov    %eax,%edx
+  8029e5:	89 ce                	mov    %ecx,%esi
+  8029e7:	89 d7                	mov    %edx,%edi
+  8029e9:	ac                   	lods   %ds:(%esi),%al
+  8029ea:	ae                   	scas   %es:(%edi),%al
+  8029eb:	75 08                	jne    8029f5 <strcmp+0x2e>
+  8029ed:	84 c0                	test   %al,%al
+  8029ef:	75 f8                	jne    8029e9 <strcmp+0x22>
+  8029f1:	31 c0                	xor    %eax,%eax
+  8029f3:	eb 04                	jmp    8029f9 <strcmp+0x32>
+  8029f5:	19 c0                	sbb    %eax,%eax
+  8029f7:	0c 01                	or     $0x1,%al
+  8029f9:	89 fa                	mov    %edi,%edx
+  8029fb:	89 f1                	mov    %esi,%ecx
+  8029fd:	89 45 ec             	mov    %eax,-0x14(%ebp)
+  802a00:	89 4d e8             	mov    %ecx,-0x18(%ebp)
+  802a03:	89 55 e4             	mov    %edx,-0x1c(%ebp)
+    return ret;
+  802a06:	8b 45 ec             	mov    -0x14(%ebp),%eax
+    while (*s1 != '\0' && *s1 == *s2) {
+        s1 ++, s2 ++;
+    }
+    return (int)((unsigned char)*s1 - (unsigned char)*s2);
+#endif /* __HAVE_ARCH_STRCMP */
+}
+  802a09:	83 c4 20             	add    $0x20,%esp
+  802a0c:	5e                   	pop    %esi
+  802a0d:	5f                   	pop    %edi
+  802a0e:	5d                   	pop    %ebp
+  802a0f:	c3                   	ret
+
+00802a10 <strncmp>:
+ * they are equal to each other, it continues with the following pairs until
+ * the characters differ, until a terminating null-character is reached, or
+ * until @n characters match in both strings, whichever happens first.
+ * */
+int
+strncmp(const char *s1, const char *s2, size_t n) {
+  802a10:	55                   	push   %ebp
+  802a11:	89 e5                	mov    %esp,%ebp
+    while (n > 0 && *s1 != '\0' && *s1 == *s2) {
+  802a13:	eb 0c                	jmp    802a21 <strncmp+0x11>
+        n --, s1 ++, s2 ++;
+  802a15:	83 6d 10 01          	subl   $0x1,0x10(%ebp)
+  802a19:	83 45 08 01          	addl   $0x1,0x8(%ebp)
+  802a1d:	83 45 0c 01          	addl   $0x1,0xc(%ebp)
+    while (n > 0 && *s1 != '\0' && *s1 == *s2) {
+  802a21:	83 7d 10 00          	cmpl   $0x0,0x10(%ebp)
+  802a25:	74 1a                	je     802a41 <strncmp+0x31>
+  802a27:	8b 45 08             	mov    0x8(%ebp),%eax
+  802a2a:	0f b6 00             	movzbl (%eax),%eax
+  802a2d:	84 c0                	test   %al,%al
+  802a2f:	74 10                	je     802a41 <strncmp+0x31>
+  802a31:	8b 45 08             	mov    0x8(%ebp),%eax
+  802a34:	0f b6 10             	movzbl (%eax),%edx
+  802a37:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802a3a:	0f b6 00             	movzbl (%eax),%eax
+  802a3d:	38 c2                	cmp    %al,%dl
+  802a3f:	74 d4                	je     802a15 <strncmp+0x5>
+    }
+    return (n == 0) ? 0 : (int)((unsigned char)*s1 - (unsigned char)*s2);
+  802a41:	83 7d 10 00          	cmpl   $0x0,0x10(%ebp)
+  802a45:	74 16                	je     802a5d <strncmp+0x4d>
+  802a47:	8b 45 08             	mov    0x8(%ebp),%eax
+  802a4a:	0f b6 00             	movzbl (%eax),%eax
+  802a4d:	0f b6 d0             	movzbl %al,%edx
+  802a50:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802a53:	0f b6 00             	movzbl (%eax),%eax
+  802a56:	0f b6 c0             	movzbl %al,%eax
+  802a59:	29 c2                	sub    %eax,%edx
+  802a5b:	eb 05                	jmp    802a62 <strncmp+0x52>
+  802a5d:	ba 00 00 00 00       	mov    $0x0,%edx
+  802a62:	89 d0                	mov    %edx,%eax
+}
+  802a64:	5d                   	pop    %ebp
+  802a65:	c3                   	ret
+
+00802a66 <strchr>:
+ *
+ * The strchr() function returns a pointer to the first occurrence of
+ * character in @s. If the value is not found, the function returns 'NULL'.
+ * */
+char *
+strchr(const char *s, char c) {
+  802a66:	55                   	push   %ebp
+  802a67:	89 e5                	mov    %esp,%ebp
+  802a69:	83 ec 04             	sub    $0x4,%esp
+  802a6c:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802a6f:	88 45 fc             	mov    %al,-0x4(%ebp)
+    while (*s != '\0') {
+  802a72:	eb 14                	jmp    802a88 <strchr+0x22>
+        if (*s == c) {
+  802a74:	8b 45 08             	mov    0x8(%ebp),%eax
+  802a77:	0f b6 00             	movzbl (%eax),%eax
+  802a7a:	38 45 fc             	cmp    %al,-0x4(%ebp)
+  802a7d:	75 05                	jne    802a84 <strchr+0x1e>
+            return (char *)s;
+  802a7f:	8b 45 08             	mov    0x8(%ebp),%eax
+  802a82:	eb 13                	jmp    802a97 <strchr+0x31>
+        }
+        s ++;
+  802a84:	83 45 08 01          	addl   $0x1,0x8(%ebp)
+    while (*s != '\0') {
+  802a88:	8b 45 08             	mov    0x8(%ebp),%eax
+  802a8b:	0f b6 00             	movzbl (%eax),%eax
+  802a8e:	84 c0                	test   %al,%al
+  802a90:	75 e2                	jne    802a74 <strchr+0xe>
+    }
+    return NULL;
+  802a92:	b8 00 00 00 00       	mov    $0x0,%eax
+}
+  802a97:	c9                   	leave
+  802a98:	c3                   	ret
+
+00802a99 <strfind>:
+ * The strfind() function is like strchr() except that if @c is
+ * not found in @s, then it returns a pointer to the null byte at the
+ * end of @s, rather than 'NULL'.
+ * */
+char *
+strfind(const char *s, char c) {
+  802a99:	55                   	push   %ebp
+  802a9a:	89 e5                	mov    %esp,%ebp
+  802a9c:	83 ec 04             	sub    $0x4,%esp
+  802a9f:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802aa2:	88 45 fc             	mov    %al,-0x4(%ebp)
+    while (*s != '\0') {
+  802aa5:	eb 0f                	jmp    802ab6 <strfind+0x1d>
+        if (*s == c) {
+  802aa7:	8b 45 08             	mov    0x8(%ebp),%eax
+  802aaa:	0f b6 00             	movzbl (%eax),%eax
+  802aad:	38 45 fc             	cmp    %al,-0x4(%ebp)
+  802ab0:	74 10                	je     802ac2 <strfind+0x29>
+            break;
+        }
+        s ++;
+  802ab2:	83 45 08 01          	addl   $0x1,0x8(%ebp)
+    while (*s != '\0') {
+  802ab6:	8b 45 08             	mov    0x8(%ebp),%eax
+  802ab9:	0f b6 00             	movzbl (%eax),%eax
+  802abc:	84 c0                	test   %al,%al
+  802abe:	75 e7                	jne    802aa7 <strfind+0xe>
+  802ac0:	eb 01                	jmp    802ac3 <strfind+0x2a>
+            break;
+  802ac2:	90                   	nop
+    }
+    return (char *)s;
+  802ac3:	8b 45 08             	mov    0x8(%ebp),%eax
+}
+  802ac6:	c9                   	leave
+  802ac7:	c3                   	ret
+
+00802ac8 <strtol>:
+ * an optional "0x" or "0X" prefix.
+ *
+ * The strtol() function returns the converted integral number as a long int value.
+ * */
+long
+strtol(const char *s, char **endptr, int base) {
+  802ac8:	55                   	push   %ebp
+  802ac9:	89 e5                	mov    %esp,%ebp
+  802acb:	83 ec 10             	sub    $0x10,%esp
+    int neg = 0;
+  802ace:	c7 45 fc 00 00 00 00 	movl   $0x0,-0x4(%ebp)
+    long val = 0;
+  802ad5:	c7 45 f8 00 00 00 00 	movl   $0x0,-0x8(%ebp)
+
+    // gobble initial whitespace
+    while (*s == ' ' || *s == '\t') {
+  802adc:	eb 04                	jmp    802ae2 <strtol+0x1a>
+        s ++;
+  802ade:	83 45 08 01          	addl   $0x1,0x8(%ebp)
+    while (*s == ' ' || *s == '\t') {
+  802ae2:	8b 45 08             	mov    0x8(%ebp),%eax
+  802ae5:	0f b6 00             	movzbl (%eax),%eax
+  802ae8:	3c 20                	cmp    $0x20,%al
+  802aea:	74 f2                	je     802ade <strtol+0x16>
+  802aec:	8b 45 08             	mov    0x8(%ebp),%eax
+  802aef:	0f b6 00             	movzbl (%eax),%eax
+  802af2:	3c 09                	cmp    $0x9,%al
+  802af4:	74 e8                	je     802ade <strtol+0x16>
+    }
+
+    // plus/minus sign
+    if (*s == '+') {
+  802af6:	8b 45 08             	mov    0x8(%ebp),%eax
+  802af9:	0f b6 00             	movzbl (%eax),%eax
+  802afc:	3c 2b                	cmp    $0x2b,%al
+  802afe:	75 06                	jne    802b06 <strtol+0x3e>
+        s ++;
+  802b00:	83 45 08 01          	addl   $0x1,0x8(%ebp)
+  802b04:	eb 15                	jmp    802b1b <strtol+0x53>
+    }
+    else if (*s == '-') {
+  802b06:	8b 45 08             	mov    0x8(%ebp),%eax
+  802b09:	0f b6 00             	movzbl (%eax),%eax
+  802b0c:	3c 2d                	cmp    $0x2d,%al
+  802b0e:	75 0b                	jne    802b1b <strtol+0x53>
+        s ++, neg = 1;
+  802b10:	83 45 08 01          	addl   $0x1,0x8(%ebp)
+  802b14:	c7 45 fc 01 00 00 00 	movl   $0x1,-0x4(%ebp)
+    }
+
+    // hex or octal base prefix
+    if ((base == 0 || base == 16) && (s[0] == '0' && s[1] == 'x')) {
+  802b1b:	83 7d 10 00          	cmpl   $0x0,0x10(%ebp)
+  802b1f:	74 06                	je     802b27 <strtol+0x5f>
+  802b21:	83 7d 10 10          	cmpl   $0x10,0x10(%ebp)
+  802b25:	75 24                	jne    802b4b <strtol+0x83>
+  802b27:	8b 45 08             	mov    0x8(%ebp),%eax
+  802b2a:	0f b6 00             	movzbl (%eax),%eax
+  802b2d:	3c 30                	cmp    $0x30,%al
+  802b2f:	75 1a                	jne    802b4b <strtol+0x83>
+  802b31:	8b 45 08             	mov    0x8(%ebp),%eax
+  802b34:	83 c0 01             	add    $0x1,%eax
+  802b37:	0f b6 00             	movzbl (%eax),%eax
+  802b3a:	3c 78                	cmp    $0x78,%al
+  802b3c:	75 0d                	jne    802b4b <strtol+0x83>
+        s += 2, base = 16;
+  802b3e:	83 45 08 02          	addl   $0x2,0x8(%ebp)
+  802b42:	c7 45 10 10 00 00 00 	movl   $0x10,0x10(%ebp)
+  802b49:	eb 2a                	jmp    802b75 <strtol+0xad>
+    }
+    else if (base == 0 && s[0] == '0') {
+  802b4b:	83 7d 10 00          	cmpl   $0x0,0x10(%ebp)
+  802b4f:	75 17                	jne    802b68 <strtol+0xa0>
+  802b51:	8b 45 08             	mov    0x8(%ebp),%eax
+  802b54:	0f b6 00             	movzbl (%eax),%eax
+  802b57:	3c 30                	cmp    $0x30,%al
+  802b59:	75 0d                	jne    802b68 <strtol+0xa0>
+        s ++, base = 8;
+  802b5b:	83 45 08 01          	addl   $0x1,0x8(%ebp)
+  802b5f:	c7 45 10 08 00 00 00 	movl   $0x8,0x10(%ebp)
+  802b66:	eb 0d                	jmp    802b75 <strtol+0xad>
+    }
+    else if (base == 0) {
+  802b68:	83 7d 10 00          	cmpl   $0x0,0x10(%ebp)
+  802b6c:	75 07                	jne    802b75 <strtol+0xad>
+        base = 10;
+  802b6e:	c7 45 10 0a 00 00 00 	movl   $0xa,0x10(%ebp)
+
+    // digits
+    while (1) {
+        int dig;
+
+        if (*s >= '0' && *s <= '9') {
+  802b75:	8b 45 08             	mov    0x8(%ebp),%eax
+  802b78:	0f b6 00             	movzbl (%eax),%eax
+  802b7b:	3c 2f                	cmp    $0x2f,%al
+  802b7d:	7e 1b                	jle    802b9a <strtol+0xd2>
+  802b7f:	8b 45 08             	mov    0x8(%ebp),%eax
+  802b82:	0f b6 00             	movzbl (%eax),%eax
+  802b85:	3c 39                	cmp    $0x39,%al
+  802b87:	7f 11                	jg     802b9a <strtol+0xd2>
+            dig = *s - '0';
+  802b89:	8b 45 08             	mov    0x8(%ebp),%eax
+  802b8c:	0f b6 00             	movzbl (%eax),%eax
+  802b8f:	0f be c0             	movsbl %al,%eax
+  802b92:	83 e8 30             	sub    $0x30,%eax
+  802b95:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  802b98:	eb 48                	jmp    802be2 <strtol+0x11a>
+        }
+        else if (*s >= 'a' && *s <= 'z') {
+  802b9a:	8b 45 08             	mov    0x8(%ebp),%eax
+  802b9d:	0f b6 00             	movzbl (%eax),%eax
+  802ba0:	3c 60                	cmp    $0x60,%al
+  802ba2:	7e 1b                	jle    802bbf <strtol+0xf7>
+  802ba4:	8b 45 08             	mov    0x8(%ebp),%eax
+  802ba7:	0f b6 00             	movzbl (%eax),%eax
+  802baa:	3c 7a                	cmp    $0x7a,%al
+  802bac:	7f 11                	jg     802bbf <strtol+0xf7>
+            dig = *s - 'a' + 10;
+  802bae:	8b 45 08             	mov    0x8(%ebp),%eax
+  802bb1:	0f b6 00             	movzbl (%eax),%eax
+  802bb4:	0f be c0             	movsbl %al,%eax
+  802bb7:	83 e8 57             	sub    $0x57,%eax
+  802bba:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  802bbd:	eb 23                	jmp    802be2 <strtol+0x11a>
+        }
+        else if (*s >= 'A' && *s <= 'Z') {
+  802bbf:	8b 45 08             	mov    0x8(%ebp),%eax
+  802bc2:	0f b6 00             	movzbl (%eax),%eax
+  802bc5:	3c 40                	cmp    $0x40,%al
+  802bc7:	7e 3c                	jle    802c05 <strtol+0x13d>
+  802bc9:	8b 45 08             	mov    0x8(%ebp),%eax
+  802bcc:	0f b6 00             	movzbl (%eax),%eax
+  802bcf:	3c 5a                	cmp    $0x5a,%al
+  802bd1:	7f 32                	jg     802c05 <strtol+0x13d>
+            dig = *s - 'A' + 10;
+  802bd3:	8b 45 08             	mov    0x8(%ebp),%eax
+  802bd6:	0f b6 00             	movzbl (%eax),%eax
+  802bd9:	0f be c0             	movsbl %al,%eax
+  802bdc:	83 e8 37             	sub    $0x37,%eax
+  802bdf:	89 45 f4             	mov    %eax,-0xc(%ebp)
+        }
+        else {
+            break;
+        }
+        if (dig >= base) {
+  802be2:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  802be5:	3b 45 10             	cmp    0x10(%ebp),%eax
+  802be8:	7d 1a                	jge    802c04 <strtol+0x13c>
+            break;
+        }
+        s ++, val = (val * base) + dig;
+  802bea:	83 45 08 01          	addl   $0x1,0x8(%ebp)
+  802bee:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  802bf1:	0f af 45 10          	imul   0x10(%ebp),%eax
+  802bf5:	89 c2                	mov    %eax,%edx
+  802bf7:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  802bfa:	01 d0                	add    %edx,%eax
+  802bfc:	89 45 f8             	mov    %eax,-0x8(%ebp)
+    while (1) {
+  802bff:	e9 71 ff ff ff       	jmp    802b75 <strtol+0xad>
+            break;
+  802c04:	90                   	nop
+        // we don't properly detect overflow!
+    }
+
+    if (endptr) {
+  802c05:	83 7d 0c 00          	cmpl   $0x0,0xc(%ebp)
+  802c09:	74 08                	je     802c13 <strtol+0x14b>
+        *endptr = (char *) s;
+  802c0b:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802c0e:	8b 55 08             	mov    0x8(%ebp),%edx
+  802c11:	89 10                	mov    %edx,(%eax)
+    }
+    return (neg ? -val : val);
+  802c13:	83 7d fc 00          	cmpl   $0x0,-0x4(%ebp)
+  802c17:	74 07                	je     802c20 <strtol+0x158>
+  802c19:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  802c1c:	f7 d8                	neg    %eax
+  802c1e:	eb 03                	jmp    802c23 <strtol+0x15b>
+  802c20:	8b 45 f8             	mov    -0x8(%ebp),%eax
+}
+  802c23:	c9                   	leave
+  802c24:	c3                   	ret
+
+00802c25 <memset>:
+ * @n:      number of bytes to be set to the value
+ *
+ * The memset() function returns @s.
+ * */
+void *
+memset(void *s, char c, size_t n) {
+  802c25:	55                   	push   %ebp
+  802c26:	89 e5                	mov    %esp,%ebp
+  802c28:	57                   	push   %edi
+  802c29:	83 ec 24             	sub    $0x24,%esp
+  802c2c:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802c2f:	88 45 d8             	mov    %al,-0x28(%ebp)
+#ifdef __HAVE_ARCH_MEMSET
+    return __memset(s, c, n);
+  802c32:	0f be 45 d8          	movsbl -0x28(%ebp),%eax
+  802c36:	8b 55 08             	mov    0x8(%ebp),%edx
+  802c39:	89 55 f8             	mov    %edx,-0x8(%ebp)
+  802c3c:	88 45 f7             	mov    %al,-0x9(%ebp)
+  802c3f:	8b 45 10             	mov    0x10(%ebp),%eax
+  802c42:	89 45 f0             	mov    %eax,-0x10(%ebp)
+#ifndef __HAVE_ARCH_MEMSET
+#define __HAVE_ARCH_MEMSET
+static inline void *
+__memset(void *s, char c, size_t n) {
+    int d0, d1;
+    asm volatile (
+  802c45:	8b 4d f0             	mov    -0x10(%ebp),%ecx
+  802c48:	0f b6 45 f7          	movzbl -0x9(%ebp),%eax
+  802c4c:	8b 55 f8             	mov    -0x8(%ebp),%edx
+  802c4f:	89 d7                	mov    %edx,%edi
+  802c51:	f3 aa                	rep stos %al,%es:(%edi)
+  802c53:	89 fa                	mov    %edi,%edx
+  802c55:	89 4d ec             	mov    %ecx,-0x14(%ebp)
+  802c58:	89 55 e8             	mov    %edx,-0x18(%ebp)
+        "rep; stosb;"
+        : "=&c" (d0), "=&D" (d1)
+        : "0" (n), "a" (c), "1" (s)
+        : "memory");
+    return s;
+  802c5b:	8b 45 f8             	mov    -0x8(%ebp),%eax
+    while (n -- > 0) {
+        *p ++ = c;
+    }
+    return s;
+#endif /* __HAVE_ARCH_MEMSET */
+}
+  802c5e:	8b 7d fc             	mov    -0x4(%ebp),%edi
+  802c61:	c9                   	leave
+  802c62:	c3                   	ret
+
+00802c63 <memmove>:
+ * @n:      number of bytes to copy
+ *
+ * The memmove() function returns @dst.
+ * */
+void *
+memmove(void *dst, const void *src, size_t n) {
+  802c63:	55                   	push   %ebp
+  802c64:	89 e5                	mov    %esp,%ebp
+  802c66:	57                   	push   %edi
+  802c67:	56                   	push   %esi
+  802c68:	53                   	push   %ebx
+  802c69:	83 ec 30             	sub    $0x30,%esp
+  802c6c:	8b 45 08             	mov    0x8(%ebp),%eax
+  802c6f:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  802c72:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802c75:	89 45 ec             	mov    %eax,-0x14(%ebp)
+  802c78:	8b 45 10             	mov    0x10(%ebp),%eax
+  802c7b:	89 45 e8             	mov    %eax,-0x18(%ebp)
+
+#ifndef __HAVE_ARCH_MEMMOVE
+#define __HAVE_ARCH_MEMMOVE
+static inline void *
+__memmove(void *dst, const void *src, size_t n) {
+    if (dst < src) {
+  802c7e:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  802c81:	3b 45 ec             	cmp    -0x14(%ebp),%eax
+  802c84:	73 42                	jae    802cc8 <memmove+0x65>
+  802c86:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  802c89:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+  802c8c:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  802c8f:	89 45 e0             	mov    %eax,-0x20(%ebp)
+  802c92:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  802c95:	89 45 dc             	mov    %eax,-0x24(%ebp)
+        "andl $3, %%ecx;"
+        "jz 1f;"
+        "rep; movsb;"
+        "1:"
+        : "=&c" (d0), "=&D" (d1), "=&S" (d2)
+        : "0" (n / 4), "g" (n), "1" (dst), "2" (src)
+  802c98:	8b 45 dc             	mov    -0x24(%ebp),%eax
+  802c9b:	c1 e8 02             	shr    $0x2,%eax
+  802c9e:	89 c1                	mov    %eax,%ecx
+    asm volatile (
+  802ca0:	8b 55 e4             	mov    -0x1c(%ebp),%edx
+  802ca3:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  802ca6:	89 d7                	mov    %edx,%edi
+  802ca8:	89 c6                	mov    %eax,%esi
+  802caa:	f3 a5                	rep movsl %ds:(%esi),%es:(%edi)
+  802cac:	8b 4d dc             	mov    -0x24(%ebp),%ecx
+  802caf:	83 e1 03             	and    $0x3,%ecx
+  802cb2:	74 02                	je     802cb6 <memmove+0x53>
+  802cb4:	f3 a4                	rep movsb %ds:(%esi),%es:(%edi)
+  802cb6:	89 f0                	mov    %esi,%eax
+  802cb8:	89 fa                	mov    %edi,%edx
+  802cba:	89 4d d8             	mov    %ecx,-0x28(%ebp)
+  802cbd:	89 55 d4             	mov    %edx,-0x2c(%ebp)
+  802cc0:	89 45 d0             	mov    %eax,-0x30(%ebp)
+        : "memory");
+    return dst;
+  802cc3:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+        return __memcpy(dst, src, n);
+  802cc6:	eb 36                	jmp    802cfe <memmove+0x9b>
+        : "0" (n), "1" (n - 1 + src), "2" (n - 1 + dst)
+  802cc8:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  802ccb:	8d 50 ff             	lea    -0x1(%eax),%edx
+  802cce:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  802cd1:	01 c2                	add    %eax,%edx
+  802cd3:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  802cd6:	8d 48 ff             	lea    -0x1(%eax),%ecx
+  802cd9:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  802cdc:	8d 1c 01             	lea    (%ecx,%eax,1),%ebx
+    asm volatile (
+  802cdf:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  802ce2:	89 c1                	mov    %eax,%ecx
+  802ce4:	89 d8                	mov    %ebx,%eax
+  802ce6:	89 d6                	mov    %edx,%esi
+  802ce8:	89 c7                	mov    %eax,%edi
+  802cea:	fd                   	std
+  802ceb:	f3 a4                	rep movsb %ds:(%esi),%es:(%edi)
+  802ced:	fc                   	cld
+  802cee:	89 f8                	mov    %edi,%eax
+  802cf0:	89 f2                	mov    %esi,%edx
+  802cf2:	89 4d cc             	mov    %ecx,-0x34(%ebp)
+  802cf5:	89 55 c8             	mov    %edx,-0x38(%ebp)
+  802cf8:	89 45 c4             	mov    %eax,-0x3c(%ebp)
+    return dst;
+  802cfb:	8b 45 f0             	mov    -0x10(%ebp),%eax
+            *d ++ = *s ++;
+        }
+    }
+    return dst;
+#endif /* __HAVE_ARCH_MEMMOVE */
+}
+  802cfe:	83 c4 30             	add    $0x30,%esp
+  802d01:	5b                   	pop    %ebx
+  802d02:	5e                   	pop    %esi
+  802d03:	5f                   	pop    %edi
+  802d04:	5d                   	pop    %ebp
+  802d05:	c3                   	ret
+
+00802d06 <memcpy>:
+ * it always copies exactly @n bytes. To avoid overflows, the size of arrays pointed
+ * by both @src and @dst, should be at least @n bytes, and should not overlap
+ * (for overlapping memory area, memmove is a safer approach).
+ * */
+void *
+memcpy(void *dst, const void *src, size_t n) {
+  802d06:	55                   	push   %ebp
+  802d07:	89 e5                	mov    %esp,%ebp
+  802d09:	57                   	push   %edi
+  802d0a:	56                   	push   %esi
+  802d0b:	83 ec 20             	sub    $0x20,%esp
+  802d0e:	8b 45 08             	mov    0x8(%ebp),%eax
+  802d11:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  802d14:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802d17:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  802d1a:	8b 45 10             	mov    0x10(%ebp),%eax
+  802d1d:	89 45 ec             	mov    %eax,-0x14(%ebp)
+        : "0" (n / 4), "g" (n), "1" (dst), "2" (src)
+  802d20:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  802d23:	c1 e8 02             	shr    $0x2,%eax
+  802d26:	89 c1                	mov    %eax,%ecx
+    asm volatile (
+  802d28:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  802d2b:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  802d2e:	89 d7                	mov    %edx,%edi
+  802d30:	89 c6                	mov    %eax,%esi
+  802d32:	f3 a5                	rep movsl %ds:(%esi),%es:(%edi)
+  802d34:	8b 4d ec             	mov    -0x14(%ebp),%ecx
+  802d37:	83 e1 03             	and    $0x3,%ecx
+  802d3a:	74 02                	je     802d3e <memcpy+0x38>
+  802d3c:	f3 a4                	rep movsb %ds:(%esi),%es:(%edi)
+  802d3e:	89 f0                	mov    %esi,%eax
+  802d40:	89 fa                	mov    %edi,%edx
+  802d42:	89 4d e8             	mov    %ecx,-0x18(%ebp)
+  802d45:	89 55 e4             	mov    %edx,-0x1c(%ebp)
+  802d48:	89 45 e0             	mov    %eax,-0x20(%ebp)
+    return dst;
+  802d4b:	8b 45 f4             	mov    -0xc(%ebp),%eax
+    while (n -- > 0) {
+        *d ++ = *s ++;
+    }
+    return dst;
+#endif /* __HAVE_ARCH_MEMCPY */
+}
+  802d4e:	83 c4 20             	add    $0x20,%esp
+  802d51:	5e                   	pop    %esi
+  802d52:	5f                   	pop    %edi
+  802d53:	5d                   	pop    %ebp
+  802d54:	c3                   	ret
+
+00802d55 <memcmp>:
+ *   match in both memory blocks has a greater value in @v1 than in @v2
+ *   as if evaluated as unsigned char values;
+ * - And a value less than zero indicates the opposite.
+ * */
+int
+memcmp(const void *v1, const void *v2, size_t n) {
+  802d55:	55                   	push   %ebp
+  802d56:	89 e5                	mov    %esp,%ebp
+  802d58:	83 ec 10             	sub    $0x10,%esp
+    const char *s1 = (const char *)v1;
+  802d5b:	8b 45 08             	mov    0x8(%ebp),%eax
+  802d5e:	89 45 fc             	mov    %eax,-0x4(%ebp)
+    const char *s2 = (const char *)v2;
+  802d61:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802d64:	89 45 f8             	mov    %eax,-0x8(%ebp)
+    while (n -- > 0) {
+  802d67:	eb 2e                	jmp    802d97 <memcmp+0x42>
+        if (*s1 != *s2) {
+  802d69:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  802d6c:	0f b6 10             	movzbl (%eax),%edx
+  802d6f:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  802d72:	0f b6 00             	movzbl (%eax),%eax
+  802d75:	38 c2                	cmp    %al,%dl
+  802d77:	74 16                	je     802d8f <memcmp+0x3a>
+            return (int)((unsigned char)*s1 - (unsigned char)*s2);
+  802d79:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  802d7c:	0f b6 00             	movzbl (%eax),%eax
+  802d7f:	0f b6 d0             	movzbl %al,%edx
+  802d82:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  802d85:	0f b6 00             	movzbl (%eax),%eax
+  802d88:	0f b6 c0             	movzbl %al,%eax
+  802d8b:	29 c2                	sub    %eax,%edx
+  802d8d:	eb 1a                	jmp    802da9 <memcmp+0x54>
+        }
+        s1 ++, s2 ++;
+  802d8f:	83 45 fc 01          	addl   $0x1,-0x4(%ebp)
+  802d93:	83 45 f8 01          	addl   $0x1,-0x8(%ebp)
+    while (n -- > 0) {
+  802d97:	8b 45 10             	mov    0x10(%ebp),%eax
+  802d9a:	8d 50 ff             	lea    -0x1(%eax),%edx
+  802d9d:	89 55 10             	mov    %edx,0x10(%ebp)
+  802da0:	85 c0                	test   %eax,%eax
+  802da2:	75 c5                	jne    802d69 <memcmp+0x14>
+    }
+    return 0;
+  802da4:	ba 00 00 00 00       	mov    $0x0,%edx
+}
+  802da9:	89 d0                	mov    %edx,%eax
+  802dab:	c9                   	leave
+  802dac:	c3                   	ret
+
+00802dad <main>:
+#include <stdio.h>
+#include <string.h>
+#include <file.h>
+
+int main(int argc, char **argv)
+{
+  802dad:	8d 4c 24 04          	lea    0x4(%esp),%ecx
+  802db1:	83 e4 f0             	and    $0xfffffff0,%esp
+  802db4:	ff 71 fc             	push   -0x4(%ecx)
+  802db7:	55                   	push   %ebp
+  802db8:	89 e5                	mov    %esp,%ebp
+  802dba:	53                   	push   %ebx
+  802dbb:	51                   	push   %ecx
+  802dbc:	83 ec 10             	sub    $0x10,%esp
+  802dbf:	89 cb                	mov    %ecx,%ebx
+	int i, nflag = 0;
+  802dc1:	c7 45 f0 00 00 00 00 	movl   $0x0,-0x10(%ebp)
+	if (argc > 1 && strcmp(argv[1], "-n") == 0) {
+  802dc8:	83 3b 01             	cmpl   $0x1,(%ebx)
+  802dcb:	7e 2b                	jle    802df8 <main+0x4b>
+  802dcd:	8b 43 04             	mov    0x4(%ebx),%eax
+  802dd0:	83 c0 04             	add    $0x4,%eax
+  802dd3:	8b 00                	mov    (%eax),%eax
+  802dd5:	83 ec 08             	sub    $0x8,%esp
+  802dd8:	68 24 33 80 00       	push   $0x803324
+  802ddd:	50                   	push   %eax
+  802dde:	e8 e4 fb ff ff       	call   8029c7 <strcmp>
+  802de3:	83 c4 10             	add    $0x10,%esp
+  802de6:	85 c0                	test   %eax,%eax
+  802de8:	75 0e                	jne    802df8 <main+0x4b>
+		nflag = 1, argc--, argv++;
+  802dea:	c7 45 f0 01 00 00 00 	movl   $0x1,-0x10(%ebp)
+  802df1:	83 2b 01             	subl   $0x1,(%ebx)
+  802df4:	83 43 04 04          	addl   $0x4,0x4(%ebx)
+	}
+	for (i = 1; i < argc; i++) {
+  802df8:	c7 45 f4 01 00 00 00 	movl   $0x1,-0xc(%ebp)
+  802dff:	eb 5b                	jmp    802e5c <main+0xaf>
+		if (i > 1) {
+  802e01:	83 7d f4 01          	cmpl   $0x1,-0xc(%ebp)
+  802e05:	7e 14                	jle    802e1b <main+0x6e>
+			write(1, " ", 1);
+  802e07:	83 ec 04             	sub    $0x4,%esp
+  802e0a:	6a 01                	push   $0x1
+  802e0c:	68 27 33 80 00       	push   $0x803327
+  802e11:	6a 01                	push   $0x1
+  802e13:	e8 89 d3 ff ff       	call   8001a1 <write>
+  802e18:	83 c4 10             	add    $0x10,%esp
+		}
+		write(1, argv[i], strlen(argv[i]));
+  802e1b:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  802e1e:	8d 14 85 00 00 00 00 	lea    0x0(,%eax,4),%edx
+  802e25:	8b 43 04             	mov    0x4(%ebx),%eax
+  802e28:	01 d0                	add    %edx,%eax
+  802e2a:	8b 00                	mov    (%eax),%eax
+  802e2c:	83 ec 0c             	sub    $0xc,%esp
+  802e2f:	50                   	push   %eax
+  802e30:	e8 9a fa ff ff       	call   8028cf <strlen>
+  802e35:	83 c4 10             	add    $0x10,%esp
+  802e38:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  802e3b:	8d 0c 95 00 00 00 00 	lea    0x0(,%edx,4),%ecx
+  802e42:	8b 53 04             	mov    0x4(%ebx),%edx
+  802e45:	01 ca                	add    %ecx,%edx
+  802e47:	8b 12                	mov    (%edx),%edx
+  802e49:	83 ec 04             	sub    $0x4,%esp
+  802e4c:	50                   	push   %eax
+  802e4d:	52                   	push   %edx
+  802e4e:	6a 01                	push   $0x1
+  802e50:	e8 4c d3 ff ff       	call   8001a1 <write>
+  802e55:	83 c4 10             	add    $0x10,%esp
+	for (i = 1; i < argc; i++) {
+  802e58:	83 45 f4 01          	addl   $0x1,-0xc(%ebp)
+  802e5c:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  802e5f:	3b 03                	cmp    (%ebx),%eax
+  802e61:	7c 9e                	jl     802e01 <main+0x54>
+	}
+	if (!nflag) {
+  802e63:	83 7d f0 00          	cmpl   $0x0,-0x10(%ebp)
+  802e67:	75 14                	jne    802e7d <main+0xd0>
+		write(1, "\n", 1);
+  802e69:	83 ec 04             	sub    $0x4,%esp
+  802e6c:	6a 01                	push   $0x1
+  802e6e:	68 29 33 80 00       	push   $0x803329
+  802e73:	6a 01                	push   $0x1
+  802e75:	e8 27 d3 ff ff       	call   8001a1 <write>
+  802e7a:	83 c4 10             	add    $0x10,%esp
+	}
+	return 0;
+  802e7d:	b8 00 00 00 00       	mov    $0x0,%eax
+}
+  802e82:	8d 65 f8             	lea    -0x8(%ebp),%esp
+  802e85:	59                   	pop    %ecx
+  802e86:	5b                   	pop    %ebx
+  802e87:	5d                   	pop    %ebp
+  802e88:	8d 61 fc             	lea    -0x4(%ecx),%esp
+  802e8b:	c3                   	ret
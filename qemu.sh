@@ -5,33 +5,33 @@ echo "Choose the process scheduling algorithm. Type 1 to choose Complete Fair Sc
 read scheduling_choice
 if [ "$scheduling_choice" == "1" ]; then 
     echo "Complete Fair Scheduling choosed."
-    sed -i '48s/default_sched_class/cfs_sched_class/' kern/schedule/sched.c
+    sed -i 's/^\( *\)sched_class = &[a-z_]*;/\1sched_class = \&cfs_sched_class;/' kern/schedule/sched.c
 elif [ "$scheduling_choice" == "2" ]; then 
     echo "Stride Scheduling choosed"
-    sed -i '48s/cfs_sched_class/default_sched_class/' kern/schedule/sched.c
+    sed -i 's/^\( *\)sched_class = &[a-z_]*;/\1sched_class = \&default_sched_class;/' kern/schedule/sched.c
 else
     echo "Input Error, choose Complete Fair Scheduling by default."
-    sed -i '48s/default_sched_class/cfs_sched_class/' kern/schedule/sched.c
+    sed -i 's/^\( *\)sched_class = &[a-z_]*;/\1sched_class = \&cfs_sched_class;/' kern/schedule/sched.c
 fi
 
 echo "Choose the process scheduling algorithm. Type 1 to choose first-fit. Type 2 to choose best-fit. Type 3 to choose worst-fit."
 read pmm_choice
 if [ "$pmm_choice" == "1" ]; then 
     echo "first-fit choosed."
-    sed -i '380c \\t.alloc_pages = default_alloc_pages,' kern/mm/default_pmm.c
-    sed -i '383c \\t.check = default_check,' kern/mm/default_pmm.c
+    sed -i 's/^\t\.alloc_pages = .*/\t.alloc_pages = default_alloc_pages,/' kern/mm/default_pmm.c
+    sed -i 's/^\t\.check = .*/\t.check = default_check,/' kern/mm/default_pmm.c
 elif [ "$pmm_choice" == "2" ]; then 
     echo "best-fit choosed"
-    sed -i '380c \\t.alloc_pages = default_alloc_pages_best_fit,' kern/mm/default_pmm.c
-    sed -i '383c \\t.check = default_check,' kern/mm/default_pmm.c
+    sed -i 's/^\t\.alloc_pages = .*/\t.alloc_pages = default_alloc_pages_best_fit,/' kern/mm/default_pmm.c
+    sed -i 's/^\t\.check = .*/\t.check = default_check,/' kern/mm/default_pmm.c
 elif [ "$pmm_choice" == "3" ]; then 
     echo "best-fit choosed"
-    sed -i '380c \\t.alloc_pages = default_alloc_pages_worst_fit,' kern/mm/default_pmm.c
-    sed -i '383c \\t.check = default_worst_fit_checker,' kern/mm/default_pmm.c
+    sed -i 's/^\t\.alloc_pages = .*/\t.alloc_pages = default_alloc_pages_worst_fit,/' kern/mm/default_pmm.c
+    sed -i 's/^\t\.check = .*/\t.check = default_worst_fit_checker,/' kern/mm/default_pmm.c
 else
     echo "Input Error, choose first-fit by default."
-    sed -i '380c \\t.alloc_pages = default_alloc_pages,' kern/mm/default_pmm.c
-    sed -i '383c \\t.check = default_check,' kern/mm/default_pmm.c
+    sed -i 's/^\t\.alloc_pages = .*/\t.alloc_pages = default_alloc_pages,/' kern/mm/default_pmm.c
+    sed -i 's/^\t\.check = .*/\t.check = default_check,/' kern/mm/default_pmm.c
 fi
 
 echo "Choose the swap algorithm. Type 1 to choose fifo. Type 2 to choose clock. Type 3 to choose clock with dirty bit."
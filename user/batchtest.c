@@ -0,0 +1,65 @@
+#include <stdio.h>
+#include <ulib.h>
+#include <x86.h>
+#include <string.h>
+#include <file.h>
+#include <stat.h>
+#include <unistd.h>
+#include <error.h>
+#include <syscall.h>
+#include <sysbatch.h>
+
+/* batchtest - SYS_batch runs a chain of system calls with one trap: check
+ * result passing, stop-on-error and the refused calls, and compare the
+ * cost of BATCH_MAX getpid calls batched and one by one. */
+
+static struct sysbatch_entry batch[BATCH_MAX];
+
+int
+main(void) {
+    int i, pid = sys_getpid();
+
+    // results feed later arguments: open, fstat, close
+    struct stat st;
+    memset(batch, 0, sizeof(batch));
+    batch[0].num = SYS_open, batch[0].args[0] = (uint32_t)"batchtest", batch[0].args[1] = O_RDONLY;
+    batch[1].num = SYS_fstat, batch[1].args[1] = (uint32_t)&st, batch[1].arg_result = BATCH_ARG_RESULT(0);
+    batch[2].num = SYS_close, batch[2].arg_result = BATCH_ARG_RESULT(0);
+    assert(sys_batch(batch, 3, 0) == 3);
+    assert(batch[0].result >= 0 && batch[1].result == 0 && batch[2].result == 0);
+    assert(S_ISREG(st.st_mode) && st.st_size > 0);
+
+    // stop on error, forward references and refused calls
+    memset(batch, 0, sizeof(batch));
+    batch[0].num = SYS_getpid;
+    batch[1].num = SYS_close, batch[1].args[0] = 1, batch[1].arg_result = BATCH_ARG_RESULT(0);
+    batch[2].num = SYS_fork;
+    batch[3].num = SYS_getpid;
+    assert(sys_batch(batch, 4, 0) == 4);
+    assert(batch[0].result == pid && batch[1].result == -E_INVAL);
+    assert(batch[2].result == -E_INVAL && batch[3].result == pid);
+    batch[2].num = SYS_batch;
+    assert(sys_batch(batch, 4, BATCH_STOP_ON_ERROR) == 2);
+    assert(sys_batch(batch, BATCH_MAX + 1, 0) == -E_INVAL);
+
+    memset(batch, 0, sizeof(batch));
+    for (i = 0; i < BATCH_MAX; i ++) {
+        batch[i].num = SYS_getpid;
+    }
+    uint64_t start = rdtsc();
+    for (i = 0; i < BATCH_MAX; i ++) {
+        sys_getpid();
+    }
+    uint32_t single = (uint32_t)(rdtsc() - start);
+    start = rdtsc();
+    assert(sys_batch(batch, BATCH_MAX, BATCH_STOP_ON_ERROR) == BATCH_MAX);
+    uint32_t batched = (uint32_t)(rdtsc() - start);
+    for (i = 0; i < BATCH_MAX; i ++) {
+        assert(batch[i].result == pid);
+    }
+    cprintf("batchtest: %d getpid calls\n", BATCH_MAX);
+    cprintf("  one trap each : %u cycles\n", single);
+    cprintf("  one batch     : %u cycles\n", batched);
+    cprintf("batchtest pass.\n");
+    return 0;
+}
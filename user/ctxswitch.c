@@ -0,0 +1,60 @@
+#include <stdio.h>
+#include <ulib.h>
+#include <pthread.h>
+
+/* ctxswitch - compare the cost of context switches between two processes
+ * (different page directories, cr3 reloaded on every switch) with switches
+ * between two threads of one process (shared mm, cr3 reload skipped).
+ * Kernel mappings are global either way, so the process case only loses
+ * the user part of the TLB. */
+
+#define ROUNDS 20000
+
+static void
+yield_rounds(void) {
+    int i;
+    for (i = 0; i < ROUNDS; i ++) {
+        yield();
+    }
+}
+
+static void *
+thread_main(void *arg) {
+    yield_rounds();
+    return NULL;
+}
+
+static unsigned int
+bench_process(void) {
+    int pid;
+    unsigned int start = gettime_msec();
+    if ((pid = fork()) == 0) {
+        yield_rounds();
+        exit(0);
+    }
+    assert(pid > 0);
+    yield_rounds();
+    assert(waitpid(pid, NULL) == 0);
+    return gettime_msec() - start;
+}
+
+static unsigned int
+bench_thread(void) {
+    pthread_t tid;
+    unsigned int start = gettime_msec();
+    assert(pthread_create(&tid, thread_main, NULL) == 0);
+    yield_rounds();
+    pthread_join(&tid);
+    return gettime_msec() - start;
+}
+
+int
+main(void) {
+    unsigned int proc_ticks = bench_process();
+    unsigned int thread_ticks = bench_thread();
+    cprintf("ctxswitch: %d rounds of yield ping-pong\n", ROUNDS);
+    cprintf("  process <-> process: %u ticks\n", proc_ticks);
+    cprintf("  thread  <-> thread : %u ticks\n", thread_ticks);
+    cprintf("ctxswitch pass.\n");
+    return 0;
+}
@@ -0,0 +1,51 @@
+#include <stdio.h>
+#include <ulib.h>
+#include <syscall.h>
+
+/* fragtest - leave holes in physical memory and print the pmm fragmentation
+ * report, to compare first/best/worst fit. Every child pins a kernel stack,
+ * a page directory and a few page tables; the children exit in an
+ * interleaved order so the survivors split the freed space. */
+
+#define NCHILD      24
+#define CHILD_PAGES 8
+
+static void
+child(int n) {
+    static char buf[CHILD_PAGES * 4096];
+    int i;
+    for (i = 0; i < CHILD_PAGES; i ++) {
+        buf[i * 4096] = (char)n;
+    }
+    assert(buf[(CHILD_PAGES - 1) * 4096] == (char)n);
+    // odd children live longer than even ones
+    sleep((n % 2 == 0) ? 10 : 100);
+    exit(0);
+}
+
+int
+main(void) {
+    int pids[NCHILD], n;
+    cprintf("fragtest: before workload\n");
+    sys_pmm_report();
+
+    for (n = 0; n < NCHILD; n ++) {
+        if ((pids[n] = fork()) == 0) {
+            child(n);
+        }
+        assert(pids[n] > 0);
+    }
+    for (n = 0; n < NCHILD; n += 2) {
+        assert(waitpid(pids[n], NULL) == 0);
+    }
+    cprintf("fragtest: half of the children gone\n");
+    sys_pmm_report();
+
+    for (n = 1; n < NCHILD; n += 2) {
+        assert(waitpid(pids[n], NULL) == 0);
+    }
+    cprintf("fragtest: all children gone\n");
+    sys_pmm_report();
+    cprintf("fragtest pass.\n");
+    return 0;
+}
@@ -0,0 +1,47 @@
+#include <stdio.h>
+#include <ulib.h>
+#include <pthread.h>
+#include <lock.h>
+
+/* futextest - threads hammer one futex-backed lock_t, yielding while they
+ * hold it so the others really contend and have to sleep in SYS_futex. */
+
+#define NR_THREADS  6
+#define ROUNDS      2000
+
+static lock_t counter_lock = INIT_LOCK;
+static volatile int counter;
+static pthread_t threads[NR_THREADS];
+
+static void *
+thread_main(void *arg) {
+    int i;
+    for (i = 0; i < ROUNDS; i ++) {
+        lock(&counter_lock);
+        int c = counter;
+        if (i % 64 == 0) {
+            yield();
+        }
+        counter = c + 1;
+        unlock(&counter_lock);
+    }
+    return NULL;
+}
+
+int
+main(void) {
+    int i;
+    unsigned int start = gettime_msec();
+    for (i = 0; i < NR_THREADS; i ++) {
+        assert(pthread_create(&threads[i], thread_main, NULL) == 0);
+    }
+    for (i = 0; i < NR_THREADS; i ++) {
+        pthread_join(&threads[i]);
+    }
+    assert(counter == NR_THREADS * ROUNDS);
+    assert(!try_lock(&counter_lock));
+    unlock(&counter_lock);
+    cprintf("futextest: %d locked increments in %d ticks\n", counter, gettime_msec() - start);
+    cprintf("futextest pass.\n");
+    return 0;
+}
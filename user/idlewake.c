@@ -0,0 +1,35 @@
+#include <stdio.h>
+#include <ulib.h>
+#include <time.h>
+
+/* idlewake - with nothing else runnable the CPU halts and the tick is
+ * stopped; a sleeper woken by the clock interrupt must run right away, not
+ * at the next tick. Sleeps repeatedly from an idle system and fails if the
+ * worst wakeup is a millisecond late. */
+
+#define ROUNDS          50
+#define MAX_LATE_US     1000
+
+static const uint32_t sleeps_us[] = {100, 700, 3000};
+
+int
+main(void) {
+    int i, j;
+    for (i = 0; i < sizeof(sleeps_us) / sizeof(sleeps_us[0]); i ++) {
+        struct timespec req = {0, sleeps_us[i] * NSEC_PER_USEC};
+        uint32_t worst = 0;
+        for (j = 0; j < ROUNDS; j ++) {
+            uint64_t start = gettime_nsec();
+            assert(nanosleep(&req) == 0);
+            uint32_t slept = (uint32_t)(gettime_nsec() - start);
+            assert(slept >= req.tv_nsec);
+            if (slept - req.tv_nsec > worst) {
+                worst = slept - req.tv_nsec;
+            }
+        }
+        cprintf("idlewake: %4u us sleeps, worst wakeup %u us late\n", sleeps_us[i], worst / NSEC_PER_USEC);
+        assert(worst < MAX_LATE_US * NSEC_PER_USEC);
+    }
+    cprintf("idlewake pass.\n");
+    return 0;
+}
@@ -0,0 +1,346 @@
+#include <stdio.h>
+#include <ulib.h>
+#include <string.h>
+#include <file.h>
+#include <unistd.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <syscall.h>
+#include <elf.h>
+#include <stab.h>
+#include <kprof.h>
+
+/* kprof - sample a program with the kernel's sampling profiler and print a
+ * flat profile of where the samples hit. With -o the call chains also go to
+ * a file as folded stacks ("prog;main;f;g count", kernel frames end in
+ * _[k]) for flamegraph.pl. Kernel pcs are resolved by the kernel, user pcs
+ * from the stabs of the program file, found the way tools/user.ld lays
+ * them out. */
+
+#define USTAB           0x200000        // struct userstabdata in every program, see tools/user.ld
+#define MAX_STACKS      1024            // distinct call chains kept
+#define MAX_IMAGES      8               // program files with their symbols loaded
+#define MAX_FLAT        256
+#define SYM_LEN         48
+
+struct stack {
+    uint32_t count;
+    struct kprof_sample s;              // depth, kdepth, name and pcs; pid is ignored
+};
+
+struct func {
+    uintptr_t addr;
+    const char *name;
+};
+
+struct image {
+    char name[KPROF_NAME_LEN + 1];
+    struct func *funcs;                 // sorted by addr, NULL if the file has no symbols
+    int nfuncs;
+};
+
+struct flat {
+    char sym[SYM_LEN];
+    uint32_t count;
+};
+
+static struct stack stacks[MAX_STACKS];
+static int nstacks;
+static uint32_t nsamples, nother;
+static struct image images[MAX_IMAGES];
+static int nimages;
+static struct flat flat[MAX_FLAT];
+static int nflat;
+
+static struct kprof_sample rbuf[256];
+static volatile int done;
+
+// add_sample - count s with the identical chains seen so far
+static void
+add_sample(struct kprof_sample *s) {
+    uint32_t h = s->depth;
+    int i, j;
+    for (i = 0; i < s->depth; i ++) {
+        h = h * 31 + s->pc[i];
+    }
+    nsamples ++;
+    for (i = h % MAX_STACKS, j = 0; j < MAX_STACKS; i = (i + 1) % MAX_STACKS, j ++) {
+        struct stack *st = &stacks[i];
+        if (st->count == 0) {
+            st->s = *s;
+            st->count = 1;
+            nstacks ++;
+            return;
+        }
+        if (st->s.depth == s->depth && st->s.kdepth == s->kdepth && strcmp(st->s.name, s->name) == 0
+            && memcmp(st->s.pc, s->pc, s->depth * sizeof(uintptr_t)) == 0) {
+            st->count ++;
+            return;
+        }
+    }
+    nother ++;
+}
+
+// drain - thread moving samples out of the kernel ring while the program runs
+static void *
+drain(void *arg) {
+    int i, n;
+    while (1) {
+        if ((n = sys_kprof(KPROF_READ, 0, rbuf, sizeof(rbuf) / sizeof(rbuf[0]))) > 0) {
+            for (i = 0; i < n; i ++) {
+                add_sample(&rbuf[i]);
+            }
+        }
+        else if (done) {
+            break;
+        }
+        else {
+            sleep(1);
+        }
+    }
+    return NULL;
+}
+
+static int
+read_at(int fd, off_t off, void *buf, size_t len) {
+    if (seek(fd, off, LSEEK_SET) != 0 || read(fd, buf, len) != len) {
+        return -1;
+    }
+    return 0;
+}
+
+// read_va - read len bytes the program loads at va
+static int
+read_va(int fd, struct proghdr *ph, int phnum, uintptr_t va, void *buf, size_t len) {
+    int i;
+    for (i = 0; i < phnum; i ++) {
+        if (ph[i].p_type == ELF_PT_LOAD && ph[i].p_va <= va && va + len <= ph[i].p_va + ph[i].p_filesz) {
+            return read_at(fd, ph[i].p_offset + va - ph[i].p_va, buf, len);
+        }
+    }
+    return -1;
+}
+
+// load_funcs - collect the N_FUN stabs of the program file fd
+static void
+load_funcs(struct image *img, int fd) {
+    struct elfhdr eh;
+    struct proghdr ph[8];
+    struct { uintptr_t stabs, stab_end, stabstr, stabstr_end; } usd;
+    if (read_at(fd, 0, &eh, sizeof(eh)) != 0 || eh.e_magic != ELF_MAGIC || eh.e_phnum > 8
+        || read_at(fd, eh.e_phoff, ph, eh.e_phnum * sizeof(struct proghdr)) != 0
+        || read_va(fd, ph, eh.e_phnum, USTAB, &usd, sizeof(usd)) != 0) {
+        return;
+    }
+    int i, j, nstabs = (usd.stab_end - usd.stabs) / sizeof(struct stab);
+    size_t strsize = usd.stabstr_end - usd.stabstr;
+    struct stab *stabs = malloc(nstabs * sizeof(struct stab));
+    char *strs = malloc(strsize);
+    struct func *funcs = malloc(nstabs * sizeof(struct func));
+    if (stabs == NULL || strs == NULL || funcs == NULL
+        || read_va(fd, ph, eh.e_phnum, usd.stabs, stabs, nstabs * sizeof(struct stab)) != 0
+        || read_va(fd, ph, eh.e_phnum, usd.stabstr, strs, strsize) != 0) {
+        goto out;
+    }
+
+    int n = 0;
+    for (i = 0; i < nstabs; i ++) {
+        if (stabs[i].n_type == N_FUN && stabs[i].n_strx != 0 && stabs[i].n_strx < strsize) {
+            char *name = strs + stabs[i].n_strx, *colon = strchr(name, ':');
+            if (colon != NULL) {
+                *colon = '\0';
+            }
+            funcs[n].addr = stabs[i].n_value, funcs[n].name = name;
+            n ++;
+        }
+    }
+    // mostly in order already
+    for (i = 1; i < n; i ++) {
+        struct func f = funcs[i];
+        for (j = i; j > 0 && funcs[j - 1].addr > f.addr; j --) {
+            funcs[j] = funcs[j - 1];
+        }
+        funcs[j] = f;
+    }
+    img->funcs = funcs, img->nfuncs = n;
+    funcs = NULL;
+
+out:
+    // on success the names stay in strs
+    if (funcs != NULL) {
+        free(funcs);
+    }
+    if (strs != NULL && img->funcs == NULL) {
+        free(strs);
+    }
+    if (stabs != NULL) {
+        free(stabs);
+    }
+}
+
+static struct image *
+get_image(const char *name) {
+    int i, fd;
+    for (i = 0; i < nimages; i ++) {
+        if (strcmp(images[i].name, name) == 0) {
+            return &images[i];
+        }
+    }
+    if (nimages == MAX_IMAGES) {
+        return NULL;
+    }
+    struct image *img = &images[nimages ++];
+    strcpy(img->name, name);
+    img->funcs = NULL, img->nfuncs = 0;
+    if ((fd = open(name, O_RDONLY)) >= 0) {
+        load_funcs(img, fd);
+        close(fd);
+    }
+    return img;
+}
+
+// symbolize - name the function holding pc into sym
+static void
+symbolize(struct kprof_sample *s, int i, char *sym) {
+    // callers' pcs are return addresses, look up the call instruction
+    uintptr_t pc = (i == 0) ? s->pc[i] : s->pc[i] - 1;
+    if (i < s->kdepth) {
+        char name[SYM_LEN - 4];
+        if (sys_kprof(KPROF_SYMBOL, pc, name, sizeof(name)) >= 0) {
+            snprintf(sym, SYM_LEN, "%s_[k]", name);
+        }
+        else {
+            snprintf(sym, SYM_LEN, "0x%08x_[k]", pc);
+        }
+        return;
+    }
+    struct image *img = get_image(s->name);
+    if (img != NULL && img->nfuncs != 0 && pc >= img->funcs[0].addr) {
+        int lo = 0, hi = img->nfuncs - 1;
+        while (lo < hi) {
+            int mid = (lo + hi + 1) / 2;
+            if (img->funcs[mid].addr <= pc) {
+                lo = mid;
+            }
+            else {
+                hi = mid - 1;
+            }
+        }
+        snprintf(sym, SYM_LEN, "%s", img->funcs[lo].name);
+        return;
+    }
+    snprintf(sym, SYM_LEN, "0x%08x", pc);
+}
+
+static void
+add_flat(const char *sym, uint32_t count) {
+    int i;
+    for (i = 0; i < nflat; i ++) {
+        if (strcmp(flat[i].sym, sym) == 0) {
+            flat[i].count += count;
+            return;
+        }
+    }
+    if (nflat < MAX_FLAT) {
+        strcpy(flat[nflat].sym, sym);
+        flat[nflat ++].count = count;
+    }
+}
+
+// write_folded - one line per chain, root first
+static void
+write_folded(int fd, struct stack *st) {
+    static char line[KPROF_DEPTH * SYM_LEN + 64];
+    char sym[SYM_LEN];
+    int i, len = snprintf(line, sizeof(line), "%s", st->s.name);
+    for (i = st->s.depth - 1; i >= 0; i --) {
+        symbolize(&(st->s), i, sym);
+        len += snprintf(line + len, sizeof(line) - len, ";%s", sym);
+    }
+    len += snprintf(line + len, sizeof(line) - len, " %u\n", st->count);
+    write(fd, line, len);
+}
+
+static void
+usage(void) {
+    cprintf("usage: kprof [-p usecs] [-o folded-file] program [args ...]\n");
+    exit(-1);
+}
+
+int
+main(int argc, char **argv) {
+    int i, j, ret, period = 0, out = -1;
+    for (i = 1; i < argc && argv[i][0] == '-'; i ++) {
+        if (i + 1 == argc) {
+            usage();
+        }
+        if (strcmp(argv[i], "-p") == 0) {
+            period = str_to_int(argv[++ i]);
+        }
+        else if (strcmp(argv[i], "-o") == 0) {
+            if ((out = open(argv[++ i], O_WRONLY | O_CREAT | O_TRUNC)) < 0) {
+                cprintf("kprof: cannot create %s: %e\n", argv[i], out);
+                return out;
+            }
+        }
+        else {
+            usage();
+        }
+    }
+    if (i == argc) {
+        usage();
+    }
+    const char **prog = (const char **)argv + i;
+
+    if ((ret = sys_kprof(KPROF_START, period, NULL, 0)) != 0) {
+        cprintf("kprof: cannot start sampling: %e\n", ret);
+        return ret;
+    }
+    pthread_t drainer;
+    assert(pthread_create(&drainer, drain, NULL) == 0);
+    int pid, code;
+    if ((pid = fork()) == 0) {
+        ret = __exec(prog[0], prog);
+        cprintf("kprof: exec %s failed: %e\n", prog[0], ret);
+        exit(ret);
+    }
+    assert(pid > 0 && waitpid(pid, &code) == 0);
+    uint32_t lost = sys_kprof(KPROF_STOP, 0, NULL, 0);
+    done = 1;
+    pthread_join(&drainer);
+
+    // flat profile by the function each sample hit
+    char sym[SYM_LEN];
+    for (i = 0; i < MAX_STACKS; i ++) {
+        if (stacks[i].count != 0) {
+            symbolize(&(stacks[i].s), 0, sym);
+            add_flat(sym, stacks[i].count);
+        }
+    }
+    for (i = 1; i < nflat; i ++) {
+        struct flat f = flat[i];
+        for (j = i; j > 0 && flat[j - 1].count < f.count; j --) {
+            flat[j] = flat[j - 1];
+        }
+        flat[j] = f;
+    }
+
+    cprintf("%s exited with %d: %u samples, %u dropped, %u chains not kept\n",
+            prog[0], code, nsamples, lost, nother);
+    cprintf(" samples      %%  function\n");
+    for (i = 0; i < nflat; i ++) {
+        uint32_t share = nsamples != 0 ? flat[i].count * 1000 / nsamples : 0;
+        cprintf("%8u  %3u.%u  %s\n", flat[i].count, share / 10, share % 10, flat[i].sym);
+    }
+
+    if (out >= 0) {
+        for (i = 0; i < MAX_STACKS; i ++) {
+            if (stacks[i].count != 0) {
+                write_folded(out, &stacks[i]);
+            }
+        }
+        close(out);
+        cprintf("kprof: %d folded stacks written\n", nstacks);
+    }
+    return 0;
+}
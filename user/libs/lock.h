@@ -3,40 +3,49 @@
 
 #include <defs.h>
 #include <atomic.h>
-#include <ulib.h>
-
+#include <unistd.h>
+#include <syscall.h>
+
+/* *
+ * lock_t is a futex-backed mutex: 0 free, 1 held, 2 held and somebody may be
+ * sleeping in the kernel on it. Taking or releasing an uncontended lock is a
+ * single atomic instruction; only contention costs a SYS_futex.
+ * */
 #define INIT_LOCK           {0}
 
-typedef volatile bool lock_t;
+typedef volatile int lock_t;
 
 static inline void
 lock_init(lock_t *l) {
     *l = 0;
 }
 
+// try_lock - take the lock if it is free, return true if it was already held
 static inline bool
 try_lock(lock_t *l) {
-    return test_and_set_bit(0, l);
+    return cmpxchg(l, 0, 1) != 0;
 }
 
 static inline void
 lock(lock_t *l) {
-    if (try_lock(l)) {
-        int step = 0;
-        do {
-            yield();
-            if (++ step == 100) {
-                step = 0;
-                sleep(10);
-            }
-        } while (try_lock(l));
+    int c;
+    if ((c = cmpxchg(l, 0, 1)) != 0) {
+        // mark the lock contended, then sleep until the holder hands it over
+        if (c != 2) {
+            c = xchg(l, 2);
+        }
+        while (c != 0) {
+            sys_futex(l, FUTEX_WAIT, 2);
+            c = xchg(l, 2);
+        }
     }
 }
 
 static inline void
 unlock(lock_t *l) {
-    test_and_clear_bit(0, l);
+    if (xchg(l, 0) == 2) {
+        sys_futex(l, FUTEX_WAKE, 1);
+    }
 }
 
 #endif /* !__USER_LIBS_LOCK_H__ */
-
@@ -4,10 +4,20 @@
 #include <string.h>
 #include <stdio.h>
 #include <ulib.h>
+#include <atomic.h>
+#include <error.h>
+
+// bit i set: TLS slot i is handed out
+static volatile uint32_t tls_keys[(TLS_NSLOTS + 31) / 32];
 
 int pthread_create(pthread_t *newthread, void *(*fn)(void *), void *arg)
 {
-  return sys_clone(newthread, fn, arg, pthread_exit);
+  return sys_clone(newthread, fn, arg, pthread_exit, 0);
+}
+
+int pthread_create_stack(pthread_t *newthread, void *(*fn)(void *), void *arg, size_t stacksize)
+{
+  return sys_clone(newthread, fn, arg, pthread_exit, stacksize);
 }
 
 int pthread_join(pthread_t *newthread)
@@ -22,4 +32,22 @@ void pthread_exit(int error_code)
 
 void phtread_daemon(){
   waitpid(-1, NULL);
-}
\ No newline at end of file
+}
+
+int pthread_key_create(pthread_key_t *key)
+{
+  int i;
+  for (i = 0; i < TLS_NSLOTS; i++)
+    if (!test_and_set_bit(i, tls_keys))
+    {
+      *key = i;
+      return 0;
+    }
+  return -E_NO_MEM;
+}
+
+void pthread_key_delete(pthread_key_t key)
+{
+  if (0 <= key && key < TLS_NSLOTS)
+    clear_bit(key, tls_keys);
+}
@@ -2,8 +2,10 @@
 #define __USER_LIBS_THREAD_H__
 
 #include <defs.h>
+#include <tls.h>
 
 typedef int pthread_t;
+typedef int pthread_key_t;
 
 void pthread_exit(int error_code);
 
@@ -16,8 +18,38 @@ void pthread_exit(int error_code);
 //  of *thread are undefined.
 int pthread_create(pthread_t *newthread, void *(*fn)(void *), void *arg);
 
+// Same as pthread_create with a stack of STACKSIZE bytes instead of the
+// default; the stack is only backed by memory as the thread touches it.
+int pthread_create_stack(pthread_t *newthread, void *(*fn)(void *), void *arg, size_t stacksize);
+
 int pthread_join(pthread_t *newthread);
 
 void phtread_daemon();
 
+// Thread-local storage. Each thread has TLS_NSLOTS pointer slots in its TLS
+// block, reached through %gs without a syscall or a lock; a key names the
+// same slot in every thread. Slots start out NULL.
+int pthread_key_create(pthread_key_t *key);
+void pthread_key_delete(pthread_key_t key);
+
+static inline void *
+pthread_getspecific(pthread_key_t key) {
+  void *value;
+  asm volatile ("movl %%gs:(%1), %0" : "=r" (value) : "r" (TLS_SLOT0 + key * 4));
+  return value;
+}
+
+static inline void
+pthread_setspecific(pthread_key_t key, const void *value) {
+  asm volatile ("movl %0, %%gs:(%1)" :: "r" (value), "r" (TLS_SLOT0 + key * 4) : "memory");
+}
+
+// linear address of the calling thread's TLS block
+static inline void *
+pthread_tls(void) {
+  void *self;
+  asm volatile ("movl %%gs:%c1, %0" : "=r" (self) : "i" (TLS_SELF));
+  return self;
+}
+
 #endif /* !__USER_LIBS_THREAD_H__ */
\ No newline at end of file
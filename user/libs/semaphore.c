@@ -2,21 +2,55 @@
 #include <string.h>
 #include <stdio.h>
 #include <ulib.h>
+#include <atomic.h>
+#include <unistd.h>
+#include <error.h>
+#include <syscall.h>
 #include <semaphore.h>
 
 int sem_init(semaphore_t *sem, int value)
 {
-  return sys_sem(sem, &value, 0);
+  if (value < 0)
+    return -E_INVAL;
+  sem->value = value;
+  sem->waiters = 0;
+  return 0;
 }
-int sem_post(semaphore_t *sem)
+
+int sem_trywait(semaphore_t *sem)
 {
-  return sys_sem(sem, NULL, 1);
+  int v;
+  while ((v = sem->value) > 0)
+    if (cmpxchg(&sem->value, v, v - 1) == v)
+      return 0;
+  return -E_AGAIN;
 }
+
 int sem_wait(semaphore_t *sem)
 {
-  return sys_sem(sem, NULL, 2);
+  while (sem_trywait(sem) != 0)
+  {
+    // announce ourselves before sleeping; FUTEX_WAIT rechecks value == 0
+    // in the kernel, so a post that slips in between is never lost
+    xadd(&sem->waiters, 1);
+    int ret = sys_futex(&sem->value, FUTEX_WAIT, 0);
+    xadd(&sem->waiters, -1);
+    if (ret == -E_KILLED)
+      return ret;
+  }
+  return 0;
 }
+
+int sem_post(semaphore_t *sem)
+{
+  xadd(&sem->value, 1);
+  if (sem->waiters > 0)
+    sys_futex(&sem->value, FUTEX_WAKE, 1);
+  return 0;
+}
+
 int sem_getvalue(semaphore_t *sem, int *value)
 {
-  return sys_sem(sem, value, 3);
-}
\ No newline at end of file
+  *value = sem->value;
+  return 0;
+}
@@ -1,28 +1,22 @@
 #ifndef __USER_LIBS_SEMAPHORE_H__
 #define __USER_LIBS_SEMAPHORE_H__
 
-struct list_entry
-{
-    struct list_entry *prev, *next;
-};
-
-typedef struct list_entry list_entry_t;
-
-typedef struct
-{
-    list_entry_t wait_head;
-} wait_queue_t;
+#include <defs.h>
 
+// The count lives in user memory and is only changed with atomic
+// instructions, so sem_wait/sem_post never enter the kernel unless a
+// thread actually has to sleep. Sleepers wait in the kernel's futex queue
+// keyed by the address of value.
 typedef struct
 {
-    int value;
-    wait_queue_t wait_queue;
+    volatile int value;   // available units
+    volatile int waiters; // threads sleeping (or about to) in sem_wait
 } semaphore_t;
 
-
 int sem_init(semaphore_t *sem, int value);
 int sem_wait(semaphore_t *sem);
+int sem_trywait(semaphore_t *sem);
 int sem_post(semaphore_t *sem);
 int sem_getvalue(semaphore_t *sem, int *value);
 
-#endif /* !__USER_LIBS_SEMAPHORE_H__ */
\ No newline at end of file
+#endif /* !__USER_LIBS_SEMAPHORE_H__ */
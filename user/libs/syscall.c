@@ -4,10 +4,40 @@
 #include <syscall.h>
 #include <stat.h>
 #include <dirent.h>
+#include <x86.h>
 
 
 #define MAX_ARGS            5
 
+#define CPUID_FEAT_SEP      0x00000800
+
+int __sysenter_call(int num, uint32_t *args);
+
+// -1 until the first syscall probes CPUID, then whether sysenter is used
+static int use_sysenter = -1;
+
+/* sysenter_supported - same test the kernel makes before it sets up the MSRs */
+static bool
+sysenter_supported(void) {
+    uint32_t eax, edx;
+    cpuid(1, &eax, NULL, NULL, &edx);
+    if (!(edx & CPUID_FEAT_SEP)) {
+        return 0;
+    }
+    uint32_t family = (eax >> 8) & 0xF, model = (eax >> 4) & 0xF, stepping = eax & 0xF;
+    return !(family == 6 && model < 3 && stepping < 3);
+}
+
+/* *
+ * syscall_set_sysenter - choose between sysenter and int 0x80; sysenter is
+ * only used where the CPU supports it. Returns whether it is in use now.
+ * */
+int
+syscall_set_sysenter(int on) {
+    use_sysenter = (on && sysenter_supported());
+    return use_sysenter;
+}
+
 static inline int
 syscall(int num, ...) {
     va_list ap;
@@ -19,6 +49,13 @@ syscall(int num, ...) {
     }
     va_end(ap);
 
+    if (use_sysenter < 0) {
+        use_sysenter = sysenter_supported();
+    }
+    if (use_sysenter) {
+        return __sysenter_call(num, a);
+    }
+
     asm volatile (
         "int %1;"
         : "=a" (ret)
@@ -168,14 +205,9 @@ int sys_get_pdb(void *base)
     return syscall(SYS_get_pdb, base);
 }
 
-int sys_clone(int *thread_id, void *(*fn)(void *), void *arg, void (*exit)(int))
-{
-    return syscall(SYS_clone, thread_id, fn, arg, exit);
-}
-
-int sys_sem(semaphore_t *sem, int *value, int type)
+int sys_clone(int *thread_id, void *(*fn)(void *), void *arg, void (*exit)(int), size_t stack_size)
 {
-    return syscall(SYS_sem, sem, value, type);
+    return syscall(SYS_clone, thread_id, fn, arg, exit, stack_size);
 }
 
 int sys_nice(int pid, int prior)
@@ -208,4 +240,44 @@ void sys_check_swap()
 int sys_fifo_check_swap()
 {
 	return syscall(SYS_fifo_check_swap);
+}
+
+void sys_pmm_report()
+{
+	syscall(SYS_pmm_report);
+}
+
+int
+sys_futex(volatile int *uaddr, int op, int val) {
+    return syscall(SYS_futex, uaddr, op, val);
+}
+
+int
+sys_nanosleep(const struct timespec *req) {
+    return syscall(SYS_nanosleep, req);
+}
+
+int
+sys_batch(struct sysbatch_entry *entries, int n, uint32_t flags) {
+    return syscall(SYS_batch, entries, n, flags);
+}
+
+int
+sys_uring_setup(struct uring **ring_store) {
+    return syscall(SYS_uring_setup, ring_store);
+}
+
+int
+sys_uring_enter(int min_complete) {
+    return syscall(SYS_uring_enter, min_complete);
+}
+
+int
+sys_sysprof(int op, uint32_t arg, struct sysprof_stat *buf, int n) {
+    return syscall(SYS_sysprof, op, arg, buf, n);
+}
+
+int
+sys_kprof(int op, uint32_t arg, void *buf, int n) {
+    return syscall(SYS_kprof, op, arg, buf, n);
 }
\ No newline at end of file
@@ -5,6 +5,11 @@
 #include <stat.h>
 #include <string.h>
 #include <lock.h>
+#include <tls.h>
+#include <vdso.h>
+#include <time.h>
+#include <error.h>
+#include <x86.h>
 
 static lock_t fork_lock = INIT_LOCK;
 
@@ -50,9 +55,12 @@ kill(int pid) {
     return sys_kill(pid);
 }
 
+// the kernel keeps the pid in the TLS block, no system call needed
 int
 getpid(void) {
-    return sys_getpid();
+    int pid;
+    asm volatile ("movl %%gs:%c1, %0" : "=r" (pid) : "i" (TLS_PID));
+    return pid;
 }
 
 //print_pgdir - print the PDT&PT
@@ -68,7 +76,40 @@ sleep(unsigned int time) {
 
 unsigned int
 gettime_msec(void) {
-    return (unsigned int)sys_gettime();
+    // the timer interrupt publishes ticks in the vdso page
+    return vdso_data_page()->ticks;
+}
+
+// gettime_nsec - nanoseconds since boot, read from the vdso page and the TSC
+uint64_t
+gettime_nsec(void) {
+    const struct vdso_data *vd = vdso_data_page();
+    uint32_t seq;
+    uint64_t ns;
+    do {
+        seq = vdso_read_begin(vd);
+        ns = vd->ns_stamp;
+        if (vd->ns_mult != 0) {
+            ns += ((rdtsc() - vd->tsc_stamp) * vd->ns_mult) >> VDSO_NS_SHIFT;
+        }
+    } while (vdso_read_retry(vd, seq));
+    return ns;
+}
+
+int
+clock_gettime(int clock_id, struct timespec *ts) {
+    if (clock_id != CLOCK_MONOTONIC) {
+        return -E_INVAL;
+    }
+    uint64_t ns = gettime_nsec();
+    ts->tv_nsec = do_div(ns, NSEC_PER_SEC);
+    ts->tv_sec = (int32_t)ns;
+    return 0;
+}
+
+int
+nanosleep(const struct timespec *req) {
+    return sys_nanosleep(req);
 }
 
 int str_to_int(char *str)
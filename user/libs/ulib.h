@@ -36,6 +36,11 @@ void print_pgdir(void);
 int sleep(unsigned int time);
 int str_to_int(char *str);
 unsigned int gettime_msec(void);
+
+struct timespec;
+uint64_t gettime_nsec(void);
+int clock_gettime(int clock_id, struct timespec *ts);
+int nanosleep(const struct timespec *req);
 int __exec(const char *name, const char **argv);
 
 #define __exec0(name, path, ...)                \
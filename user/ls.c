@@ -6,6 +6,8 @@
 #include <stat.h>
 #include <dirent.h>
 #include <unistd.h>
+#include <syscall.h>
+#include <sysbatch.h>
 
 #define printf(...)                     fprintf(1, __VA_ARGS__)
 #define BUFSIZE                         4096
@@ -21,15 +23,26 @@ getmode(uint32_t st_mode) {
     return mode;
 }
 
+// getstat - open, fstat and close in one SYS_batch, the fd passed along by the kernel
 static int
 getstat(const char *name, struct stat *stat) {
-    int fd, ret;
-    if ((fd = open(name, O_RDONLY)) < 0) {
-        return fd;
+    struct sysbatch_entry batch[3] = {
+        {.num = SYS_open, .args = {(uint32_t)name, O_RDONLY}},
+        {.num = SYS_fstat, .args = {0, (uint32_t)stat}, .arg_result = BATCH_ARG_RESULT(0)},
+        {.num = SYS_close, .args = {0}, .arg_result = BATCH_ARG_RESULT(0)},
+    };
+    int ret;
+    if ((ret = sys_batch(batch, 3, BATCH_STOP_ON_ERROR)) < 0) {
+        return ret;
     }
-    ret = fstat(fd, stat);
-    close(fd);
-    return ret;
+    if (batch[0].result < 0) {
+        return batch[0].result;
+    }
+    if (batch[1].result < 0) {
+        // stopped before the close
+        close(batch[0].result);
+    }
+    return batch[1].result;
 }
 
 void
@@ -0,0 +1,40 @@
+#include <stdio.h>
+#include <ulib.h>
+#include <time.h>
+
+/* nanosleep - clock_gettime is monotonic, and nanosleep wakes no earlier
+ * than asked and no later than MAX_LATE_US after, also for deadlines well
+ * below the 10ms timer tick. Prints how late each wakeup was. */
+
+#define MAX_LATE_US     2000            // a wakeup at the next tick is a failure
+
+static const uint32_t sleeps_us[] = {50, 200, 1000, 2500, 10000, 25000};
+
+int
+main(void) {
+    struct timespec a, b;
+    int i;
+
+    assert(clock_gettime(CLOCK_MONOTONIC, &a) == 0);
+    for (i = 0; i < 10000; i ++) {
+        assert(clock_gettime(CLOCK_MONOTONIC, &b) == 0);
+        assert(b.tv_sec > a.tv_sec || (b.tv_sec == a.tv_sec && b.tv_nsec >= a.tv_nsec));
+        a = b;
+    }
+    assert(clock_gettime(0, &a) != 0);
+
+    for (i = 0; i < sizeof(sleeps_us) / sizeof(sleeps_us[0]); i ++) {
+        struct timespec req = {0, sleeps_us[i] * NSEC_PER_USEC};
+        uint64_t start = gettime_nsec();
+        assert(nanosleep(&req) == 0);
+        uint32_t slept = (uint32_t)(gettime_nsec() - start);
+        assert(slept >= req.tv_nsec);
+        assert(slept - req.tv_nsec < MAX_LATE_US * NSEC_PER_USEC);
+        cprintf("nanosleep: %6u us asked, woke %u us late\n", sleeps_us[i], (slept - req.tv_nsec) / NSEC_PER_USEC);
+    }
+
+    struct timespec bad = {0, NSEC_PER_SEC};
+    assert(nanosleep(&bad) != 0);
+    cprintf("nanosleep pass.\n");
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include <stdio.h>
+#include <ulib.h>
+#include <pthread.h>
+#include <semaphore.h>
+
+/* semtest - uncontended sem_wait/sem_post stay in user space; a bounded
+ * buffer between one producer and one consumer exercises the sleeping
+ * path through SYS_futex. */
+
+#define FAST_ROUNDS 100000
+#define NR_ITEMS    5000
+#define BUF_SIZE    8
+
+static semaphore_t empty, full, fast;
+static int buffer[BUF_SIZE];
+static pthread_t produ, consu;
+static volatile int consumed_sum;
+
+static void *
+producer(void *arg) {
+    int i;
+    for (i = 1; i <= NR_ITEMS; i ++) {
+        sem_wait(&empty);
+        buffer[i % BUF_SIZE] = i;
+        sem_post(&full);
+    }
+    return NULL;
+}
+
+static void *
+consumer(void *arg) {
+    int i, sum = 0;
+    for (i = 1; i <= NR_ITEMS; i ++) {
+        sem_wait(&full);
+        sum += buffer[i % BUF_SIZE];
+        sem_post(&empty);
+    }
+    consumed_sum = sum;
+    return NULL;
+}
+
+int
+main(void) {
+    int i, value;
+    unsigned int start = gettime_msec();
+    sem_init(&fast, 1);
+    for (i = 0; i < FAST_ROUNDS; i ++) {
+        sem_wait(&fast);
+        sem_post(&fast);
+    }
+    assert(sem_getvalue(&fast, &value) == 0 && value == 1);
+    cprintf("semtest: %d uncontended P/V pairs in %d ticks\n", FAST_ROUNDS, gettime_msec() - start);
+
+    start = gettime_msec();
+    sem_init(&empty, BUF_SIZE);
+    sem_init(&full, 0);
+    assert(pthread_create(&produ, producer, NULL) == 0);
+    assert(pthread_create(&consu, consumer, NULL) == 0);
+    pthread_join(&produ);
+    pthread_join(&consu);
+    assert(consumed_sum == NR_ITEMS * (NR_ITEMS + 1) / 2);
+    assert(sem_trywait(&full) != 0);
+    cprintf("semtest: %d items through the bounded buffer in %d ticks\n", NR_ITEMS, gettime_msec() - start);
+    cprintf("semtest pass.\n");
+    return 0;
+}
@@ -0,0 +1,38 @@
+#include <stdio.h>
+#include <string.h>
+#include <ulib.h>
+#include <dir.h>
+
+/* stackgrow - the main stack starts as a single page and grows on demand.
+ * Hand a syscall a buffer below anything touched so far, so the kernel has
+ * to grow the stack for it, then recurse through a few MB of frames (well
+ * past the old fixed 1MB stack). */
+
+#define FRAME_SIZE  4096
+#define DEPTH       1024
+
+static int
+recurse(int depth) {
+    unsigned char frame[FRAME_SIZE];
+    memset(frame, depth & 0xff, sizeof(frame));
+    if (depth == 0) {
+        return 0;
+    }
+    return recurse(depth - 1) + (frame[FRAME_SIZE - 1] == (depth & 0xff));
+}
+
+static void
+untouched_buffer(void) {
+    char buf[3 * 4096];
+    assert(getcwd(buf, sizeof(buf)) == 0);
+    assert(buf[0] != '\0');
+}
+
+int
+main(void) {
+    untouched_buffer();
+    assert(recurse(DEPTH) == DEPTH);
+    cprintf("stackgrow: %d KB of stack frames\n", DEPTH * FRAME_SIZE / 1024);
+    cprintf("stackgrow pass.\n");
+    return 0;
+}
@@ -0,0 +1,182 @@
+#include <stdio.h>
+#include <ulib.h>
+#include <x86.h>
+#include <string.h>
+#include <unistd.h>
+#include <syscall.h>
+#include <sysprof.h>
+#include <vdso.h>
+
+/* strace - count the system calls of a program and time them, like
+ * strace -c: start a SYSPROF_CHILDREN profile, run the program in a child
+ * and print the counts collected when it exits. -h adds the latency
+ * histogram of every call. */
+
+static const char *syscall_names[] = {
+    [SYS_exit]          "exit",
+    [SYS_fork]          "fork",
+    [SYS_wait]          "wait",
+    [SYS_exec]          "exec",
+    [SYS_clone]         "clone",
+    [SYS_yield]         "yield",
+    [SYS_sleep]         "sleep",
+    [SYS_kill]          "kill",
+    [SYS_gettime]       "gettime",
+    [SYS_getpid]        "getpid",
+    [SYS_brk]           "brk",
+    [SYS_mmap]          "mmap",
+    [SYS_munmap]        "munmap",
+    [SYS_shmem]         "shmem",
+    [SYS_putc]          "putc",
+    [SYS_pgdir]         "pgdir",
+    [SYS_open]          "open",
+    [SYS_close]         "close",
+    [SYS_read]          "read",
+    [SYS_write]         "write",
+    [SYS_seek]          "seek",
+    [SYS_fstat]         "fstat",
+    [SYS_fsync]         "fsync",
+    [SYS_chdir]         "chdir",
+    [SYS_getcwd]        "getcwd",
+    [SYS_mkdir]         "mkdir",
+    [SYS_link]          "link",
+    [SYS_rename]        "rename",
+    [SYS_readlink]      "readlink",
+    [SYS_symlink]       "symlink",
+    [SYS_unlink]        "unlink",
+    [SYS_getdirentry]   "getdirentry",
+    [SYS_dup]           "dup",
+    [SYS_get_pdb]       "get_pdb",
+    [SYS_nice]          "nice",
+    [SYS_futex]         "futex",
+    [SYS_nanosleep]     "nanosleep",
+    [SYS_batch]         "batch",
+    [SYS_uring_setup]   "uring_setup",
+    [SYS_uring_enter]   "uring_enter",
+    [SYS_sysprof]       "sysprof",
+};
+
+#define NUM_NAMES   ((sizeof(syscall_names)) / (sizeof(syscall_names[0])))
+
+static struct sysprof_stat stats[SYSPROF_MAX_CALLS];
+
+static const char *
+syscall_name(int num) {
+    if (num >= 0 && num < NUM_NAMES && syscall_names[num] != NULL) {
+        return syscall_names[num];
+    }
+    return "?";
+}
+
+// usecs - TSC cycles to microseconds
+static uint32_t
+usecs(uint64_t cycles, uint32_t tsc_khz) {
+    cycles *= 1000;
+    do_div(cycles, tsc_khz);
+    return (uint32_t)cycles;
+}
+
+// permille - part / total in tenths of a percent; do_div takes a 32-bit divisor
+static uint32_t
+permille(uint64_t part, uint64_t total) {
+    while ((total >> 32) != 0) {
+        part >>= 1, total >>= 1;
+    }
+    if (total == 0) {
+        return 0;
+    }
+    part *= 1000;
+    do_div(part, (uint32_t)total);
+    return (uint32_t)part;
+}
+
+static void
+print_hist(struct sysprof_stat *st, uint32_t tsc_khz) {
+    int b;
+    for (b = 0; b < SYSPROF_HIST_BUCKETS; b ++) {
+        if (st->hist[b] != 0) {
+            uint64_t limit = 1ULL << (SYSPROF_HIST_SHIFT + b);
+            if (b == SYSPROF_HIST_BUCKETS - 1) {
+                cprintf("        >= %8u us %8u\n", usecs(limit >> 1, tsc_khz), st->hist[b]);
+            }
+            else {
+                cprintf("        <  %8u us %8u\n", usecs(limit, tsc_khz), st->hist[b]);
+            }
+        }
+    }
+}
+
+static void
+usage(void) {
+    cprintf("usage: strace [-c] [-h] program [args ...]\n");
+    exit(-1);
+}
+
+int
+main(int argc, char **argv) {
+    int i, j, hist = 0, ret;
+    uint32_t tsc_khz = vdso_data_page()->tsc_khz;
+
+    for (i = 1; i < argc && argv[i][0] == '-'; i ++) {
+        if (strcmp(argv[i], "-h") == 0) {
+            hist = 1;
+        }
+        else if (strcmp(argv[i], "-c") != 0) {
+            usage();
+        }
+    }
+    if (i == argc) {
+        usage();
+    }
+    const char **prog = (const char **)argv + i;
+
+    if ((ret = sys_sysprof(SYSPROF_START, SYSPROF_CHILDREN, NULL, 0)) != 0) {
+        cprintf("strace: cannot start a profile: %e\n", ret);
+        return ret;
+    }
+    int pid, code;
+    if ((pid = fork()) == 0) {
+        ret = __exec(prog[0], prog);
+        cprintf("strace: exec %s failed: %e\n", prog[0], ret);
+        exit(ret);
+    }
+    assert(pid > 0 && waitpid(pid, &code) == 0);
+
+    int n = sys_sysprof(SYSPROF_READ, 0, stats, SYSPROF_MAX_CALLS);
+    sys_sysprof(SYSPROF_STOP, 0, NULL, 0);
+    assert(n >= 0);
+
+    // most time first
+    for (i = 1; i < n; i ++) {
+        struct sysprof_stat st = stats[i];
+        for (j = i; j > 0 && stats[j - 1].cycles < st.cycles; j --) {
+            stats[j] = stats[j - 1];
+        }
+        stats[j] = st;
+    }
+
+    uint64_t total = 0;
+    uint32_t calls = 0, errors = 0;
+    for (i = 0; i < n; i ++) {
+        total += stats[i].cycles;
+        calls += stats[i].calls;
+        errors += stats[i].errors;
+    }
+
+    cprintf("%% time      usecs  usecs/call   max usecs    calls   errors syscall\n");
+    cprintf("------ ---------- ----------- ----------- -------- -------- ----------------\n");
+    for (i = 0; i < n; i ++) {
+        struct sysprof_stat *st = &stats[i];
+        uint32_t share = permille(st->cycles, total), us = usecs(st->cycles, tsc_khz);
+        cprintf("%3u.%u %10u %11u %11u %8u %8u %s\n", share / 10, share % 10,
+                us, us / st->calls, usecs(st->max_cycles, tsc_khz), st->calls, st->errors,
+                syscall_name(st->num));
+        if (hist) {
+            print_hist(st, tsc_khz);
+        }
+    }
+    cprintf("------ ---------- ----------- ----------- -------- -------- ----------------\n");
+    cprintf("100.0 %10u %11s %11s %8u %8u total\n", usecs(total, tsc_khz), "", "", calls, errors);
+    cprintf("%s exited with %d\n", prog[0], code);
+    return 0;
+}
@@ -0,0 +1,47 @@
+#include <stdio.h>
+#include <ulib.h>
+#include <x86.h>
+#include <syscall.h>
+
+/* syscallbench - round-trip cost of a trivial system call (getpid) through
+ * int 0x80/iret and through sysenter/sysexit. Both paths dispatch into the
+ * same syscalls[] table, so the difference is the entry and exit. */
+
+#define ROUNDS 20000
+
+static uint32_t
+bench(void) {
+    int i, pid = getpid();
+    uint64_t start = rdtsc();
+    for (i = 0; i < ROUNDS; i ++) {
+        assert(sys_getpid() == pid);
+    }
+    // small enough to fit 32 bits, and no 64-bit division in user space
+    return (uint32_t)(rdtsc() - start) / ROUNDS;
+}
+
+int
+main(void) {
+    uint32_t trap_cycles, fast_cycles;
+    syscall_set_sysenter(0);
+    trap_cycles = bench();
+    if (!syscall_set_sysenter(1)) {
+        cprintf("syscallbench: no sysenter on this CPU, int 0x80 %u cycles/call\n", trap_cycles);
+        return 0;
+    }
+    fast_cycles = bench();
+    cprintf("syscallbench: %d getpid calls\n", ROUNDS);
+    cprintf("  int 0x80 / iret    : %u cycles/call\n", trap_cycles);
+    cprintf("  sysenter / sysexit : %u cycles/call\n", fast_cycles);
+
+    // fork and exec through the fast path come back through iret
+    int pid;
+    if ((pid = fork()) == 0) {
+        exit(getpid());
+    }
+    assert(pid > 0);
+    int code;
+    assert(waitpid(pid, &code) == 0 && code == pid);
+    cprintf("syscallbench pass.\n");
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <ulib.h>
+
+/* threadmany - start far more threads than the old 16 fixed stack slots
+ * allowed. Every thread stack is its own lazily populated area, so each
+ * worker only costs the pages it actually touches. */
+
+#define NR_WORKERS  300
+#define BIG_STACK   (512 * 1024)
+
+static pthread_t workers[NR_WORKERS];
+static int done[NR_WORKERS];
+
+static void *
+worker(void *arg) {
+    int id = (int)arg;
+    char buf[2048];
+    memset(buf, id & 0xff, sizeof(buf));
+    done[id] = buf[id % sizeof(buf)] == (char)(id & 0xff);
+    return NULL;
+}
+
+static int
+recurse(int depth) {
+    unsigned char frame[1024];
+    memset(frame, depth & 0xff, sizeof(frame));
+    if (depth == 0) {
+        return frame[0];
+    }
+    return recurse(depth - 1) + frame[sizeof(frame) - 1] - (depth & 0xff) + 1;
+}
+
+static void *
+deep_worker(void *arg) {
+    // about 400KB of frames, far past the default thread stack
+    done[0] = recurse(400) == 400;
+    return NULL;
+}
+
+int
+main(void) {
+    int i;
+    for (i = 0; i < NR_WORKERS; i ++) {
+        assert(pthread_create(&workers[i], worker, (void *)i) == 0);
+    }
+    for (i = 0; i < NR_WORKERS; i ++) {
+        pthread_join(&workers[i]);
+        assert(done[i]);
+    }
+    cprintf("threadmany: %d threads joined\n", NR_WORKERS);
+
+    done[0] = 0;
+    assert(pthread_create_stack(&workers[0], deep_worker, NULL, BIG_STACK) == 0);
+    pthread_join(&workers[0]);
+    assert(done[0]);
+    cprintf("threadmany: %d KB stack thread passed\n", BIG_STACK / 1024);
+
+    cprintf("threadmany pass.\n");
+    return 0;
+}
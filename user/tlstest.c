@@ -0,0 +1,52 @@
+#include <stdio.h>
+#include <ulib.h>
+#include <pthread.h>
+
+/* tlstest - every thread sees its own TLS block through %gs: the same key
+ * holds a different value in each thread, and nobody else's writes leak. */
+
+#define NR_THREADS  8
+#define ROUNDS      1000
+
+static pthread_key_t key;
+static pthread_t threads[NR_THREADS];
+static void *blocks[NR_THREADS];
+static int ok[NR_THREADS];
+
+static void *
+thread_main(void *arg) {
+    int id = (int)arg, i;
+    assert(pthread_getspecific(key) == NULL);
+    blocks[id] = pthread_tls();
+    for (i = 0; i < ROUNDS; i ++) {
+        pthread_setspecific(key, (void *)(id * ROUNDS + i));
+        yield();
+        if (pthread_getspecific(key) != (void *)(id * ROUNDS + i)) {
+            return NULL;
+        }
+    }
+    ok[id] = 1;
+    return NULL;
+}
+
+int
+main(void) {
+    int i, j;
+    assert(pthread_key_create(&key) == 0);
+    pthread_setspecific(key, (void *)0x1234);
+    for (i = 0; i < NR_THREADS; i ++) {
+        assert(pthread_create(&threads[i], thread_main, (void *)i) == 0);
+    }
+    for (i = 0; i < NR_THREADS; i ++) {
+        pthread_join(&threads[i]);
+        assert(ok[i]);
+        assert(blocks[i] != pthread_tls());
+        for (j = 0; j < i; j ++) {
+            assert(blocks[i] != blocks[j]);
+        }
+    }
+    assert(pthread_getspecific(key) == (void *)0x1234);
+    pthread_key_delete(key);
+    cprintf("tlstest pass.\n");
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include <stdio.h>
+#include <ulib.h>
+#include <x86.h>
+#include <syscall.h>
+#include <pthread.h>
+#include <vdso.h>
+
+/* vdsotest - getpid() and gettime_msec() answer from the TLS block and the
+ * vdso page without trapping; check they agree with the system calls in
+ * the parent, in a forked child and in a thread, and compare the cost. */
+
+#define ROUNDS 20000
+
+static void *
+thread_main(void *arg) {
+    assert(getpid() == sys_getpid());
+    assert(getpid() != (int)arg);
+    return NULL;
+}
+
+int
+main(void) {
+    int i, pid = sys_getpid();
+    assert(getpid() == pid);
+
+    pthread_t tid;
+    assert(pthread_create(&tid, thread_main, (void *)pid) == 0);
+    pthread_join(&tid);
+
+    int child, code;
+    if ((child = fork()) == 0) {
+        exit(getpid() == sys_getpid() && getpid() != pid ? 0 : -1);
+    }
+    assert(child > 0 && waitpid(child, &code) == 0 && code == 0);
+
+    unsigned int t0 = gettime_msec();
+    sleep(3);
+    unsigned int t1 = gettime_msec(), t2 = sys_gettime();
+    assert(t1 >= t0 + 3 && t2 >= t1 && t2 <= t1 + 1);
+
+    const struct vdso_data *vd = vdso_data_page();
+    cprintf("vdsotest: %u ticks/s, TSC %u kHz\n", vd->tick_hz, vd->tsc_khz);
+
+    uint64_t start = rdtsc();
+    for (i = 0; i < ROUNDS; i ++) {
+        gettime_msec();
+    }
+    uint32_t fast = (uint32_t)(rdtsc() - start) / ROUNDS;
+    start = rdtsc();
+    for (i = 0; i < ROUNDS; i ++) {
+        sys_gettime();
+    }
+    uint32_t slow = (uint32_t)(rdtsc() - start) / ROUNDS;
+    cprintf("  gettime via vdso : %u cycles/call\n", fast);
+    cprintf("  gettime syscall  : %u cycles/call\n", slow);
+    cprintf("vdsotest pass.\n");
+    return 0;
+}